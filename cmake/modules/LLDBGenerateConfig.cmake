@@ -19,6 +19,15 @@ check_cxx_symbol_exists(process_vm_readv "sys/uio.h" HAVE_PROCESS_VM_READV)
 check_cxx_symbol_exists(__NR_process_vm_readv "sys/syscall.h" HAVE_NR_PROCESS_VM_READV)
 
 check_library_exists(compression compression_encode_buffer "" HAVE_LIBCOMPRESSION)
+if (LLVM_ENABLE_ZLIB)
+  check_library_exists(z deflateBound "" HAVE_LIBZ)
+endif()
+if (LLDB_ENABLE_LZ4)
+  check_include_file(lz4.h HAVE_LZ4_H)
+  if (HAVE_LZ4_H)
+    check_library_exists(lz4 LZ4_compress_default "" HAVE_LIBLZ4)
+  endif()
+endif()
 
 # These checks exist in LLVM's configuration, so I want to match the LLVM names
 # so that the check isn't duplicated, but we translate them into the LLDB names
@@ -164,6 +164,25 @@ public:
 
   typedef std::shared_ptr<BreakpointPrecondition> BreakpointPreconditionSP;
 
+  //------------------------------------------------------------------
+  /// An item a tracepoint records each time it is hit: a register, or a
+  /// range of memory at a fixed address or relative to a register.
+  //------------------------------------------------------------------
+  struct CollectedItem {
+    // The register, or the base register of the memory range if any.
+    std::string reg_name;
+    bool is_memory = false;
+    // The address of the memory range, relative to reg_name if it is set.
+    int64_t offset = 0;
+    uint32_t size = 0;
+
+    /// Parse "<reg>" for a register, or "<addr>,<size>",
+    /// "<reg>[+-]<offset>,<size>" or "<reg>,<size>" for memory.
+    static bool Parse(llvm::StringRef text, CollectedItem &item);
+
+    void GetDescription(Stream &s) const;
+  };
+
   // Saving & restoring breakpoints:
   static lldb::BreakpointSP CreateFromStructuredData(
       Target &target, StructuredData::ObjectSP &data_object_sp, Status &error);
@@ -660,6 +679,22 @@ public:
   bool EvaluatePrecondition(StoppointCallbackContext &context);
 
   BreakpointPreconditionSP GetPrecondition() { return m_precondition_sp; }
+
+  //------------------------------------------------------------------
+  /// Make the breakpoint a tracepoint recording \a items when it is hit,
+  /// or a plain breakpoint if they are empty. Stubs which support it record
+  /// the hits of its locations without stopping, until the process plugin
+  /// reads them; elsewhere it stops like any other breakpoint.
+  //------------------------------------------------------------------
+  void SetCollectedItems(std::vector<CollectedItem> items) {
+    m_collected_items = std::move(items);
+  }
+
+  const std::vector<CollectedItem> &GetCollectedItems() const {
+    return m_collected_items;
+  }
+
+  bool IsTracepoint() const { return !m_collected_items.empty(); }
   
   // Produces the OR'ed values for all the names assigned to this breakpoint.
   const BreakpointName::Permissions &GetPermissions() const { 
@@ -766,6 +801,9 @@ private:
   // to skip certain breakpoint hits.  For instance, exception breakpoints use
   // this to limit the stop to certain exception classes, while leaving the
   // condition & callback free for user specification.
+  std::vector<CollectedItem> m_collected_items; // What the breakpoint
+                                                // records if it's a
+                                                // tracepoint.
   std::unique_ptr<BreakpointOptions>
       m_options_up; // Settable breakpoint options
   BreakpointLocationList
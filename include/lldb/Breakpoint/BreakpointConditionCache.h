@@ -0,0 +1,79 @@
+//===-- BreakpointConditionCache.h ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_BreakpointConditionCache_h_
+#define liblldb_BreakpointConditionCache_h_
+
+// C Includes
+// C++ Includes
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Other libraries and framework includes
+#include "llvm/ADT/StringRef.h"
+
+// Project includes
+#include "lldb/Expression/UserExpressionCache.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class BreakpointConditionCache BreakpointConditionCache.h
+/// "lldb/Breakpoint/BreakpointConditionCache.h"
+/// The parsed and JIT compiled conditions of the breakpoint locations of a
+/// target. Locations stopping in the same block with the same condition
+/// share one expression, which is parsed the first time any of them is hit
+/// and then only moved from one address to the other.
+///
+/// Like the user expressions of the target, an expression is found again
+/// only while the modules and persistent declarations it was parsed with
+/// are unchanged. The code of an expression lives in the process it was
+/// compiled for, so the cache is emptied whenever the target's process goes
+/// away.
+//----------------------------------------------------------------------
+class BreakpointConditionCache {
+public:
+  //------------------------------------------------------------------
+  /// Returns the expression of \a condition, in \a language, ready to be
+  /// executed in \a exe_ctx, parsing it if no location of the same block
+  /// has. Returns an empty pointer and sets \a error if it couldn't be
+  /// parsed.
+  //------------------------------------------------------------------
+  lldb::UserExpressionSP GetExpression(Target &target,
+                                       llvm::StringRef condition,
+                                       lldb::LanguageType language,
+                                       ExecutionContext &exe_ctx,
+                                       Status &error);
+
+  void Clear();
+
+  //------------------------------------------------------------------
+  /// Returns the time spent parsing conditions while the target was
+  /// collecting statistics.
+  //------------------------------------------------------------------
+  std::chrono::nanoseconds GetCompileTime() const;
+
+private:
+  // The key of a condition, which is parsed like an expression of its
+  // language evaluated with the default options.
+  static UserExpressionCache::Key MakeKey(llvm::StringRef condition,
+                                          lldb::LanguageType language,
+                                          ExecutionContext &exe_ctx);
+
+  mutable std::mutex m_mutex;
+  std::map<UserExpressionCache::Key, lldb::UserExpressionSP> m_expressions;
+  std::chrono::nanoseconds m_compile_time{0};
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_BreakpointConditionCache_h_
@@ -414,8 +414,6 @@ private:
   std::mutex m_condition_mutex; ///< Guards parsing and evaluation of the
                                 ///condition, which could be evaluated by
                                 /// multiple processes.
-  size_t m_condition_hash; ///< For testing whether the condition source code
-                           ///changed.
 
   void SetShouldResolveIndirectFunctions(bool do_resolve) {
     m_should_resolve_indirect_functions = do_resolve;
@@ -738,6 +738,20 @@ public:
   GetSymbolVendor(bool can_create = true,
                   lldb_private::Stream *feedback_strm = nullptr);
 
+  //------------------------------------------------------------------
+  /// Get the number of bytes of memory held by the debug information
+  /// parsed so far for this module. The symbol file isn't loaded if it
+  /// hasn't been yet.
+  //------------------------------------------------------------------
+  uint64_t GetParsedDebugInfoByteSize();
+
+  //------------------------------------------------------------------
+  /// Get the number of separate debug info files opened so far for this
+  /// module, and the time spent opening them in \a load_time. The symbol
+  /// file isn't loaded if it hasn't been yet.
+  //------------------------------------------------------------------
+  uint32_t GetSplitDebugInfoLoadStatistics(std::chrono::nanoseconds &load_time);
+
   //------------------------------------------------------------------
   /// Get accessor the type list for this module.
   ///
@@ -151,8 +151,17 @@ public:
   ///
   /// @param[in] module_sp
   ///     A shared pointer to a module to add to this collection.
+  ///
+  /// @param[in] notify
+  ///     If true, and a notifier function is set, the notifier function
+  ///     will be called.  Defaults to true.
+  ///
+  ///     When this ModuleList is the Target's ModuleList, the notifier
+  ///     function is Target::ModuleAdded.  Adding many modules at once is
+  ///     cheaper without notifications followed by one call to
+  ///     Target::ModulesDidLoad for all of them.
   //------------------------------------------------------------------
-  void Append(const lldb::ModuleSP &module_sp);
+  void Append(const lldb::ModuleSP &module_sp, bool notify = true);
 
   //------------------------------------------------------------------
   /// Append a module to the module list and remove any equivalent modules.
@@ -166,7 +175,7 @@ public:
   //------------------------------------------------------------------
   void ReplaceEquivalent(const lldb::ModuleSP &module_sp);
 
-  bool AppendIfNeeded(const lldb::ModuleSP &module_sp);
+  bool AppendIfNeeded(const lldb::ModuleSP &module_sp, bool notify = true);
 
   void Append(const ModuleList &module_list);
 
@@ -836,11 +836,15 @@ public:
 
   ~RangeDataVector() = default;
 
-  void Append(const Entry &entry) { m_entries.push_back(entry); }
+  void Append(const Entry &entry) {
+    m_entries.push_back(entry);
+    m_indexed = false;
+  }
 
   void Sort() {
     if (m_entries.size() > 1)
       std::stable_sort(m_entries.begin(), m_entries.end());
+    BuildIndex();
   }
 
 #ifdef ASSERT_RANGEMAP_ARE_SORTED
@@ -890,6 +894,8 @@ public:
       // swap when using the STL because std::vector objects never release or
       // reduce the memory once it has been allocated/reserved.
       m_entries.swap(minimal_ranges);
+      if (m_indexed)
+        BuildIndex();
     }
   }
 
@@ -919,11 +925,20 @@ public:
           pos->SetByteSize(full_size - curr_base);
       }
     }
+    if (m_indexed)
+      BuildIndex();
   }
 
-  void Clear() { m_entries.clear(); }
+  void Clear() {
+    m_entries.clear();
+    m_max_ends.clear();
+    m_indexed = false;
+  }
 
-  void Reserve(typename Collection::size_type size) { m_entries.resize(size); }
+  void Reserve(typename Collection::size_type size) {
+    m_entries.resize(size);
+    m_indexed = false;
+  }
 
   bool IsEmpty() const { return m_entries.empty(); }
 
@@ -933,7 +948,10 @@ public:
     return ((i < m_entries.size()) ? &m_entries[i] : nullptr);
   }
 
+  // The entry may be modified, so the index has to be rebuilt by calling
+  // Sort() again.
   Entry *GetMutableEntryAtIndex(size_t i) {
+    m_indexed = false;
     return ((i < m_entries.size()) ? &m_entries[i] : nullptr);
   }
 
@@ -961,6 +979,10 @@ public:
 
       if (pos != end && pos->Contains(addr))
         return std::distance(begin, pos);
+
+      // An entry can still contain addr if it encloses the entries right
+      // before addr which don't.
+      return FindLastEntryIndexThatContains(addr);
     }
     return UINT32_MAX;
   }
@@ -971,7 +993,16 @@ public:
     assert(IsSorted());
 #endif
 
-    if (!m_entries.empty()) {
+    if (m_indexed && m_max_ends.empty()) {
+      // The entries don't overlap, so at most one of them contains addr.
+      uint32_t idx = FindEntryIndexThatContains(addr);
+      if (idx != UINT32_MAX)
+        indexes.push_back(m_entries[idx].data);
+    } else if (m_indexed) {
+      ForEachEntryIndexThatContains(addr, 0, m_entries.size(), [&](size_t i) {
+        indexes.push_back(m_entries[i].data);
+      });
+    } else {
       for (const auto &entry : m_entries) {
         if (entry.Contains(addr))
           indexes.push_back(entry.data);
@@ -998,6 +1029,12 @@ public:
 
       if (pos != end && pos->Contains(addr))
         return &(*pos);
+
+      // An entry can still contain addr if it encloses the entries right
+      // before addr which don't.
+      uint32_t idx = FindLastEntryIndexThatContains(addr);
+      if (idx != UINT32_MAX)
+        return &m_entries[idx];
     }
     return nullptr;
   }
@@ -1020,6 +1057,12 @@ public:
 
       if (pos != end && pos->Contains(addr))
         return &(*pos);
+
+      // An entry can still contain addr if it encloses the entries right
+      // before addr which don't.
+      uint32_t idx = FindLastEntryIndexThatContains(addr);
+      if (idx != UINT32_MAX)
+        return &m_entries[idx];
     }
     return nullptr;
   }
@@ -1087,14 +1130,88 @@ public:
     return nullptr;
   }
 
-  Entry *Back() { return (m_entries.empty() ? nullptr : &m_entries.back()); }
+  // The entry may be modified, so the index has to be rebuilt by calling
+  // Sort() again.
+  Entry *Back() {
+    m_indexed = false;
+    return (m_entries.empty() ? nullptr : &m_entries.back());
+  }
 
   const Entry *Back() const {
     return (m_entries.empty() ? nullptr : &m_entries.back());
   }
 
 protected:
+  // Index the sorted entries to find all the ranges containing an address in
+  // O(log n + k) instead of O(n) when some of them overlap.
+  //
+  // The entries are seen as an implicit balanced binary search tree where the
+  // root of the entries [lo, hi) is the one at (lo + hi) / 2, and
+  // m_max_ends[i] is the largest range end in the subtree rooted at entry i.
+  void BuildIndex() {
+    m_max_ends.clear();
+    m_indexed = true;
+    bool overlaps = false;
+    for (size_t i = 1; i < m_entries.size() && !overlaps; ++i)
+      overlaps = m_entries[i - 1].GetRangeEnd() > m_entries[i].GetRangeBase();
+    // Without overlapping entries, a binary search finds the only entry
+    // containing an address.
+    if (!overlaps)
+      return;
+    m_max_ends.resize(m_entries.size());
+    BuildMaxEnds(0, m_entries.size());
+  }
+
+  B BuildMaxEnds(size_t lo, size_t hi) {
+    if (lo >= hi)
+      return B();
+    const size_t mid = lo + (hi - lo) / 2;
+    B max_end = m_entries[mid].GetRangeEnd();
+    max_end = std::max(max_end, BuildMaxEnds(lo, mid));
+    max_end = std::max(max_end, BuildMaxEnds(mid + 1, hi));
+    m_max_ends[mid] = max_end;
+    return max_end;
+  }
+
+  // Call 'callback' with the index of each entry in [lo, hi) containing
+  // 'addr', in increasing order. Requires the overlapping entries index.
+  template <typename Callback>
+  void ForEachEntryIndexThatContains(B addr, size_t lo, size_t hi,
+                                     const Callback &callback) const {
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      // No range of this subtree reaches addr.
+      if (m_max_ends[mid] <= addr)
+        return;
+      ForEachEntryIndexThatContains(addr, lo, mid, callback);
+      const Entry &entry = m_entries[mid];
+      // The entries of the right subtree start after addr too.
+      if (addr < entry.GetRangeBase())
+        return;
+      if (entry.Contains(addr))
+        callback(mid);
+      lo = mid + 1;
+    }
+  }
+
+  // Returns the index of the entry with the largest base containing 'addr',
+  // or UINT32_MAX if there is none or the entries have no overlapping entries
+  // index.
+  uint32_t FindLastEntryIndexThatContains(B addr) const {
+    uint32_t last = UINT32_MAX;
+    if (m_indexed && !m_max_ends.empty())
+      ForEachEntryIndexThatContains(addr, 0, m_entries.size(),
+                                    [&last](size_t i) { last = i; });
+    return last;
+  }
+
   Collection m_entries;
+  // The largest range ends of the overlapping entries index, empty if the
+  // entries don't overlap.
+  std::vector<B> m_max_ends;
+  // Whether the entries have been sorted, and m_max_ends built, since they
+  // were last modified.
+  bool m_indexed = false;
 };
 
 //----------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
 
@@ -60,6 +61,14 @@ public:
 
   void Append(const Entry &e) { m_map.push_back(e); }
 
+  //------------------------------------------------------------------
+  // Append all the entries of another map. This allows filling several maps
+  // in parallel and combining them before calling Sort().
+  //------------------------------------------------------------------
+  void Append(const UniqueCStringMap<T> &rhs) {
+    m_map.insert(m_map.end(), rhs.m_map.begin(), rhs.m_map.end());
+  }
+
   void Clear() { m_map.clear(); }
 
   //------------------------------------------------------------------
@@ -223,6 +232,11 @@ public:
   //------------------------------------------------------------------
   void Sort() { std::sort(m_map.begin(), m_map.end()); }
 
+  //------------------------------------------------------------------
+  // Same as Sort(), but large maps are sorted on the task pool.
+  //------------------------------------------------------------------
+  void ParallelSort() { TaskSort(m_map.begin(), m_map.end()); }
+
   //------------------------------------------------------------------
   // Since we are using a vector to contain our items it will always double its
   // memory consumption as things are added to the vector, so if you intend to
@@ -253,8 +253,18 @@ public:
 
   void RegisterExecutionUnit(lldb::IRExecutionUnitSP &execution_unit_sp);
 
+  //----------------------------------------------------------------------
+  /// Returns a count of the persistent variables and declarations made by
+  /// expressions so far, which later expressions can refer to by name.
+  /// Result variables aren't counted.
+  //----------------------------------------------------------------------
+  uint32_t GetDeclarationGeneration() const { return m_declaration_generation; }
+
+  void DidDeclare() { ++m_declaration_generation; }
+
 private:
   LLVMCastKind m_kind;
+  uint32_t m_declaration_generation = 0;
 
   typedef std::set<lldb::IRExecutionUnitSP> ExecutionUnitSet;
   ExecutionUnitSet
@@ -130,6 +130,18 @@ public:
 
   bool MatchesContext(ExecutionContext &exe_ctx);
 
+  //------------------------------------------------------------------
+  /// Move the context of the expression to the frame of \a exe_ctx, if it
+  /// is stopped in the same block of the same process as the expression was
+  /// parsed in, where the expression sees the same variables and types.
+  /// This lets an expression parsed at one address run at the others of
+  /// the block without being parsed again.
+  ///
+  /// @return
+  ///     True if the expression can now be executed in \a exe_ctx.
+  //------------------------------------------------------------------
+  bool RebindContext(ExecutionContext &exe_ctx);
+
   //------------------------------------------------------------------
   /// Execute the parsed expression by callinng the derived class's DoExecute
   /// method.
@@ -0,0 +1,117 @@
+//===-- UserExpressionCache.h -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_UserExpressionCache_h_
+#define liblldb_UserExpressionCache_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <mutex>
+#include <string>
+
+// Other libraries and framework includes
+#include "llvm/ADT/StringRef.h"
+
+// Project includes
+#include "lldb/Expression/Expression.h"
+#include "lldb/Utility/UUID.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class UserExpressionCache UserExpressionCache.h
+/// "lldb/Expression/UserExpressionCache.h"
+/// The parsed and JIT compiled user expressions of a target, so evaluating
+/// the same expression again in the same block, like a watch window does
+/// at every stop, only materializes and runs it.
+///
+/// An expression is found again only while the modules of the target and
+/// the persistent declarations of its language are the ones it was parsed
+/// with, since either could change what its names refer to. The code of
+/// the expressions lives in the process, so the cache is emptied whenever
+/// the process goes away, and holds a bounded number of expressions, the
+/// least recently used of which is dropped to make room for a new one.
+///
+/// The hits, misses and evictions are counted in the statistics of the
+/// target of the execution contexts.
+//----------------------------------------------------------------------
+class UserExpressionCache {
+public:
+  struct Key {
+    std::string text;
+    std::string prefix;
+    lldb::LanguageType language = lldb::eLanguageTypeUnknown;
+    Expression::ResultType desired_type = Expression::eResultTypeAny;
+    ExecutionPolicy execution_policy = eExecutionPolicyOnlyWhenNeeded;
+    bool generate_debug_info = false;
+    uint32_t process_id = 0;
+    UUID module_uuid;
+    // The load address of the function, so a module loaded again at another
+    // address doesn't reuse code made for the old one.
+    lldb::addr_t function_addr = LLDB_INVALID_ADDRESS;
+    lldb::user_id_t block_id = LLDB_INVALID_UID;
+    uint32_t images_generation = 0;
+    uint32_t declaration_generation = 0;
+
+    bool operator<(const Key &rhs) const;
+  };
+
+  explicit UserExpressionCache(size_t capacity) : m_capacity(capacity) {}
+
+  //------------------------------------------------------------------
+  /// Returns the key of \a text, parsed with these settings to be executed
+  /// in \a exe_ctx. Expressions parsed in the same block of the same process
+  /// with the same settings have the same key.
+  //------------------------------------------------------------------
+  static Key MakeKey(ExecutionContext &exe_ctx, llvm::StringRef text,
+                     llvm::StringRef prefix, lldb::LanguageType language,
+                     Expression::ResultType desired_type,
+                     ExecutionPolicy execution_policy,
+                     bool generate_debug_info);
+
+  //------------------------------------------------------------------
+  /// Returns whether the modules of the target of \a exe_ctx and the
+  /// persistent declarations of the language of \a key are still the ones
+  /// it was made with, so an expression parsed for it can be kept.
+  //------------------------------------------------------------------
+  static bool IsCurrent(const Key &key, ExecutionContext &exe_ctx);
+
+  //------------------------------------------------------------------
+  /// Returns the expression parsed for \a key, ready to be executed in
+  /// \a exe_ctx, or an empty pointer if there is none or it is in use.
+  //------------------------------------------------------------------
+  lldb::UserExpressionSP Find(const Key &key, ExecutionContext &exe_ctx);
+
+  //------------------------------------------------------------------
+  /// Add the expression parsed for \a key in \a exe_ctx, unless parsing it
+  /// declared something, in which case evaluating it again has to declare
+  /// it again.
+  //------------------------------------------------------------------
+  void Insert(const Key &key, ExecutionContext &exe_ctx,
+              const lldb::UserExpressionSP &expr_sp);
+
+  void Clear();
+
+private:
+  struct Entry {
+    lldb::UserExpressionSP expr_sp;
+    uint64_t last_use;
+  };
+
+  const size_t m_capacity;
+  mutable std::mutex m_mutex;
+  std::map<Key, Entry> m_entries;
+  uint64_t m_use_count = 0;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_UserExpressionCache_h_
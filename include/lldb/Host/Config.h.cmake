@@ -34,4 +34,12 @@
 #cmakedefine HAVE_LIBCOMPRESSION
 #endif
 
+#ifndef HAVE_LIBZ
+#cmakedefine HAVE_LIBZ
+#endif
+
+#ifndef HAVE_LIBLZ4
+#cmakedefine HAVE_LIBLZ4
+#endif
+
 #endif // #ifndef LLDB_HOST_CONFIG_H
@@ -11,8 +11,11 @@
 #define utility_TaskPool_h_
 
 #include "llvm/ADT/STLExtras.h"
+#include <algorithm>  // for sort, inplace_merge
+#include <chrono>     // for microseconds, seconds
 #include <functional> // for bind, function
 #include <future>
+#include <iterator>   // for iterator_traits
 #include <list>
 #include <memory>      // for make_shared
 #include <mutex>       // for mutex, unique_lock, condition_variable
@@ -21,12 +24,17 @@
 namespace lldb_private {
 
 // Global TaskPool class for running tasks in parallel on a set of worker
-// thread created the first time the task pool is used. The TaskPool provide no
-// guarantee about the order the task will be run and about what tasks will run
-// in parallel. None of the task added to the task pool should block on
-// something (mutex, future, condition variable) what will be set only by the
-// completion of an other task on the task pool as they may run on the same
-// thread sequentally.
+// threads created the first time the task pool is used. The workers live for
+// the rest of the process and each of them owns a queue of tasks: tasks added
+// from a worker go to that worker's queue and idle workers steal from the
+// queues of busy ones. The TaskPool provide no guarantee about the order the
+// task will be run and about what tasks will run in parallel.
+//
+// A task may wait for tasks it added itself by calling TaskPool::Wait, which
+// keeps running other pending tasks on the waiting worker. None of the task
+// added to the task pool should block on anything else (mutex, condition
+// variable) what will be set only by the completion of an other task on the
+// task pool as they may run on the same thread sequentally.
 class TaskPool {
 public:
   // Add a new task to the task pool and return a std::future belonging to the
@@ -43,12 +51,24 @@ public:
   // then call wait() on each returned future.
   template <typename... T> static void RunTasks(T &&... tasks);
 
+  // Wait until the given future is ready. When called from a worker thread
+  // of the task pool, the worker runs other pending tasks while waiting
+  // instead of blocking, so tasks can safely wait for nested tasks.
+  template <typename T> static void Wait(const std::future<T> &future);
+
 private:
   TaskPool() = delete;
 
   template <typename... T> struct RunTaskImpl;
 
   static void AddTaskImpl(std::function<void()> &&task_fn);
+
+  // Returns true if the calling thread is one of the task pool workers.
+  static bool IsWorkerThread();
+
+  // Run one pending task on the calling worker thread. Returns false if
+  // there was nothing to run.
+  static bool RunPendingTask();
 };
 
 template <typename F, typename... Args>
@@ -67,12 +87,24 @@ template <typename... T> void TaskPool::RunTasks(T &&... tasks) {
   RunTaskImpl<T...>::Run(std::forward<T>(tasks)...);
 }
 
+template <typename T> void TaskPool::Wait(const std::future<T> &future) {
+  if (!IsWorkerThread()) {
+    future.wait();
+    return;
+  }
+  while (future.wait_for(std::chrono::seconds(0)) !=
+         std::future_status::ready) {
+    if (!RunPendingTask())
+      future.wait_for(std::chrono::microseconds(100));
+  }
+}
+
 template <typename Head, typename... Tail>
 struct TaskPool::RunTaskImpl<Head, Tail...> {
   static void Run(Head &&h, Tail &&... t) {
     auto f = AddTask(std::forward<Head>(h));
     RunTaskImpl<Tail...>::Run(std::forward<Tail>(t)...);
-    f.wait();
+    Wait(f);
   }
 };
 
@@ -80,14 +112,57 @@ template <> struct TaskPool::RunTaskImpl<> {
   static void Run() {}
 };
 
-// Run 'func' on every value from begin .. end-1.  Each worker will grab
-// 'batch_size' numbers at a time to work on, so for very fast functions, batch
-// should be large enough to avoid too much cache line contention.
+// Run 'func' on every value from begin .. end-1.  The range is split into
+// batches and each worker, as well as the calling thread, grabs one batch at a
+// time. There are several batches per worker so that uneven work still
+// balances out, while fast functions don't contend on the shared counter for
+// every single value. It is safe to call this from within a task.
 void TaskMapOverInt(size_t begin, size_t end,
                     const llvm::function_ref<void(size_t)> &func);
 
 unsigned GetHardwareConcurrencyHint();
 
+// Sort the elements in [begin, end) with 'comp' like std::sort does. Large
+// ranges are split in one chunk per worker, the chunks are sorted in
+// parallel and then merged pairwise, also in parallel. Like std::sort, this
+// is not a stable sort. It is safe to call this from within a task.
+template <typename RandomIt, typename Compare>
+void TaskSort(RandomIt begin, RandomIt end, Compare comp) {
+  // Below this size the cost of dispatching the chunks to the workers
+  // outweighs the gains.
+  const size_t min_chunk_size = 16 * 1024;
+  const size_t size = end - begin;
+
+  // Use a power of two number of chunks so that they can be merged in pairs.
+  size_t num_chunks = 1;
+  while (num_chunks < GetHardwareConcurrencyHint() &&
+         size / (num_chunks * 2) >= min_chunk_size)
+    num_chunks *= 2;
+  if (num_chunks == 1) {
+    std::sort(begin, end, comp);
+    return;
+  }
+
+  auto chunk_begin = [begin, size, num_chunks](size_t i) {
+    return begin + size * i / num_chunks;
+  };
+  TaskMapOverInt(0, num_chunks, [&](size_t i) {
+    std::sort(chunk_begin(i), chunk_begin(i + 1), comp);
+  });
+  for (size_t width = 1; width < num_chunks; width *= 2) {
+    TaskMapOverInt(0, num_chunks / (2 * width), [&](size_t i) {
+      const size_t first = i * 2 * width;
+      std::inplace_merge(chunk_begin(first), chunk_begin(first + width),
+                         chunk_begin(first + 2 * width), comp);
+    });
+  }
+}
+
+template <typename RandomIt> void TaskSort(RandomIt begin, RandomIt end) {
+  TaskSort(begin, end,
+           std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
 } // namespace lldb_private
 
 #endif // #ifndef utility_TaskPool_h_
@@ -87,6 +87,42 @@ public:
   virtual Status ReadMemoryWithoutTrap(lldb::addr_t addr, void *buf,
                                        size_t size, size_t &bytes_read) = 0;
 
+  //------------------------------------------------------------------
+  /// A range of the inferior's memory and the local buffer receiving its
+  /// contents, used for scatter/gather reads.
+  //------------------------------------------------------------------
+  struct MemoryReadRange {
+    lldb::addr_t addr;
+    void *buf;
+    size_t size;
+    /// Set to the number of bytes read into \a buf. A count smaller than
+    /// \a size means that the rest of the range couldn't be read.
+    size_t bytes_read;
+  };
+
+  //------------------------------------------------------------------
+  /// Read several ranges of memory at once.
+  ///
+  /// Each range is read as far as possible independently of the others, so
+  /// an unreadable range doesn't prevent reading the following ones. The
+  /// default implementation calls ReadMemory for each range, subclasses can
+  /// override it with something faster.
+  ///
+  /// @return
+  ///     An error if the memory couldn't be accessed at all. Failures to
+  ///     read individual ranges are reported through their bytes_read
+  ///     member.
+  //------------------------------------------------------------------
+  virtual Status
+  ReadMemoryRanges(llvm::MutableArrayRef<MemoryReadRange> ranges);
+
+  //------------------------------------------------------------------
+  /// Same as ReadMemoryRanges, but also replaces the breakpoint traps
+  /// inserted into the memory with the original opcodes.
+  //------------------------------------------------------------------
+  Status
+  ReadMemoryRangesWithoutTrap(llvm::MutableArrayRef<MemoryReadRange> ranges);
+
   virtual Status WriteMemory(lldb::addr_t addr, const void *buf, size_t size,
                              size_t &bytes_written) = 0;
 
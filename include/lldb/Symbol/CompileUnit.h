@@ -245,6 +245,15 @@ public:
   //------------------------------------------------------------------
   LineTable *GetLineTable();
 
+  //------------------------------------------------------------------
+  /// Check if the line table has been parsed, or if parsing it has been
+  /// attempted, without parsing it.
+  ///
+  /// Used by SymbolFile plug-ins which parse the line tables of several
+  /// compile units at once.
+  //------------------------------------------------------------------
+  bool HasParsedLineTable() const;
+
   DebugMacros *GetDebugMacros();
 
   //------------------------------------------------------------------
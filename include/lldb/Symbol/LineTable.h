@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <memory>
 #include <vector>
 
 // Other libraries and framework includes
@@ -94,6 +95,12 @@ public:
   // Insert a sequence of entries into this line table.
   void InsertSequence(LineSequence *sequence);
 
+  // Insert all the sequences of entries of a line table at once. They are
+  // inserted in address order, so that they are appended to the entries
+  // instead of being inserted in the middle of them, and the line table is
+  // indexed by sequence for FindLineEntryByAddress.
+  void InsertSequences(std::vector<std::unique_ptr<LineSequence>> &sequences);
+
   //------------------------------------------------------------------
   /// Dump all line entries in this line table to the stream \a s.
   ///
@@ -352,6 +359,12 @@ protected:
       *m_comp_unit; ///< The compile unit that this line table belongs to.
   entry_collection
       m_entries; ///< The collection of line entries in this line table.
+  // The address range of each sequence and the indexes of its first and
+  // terminal entries, or nothing if the sequences haven't been indexed.
+  typedef RangeDataVector<lldb::addr_t, lldb::addr_t,
+                          std::pair<uint32_t, uint32_t>>
+      SequenceIndex;
+  SequenceIndex m_sequence_index;
 
   //------------------------------------------------------------------
   // Helper class
@@ -370,6 +383,12 @@ protected:
 
   bool ConvertEntryAtIndexToLineEntry(uint32_t idx, LineEntry &line_entry);
 
+  // Fill m_sequence_index from m_entries.
+  void IndexSequences();
+
+  // Find the entry for "file_addr" in the rows of the sequence containing it.
+  uint32_t FindEntryIndexInSequences(lldb::addr_t file_addr) const;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(LineTable);
 };
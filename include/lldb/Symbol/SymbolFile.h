@@ -19,6 +19,8 @@
 
 #include "llvm/ADT/DenseSet.h"
 
+#include <chrono>
+
 namespace lldb_private {
 
 class SymbolFile : public PluginInterface {
@@ -202,6 +204,23 @@ public:
 
   virtual void Dump(Stream &s) {}
 
+  //------------------------------------------------------------------
+  /// Returns the number of bytes of memory held by the debug information
+  /// parsed so far (e.g. the DIEs extracted from DWARF units).
+  //------------------------------------------------------------------
+  virtual uint64_t GetParsedDebugInfoByteSize() { return 0; }
+
+  //------------------------------------------------------------------
+  /// Returns the number of separate debug info files (e.g. split DWARF
+  /// .dwo files) opened so far, and the time spent opening them in
+  /// \a load_time.
+  //------------------------------------------------------------------
+  virtual uint32_t
+  GetSplitDebugInfoLoadStatistics(std::chrono::nanoseconds &load_time) {
+    load_time = std::chrono::nanoseconds::zero();
+    return 0;
+  }
+
 protected:
   ObjectFile *m_obj_file; // The object file that symbols can be extracted from.
   uint32_t m_abilities;
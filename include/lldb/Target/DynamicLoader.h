@@ -254,10 +254,14 @@ public:
 
   /// Locates or creates a module given by @p file and updates/loads the
   /// resulting module at the virtual base address @p base_addr.
+  ///
+  /// If @p notify is false, a module that gets added to the target is not
+  /// announced through Target::ModulesDidLoad, the caller has to do it.
   virtual lldb::ModuleSP LoadModuleAtAddress(const lldb_private::FileSpec &file,
                                              lldb::addr_t link_map_addr,
                                              lldb::addr_t base_addr,
-                                             bool base_addr_is_offset);
+                                             bool base_addr_is_offset,
+                                             bool notify = true);
 
   //------------------------------------------------------------------
   /// Get information about the shared cache for a process, if possible.
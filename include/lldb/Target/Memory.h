@@ -25,10 +25,34 @@
 namespace lldb_private {
 //----------------------------------------------------------------------
 // A class to track memory that was read from a live process between
-// runs.
+// runs. The cached memory is what Process::ReadMemoryFromInferior returns,
+// with the original opcodes in place of any software breakpoint traps.
 //----------------------------------------------------------------------
 class MemoryCache {
 public:
+  //------------------------------------------------------------------
+  // Counters describing how well the cache performs. They are kept for
+  // the lifetime of the process and are not reset by Clear().
+  //------------------------------------------------------------------
+  struct Statistics {
+    // Reads that were served entirely from an L1 cache chunk
+    uint64_t l1_hits = 0;
+    // L2 cache lines that were found in the cache
+    uint64_t l2_hits = 0;
+    // L2 cache lines that had to be read from the process
+    uint64_t l2_misses = 0;
+    // Bytes copied out of the L1 and L2 caches
+    uint64_t bytes_from_cache = 0;
+    // Bytes read from the process, including prefetched lines
+    uint64_t bytes_from_process = 0;
+    // Reads from the process that fetched lines ahead of the current one
+    uint64_t prefetch_reads = 0;
+    // L2 cache lines that were read ahead of being requested
+    uint64_t prefetched_lines = 0;
+    // L1 chunks and L2 cache lines dropped by Flush()
+    uint64_t invalidations = 0;
+  };
+
   //------------------------------------------------------------------
   // Constructors and Destructors
   //------------------------------------------------------------------
@@ -54,6 +78,8 @@ public:
   void AddL1CacheData(lldb::addr_t addr,
                       const lldb::DataBufferSP &data_buffer_sp);
 
+  Statistics GetStatistics();
+
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
   typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
@@ -70,8 +96,29 @@ protected:
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  uint32_t m_prefetch_line_count;
+  // The last L2 cache line that was accessed, the distance from the line
+  // accessed before it and how many times in a row that distance was seen.
+  lldb::addr_t m_last_line_addr;
+  int64_t m_stride;
+  uint32_t m_stride_count;
+  Statistics m_stats;
 
 private:
+  void TrackLineAccess(lldb::addr_t line_addr);
+
+  // Returns the addresses of the lines that are expected to be accessed
+  // after the one at line_addr, based on the current access stride.
+  std::vector<lldb::addr_t> GetPrefetchLines(lldb::addr_t line_addr);
+
+  bool IntersectsInvalidRange(lldb::addr_t addr, lldb::addr_t size);
+
+  // Read the L2 cache line at line_addr, along with any lines that are
+  // predicted to be read next, into m_L2_cache. Returns the number of bytes
+  // read for the line at line_addr.
+  size_t FillL2CacheLine(lldb::addr_t line_addr, Status &error);
+
+
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
 };
 
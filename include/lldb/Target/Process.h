@@ -75,6 +75,8 @@ public:
 
   uint64_t GetMemoryCacheLineSize() const;
 
+  uint64_t GetMemoryCachePrefetchLines() const;
+
   Args GetExtraStartupCommands() const;
 
   void SetExtraStartupCommands(const Args &args);
@@ -1763,6 +1765,61 @@ public:
   virtual size_t ReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                             Status &error);
 
+  typedef Range<lldb::addr_t, size_t> MemoryRange;
+
+  //------------------------------------------------------------------
+  /// Read several, possibly unrelated, ranges of memory from a process.
+  ///
+  /// Reading many small objects one at a time costs a round trip to the
+  /// debug server for each of them. Processes that support it fetch all
+  /// the ranges at once, other ones fall back to one Process::ReadMemory
+  /// call per range. Traps that may have been inserted into the memory are
+  /// removed like in Process::ReadMemory.
+  ///
+  /// Unless the memory cache is disabled, the ranges that were fetched at
+  /// once are added to it, so that reading them again with
+  /// Process::ReadMemory doesn't go back to the process.
+  ///
+  /// @param[in] ranges
+  ///     The address and size of each range to read.
+  ///
+  /// @param[out] buffer
+  ///     A buffer that will receive the bytes of each range one after the
+  ///     other, each range starting right after the end of the previous one.
+  ///     It must be at least as large as the sum of the sizes of \a ranges.
+  ///
+  /// @return
+  ///     The number of bytes read for each range. A count that is smaller
+  ///     than the size of its range indicates that only the beginning of the
+  ///     range could be read.
+  //------------------------------------------------------------------
+  std::vector<size_t> ReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                       llvm::MutableArrayRef<uint8_t> buffer);
+
+  //------------------------------------------------------------------
+  /// Read several ranges of memory like Process::ReadMemoryRanges, without
+  /// going through the memory cache, the way Process::ReadMemoryFromInferior
+  /// reads a single range.
+  //------------------------------------------------------------------
+  std::vector<size_t>
+  ReadMemoryRangesFromInferior(llvm::ArrayRef<MemoryRange> ranges,
+                               llvm::MutableArrayRef<uint8_t> buffer);
+
+  //------------------------------------------------------------------
+  /// Actually do the reading of several ranges of memory from a process.
+  ///
+  /// Subclasses that can read many ranges more efficiently than with one
+  /// DoReadMemory call per range should override this function. The default
+  /// implementation returns an empty vector, which makes
+  /// Process::ReadMemoryRanges read each range on its own.
+  ///
+  /// @see Process::ReadMemoryRanges
+  //------------------------------------------------------------------
+  virtual std::vector<size_t>
+  DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges, uint8_t *buf) {
+    return std::vector<size_t>();
+  }
+
   //------------------------------------------------------------------
   /// Read a NULL terminated string from memory
   ///
@@ -2349,6 +2406,18 @@ public:
   // doesn't work for a specific process plug-in.
   virtual Status DisableSoftwareBreakpoint(BreakpointSite *bp_site);
 
+  //------------------------------------------------------------------
+  /// Record a hit of the tracepoint \a bp, which stopped \a thread, so
+  /// that it doesn't have to stop the process.
+  ///
+  /// @return
+  ///     False if this process can't record tracepoint hits, in which
+  ///     case the tracepoint stops like a plain breakpoint.
+  //------------------------------------------------------------------
+  virtual bool RecordTracepointHit(Thread &thread, Breakpoint &bp) {
+    return false;
+  }
+
   BreakpointSiteList &GetBreakpointSiteList();
 
   const BreakpointSiteList &GetBreakpointSiteList() const;
@@ -2604,6 +2673,13 @@ public:
   //------------------------------------------------------------------
   bool RemoveInvalidMemoryRange(const LoadRange &region);
 
+  //------------------------------------------------------------------
+  // Get the hit, miss and traffic counters of the memory cache.
+  //------------------------------------------------------------------
+  MemoryCache::Statistics GetMemoryCacheStatistics() {
+    return m_memory_cache.GetStatistics();
+  }
+
   //------------------------------------------------------------------
   // If the setup code of a thread plan needs to do work that might involve
   // calling a function in the target, it should not do that work directly in
@@ -3139,6 +3215,11 @@ protected:
   size_t RemoveBreakpointOpcodesFromBuffer(lldb::addr_t addr, size_t size,
                                            uint8_t *buf) const;
 
+  std::vector<size_t>
+  ReadMemoryRangesImpl(llvm::ArrayRef<MemoryRange> ranges,
+                       llvm::MutableArrayRef<uint8_t> buffer,
+                       bool use_memory_cache);
+
   void SynchronouslyNotifyStateChanged(lldb::StateType state);
 
   void SetPublicState(lldb::StateType new_state, bool restarted);
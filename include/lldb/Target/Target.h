@@ -20,6 +20,7 @@
 
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Breakpoint/BreakpointConditionCache.h"
 #include "lldb/Breakpoint/BreakpointList.h"
 #include "lldb/Breakpoint/BreakpointName.h"
 #include "lldb/Breakpoint/WatchpointList.h"
@@ -29,6 +30,7 @@
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Expression/Expression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Symbol/TypeSystem.h"
 #include "lldb/Target/ExecutionContextScope.h"
 #include "lldb/Target/PathMappingList.h"
@@ -36,6 +38,7 @@
 #include "lldb/Target/SectionLoadHistory.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/LLDBAssert.h"
+#include "lldb/Utility/StructuredData.h"
 #include "lldb/Utility/Timeout.h"
 #include "lldb/lldb-public.h"
 
@@ -494,8 +497,31 @@ public:
 
   static void SetDefaultArchitecture(const ArchSpec &arch);
 
+  //------------------------------------------------------------------
+  /// Find or create the module matching \a module_spec and add it to the
+  /// target's image list if it isn't in it yet.
+  ///
+  /// @param[in] notify
+  ///     If false, the module is added without calling ModulesDidLoad for
+  ///     it. The caller is then responsible for calling ModulesDidLoad,
+  ///     which allows notifying about many modules at once.
+  //------------------------------------------------------------------
   lldb::ModuleSP GetSharedModule(const ModuleSpec &module_spec,
-                                 Status *error_ptr = nullptr);
+                                 Status *error_ptr = nullptr,
+                                 bool notify = true);
+
+  //------------------------------------------------------------------
+  /// Add \a module_sp to the target's image list if it isn't in it yet.
+  ///
+  /// @param[in] notify
+  ///     If false, the module is added without calling ModulesDidLoad for
+  ///     it, like in GetSharedModule.
+  ///
+  /// @return
+  ///     True if the module was added.
+  //------------------------------------------------------------------
+  bool AppendModuleIfNeeded(const lldb::ModuleSP &module_sp,
+                            bool notify = true);
 
   //----------------------------------------------------------------------
   // Settings accessors
@@ -1287,6 +1313,11 @@ protected:
   bool m_suppress_stop_hooks;
   bool m_is_dummy_target;
   unsigned m_next_persistent_variable_index = 0;
+  BreakpointConditionCache m_breakpoint_condition_cache;
+  // The most expressions kept parsed for evaluating again is arbitrary; each
+  // holds its code in the process.
+  UserExpressionCache m_user_expression_cache{128};
+  uint32_t m_images_generation = 0;
 
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
@@ -1311,7 +1342,28 @@ public:
     m_stats_storage[key] += 1;
   }
 
-  std::vector<uint32_t> GetStatistics() { return m_stats_storage; }
+  //------------------------------------------------------------------
+  /// Returns the statistics of the target, its process, modules and the
+  /// global string pool, as printed by "statistics dump" and returned by
+  /// SBTarget::GetStatistics(). The counts of StatisticKind are only
+  /// collected between "statistics enable" and "statistics disable".
+  //------------------------------------------------------------------
+  StructuredData::DictionarySP GetStatistics();
+
+  BreakpointConditionCache &GetBreakpointConditionCache() {
+    return m_breakpoint_condition_cache;
+  }
+
+  UserExpressionCache &GetUserExpressionCache() {
+    return m_user_expression_cache;
+  }
+
+  //------------------------------------------------------------------
+  /// Returns a count of the changes to the modules of the target and to
+  /// their symbols, which can change what the names in expressions refer
+  /// to.
+  //------------------------------------------------------------------
+  uint32_t GetImagesGeneration() const { return m_images_generation; }
 
 private:
   //------------------------------------------------------------------
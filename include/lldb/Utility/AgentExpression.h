@@ -0,0 +1,129 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_AGENTEXPRESSION_H
+#define LLDB_UTILITY_AGENTEXPRESSION_H
+
+#include "lldb/Utility/Status.h"
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class AgentExpression AgentExpression.h
+/// "lldb/Utility/AgentExpression.h"
+/// A program in the agent expression bytecode of the gdb-remote protocol,
+/// which a stub evaluates without help from the debugger, for instance to
+/// test the condition of a breakpoint. Only the subset of the opcodes
+/// needed to test integer conditions on registers and memory is supported.
+//----------------------------------------------------------------------
+class AgentExpression {
+public:
+  // The opcodes, with the values the gdb-remote protocol gives them. Their
+  // operands follow them in big endian order.
+  enum Opcode : uint8_t {
+    eOpAdd = 0x02,
+    eOpSub = 0x03,
+    eOpMul = 0x04,
+    eOpLogNot = 0x0e,
+    eOpBitAnd = 0x0f,
+    eOpBitOr = 0x10,
+    eOpBitXor = 0x11,
+    eOpBitNot = 0x12,
+    eOpEqual = 0x13,
+    eOpLessSigned = 0x14,
+    eOpLessUnsigned = 0x15,
+    eOpExt = 0x16, // 1 byte operand: the number of bits to sign extend.
+    eOpRef8 = 0x17,
+    eOpRef16 = 0x18,
+    eOpRef32 = 0x19,
+    eOpRef64 = 0x1a,
+    eOpIfGoto = 0x20, // 2 byte operand: the offset to jump to.
+    eOpGoto = 0x21, // 2 byte operand: the offset to jump to.
+    eOpConst8 = 0x22,
+    eOpConst16 = 0x23,
+    eOpConst32 = 0x24,
+    eOpConst64 = 0x25,
+    eOpReg = 0x26, // 2 byte operand: the register number.
+    eOpEnd = 0x27,
+    eOpDup = 0x28,
+    eOpPop = 0x29,
+    eOpZeroExt = 0x2a, // 1 byte operand: the number of bits to keep.
+    eOpSwap = 0x2b
+  };
+
+  /// What an expression can read from the inferior.
+  class Context {
+  public:
+    virtual ~Context() = default;
+
+    /// Read register \a reg, numbered the way the stub numbers them.
+    virtual Status ReadRegister(uint32_t reg, uint64_t &value) = 0;
+
+    /// Read the \a size bytes at \a addr, in the byte order of the inferior.
+    virtual Status ReadMemory(lldb::addr_t addr, size_t size,
+                              uint64_t &value) = 0;
+  };
+
+  AgentExpression() = default;
+
+  explicit AgentExpression(llvm::ArrayRef<uint8_t> bytes)
+      : m_bytes(bytes.begin(), bytes.end()) {}
+
+  llvm::ArrayRef<uint8_t> GetBytes() const { return m_bytes; }
+
+  size_t GetSize() const { return m_bytes.size(); }
+
+  //------------------------------------------------------------------
+  // Building expressions.
+  //------------------------------------------------------------------
+  void Emit(Opcode op) { m_bytes.push_back(op); }
+
+  /// Push \a value with the smallest const opcode which holds it.
+  void EmitConst(uint64_t value);
+
+  void EmitReg(uint32_t reg);
+
+  /// Replace the address on top of the stack with the \a byte_size bytes of
+  /// memory it points to, \a byte_size being 1, 2, 4 or 8.
+  void EmitRef(uint32_t byte_size);
+
+  void EmitExt(uint8_t bits);
+
+  void EmitZeroExt(uint8_t bits);
+
+  /// Emit \a op, which is eOpGoto or eOpIfGoto, and return the offset of its
+  /// operand, to give to SetGotoTarget() once the target is known.
+  size_t EmitGoto(Opcode op);
+
+  void SetGotoTarget(size_t operand_offset, size_t target);
+
+  //------------------------------------------------------------------
+  /// Run the expression and return the value on top of the stack when it
+  /// reaches eOpEnd in \a result. The evaluation fails on an unknown opcode,
+  /// a stack underflow or overflow, a jump out of the expression, a failed
+  /// read or when it takes too many steps, as a loop would.
+  //------------------------------------------------------------------
+  Status Evaluate(Context &context, uint64_t &result) const;
+
+private:
+  void EmitOperand(uint64_t value, size_t byte_size);
+
+  std::vector<uint8_t> m_bytes;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_AGENTEXPRESSION_H
@@ -0,0 +1,43 @@
+//===-- CRC32.h -------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_CRC32_H
+#define LLDB_UTILITY_CRC32_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stdint.h>
+
+namespace lldb_private {
+
+/// Computes the CRC-32 checksum used by zlib and by the .gnu_debuglink
+/// section (ISO 3309, reflected polynomial 0xedb88320).
+///
+/// The data can be fed in pieces of any size, so large files can be
+/// checksummed without holding all of their contents at once. The
+/// implementation is picked at runtime depending on what the CPU supports.
+class CRC32 {
+public:
+  explicit CRC32(uint32_t crc = 0) : m_crc(crc) {}
+
+  void Update(llvm::ArrayRef<uint8_t> data);
+
+  uint32_t GetValue() const { return m_crc; }
+
+  /// Returns the checksum of \a data, continuing from the checksum \a crc of
+  /// the data preceding it.
+  static uint32_t Calculate(llvm::ArrayRef<uint8_t> data, uint32_t crc = 0);
+
+private:
+  uint32_t m_crc;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_CRC32_H
@@ -13,7 +13,10 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FormatVariadic.h" // for format_provider
 
+#include <memory>
+
 #include <stddef.h> // for size_t
+#include <stdint.h> // for uint32_t, uint64_t
 
 namespace lldb_private {
 class Stream;
@@ -466,13 +469,67 @@ public:
   //------------------------------------------------------------------
   static size_t StaticMemorySize();
 
+  //------------------------------------------------------------------
+  /// The memory held by a string pool.
+  //------------------------------------------------------------------
+  struct MemoryReport {
+    /// The number of strings in the pool.
+    uint64_t num_strings = 0;
+    /// The bytes used by the strings and their entries.
+    uint64_t bytes_used = 0;
+    /// The bytes allocated for the strings, which are allocated in slabs,
+    /// and for the hash tables they are looked up in. They are never given
+    /// back to the system.
+    uint64_t bytes_allocated = 0;
+    /// The number of shards the pool is split in, each with its own lock,
+    /// and the fewest and most strings found in one of them.
+    uint32_t num_shards = 0;
+    uint64_t min_shard_strings = 0;
+    uint64_t max_shard_strings = 0;
+  };
+
+  //------------------------------------------------------------------
+  /// Get a report of the memory held by the global string pool.
+  //------------------------------------------------------------------
+  static MemoryReport GetMemoryReport();
+
 protected:
+  friend class ConstStringArena;
+
   //------------------------------------------------------------------
   // Member variables
   //------------------------------------------------------------------
   const char *m_string;
 };
 
+//----------------------------------------------------------------------
+/// @class ConstStringArena ConstString.h "lldb/Utility/ConstString.h"
+/// A string pool whose strings are freed when it is destroyed.
+///
+/// The strings of an arena are ConstStrings which are unique within the
+/// arena. They are meant for names only needed for a while, like the names a
+/// DWARF index is built with before it is frozen, which would otherwise stay
+/// in the global string pool forever. They must not outlive the arena, can
+/// only be compared with strings of the same arena, and have no mangled
+/// counterpart. Strings can be added from several threads at once.
+//----------------------------------------------------------------------
+class ConstStringArena {
+public:
+  ConstStringArena();
+  ~ConstStringArena();
+
+  ConstString GetString(llvm::StringRef s);
+
+  ConstString::MemoryReport GetMemoryReport() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl_up;
+
+  ConstStringArena(const ConstStringArena &) = delete;
+  const ConstStringArena &operator=(const ConstStringArena &) = delete;
+};
+
 //------------------------------------------------------------------
 /// Stream the string value \a str to the stream \a s
 //------------------------------------------------------------------
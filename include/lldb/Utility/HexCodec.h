@@ -0,0 +1,50 @@
+//===-- HexCodec.h ----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_HEXCODEC_H
+#define LLDB_UTILITY_HEXCODEC_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lldb_private {
+
+/// Encoders and decoders for the ways the gdb-remote protocol carries bytes,
+/// which work on caller provided buffers and handle several bytes per step.
+class HexCodec {
+public:
+  /// Write the two lowercase hex digits of each byte of \a src to \a dst,
+  /// which must have room for 2 * src.size() characters. The bytes are
+  /// taken from last to first if \a reverse is true.
+  static void Encode(llvm::ArrayRef<uint8_t> src, char *dst,
+                     bool reverse = false);
+
+  /// Decode pairs of hex digits from the start of \a src into \a dst, until
+  /// \a dst is full or a pair isn't made of two hex digits. Returns the
+  /// number of bytes decoded, from twice as many characters.
+  static size_t Decode(llvm::StringRef src, llvm::MutableArrayRef<uint8_t> dst);
+
+  /// Write \a src to \a dst with the binary escaping of the gdb-remote
+  /// protocol: '#', '$', '}' and '*' are written as '}' followed by the
+  /// byte xor 0x20. \a dst must have room for 2 * src.size() characters.
+  /// Returns the number of characters written.
+  static size_t Escape(llvm::ArrayRef<uint8_t> src, char *dst);
+
+  /// Undo Escape(): write the bytes \a src stands for to \a dst, which must
+  /// have room for src.size() bytes. A trailing escape character is
+  /// dropped. Returns the number of bytes written.
+  static size_t Unescape(llvm::StringRef src, uint8_t *dst);
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_HEXCODEC_H
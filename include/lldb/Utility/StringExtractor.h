@@ -124,6 +124,9 @@ protected:
     m_index = UINT64_MAX;
     return false;
   }
+
+  size_t DecodeHexBytesFast(llvm::MutableArrayRef<uint8_t> &dest);
+
   //------------------------------------------------------------------
   // For StringExtractor only
   //------------------------------------------------------------------
@@ -74,6 +74,7 @@ public:
     eServerPacketType_qFileLoadAddress,
     eServerPacketType_QEnvironment,
     eServerPacketType_QEnableErrorStrings,
+    eServerPacketType_QEnableCompression,
     eServerPacketType_QLaunchArch,
     eServerPacketType_QSetDisableASLR,
     eServerPacketType_QSetDetachOnError,
@@ -126,6 +127,7 @@ public:
     eServerPacketType_qSyncThreadStateSupported,
     eServerPacketType_qThreadExtraInfo,
     eServerPacketType_qThreadStopInfo,
+    eServerPacketType_qTracepointBuffer,
     eServerPacketType_qVAttachOrWaitSupported,
     eServerPacketType_qWatchpointSupportInfo,
     eServerPacketType_qWatchpointSupportInfoSupported,
@@ -133,6 +135,7 @@ public:
 
     eServerPacketType_jSignalsInfo,
     eServerPacketType_jModulesInfo,
+    eServerPacketType_jMultiMemRead,
 
     eServerPacketType_vAttach,
     eServerPacketType_vAttachWait,
@@ -0,0 +1,105 @@
+//===-- TracepointBuffer.h --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_TRACEPOINTBUFFER_H
+#define LLDB_UTILITY_TRACEPOINTBUFFER_H
+
+#include "lldb/lldb-defines.h"
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// What a tracepoint records each time it is hit: a register, or a range of
+/// memory at a fixed address or relative to a register. Registers are
+/// numbered the way the stub numbers them.
+//----------------------------------------------------------------------
+struct TracepointCollect {
+  enum Kind { eRegister, eMemory };
+
+  Kind kind = eRegister;
+  // The register, or the base register of the memory range, if any.
+  uint32_t reg = LLDB_INVALID_REGNUM;
+  // The address of the memory range, relative to reg if it is valid.
+  int64_t offset = 0;
+  // The number of bytes recorded.
+  uint32_t size = 0;
+
+  bool operator==(const TracepointCollect &rhs) const {
+    return kind == rhs.kind && reg == rhs.reg && offset == rhs.offset &&
+           size == rhs.size;
+  }
+};
+
+//----------------------------------------------------------------------
+/// @class TracepointBuffer TracepointBuffer.h
+/// "lldb/Utility/TracepointBuffer.h"
+/// A ring buffer of the hits of tracepoints, which a stub fills while the
+/// process runs and the debugger drains when it wants them. Once the
+/// buffer holds its capacity, the oldest entries are dropped to make room
+/// for the new ones. The capacity bounds the memory the entries take, so
+/// each entry counts its Entry as well as its data, and a tracepoint which
+/// collects nothing still fills the buffer.
+///
+/// The data of an entry has, for each item the tracepoint collects, a byte
+/// which is 1 if the item could be read, followed by its bytes in the byte
+/// order of the inferior, which are zero if it couldn't.
+//----------------------------------------------------------------------
+class TracepointBuffer {
+public:
+  struct Entry {
+    lldb::addr_t addr = LLDB_INVALID_ADDRESS;
+    lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+    std::vector<uint8_t> data;
+  };
+
+  explicit TracepointBuffer(size_t capacity) : m_capacity(capacity) {}
+
+  /// The size of the data of the entries of a tracepoint collecting
+  /// \a collects.
+  static size_t GetEntryDataSize(llvm::ArrayRef<TracepointCollect> collects);
+
+  void Append(Entry entry);
+
+  /// Move the oldest entries to \a entries, up to \a max_bytes bytes of data
+  /// but at least one entry if there is any. Returns how many were moved.
+  size_t Drain(size_t max_bytes, std::vector<Entry> &entries);
+
+  /// Returns the number of entries dropped since the last call.
+  uint64_t TakeNumDropped();
+
+  size_t GetNumEntries() const { return m_entries.size(); }
+
+  /// The memory taken by the entries, counted against the capacity.
+  size_t GetByteSize() const { return m_byte_size; }
+
+  /// The memory taken by \a entry, counted against the capacity.
+  static size_t GetEntryByteSize(const Entry &entry) {
+    return sizeof(Entry) + entry.data.size();
+  }
+
+  void Clear();
+
+private:
+  std::deque<Entry> m_entries;
+  size_t m_capacity;
+  size_t m_byte_size = 0;
+  uint64_t m_num_dropped = 0;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_TRACEPOINTBUFFER_H
@@ -661,6 +661,7 @@ enum SectionType {
   eSectionTypeDWARFGNUDebugAltLink,
   eSectionTypeDWARFDebugTypes, // DWARF .debug_types section
   eSectionTypeDWARFDebugNames, // DWARF v5 .debug_names
+  eSectionTypeGdbIndex,        // GDB .gdb_index name to compile unit table
   eSectionTypeOther
 };
 
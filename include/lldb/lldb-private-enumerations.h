@@ -262,7 +262,12 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  BreakpointConditionCacheHit = 4,
+  BreakpointConditionCacheMiss = 5,
+  ExpressionCacheHit = 6,
+  ExpressionCacheMiss = 7,
+  ExpressionCacheEviction = 8,
+  StatisticMax = 9
 };
 
 
@@ -276,6 +281,16 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::BreakpointConditionCacheHit:
+     return "Number of breakpoint condition cache hits";
+   case StatisticKind::BreakpointConditionCacheMiss:
+     return "Number of breakpoint condition cache misses";
+   case StatisticKind::ExpressionCacheHit:
+     return "Number of expression cache hits";
+   case StatisticKind::ExpressionCacheMiss:
+     return "Number of expression cache misses";
+   case StatisticKind::ExpressionCacheEviction:
+     return "Number of expression cache evictions";
    case StatisticKind::StatisticMax:
      return "";
    }
@@ -0,0 +1,48 @@
+// Test that we use the .gdb_index section to look up names.
+
+// REQUIRES: lld
+
+// RUN: clang %s -g -c -o %t.o --target=x86_64-pc-linux -ggnu-pubnames \
+// RUN:   -mllvm -accel-tables=Disable
+// RUN: ld.lld --gdb-index %t.o -o %t
+// RUN: lldb-test symbols %t | FileCheck --check-prefix=INDEX %s
+// RUN: lldb-test symbols --name=foo --find=function --function-flags=base %t | \
+// RUN:   FileCheck --check-prefix=BASE %s
+// RUN: lldb-test symbols --name=_ZN2ns3fooEv --find=function \
+// RUN:   --function-flags=full %t | FileCheck --check-prefix=FULL-MANGLED %s
+// RUN: lldb-test symbols --name=bar --find=variable %t | \
+// RUN:   FileCheck --check-prefix=VARIABLE %s
+// RUN: lldb-test symbols --name=Struct --find=type %t | \
+// RUN:   FileCheck --check-prefix=TYPE %s
+// RUN: lldb-test symbols --name=not_there --find=function %t | \
+// RUN:   FileCheck --check-prefix=EMPTY %s
+
+// INDEX: GDB index version 7
+// INDEX-DAG: "ns::foo": 0x00000000
+// INDEX-DAG: "ns::bar": 0x00000000
+
+// BASE: Found 2 functions:
+// BASE-DAG: name = "foo()", mangled = "_Z3foov"
+// BASE-DAG: name = "ns::foo()", mangled = "_ZN2ns3fooEv"
+
+// FULL-MANGLED: Found 1 functions:
+// FULL-MANGLED: name = "ns::foo()", mangled = "_ZN2ns3fooEv"
+
+// VARIABLE: Found 1 variables:
+// VARIABLE: name = "bar", type = {{.*}} (int)
+
+// TYPE: Found 1 types:
+// TYPE: name = "Struct", {{.*}} decl = gdb-index.cpp
+
+// EMPTY: Found 0 functions:
+
+namespace ns {
+void foo() {}
+int bar;
+struct Struct {
+} s;
+} // namespace ns
+
+void foo() {}
+
+extern "C" void _start() {}
@@ -0,0 +1,99 @@
+"""
+Compare the native libstdc++ container data formatters with the Python ones.
+"""
+
+from __future__ import print_function
+
+
+import os
+import time
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkLibstdcppContainers(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @benchmarks_test
+    @add_test_categories(["libstdcxx"])
+    def test_run_command(self):
+        """Benchmark the std::map, std::list and std::vector data formatters (libstdc++)"""
+        self.build()
+        self.data_formatter_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        BenchBase.setUp(self)
+
+    def time_command(self, command, substrs):
+        sw = Stopwatch()
+        sw.start()
+        self.expect(command, substrs=substrs)
+        sw.stop()
+        return sw
+
+    def data_formatter_commands(self):
+        """Benchmark the std::map, std::list and std::vector data formatters (libstdc++)"""
+        self.runCmd("file " + self.getBuildArtifact("a.out"),
+                    CURRENT_EXECUTABLE_SET)
+
+        bkpt = self.target().FindBreakpointByID(
+            lldbutil.run_break_set_by_source_regexp(
+                self, "break here"))
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped',
+                             'stop reason = breakpoint'])
+
+        # This is the function to remove the custom formats in order to have a
+        # clean slate for the next test case.
+        def cleanup():
+            self.runCmd('type format clear', check=False)
+            self.runCmd('type summary clear', check=False)
+            self.runCmd('type filter clear', check=False)
+            self.runCmd('type synth clear', check=False)
+            self.runCmd(
+                "settings set target.max-children-count 256",
+                check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        self.runCmd("settings set target.max-children-count 2000")
+
+        containers = [
+            ("map", "^std::map<.+> >$", "StdMapSynthProvider"),
+            ("list", "^std::(__cxx11::)?list<.+>$", "StdListSynthProvider"),
+            ("vector", "^std::vector<.+>$", "StdVectorSynthProvider"),
+        ]
+
+        # The native providers run first, so the Python ones find the
+        # containers in the memory cache: the comparison favors Python.
+        native = {}
+        for name, regex, provider in containers:
+            native[name] = self.time_command(
+                "frame variable -A " + name, ['[1499]', '1499'])
+
+        # The providers added to the default category take precedence over
+        # the native ones of the C++ category.
+        for name, regex, provider in containers:
+            self.runCmd(
+                'type synthetic add -l lldb.formatters.cpp.gnu_libstdcpp.%s '
+                '-x "%s"' % (provider, regex))
+
+        for name, regex, provider in containers:
+            python = self.time_command(
+                "frame variable -A " + name, ['[1499]', '1499'])
+            print("std::%s: native %s, python %s" %
+                  (name, native[name], python))
+
+        sw = self.time_command("frame variable -A unordered_map",
+                               ['[1499]', '1499'])
+        print("std::unordered_map: native %s" % sw)
@@ -0,0 +1,23 @@
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+int main()
+{
+    std::map<int, int> map;
+    std::list<int> list;
+    std::vector<int> vector;
+    std::unordered_map<int, int> unordered_map;
+    for (int i = 0;
+    i < 1500;
+    i++)
+    {
+        map[i] = i;
+        list.push_back(i);
+        vector.push_back(i);
+        unordered_map[i] = i;
+    }
+    return map.size() + list.size() + vector.size() +
+           unordered_map.size(); // break here
+}
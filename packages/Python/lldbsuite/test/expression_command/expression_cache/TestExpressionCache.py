@@ -0,0 +1,199 @@
+"""
+Test that the parsed expressions of a target are reused only while what
+their names refer to stays the same.
+"""
+
+from __future__ import print_function
+
+
+import json
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    main_spec = lldb.SBFileSpec("main.c", False)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Make the hidden directory in the build hierarchy:
+        lldbutil.mkdir_p(self.getBuildArtifact("hidden"))
+
+    def run_to_main(self):
+        self.build()
+        (self.target, self.process, self.thread,
+         _) = lldbutil.run_to_source_breakpoint(self, "// Break in main",
+                                                self.main_spec)
+        # The cache only counts its hits while statistics are enabled.
+        self.runCmd("statistics enable")
+
+    def cache_statistics(self):
+        stream = lldb.SBStream()
+        self.target.GetStatistics().GetAsJSON(stream)
+        stats = json.loads(stream.GetData())
+        return (stats["Number of expression cache hits"],
+                stats["Number of expression cache misses"])
+
+    def value(self, frame=None):
+        if frame is None:
+            frame = self.thread.GetFrameAtIndex(0)
+        return frame.FindVariable("value").GetValueAsSigned()
+
+    def evaluate(self, text, expected, options=None, frame=None):
+        """Evaluate 'text', check its result is 'expected', and return how
+        many times the cache was hit and missed meanwhile."""
+        if frame is None:
+            frame = self.thread.GetFrameAtIndex(0)
+        if options is None:
+            options = lldb.SBExpressionOptions()
+        (hits, misses) = self.cache_statistics()
+        result = frame.EvaluateExpression(text, options)
+        self.assertTrue(result.GetError().Success(),
+                        result.GetError().GetCString())
+        self.assertEqual(expected, result.GetValueAsSigned(), text)
+        (new_hits, new_misses) = self.cache_statistics()
+        return (new_hits - hits, new_misses - misses)
+
+    def assertMisses(self, text, expected, **kwargs):
+        self.assertEqual((0, 1), self.evaluate(text, expected, **kwargs),
+                         text)
+
+    def assertHits(self, text, expected, **kwargs):
+        self.assertEqual((1, 0), self.evaluate(text, expected, **kwargs),
+                         text)
+
+    @add_test_categories(['pyapi'])
+    def test_repeat_hits(self):
+        """Test that evaluating an expression again in the same block reuses
+        it."""
+        self.run_to_main()
+        self.assertMisses("value + 0", 0)
+        self.assertHits("value + 0", 0)
+
+        # The next stop is in the same block, with another value.
+        self.process.Continue()
+        self.assertEqual(1, self.value())
+        self.assertHits("value + 0", 1)
+        self.assertMisses("value + 1", 2)
+
+    @add_test_categories(['pyapi'])
+    def test_counts_only_while_enabled(self):
+        """Test that the cache doesn't count its hits and misses while
+        statistics are disabled."""
+        self.run_to_main()
+        self.runCmd("statistics disable")
+        frame = self.thread.GetFrameAtIndex(0)
+        for i in range(2):
+            result = frame.EvaluateExpression("value + 0")
+            self.assertTrue(result.GetError().Success(),
+                            result.GetError().GetCString())
+        self.assertEqual((0, 0), self.cache_statistics())
+
+    @add_test_categories(['pyapi'])
+    def test_persistent_declaration_misses(self):
+        """Test that declaring a persistent variable invalidates the
+        expressions parsed before it."""
+        self.run_to_main()
+        self.assertMisses("value + 0", 0)
+        self.assertHits("value + 0", 0)
+
+        result = self.thread.GetFrameAtIndex(0).EvaluateExpression(
+            "int $x = 1")
+        self.assertTrue(result.GetError().Success(),
+                        result.GetError().GetCString())
+
+        self.assertMisses("value + 0", 0)
+        self.assertHits("value + 0", 0)
+
+    @add_test_categories(['pyapi'])
+    def test_top_level_expressions_miss(self):
+        """Test that top level expressions are never reused, and invalidate
+        the expressions parsed before them."""
+        self.run_to_main()
+        self.assertMisses("value + 0", 0)
+
+        frame = self.thread.GetFrameAtIndex(0)
+        options = lldb.SBExpressionOptions()
+        options.SetTopLevel(True)
+        for i in range(2):
+            statistics = self.cache_statistics()
+            result = frame.EvaluateExpression(
+                "int top_level_five() { return 5; }", options)
+            self.assertTrue(result.GetError().Success(),
+                            result.GetError().GetCString())
+            # Top level expressions don't even look in the cache.
+            self.assertEqual(statistics, self.cache_statistics())
+
+        self.assertMisses("value + 0", 0)
+        self.assertMisses("top_level_five() + value", 5)
+        self.assertHits("top_level_five() + value", 5)
+
+    @skipIfWindows  # The Windows platform doesn't implement DoLoadImage.
+    @not_remote_testsuite_ready
+    @add_test_categories(['pyapi'])
+    def test_module_load_misses(self):
+        """Test that loading a module invalidates the expressions parsed
+        before it."""
+        self.run_to_main()
+        self.assertMisses("value + 0", 0)
+        self.assertHits("value + 0", 0)
+
+        ext = 'so'
+        if self.platformIsDarwin():
+            ext = 'dylib'
+        hidden_lib = os.path.join(self.getBuildDir(), "hidden",
+                                  "libhidden." + ext)
+        error = lldb.SBError()
+        token = self.process.LoadImage(lldb.SBFileSpec(hidden_lib), error)
+        self.assertNotEqual(token, lldb.LLDB_INVALID_IMAGE_TOKEN,
+                            error.GetCString())
+
+        self.assertMisses("value + 0", 0)
+        self.assertHits("value + 0", 0)
+
+    @add_test_categories(['pyapi'])
+    @expectedFailureAll(oslist=["windows"])
+    def test_interrupted_expression_misses(self):
+        """Test that an expression stopped in the middle of its execution
+        isn't reused until it is unwound."""
+        self.run_to_main()
+        bkpt = self.target.BreakpointCreateBySourceRegex(
+            "// Break in called_from_expression", self.main_spec)
+        self.assertTrue(bkpt, VALID_BREAKPOINT)
+        # Stop where the result of the expression isn't zero.
+        self.process.Continue()
+
+        main_frame = self.thread.GetFrameAtIndex(0)
+        options = lldb.SBExpressionOptions()
+        options.SetIgnoreBreakpoints(False)
+        options.SetUnwindOnError(False)
+        expected = 2 * self.value(main_frame)
+        result = main_frame.EvaluateExpression(
+            "called_from_expression(value)", options)
+        self.assertTrue(result.GetError().Fail(),
+                        "We did not complete the execution.")
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(
+            self.process, bkpt)
+        self.assertTrue(thread.IsValid(),
+                        "We are stopped in called_from_expression")
+
+        # Evaluating it again from main, where it was stopped, can't reuse
+        # the expression which is still running.
+        options = lldb.SBExpressionOptions()
+        options.SetIgnoreBreakpoints(True)
+        self.assertMisses("called_from_expression(value)", expected,
+                          options=options, frame=main_frame)
+
+        error = thread.UnwindInnermostExpression()
+        self.assertTrue(error.Success(), "We succeeded in unwinding")
+        self.assertTrue(thread.GetFrameAtIndex(0).IsEqual(main_frame),
+                        "We got back to the main frame.")
+        self.assertHits("called_from_expression(value)", expected,
+                        options=options)
@@ -0,0 +1 @@
+int hidden_function() { return 12345; }
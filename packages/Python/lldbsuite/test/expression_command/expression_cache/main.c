@@ -0,0 +1,16 @@
+#include <dlfcn.h>
+#include <stdio.h>
+
+int called_from_expression(int i) {
+  return i * 2; // Break in called_from_expression
+}
+
+int main(int argc, char const *argv[]) {
+  // Loading a library from an expression needs libdl.
+  if (argc > 1)
+    dlopen(argv[1], RTLD_NOW);
+
+  for (int value = 0; value < 4; ++value)
+    printf("%d\n", value); // Break in main
+  return 0;
+}
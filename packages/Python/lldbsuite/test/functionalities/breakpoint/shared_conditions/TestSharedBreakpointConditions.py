@@ -0,0 +1,159 @@
+"""
+Test that breakpoint locations in the same block share their parsed
+condition, and still stop where it is true.
+"""
+
+from __future__ import print_function
+
+
+import json
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class SharedBreakpointConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        TestBase.setUp(self)
+        self.line1 = line_number('main.c', '// First location')
+        self.line2 = line_number('main.c', '// Second location')
+
+    def get_condition_stats(self, target):
+        stream = lldb.SBStream()
+        target.GetStatistics().GetAsJSON(stream)
+        stats = json.loads(stream.GetData())
+        return (stats["Number of breakpoint condition cache hits"],
+                stats["Number of breakpoint condition cache misses"])
+
+    def get_stop(self, process, breakpoints):
+        """Return the index of the breakpoint the process is stopped at and
+        the value of i there."""
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+        for index, breakpoint in enumerate(breakpoints):
+            threads = lldbutil.get_threads_stopped_at_breakpoint(
+                process, breakpoint)
+            if threads:
+                i = threads[0].GetFrameAtIndex(0).FindVariable("i")
+                self.assertTrue(i.IsValid())
+                return (index, i.GetValueAsSigned())
+        self.fail("not stopped at a breakpoint")
+
+    def continue_to_exit(self, process):
+        process.Continue()
+        self.assertEqual(process.GetState(), lldb.eStateExited)
+        self.assertEqual(process.GetExitStatus(), 0)
+
+    def launch(self, target):
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        return process
+
+    # Requires EE to support COFF on Windows (http://llvm.org/pr22232)
+    @skipIfWindows
+    @add_test_categories(['pyapi'])
+    def test_shared_condition(self):
+        """Two locations in one block with the same condition parse it once,
+        stop where it is true, and parse it again when it changes or the
+        process is launched again."""
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        # The cache only counts its hits while statistics are enabled.
+        self.runCmd("statistics enable")
+
+        breakpoints = [
+            target.BreakpointCreateByLocation("main.c", self.line1),
+            target.BreakpointCreateByLocation("main.c", self.line2)]
+        # The conditions use '%', which lldb-server can't test by itself, so
+        # the debugger tests them at every hit.
+        for breakpoint in breakpoints:
+            self.assertEqual(breakpoint.GetNumLocations(), 1)
+            breakpoint.SetCondition("i % 3 == 0")
+
+        # The first location parses the condition and the second one finds
+        # it in the cache.
+        process = self.launch(target)
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 0))
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 0))
+        hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 1)
+        self.assertGreaterEqual(hits, 1)
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 3))
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 3))
+        hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 1)
+
+        # A changed condition is parsed again, once for both locations.
+        for breakpoint in breakpoints:
+            breakpoint.SetCondition("i % 5 == 4")
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 4))
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 4))
+        new_hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 2)
+        self.assertGreater(new_hits, hits)
+        hits = new_hits
+        self.continue_to_exit(process)
+
+        # The code of the expressions went away with the last process, so
+        # the same condition is parsed again for the new one.
+        process = self.launch(target)
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 4))
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 4))
+        new_hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 3)
+        self.assertGreater(new_hits, hits)
+        self.continue_to_exit(process)
+
+    # Requires EE to support COFF on Windows (http://llvm.org/pr22232)
+    @skipIfWindows
+    @add_test_categories(['pyapi'])
+    def test_declaration_reparses_condition(self):
+        """A condition parsed before a persistent declaration is parsed
+        again, since its names might refer to the new declaration."""
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        self.runCmd("statistics enable")
+
+        breakpoints = [
+            target.BreakpointCreateByLocation("main.c", self.line1),
+            target.BreakpointCreateByLocation("main.c", self.line2)]
+        for breakpoint in breakpoints:
+            self.assertEqual(breakpoint.GetNumLocations(), 1)
+            breakpoint.SetCondition("i % 3 == 0")
+
+        process = self.launch(target)
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 0))
+        hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 1)
+
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        result = frame.EvaluateExpression("int $condition_y = 1")
+        self.assertTrue(result.GetError().Success(),
+                        result.GetError().GetCString())
+
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 0))
+        hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 2)
+
+        # The condition parsed again is shared as before.
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (0, 3))
+        process.Continue()
+        self.assertEqual(self.get_stop(process, breakpoints), (1, 3))
+        new_hits, misses = self.get_condition_stats(target)
+        self.assertEqual(misses, 2)
+        self.assertGreater(new_hits, hits)
+        self.continue_to_exit(process)
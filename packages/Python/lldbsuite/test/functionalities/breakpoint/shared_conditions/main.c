@@ -0,0 +1,19 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+int step(int i) {
+  int value = i * 2; // First location
+  return value + 1;  // Second location
+}
+
+int main(int argc, char const *argv[]) {
+  int total = 0;
+  for (int i = 0; i < 6; ++i)
+    total += step(i);
+  return total == 36 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+"""
+Test that tracepoints record their hits without stopping, in lldb-server or
+in the debugger, and that the hits are shown the way they were recorded.
+"""
+
+from __future__ import print_function
+
+
+import re
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TracepointsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    main_spec = lldb.SBFileSpec("main.c", False)
+
+    def run_to_main(self):
+        self.build()
+        (self.target, self.process, self.thread,
+         _) = lldbutil.run_to_source_breakpoint(self, "// Break in main",
+                                                self.main_spec)
+        self.tracepoint = self.target.BreakpointCreateBySourceRegex(
+            "// Tracepoint", self.main_spec)
+        self.assertEqual(self.tracepoint.GetNumLocations(), 1)
+        counter = self.target.FindFirstGlobalVariable("g_counter")
+        self.assertTrue(counter.IsValid())
+        self.counter_item = "0x{:x},4".format(counter.GetLoadAddress())
+
+    def collect(self, *items):
+        self.runCmd("process plugin tracepoint collect {} {}".format(
+            self.tracepoint.GetID(), " ".join(items)))
+
+    def continue_to(self, comment):
+        bkpt = self.target.BreakpointCreateBySourceRegex(comment,
+                                                         self.main_spec)
+        self.assertEqual(bkpt.GetNumLocations(), 1)
+        self.process.Continue()
+        # Nothing stops at the tracepoint.
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(self.process,
+                                                               bkpt)
+        self.assertTrue(thread.IsValid(), comment)
+
+    def dump_hits(self):
+        """Return the value of g_counter and the labels of the items of each
+        hit shown by "process plugin tracepoint dump"."""
+        result = lldb.SBCommandReturnObject()
+        self.dbg.GetCommandInterpreter().HandleCommand(
+            "process plugin tracepoint dump", result)
+        self.assertTrue(result.Succeeded(), result.GetError())
+        hits = []
+        for line in result.GetOutput().splitlines():
+            match = re.match(r"^0x[0-9a-f]+ tid 0x[0-9a-f]+: (.*)$", line)
+            self.assertIsNotNone(match, line)
+            items = match.group(1).split(", ")
+            labels = [item.split(" = ")[0] for item in items]
+            counter = re.match(r"^[^=]+ = \{([0-9a-f]{2})", items[0])
+            self.assertIsNotNone(counter, line)
+            hits.append((int(counter.group(1), 16), labels))
+        return hits
+
+    @skipIfWindows
+    @skipIfDarwin  # debugserver doesn't record tracepoint hits.
+    def test_stub_records_hits(self):
+        """Test that lldb-server records the hits of a tracepoint, and that
+        the hits recorded before its items change are shown with the old
+        items."""
+        self.run_to_main()
+        self.collect(self.counter_item)
+        self.continue_to("// Break in the middle")
+        # The tracepoint is sent again with the new items, after the hits
+        # recorded with the old ones are read.
+        self.collect(self.counter_item, "pc")
+        self.continue_to("// Break at the end")
+
+        hits = self.dump_hits()
+        self.assertEqual([counter for (counter, labels) in hits],
+                         list(range(6)))
+        for (counter, labels) in hits:
+            if counter < 3:
+                self.assertEqual(labels, [self.counter_item])
+            else:
+                self.assertEqual(labels, [self.counter_item, "pc"])
+        # The hits are only shown once.
+        self.assertEqual(self.dump_hits(), [])
+
+    # Requires EE to support COFF on Windows (http://llvm.org/pr22232)
+    @skipIfWindows
+    def test_debugger_records_hits(self):
+        """Test that the debugger records the hits of a tracepoint whose
+        condition lldb-server can't test, and continues."""
+        self.run_to_main()
+        self.collect(self.counter_item)
+        # The condition uses '%', which lldb-server can't test by itself, so
+        # it reports the hits.
+        self.tracepoint.SetCondition("g_counter % 2 == 0")
+        self.continue_to("// Break in the middle")
+        self.continue_to("// Break at the end")
+
+        hits = self.dump_hits()
+        self.assertEqual([counter for (counter, labels) in hits], [0, 2, 4])
+        for (counter, labels) in hits:
+            self.assertEqual(labels, [self.counter_item])
+        # Only the hits where the condition is true count.
+        self.assertEqual(self.tracepoint.GetHitCount(), 3)
@@ -0,0 +1,24 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+int g_counter;
+int g_middle;
+
+void hit(void) {
+  ++g_counter; // Tracepoint
+}
+
+int main(int argc, char const *argv[]) {
+  g_counter = 0; // Break in main
+  for (int i = 0; i < 3; ++i)
+    hit();
+  g_middle = 1; // Break in the middle
+  for (int i = 0; i < 3; ++i)
+    hit();
+  return g_counter == 6 ? 0 : 1; // Break at the end
+}
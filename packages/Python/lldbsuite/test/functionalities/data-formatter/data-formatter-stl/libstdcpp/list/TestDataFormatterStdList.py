@@ -161,6 +161,16 @@ class StdListDataFormatterTestCase(TestBase):
                              '[2] = ', '3',
                              '[3] = ', '4'])
 
+        # A reference shows the list it refers to.
+        self.expect("frame variable numbers_list_ref",
+                    substrs=['size=4',
+                             '[0] = ', '1',
+                             '[1] = ', '2',
+                             '[2] = ', '3',
+                             '[3] = ', '4'])
+        self.expect("frame variable numbers_list_ref[2]",
+                    substrs=['3'])
+
         self.runCmd("type format delete int")
 
         self.runCmd("n")
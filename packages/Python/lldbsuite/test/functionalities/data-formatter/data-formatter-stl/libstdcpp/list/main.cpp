@@ -7,6 +7,7 @@ typedef std::list<std::string> string_list;
 int main()
 {
     int_list numbers_list;
+    int_list &numbers_list_ref = numbers_list;
     
     numbers_list.push_back(0x12345678); // Set break point at this line.
     numbers_list.push_back(0x11223344);
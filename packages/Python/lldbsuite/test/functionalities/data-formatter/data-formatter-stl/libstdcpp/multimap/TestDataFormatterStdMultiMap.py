@@ -0,0 +1,49 @@
+"""
+Test lldb data formatter subsystem.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StdMultiMapDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def pair(self, index, first, second):
+        # The pairs are shown on one line or on several ones, depending on
+        # their size.
+        return r'\[%d\] = [({]\s*first = %d,?\s+second = "%s"' % (
+            index, first, second)
+
+    @add_test_categories(["libstdcxx"])
+    def test_with_run_command(self):
+        """Test that std::multimap shows every pair, in key order."""
+        self.build()
+        (self.target, process, _, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "Set break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+
+        self.expect("frame variable mm", substrs=['size=0', '{}'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.expect("frame variable mm",
+                    patterns=['size=4',
+                              self.pair(0, 1, 'one'),
+                              self.pair(1, 1, 'uno'),
+                              self.pair(2, 2, 'two'),
+                              self.pair(3, 3, 'three')])
+        self.expect("frame variable mm[1]",
+                    substrs=['first = 1', 'second = "uno"'])
+        self.expect("p mm", substrs=['size=4', 'second = "three"'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.expect("frame variable mm",
+                    patterns=['size=2',
+                              self.pair(0, 2, 'two'),
+                              self.pair(1, 3, 'three')])
@@ -0,0 +1,29 @@
+#include <map>
+#include <string>
+
+typedef std::multimap<int, std::string> intstr_mmap;
+
+int g_the_foo = 0;
+
+int thefoo_rw(int arg = 1)
+{
+    g_the_foo += arg;
+    return g_the_foo;
+}
+
+int main()
+{
+    intstr_mmap mm;
+    thefoo_rw(); // Set break point at this line.
+
+    mm.insert(std::make_pair(2, "two"));
+    mm.insert(std::make_pair(1, "one"));
+    mm.insert(std::make_pair(1, "uno"));
+    mm.insert(std::make_pair(3, "three"));
+    thefoo_rw(); // Set break point at this line.
+
+    mm.erase(1);
+    thefoo_rw(); // Set break point at this line.
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+"""
+Test lldb data formatter subsystem.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StdMultiSetDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @add_test_categories(["libstdcxx"])
+    def test_with_run_command(self):
+        """Test that std::multiset shows every copy of its elements."""
+        self.build()
+        (self.target, process, _, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "Set break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+
+        self.expect("frame variable ii", substrs=['size=0', '{}'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.expect("frame variable ii",
+                    substrs=['size=5',
+                             '[0] = 1',
+                             '[1] = 2',
+                             '[2] = 3',
+                             '[3] = 3',
+                             '[4] = 3'])
+        self.expect("frame variable ii[4]", substrs=[' = 3'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.expect("frame variable ii",
+                    substrs=['size=2', '[0] = 1', '[1] = 2'])
+        self.expect("frame variable ss",
+                    substrs=['size=4',
+                             '[0] = "hello"',
+                             '[1] = "is"',
+                             '[2] = "world"',
+                             '[3] = "world"'])
+        self.expect("p ss", substrs=['size=4', '[3] = "world"'])
@@ -0,0 +1,36 @@
+#include <set>
+#include <string>
+
+typedef std::multiset<int> intset;
+typedef std::multiset<std::string> stringset;
+
+int g_the_foo = 0;
+
+int thefoo_rw(int arg = 1)
+{
+    g_the_foo += arg;
+    return g_the_foo;
+}
+
+int main()
+{
+    intset ii;
+    thefoo_rw(); // Set break point at this line.
+
+    ii.insert(3);
+    ii.insert(1);
+    ii.insert(3);
+    ii.insert(2);
+    ii.insert(3);
+    thefoo_rw(); // Set break point at this line.
+
+    stringset ss;
+    ss.insert("is");
+    ss.insert("world");
+    ss.insert("hello");
+    ss.insert("world");
+    ii.erase(3);
+    thefoo_rw(); // Set break point at this line.
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+"""
+Test lldb data formatter subsystem.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StdSetDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_ii(self, var_name):
+        self.expect("frame variable " + var_name,
+                    substrs=['size=6',
+                             '[0] = 0',
+                             '[1] = 1',
+                             '[2] = 2',
+                             '[3] = 3',
+                             '[4] = 4',
+                             '[5] = 5'])
+        self.expect("frame variable " + var_name + "[2]", substrs=[' = 2'])
+
+    @add_test_categories(["libstdcxx"])
+    def test_with_run_command(self):
+        """Test that std::set is shown sorted, with its size."""
+        self.build()
+        (self.target, process, _, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "Set break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+
+        self.expect("frame variable ii", substrs=['size=0', '{}'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.check_ii("ii")
+        self.expect("p ii", substrs=['size=6', '[0] = 0', '[5] = 5'])
+
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        self.expect("frame variable ss",
+                    substrs=['size=3',
+                             '[0] = "a"',
+                             '[1] = "a very long string is right here"',
+                             '[2] = "c"'])
+        self.expect("frame variable ss[2]", substrs=[' = "c"'])
+
+    @add_test_categories(["libstdcxx"])
+    def test_ref_and_ptr(self):
+        """Test that the std::set formatters work on a reference and a pointer."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(
+            self, "Stop here to check by ref and ptr.",
+            lldb.SBFileSpec("main.cpp", False))
+
+        self.check_ii("ref")
+        self.expect("frame variable ptr", substrs=['ptr =', 'size=6'])
+        self.expect("frame variable *ptr", substrs=['size=6', '[5] = 5'])
@@ -0,0 +1,44 @@
+#include <set>
+#include <string>
+
+typedef std::set<int> intset;
+typedef std::set<std::string> stringset;
+
+int g_the_foo = 0;
+
+int thefoo_rw(int arg = 1)
+{
+    g_the_foo += arg;
+    return g_the_foo;
+}
+
+void by_ref_and_ptr(intset &ref, intset *ptr)
+{
+    thefoo_rw(); // Stop here to check by ref and ptr.
+}
+
+int main()
+{
+    intset ii;
+    thefoo_rw(); // Set break point at this line.
+
+    ii.insert(5);
+    ii.insert(3);
+    ii.insert(0);
+    ii.insert(4);
+    ii.insert(1);
+    ii.insert(2);
+    thefoo_rw(); // Set break point at this line.
+
+    by_ref_and_ptr(ii, &ii);
+
+    stringset ss;
+    ss.insert("c");
+    ss.insert("a very long string is right here");
+    ss.insert("b");
+    ss.insert("a");
+    ss.erase("b");
+    thefoo_rw(); // Set break point at this line.
+
+    return 0;
+}
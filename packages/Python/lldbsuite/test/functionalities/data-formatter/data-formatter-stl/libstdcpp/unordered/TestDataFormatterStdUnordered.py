@@ -0,0 +1,61 @@
+"""
+Test lldb data formatter subsystem.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StdUnorderedDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @add_test_categories(["libstdcxx"])
+    def test_with_run_command(self):
+        """Test that the std::unordered_* containers show all their elements."""
+        self.build()
+        (self.target, self.process, _, self.bkpt) = \
+            lldbutil.run_to_source_breakpoint(
+                self, "Set break point at this line.",
+                lldb.SBFileSpec("main.cpp", False))
+
+        self.expect("frame variable map", substrs=['size=0', '{}'])
+        self.continue_to_breakpoint()
+
+        # The order of the elements depends on the hash table, only check
+        # that each of them is there.
+        self.look_for_content_and_continue(
+            "map", ['size=5 {', 'hello', 'world', 'this', 'is', 'me'])
+
+        self.look_for_content_and_continue(
+            "mmap", ['size=6 {', 'first = 3', 'second = "this"', 'first = 2',
+                     'second = "hello"'])
+
+        self.look_for_content_and_continue(
+            "iset", ['size=5 {', r'\[\d\] = 5', r'\[\d\] = 3', r'\[\d\] = 2'])
+
+        self.look_for_content_and_continue(
+            "sset", ['size=5 {', r'\[\d\] = "is"', r'\[\d\] = "world"',
+                     r'\[\d\] = "hello"'])
+
+        self.look_for_content_and_continue(
+            "imset", ['size=6 {', r'(\[\d\] = 3(\n|.)+){3}', r'\[\d\] = 2',
+                      r'\[\d\] = 1'])
+
+        self.expect("frame variable smset",
+                    patterns=['size=5 {',
+                              r'(\[\d\] = "is"(\n|.)+){2}',
+                              r'(\[\d\] = "world"(\n|.)+){2}'])
+
+    def continue_to_breakpoint(self):
+        lldbutil.continue_to_breakpoint(self.process, self.bkpt)
+
+    def look_for_content_and_continue(self, var_name, patterns):
+        self.expect("frame variable %s" % var_name,
+                    patterns=patterns)
+        self.continue_to_breakpoint()
@@ -0,0 +1,61 @@
+"""
+Test that the characters of the strings in a std::vector are read from the
+inferior all at once.
+"""
+
+from __future__ import print_function
+
+
+import re
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StdVectorOfStringsDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @add_test_categories(["libstdcxx"])
+    @skipIfDarwin  # debugserver doesn't support jMultiMemRead.
+    @skipIfWindows
+    def test_characters_read_in_one_packet(self):
+        """Test that showing a vector of strings reads the characters of all
+        of them with a single jMultiMemRead packet."""
+        self.build()
+        (target, process, thread, _) = lldbutil.run_to_source_breakpoint(
+            self, "// Set break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+
+        log_file = self.getBuildArtifact("packets.log")
+        self.runCmd("log enable -f '{}' gdb-remote packets".format(log_file))
+        self.expect("frame variable strings",
+                    substrs=['size=17',
+                             '[0] = "{}"'.format('a' * 40),
+                             '[15] = "{}"'.format('p' * 40),
+                             '[16] = "short"'])
+        self.runCmd("log disable gdb-remote packets")
+        with open(log_file) as f:
+            packets = [line for line in f if "send packet: $" in line]
+
+        multi_reads = [packet for packet in packets
+                       if "$jMultiMemRead:" in packet]
+        self.assertEqual(len(multi_reads), 1, "".join(multi_reads))
+        multi_read_addresses = set(
+            int(address)
+            for address in re.findall(r'"address":([0-9]+)', multi_reads[0]))
+
+        strings = thread.GetFrameAtIndex(0).FindVariable("strings")
+        self.assertEqual(strings.GetNumChildren(), 17)
+        for i in range(16):
+            address = strings.GetChildAtIndex(i).GetChildMemberWithName(
+                "_M_dataplus").GetChildMemberWithName(
+                "_M_p").GetValueAsUnsigned()
+            self.assertIn(address, multi_read_addresses)
+            # The characters weren't read again on their own.
+            for packet in packets:
+                self.assertIsNone(
+                    re.search(r"send packet: \$[mx]{:x},".format(address),
+                              packet),
+                    packet)
@@ -0,0 +1,12 @@
+#include <string>
+#include <vector>
+
+int main()
+{
+    std::vector<std::string> strings;
+    // Strings too long to keep their characters inside of themselves.
+    for (int i = 0; i < 16; ++i)
+        strings.push_back(std::string(40, 'a' + i));
+    strings.push_back(std::string("short"));
+    return 0; // Set break point at this line.
+}
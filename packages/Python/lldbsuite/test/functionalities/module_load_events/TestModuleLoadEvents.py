@@ -0,0 +1,105 @@
+"""
+Test that the shared libraries loaded together are announced together.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ModuleLoadEventsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    main_spec = lldb.SBFileSpec("main.c", False)
+
+    def launch(self):
+        self.build()
+        self.target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(self.target, VALID_TARGET)
+        # Listen before launching, to hear about the libraries loaded with
+        # the program.
+        self.listener = lldb.SBListener("module load events")
+        self.assertNotEqual(
+            0, self.listener.StartListeningForEvents(
+                self.target.GetBroadcaster(),
+                lldb.SBTarget.eBroadcastBitModulesLoaded))
+
+        bkpt = self.target.BreakpointCreateBySourceRegex(
+            "// Break before dlopen", self.main_spec)
+        self.assertEqual(bkpt.GetNumLocations(), 1)
+        launch_info = lldb.SBLaunchInfo(None)
+        launch_info.SetWorkingDirectory(self.get_process_working_directory())
+        launch_info.SetEnvironmentEntries(
+            ["{}={}".format(self.dylibPath, self.getBuildDir())], True)
+        error = lldb.SBError()
+        self.process = self.target.Launch(launch_info, error)
+        self.assertTrue(self.process, error.GetCString())
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(self.process,
+                                                               bkpt)
+        self.assertTrue(thread.IsValid())
+
+    def loaded_batches(self):
+        """Return the file names of the modules of each module load event
+        received since the last call."""
+        batches = []
+        event = lldb.SBEvent()
+        while self.listener.GetNextEvent(event):
+            self.assertTrue(lldb.SBTarget.EventIsTargetEvent(event))
+            self.assertEqual(event.GetType(),
+                             lldb.SBTarget.eBroadcastBitModulesLoaded)
+            batches.append(
+                [lldb.SBTarget.GetModuleAtIndexFromEvent(i, event)
+                 .GetFileSpec().GetFilename()
+                 for i in range(lldb.SBTarget.GetNumModulesFromEvent(event))])
+        return batches
+
+    def assertLoadedTogether(self, batches, names):
+        """Check that the modules called 'names' are all announced by the
+        same event, and that their sections are loaded."""
+        with_names = [batch for batch in batches
+                      if any(name in batch for name in names)]
+        self.assertEqual(len(with_names), 1, str(batches))
+        for name in names:
+            self.assertIn(name, with_names[0])
+            module = self.target.FindModule(lldb.SBFileSpec(name, False))
+            self.assertTrue(module.IsValid(), name)
+            text = module.FindSection(".text")
+            self.assertTrue(text.IsValid(), name)
+            self.assertNotEqual(text.GetLoadAddress(self.target),
+                                lldb.LLDB_INVALID_ADDRESS, name)
+
+    @skipIfRemote
+    @skipIfWindows
+    @skipIfDarwin  # Only the POSIX dynamic loader loads libraries in batches.
+    def test_linked_libraries_loaded_together(self):
+        """Test that the libraries the program is linked with are loaded and
+        announced by a single event."""
+        self.launch()
+        self.assertLoadedTogether(self.loaded_batches(),
+                                  ["libbatch_one.so", "libbatch_two.so"])
+
+    @skipIfRemote
+    @skipIfWindows
+    @skipIfDarwin  # Only the POSIX dynamic loader loads libraries in batches.
+    def test_opened_libraries_loaded_together(self):
+        """Test that a library opened by the program, and the library it
+        depends on, are loaded and announced by a single event."""
+        self.launch()
+        self.loaded_batches()
+
+        bkpt = self.target.BreakpointCreateBySourceRegex(
+            "// Break after dlopen", self.main_spec)
+        self.assertEqual(bkpt.GetNumLocations(), 1)
+        self.process.Continue()
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(self.process,
+                                                               bkpt)
+        self.assertTrue(thread.IsValid())
+        self.assertLoadedTogether(self.loaded_batches(),
+                                  ["libbatch_three.so", "libbatch_four.so"])
@@ -0,0 +1,5 @@
+int
+four_function ()
+{
+    return 1;
+}
@@ -0,0 +1,9 @@
+LEVEL := ../../make
+
+LIB_PREFIX := batch_
+
+DYLIB_NAME := $(LIB_PREFIX)four
+DYLIB_C_SOURCES := four.c
+DYLIB_ONLY := YES
+
+include $(LEVEL)/Makefile.rules
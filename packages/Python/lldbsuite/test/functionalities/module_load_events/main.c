@@ -0,0 +1,20 @@
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern int one_function ();
+extern int two_function ();
+
+int
+main (int argc, char const *argv[])
+{
+    int result = one_function () + two_function (); // Break before dlopen
+    // Loads libbatch_four.so along with it.
+    void *handle = dlopen ("libbatch_three.so", RTLD_NOW);
+    if (handle == NULL)
+    {
+        fprintf (stderr, "%s\n", dlerror());
+        exit (1);
+    }
+    return result; // Break after dlopen
+}
@@ -0,0 +1,5 @@
+int
+one_function ()
+{
+    return 1;
+}
@@ -0,0 +1,9 @@
+LEVEL := ../../make
+
+LIB_PREFIX := batch_
+
+DYLIB_NAME := $(LIB_PREFIX)one
+DYLIB_C_SOURCES := one.c
+DYLIB_ONLY := YES
+
+include $(LEVEL)/Makefile.rules
@@ -0,0 +1,7 @@
+extern int four_function ();
+
+int
+three_function ()
+{
+    return four_function () + 1;
+}
@@ -0,0 +1,19 @@
+LEVEL := ../../make
+
+LIB_PREFIX := batch_
+
+LD_EXTRAS := -L. -l$(LIB_PREFIX)four
+
+DYLIB_NAME := $(LIB_PREFIX)three
+DYLIB_C_SOURCES := three.c
+DYLIB_ONLY := YES
+
+include $(LEVEL)/Makefile.rules
+
+$(DYLIB_FILENAME): lib_four
+
+.PHONY lib_four:
+	$(MAKE) VPATH=$(SRCDIR) -I $(SRCDIR) -f $(SRCDIR)/four.mk
+
+clean::
+	$(MAKE) -I $(SRCDIR) -f $(SRCDIR)/four.mk clean
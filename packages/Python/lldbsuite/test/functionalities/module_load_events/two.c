@@ -0,0 +1,5 @@
+int
+two_function ()
+{
+    return 1;
+}
@@ -0,0 +1,9 @@
+LEVEL := ../../make
+
+LIB_PREFIX := batch_
+
+DYLIB_NAME := $(LIB_PREFIX)two
+DYLIB_C_SOURCES := two.c
+DYLIB_ONLY := YES
+
+include $(LEVEL)/Makefile.rules
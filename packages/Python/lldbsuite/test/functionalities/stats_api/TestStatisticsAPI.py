@@ -20,9 +20,27 @@ class TestStatsAPI(TestBase):
         stats = target.GetStatistics()
         stream = lldb.SBStream()
         res = stats.GetAsJSON(stream)
-        stats_json = sorted(json.loads(stream.GetData()))
-        self.assertEqual(len(stats_json), 4)
+        stats_json = json.loads(stream.GetData())
         self.assertTrue("Number of expr evaluation failures" in stats_json)
         self.assertTrue("Number of expr evaluation successes" in stats_json)
         self.assertTrue("Number of frame var failures" in stats_json)
         self.assertTrue("Number of frame var successes" in stats_json)
+        for key in ["Number of strings in the string pool",
+                    "Bytes used by the string pool",
+                    "Bytes allocated by the string pool",
+                    "Number of string pool shards",
+                    "Fewest strings in a string pool shard",
+                    "Most strings in a string pool shard"]:
+            self.assertTrue(key in stats_json, key)
+        for key in ["Number of breakpoint condition cache hits",
+                    "Number of breakpoint condition cache misses",
+                    "Time spent compiling breakpoint conditions (ns)"]:
+            self.assertTrue(key in stats_json, key)
+        for key in ["Number of expression cache hits",
+                    "Number of expression cache misses",
+                    "Number of expression cache evictions"]:
+            self.assertTrue(key in stats_json, key)
+        self.assertTrue(isinstance(
+            stats_json.get("Debug info bytes held per module"), dict))
+        self.assertTrue(isinstance(
+            stats_json.get("Split debug info files opened per module"), dict))
@@ -0,0 +1,178 @@
+from __future__ import print_function
+
+
+import struct
+
+import gdbremote_testcase
+import lldbgdbserverutils
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemoteConditionalBreakpoints(
+        gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # The agent expression opcodes the conditions are made of.
+    OP_EQUAL = 0x13
+    OP_CONST8 = 0x22
+    OP_CONST64 = 0x25
+    OP_REG = 0x26
+    OP_END = 0x27
+
+    def const(self, value):
+        return struct.pack(">BQ", self.OP_CONST64, value)
+
+    def reg(self, reg_index):
+        return struct.pack(">BH", self.OP_REG, reg_index)
+
+    def condition(self, *parts):
+        bytecode = b"".join(parts) + struct.pack(">B", self.OP_END)
+        return ";X{:x},{}".format(
+            len(bytecode),
+            "".join("{:02x}".format(byte) for byte in bytearray(bytecode)))
+
+    def launch_and_get_function_address(self):
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "get-code-address-hex:hello",
+                "sleep:1",
+                "call-function:hello",
+                "call-function:hello"])
+
+        self.add_qSupported_packets()
+        self.add_register_info_collection_packets()
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"code address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "function_address"}},
+                "read packet: {}".format(chr(3)),
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        supported = self.parse_qSupported_response(context)
+        self.assertEqual(supported.get("ConditionalBreakpoints"), "+")
+
+        reg_infos = self.parse_register_info_packets(context)
+        (pc_reg_index, pc_reg_info) = self.find_pc_reg_info(reg_infos)
+        self.assertIsNotNone(pc_reg_index)
+
+        self.assertIsNotNone(context.get("function_address"))
+        return (int(context.get("function_address"), 16), pc_reg_index)
+
+    def breakpoint_kind(self):
+        if self.getArchitecture() in ["arm", "aarch64"]:
+            return 4
+        return 1
+
+    def set_breakpoint(self, address, conditions):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $Z0,{:x},{}{}#00".format(
+                address, self.breakpoint_kind(), "".join(conditions)),
+             "send packet: $OK#00"],
+            True)
+        self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+    def continue_to_breakpoint(self):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"direction": "send",
+              "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(int(context.get("stop_signo"), 16),
+                         lldbutil.get_signal_number('SIGTRAP'))
+
+    def continue_to_exit(self, num_calls):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"type": "output_match",
+              "regex": r"^(hello, world\r\n){%d}$" % num_calls},
+             {"direction": "send", "regex": r"^\$W00(.*)#[0-9a-fA-F]{2}$"}],
+            True)
+        self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+    def false_condition_resumes(self):
+        (address, pc_reg_index) = self.launch_and_get_function_address()
+        # Both calls run past the breakpoint without reporting a stop, so it
+        # is inserted again after the first one.
+        self.set_breakpoint(
+            address,
+            [self.condition(struct.pack(">BB", self.OP_CONST8, 0))])
+        self.continue_to_exit(2)
+
+    @llgs_test
+    def test_false_condition_resumes_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.false_condition_resumes()
+
+    def register_condition_stops(self):
+        (address, pc_reg_index) = self.launch_and_get_function_address()
+        # Stop only where the pc is the breakpoint address, which it always
+        # is at a breakpoint.
+        self.set_breakpoint(
+            address,
+            [self.condition(self.reg(pc_reg_index), self.const(address),
+                            struct.pack(">B", self.OP_EQUAL))])
+        self.continue_to_breakpoint()
+        self.continue_to_breakpoint()
+
+        self.reset_test_sequence()
+        self.add_remove_breakpoint_packets(
+            address, breakpoint_kind=self.breakpoint_kind())
+        self.assertIsNotNone(self.expect_gdbremote_sequence())
+        self.continue_to_exit(2)
+
+    @llgs_test
+    def test_register_condition_stops_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.register_condition_stops()
+
+    def any_true_condition_stops(self):
+        (address, pc_reg_index) = self.launch_and_get_function_address()
+        # A register condition which is false, next to one which is true.
+        self.set_breakpoint(
+            address,
+            [self.condition(self.reg(pc_reg_index), self.const(address + 1),
+                            struct.pack(">B", self.OP_EQUAL)),
+             self.condition(struct.pack(">BB", self.OP_CONST8, 1))])
+        self.continue_to_breakpoint()
+
+    @llgs_test
+    def test_any_true_condition_stops_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.any_true_condition_stops()
+
+    def malformed_conditions_are_rejected(self):
+        (address, pc_reg_index) = self.launch_and_get_function_address()
+        for conditions in [";X0,", ";X2,22", ";X3", ";Y1,27"]:
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $Z0,{:x},{}{}#00".format(
+                    address, self.breakpoint_kind(), conditions),
+                 {"direction": "send", "regex": r"^\$E[0-9a-fA-F]{2}"}],
+                True)
+            self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+    @llgs_test
+    def test_malformed_conditions_are_rejected_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.malformed_conditions_are_rejected()
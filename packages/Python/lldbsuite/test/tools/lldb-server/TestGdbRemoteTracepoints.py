@@ -0,0 +1,216 @@
+from __future__ import print_function
+
+
+import struct
+
+import gdbremote_testcase
+import lldbgdbserverutils
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemoteTracepoints(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # The register number meaning a memory range has a fixed address.
+    NO_REGISTER = 0xffffffff
+    # The most bytes lldb-server records of a register or memory range.
+    MAX_COLLECT_SIZE = 4096
+
+    def launch_and_get_function_address(self, num_calls):
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "get-code-address-hex:hello",
+                "sleep:1"] +
+            ["call-function:hello"] * num_calls +
+            ["sleep:60"])
+
+        self.add_qSupported_packets()
+        self.add_register_info_collection_packets()
+        self.add_process_info_collection_packets()
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"code address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "function_address"}},
+                "read packet: {}".format(chr(3)),
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        supported = self.parse_qSupported_response(context)
+        self.assertEqual(supported.get("Tracepoints"), "+")
+
+        self.reg_infos = self.parse_register_info_packets(context)
+        (self.pc_reg_index, self.pc_reg_info) = self.find_pc_reg_info(
+            self.reg_infos)
+        self.assertIsNotNone(self.pc_reg_index)
+        process_info = self.parse_process_info_response(context)
+        self.endian = process_info.get("endian")
+        self.assertIsNotNone(self.endian)
+
+        self.assertIsNotNone(context.get("function_address"))
+        return int(context.get("function_address"), 16)
+
+    def breakpoint_kind(self):
+        if self.getArchitecture() in ["arm", "aarch64"]:
+            return 4
+        return 1
+
+    def set_breakpoint(self, address, items):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $Z0,{:x},{}{}#00".format(
+                address, self.breakpoint_kind(), "".join(items)),
+             "send packet: $OK#00"],
+            True)
+        self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+    def read_memory(self, address, size):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $m{:x},{:x}#00".format(address, size),
+             {"direction": "send", "regex": r"^\$([0-9a-fA-F]+)#",
+              "capture": {1: "contents"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        return context.get("contents").decode("hex")
+
+    def continue_past_hits(self, num_calls):
+        # The inferior runs through all the calls without reporting a stop,
+        # then sleeps until it is interrupted.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"type": "output_match",
+              "regex": r"^(hello, world\r\n){%d}$" % num_calls},
+             "read packet: {}".format(chr(3)),
+             {"direction": "send",
+              "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertNotEqual(int(context.get("stop_signo"), 16),
+                            lldbutil.get_signal_number('SIGTRAP'))
+
+    def read_tracepoint_buffer(self):
+        """Drain the tracepoint buffer, returning the number of hits dropped
+        and the (address, thread id, data) of the hits recorded."""
+        num_dropped = 0
+        entries = []
+        while True:
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $qTracepointBuffer#00",
+                 {"direction": "send",
+                  "regex": r"^\$([0-9a-fA-F]+);(.*)#[0-9a-fA-F]{2}$",
+                  "capture": {1: "num_dropped", 2: "entries"}}],
+                True)
+            context = self.expect_gdbremote_sequence()
+            self.assertIsNotNone(context)
+            num_dropped += int(context.get("num_dropped"), 16)
+            response_entries = context.get("entries")
+            if not response_entries:
+                return (num_dropped, entries)
+            self.assertTrue(response_entries.endswith(";"))
+            for entry in response_entries[:-1].split(";"):
+                (address, tid, data) = entry.split(",")
+                entries.append((int(address, 16), int(tid, 16),
+                                data.decode("hex")))
+
+    def register_and_memory_are_recorded(self):
+        num_calls = 3
+        address = self.launch_and_get_function_address(num_calls)
+        code = self.read_memory(address, 4)
+        pc_size = int(self.pc_reg_info["bitsize"]) // 8
+        # Record the pc, and the code of the function from its fixed
+        # address, which reads its bytes without the breakpoint.
+        self.set_breakpoint(
+            address,
+            [";R{:x},{:x}".format(self.pc_reg_index, pc_size),
+             ";M{:x},{:x},{:x}".format(self.NO_REGISTER, address, 4)])
+        self.continue_past_hits(num_calls)
+
+        (num_dropped, entries) = self.read_tracepoint_buffer()
+        self.assertEqual(num_dropped, 0)
+        self.assertEqual(len(entries), num_calls)
+        for (entry_address, tid, data) in entries:
+            self.assertEqual(entry_address, address)
+            self.assertNotEqual(tid, 0)
+            # Each item is a flag saying it could be read, then its bytes.
+            self.assertEqual(len(data), 1 + pc_size + 1 + 4)
+            self.assertEqual(data[0], "\x01")
+            self.assertEqual(
+                lldbgdbserverutils.unpack_endian_binary_string(
+                    self.endian, data[1:1 + pc_size]),
+                address)
+            self.assertEqual(data[1 + pc_size], "\x01")
+            self.assertEqual(data[2 + pc_size:], code)
+
+        # The hits were removed from the buffer.
+        self.assertEqual(self.read_tracepoint_buffer(), (0, []))
+
+    @llgs_test
+    def test_register_and_memory_are_recorded_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.register_and_memory_are_recorded()
+
+    def oldest_hits_are_dropped(self):
+        # Each hit records almost as much as a qTracepointBuffer response
+        # holds, so that 1 MiB of them fills the buffer and each response
+        # has one of them.
+        num_calls = 40
+        address = self.launch_and_get_function_address(num_calls)
+        num_items = 7
+        self.set_breakpoint(
+            address,
+            [";M{:x},{:x},{:x}".format(
+                self.NO_REGISTER, address, self.MAX_COLLECT_SIZE)] *
+            num_items)
+        self.continue_past_hits(num_calls)
+
+        (num_dropped, entries) = self.read_tracepoint_buffer()
+        self.assertGreater(num_dropped, 0)
+        self.assertGreater(len(entries), 0)
+        self.assertEqual(num_dropped + len(entries), num_calls)
+        for (entry_address, tid, data) in entries:
+            self.assertEqual(entry_address, address)
+            self.assertEqual(len(data),
+                             num_items * (1 + self.MAX_COLLECT_SIZE))
+
+        # The count of the dropped hits is reset once it was sent.
+        self.assertEqual(self.read_tracepoint_buffer(), (0, []))
+
+    @llgs_test
+    def test_oldest_hits_are_dropped_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.oldest_hits_are_dropped()
+
+    def malformed_items_are_rejected(self):
+        address = self.launch_and_get_function_address(1)
+        for items in [";R0", ";R0,0", ";Rffffffff,8", ";M0,10",
+                      ";M0,10,0", ";M0,10,{:x}".format(
+                          self.MAX_COLLECT_SIZE + 1)]:
+            self.reset_test_sequence()
+            self.test_sequence.add_log_lines(
+                ["read packet: $Z0,{:x},{}{}#00".format(
+                    address, self.breakpoint_kind(), items),
+                 {"direction": "send", "regex": r"^\$E[0-9a-fA-F]{2}"}],
+                True)
+            self.assertIsNotNone(self.expect_gdbremote_sequence())
+
+    @llgs_test
+    def test_malformed_items_are_rejected_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.malformed_items_are_rejected()
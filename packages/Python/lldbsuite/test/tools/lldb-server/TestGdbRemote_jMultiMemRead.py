@@ -0,0 +1,116 @@
+from __future__ import print_function
+
+
+import json
+
+import gdbremote_testcase
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemote_jMultiMemRead(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+    def launch_and_get_message_address(self):
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" % self.MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5"])
+
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"data address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "message_address"}},
+                "read packet: {}".format(chr(3)),
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("message_address"))
+        return int(context.get("message_address"), 16)
+
+    def send_multi_mem_read(self, payload):
+        # The closing brace is the packet escape character, so it has to be
+        # escaped itself.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $jMultiMemRead:{}#00".format(
+                payload.replace("}", "}]")),
+             {"direction": "send",
+              "regex": re.compile(r"^\$(.*)#[0-9a-fA-F]{2}$",
+                                  re.MULTILINE | re.DOTALL),
+              "capture": {1: "response"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("response"))
+        return context.get("response")
+
+    def read_ranges(self, ranges):
+        response = self.send_multi_mem_read(json.dumps(
+            [{"address": address, "length": length}
+             for address, length in ranges]))
+        self.assertFalse(response.startswith("E"), response)
+        counts, data = response.split(";", 1)
+        counts = [int(count, 16) for count in counts.split(",")]
+        data = self.decode_gdbremote_binary(data)
+        self.assertEqual(sum(counts), len(data))
+        contents = []
+        for count in counts:
+            contents.append(data[:count])
+            data = data[count:]
+        return contents
+
+    def reads_ranges(self):
+        address = self.launch_and_get_message_address()
+        self.assertEqual(
+            self.read_ranges([(address, 4), (address + 5, 8)]),
+            ["Test", "contents"])
+
+    @llgs_test
+    def test_reads_ranges_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.reads_ranges()
+
+    def reads_partial_ranges(self):
+        address = self.launch_and_get_message_address()
+        # An unreadable range reads nothing, and doesn't keep the ranges
+        # after it from being read.
+        self.assertEqual(
+            self.read_ranges([(address, 4), (0, 16), (address + 14, 10)]),
+            ["Test", "", "0123456789"])
+
+    @llgs_test
+    def test_reads_partial_ranges_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.reads_partial_ranges()
+
+    def rejects_malformed_requests(self):
+        address = self.launch_and_get_message_address()
+        for payload in [
+                "not json",
+                '{"address": %d, "length": 4}' % address,
+                '[{"address": %d}]' % address,
+                '[{"length": 4}]',
+                '[4]',
+                # More than fits in a packet.
+                '[{"address": %d, "length": %d}]' % (address, 1 << 40)]:
+            self.assertRegexpMatches(
+                self.send_multi_mem_read(payload), r"^E[0-9a-fA-F]{2}")
+
+    @llgs_test
+    def test_rejects_malformed_requests_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.rejects_malformed_requests()
@@ -189,16 +189,7 @@ SBStructuredData SBTarget::GetStatistics() {
   if (!target_sp)
     return data;
 
-  auto stats_up = llvm::make_unique<StructuredData::Dictionary>();
-  int i = 0;
-  for (auto &Entry : target_sp->GetStatistics()) {
-    std::string Desc = lldb_private::GetStatDescription(
-        static_cast<lldb_private::StatisticKind>(i));
-    stats_up->AddIntegerItem(Desc, Entry);
-    i += 1;
-  }
-
-  data.m_impl_up->SetObjectSP(std::move(stats_up));
+  data.m_impl_up->SetObjectSP(target_sp->GetStatistics());
   return data;
 }
 
@@ -8,7 +8,12 @@
 //===----------------------------------------------------------------------===//
 
 // C Includes
+#include <ctype.h>
+
 // C++ Includes
+#include <algorithm>
+#include <tuple>
+
 // Other libraries and framework includes
 #include "llvm/Support/Casting.h"
 
@@ -62,6 +67,7 @@ Breakpoint::Breakpoint(Target &target, SearchFilterSP &filter_sp,
 Breakpoint::Breakpoint(Target &new_target, Breakpoint &source_bp)
     : m_being_created(true), m_hardware(source_bp.m_hardware),
       m_target(new_target), m_name_list(source_bp.m_name_list),
+      m_collected_items(source_bp.m_collected_items),
       m_options_up(new BreakpointOptions(*source_bp.m_options_up.get())),
       m_locations(*this),
       m_resolve_indirect_symbols(source_bp.m_resolve_indirect_symbols),
@@ -909,6 +915,14 @@ void Breakpoint::GetDescription(Stream *s, lldb::DescriptionLevel level,
     if (m_precondition_sp)
       m_precondition_sp->GetDescription(*s, level);
 
+    if (!m_collected_items.empty()) {
+      s->PutCString(", collects =");
+      for (const CollectedItem &item : m_collected_items) {
+        s->PutChar(' ');
+        item.GetDescription(*s);
+      }
+    }
+
     if (level == lldb::eDescriptionLevelFull) {
       if (!m_name_list.empty()) {
         s->EOL();
@@ -1017,6 +1031,62 @@ Breakpoint::BreakpointPrecondition::ConfigurePrecondition(Args &options) {
   return error;
 }
 
+bool Breakpoint::CollectedItem::Parse(llvm::StringRef text,
+                                      CollectedItem &item) {
+  item = CollectedItem();
+  llvm::StringRef size_text;
+  std::tie(text, size_text) = text.split(',');
+  text = text.trim();
+  if (text.empty())
+    return false;
+  if (size_text.empty()) {
+    // A register, which has to be named.
+    auto is_name_char = [](char c) {
+      return isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+    if (isdigit(static_cast<unsigned char>(text.front())) ||
+        !std::all_of(text.begin(), text.end(), is_name_char))
+      return false;
+    item.reg_name = text.str();
+    return true;
+  }
+
+  item.is_memory = true;
+  if (size_text.trim().getAsInteger(0, item.size) || item.size == 0)
+    return false;
+  // An address, or a register and an optional offset.
+  if (!text.getAsInteger(0, item.offset))
+    return true;
+  const size_t sign_pos = text.find_first_of("+-");
+  item.reg_name = text.substr(0, sign_pos).trim().str();
+  if (item.reg_name.empty())
+    return false;
+  if (sign_pos == llvm::StringRef::npos)
+    return true;
+  llvm::StringRef offset_text = text.substr(sign_pos + 1).trim();
+  if (offset_text.getAsInteger(0, item.offset))
+    return false;
+  if (text[sign_pos] == '-')
+    item.offset = -item.offset;
+  return true;
+}
+
+void Breakpoint::CollectedItem::GetDescription(Stream &s) const {
+  if (!is_memory) {
+    s.PutCString(reg_name);
+    return;
+  }
+  if (reg_name.empty())
+    s.Printf("0x%" PRIx64, static_cast<uint64_t>(offset));
+  else if (offset == 0)
+    s.PutCString(reg_name);
+  else
+    s.Printf("%s%c0x%" PRIx64, reg_name.c_str(), offset < 0 ? '-' : '+',
+             offset < 0 ? -static_cast<uint64_t>(offset)
+                        : static_cast<uint64_t>(offset));
+  s.Printf(",%u", size);
+}
+
 void Breakpoint::SendBreakpointChangedEvent(
     lldb::BreakpointEventType eventKind) {
   if (!m_being_created && !IsInternal() &&
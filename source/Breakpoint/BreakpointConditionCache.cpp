@@ -0,0 +1,98 @@
+//===-- BreakpointConditionCache.cpp ----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Breakpoint/BreakpointConditionCache.h"
+#include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/UserExpression.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+UserExpressionCache::Key
+BreakpointConditionCache::MakeKey(llvm::StringRef condition,
+                                  LanguageType language,
+                                  ExecutionContext &exe_ctx) {
+  return UserExpressionCache::MakeKey(
+      exe_ctx, condition, llvm::StringRef(), language,
+      Expression::eResultTypeAny, eExecutionPolicyOnlyWhenNeeded, false);
+}
+
+UserExpressionSP BreakpointConditionCache::GetExpression(
+    Target &target, llvm::StringRef condition, LanguageType language,
+    ExecutionContext &exe_ctx, Status &error) {
+  error.Clear();
+
+  UserExpressionCache::Key key = MakeKey(condition, language, exe_ctx);
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto pos = m_expressions.find(key);
+    if (pos != m_expressions.end() && pos->second->RebindContext(exe_ctx)) {
+      target.IncrementStats(StatisticKind::BreakpointConditionCacheHit);
+      return pos->second;
+    }
+    target.IncrementStats(StatisticKind::BreakpointConditionCacheMiss);
+  }
+
+  // Parse without holding the lock, which can take a while.
+  const auto start_time = std::chrono::steady_clock::now();
+
+  UserExpressionSP expr_sp(target.GetUserExpressionForLanguage(
+      condition, llvm::StringRef(), language, Expression::eResultTypeAny,
+      EvaluateExpressionOptions(), error));
+  if (error.Fail())
+    return UserExpressionSP();
+
+  DiagnosticManager diagnostics;
+  const bool parsed = expr_sp->Parse(
+      diagnostics, exe_ctx, eExecutionPolicyOnlyWhenNeeded, true, false);
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (target.GetCollectingStats())
+    m_compile_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_time);
+
+  if (!parsed) {
+    error.SetErrorStringWithFormat("Couldn't parse conditional expression:\n%s",
+                                   diagnostics.GetString().c_str());
+    return UserExpressionSP();
+  }
+
+  // Parsing it declared something or a module was loaded meanwhile, so the
+  // names it refers to might be other ones by the next time.
+  if (!UserExpressionCache::IsCurrent(key, exe_ctx))
+    return expr_sp;
+
+  // The conditions parsed before a module was loaded or a declaration made
+  // can't be found anymore.
+  for (auto pos = m_expressions.begin(); pos != m_expressions.end();) {
+    if (UserExpressionCache::IsCurrent(pos->first, exe_ctx))
+      ++pos;
+    else
+      pos = m_expressions.erase(pos);
+  }
+  m_expressions[std::move(key)] = expr_sp;
+  return expr_sp;
+}
+
+void BreakpointConditionCache::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_expressions.clear();
+}
+
+std::chrono::nanoseconds BreakpointConditionCache::GetCompileTime() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_compile_time;
+}
@@ -237,8 +237,7 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   std::lock_guard<std::mutex> guard(m_condition_mutex);
 
-  size_t condition_hash;
-  const char *condition_text = GetConditionText(&condition_hash);
+  const char *condition_text = GetConditionText();
 
   if (!condition_text) {
     m_user_expression_sp.reset();
@@ -249,37 +248,24 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   DiagnosticManager diagnostics;
 
-  if (condition_hash != m_condition_hash || !m_user_expression_sp ||
-      !m_user_expression_sp->MatchesContext(exe_ctx)) {
-    LanguageType language = eLanguageTypeUnknown;
-    // See if we can figure out the language from the frame, otherwise use the
-    // default language:
-    CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
-    if (comp_unit)
-      language = comp_unit->GetLanguage();
-
-    m_user_expression_sp.reset(GetTarget().GetUserExpressionForLanguage(
-        condition_text, llvm::StringRef(), language, Expression::eResultTypeAny,
-        EvaluateExpressionOptions(), error));
-    if (error.Fail()) {
-      if (log)
-        log->Printf("Error getting condition expression: %s.",
-                    error.AsCString());
-      m_user_expression_sp.reset();
-      return true;
-    }
-
-    if (!m_user_expression_sp->Parse(diagnostics, exe_ctx,
-                                     eExecutionPolicyOnlyWhenNeeded, true,
-                                     false)) {
-      error.SetErrorStringWithFormat(
-          "Couldn't parse conditional expression:\n%s",
-          diagnostics.GetString().c_str());
-      m_user_expression_sp.reset();
-      return true;
-    }
-
-    m_condition_hash = condition_hash;
+  LanguageType language = eLanguageTypeUnknown;
+  // See if we can figure out the language from the frame, otherwise use the
+  // default language:
+  CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
+  if (comp_unit)
+    language = comp_unit->GetLanguage();
+
+  // Locations stopping in the same block share the parsed expression. The
+  // cache parses it again whenever the condition, the modules or the
+  // persistent declarations changed since, so ask it at every hit.
+  Target &target = GetTarget();
+  m_user_expression_sp = target.GetBreakpointConditionCache().GetExpression(
+      target, condition_text, language, exe_ctx, error);
+  if (!m_user_expression_sp) {
+    if (log)
+      log->Printf("Error getting condition expression: %s.",
+                  error.AsCString());
+    return true;
   }
 
   // We need to make sure the user sees any parse errors in their condition, so
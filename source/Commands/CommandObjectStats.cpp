@@ -75,18 +75,26 @@ public:
   ~CommandObjectStatsDump() override = default;
 
 protected:
+  static void DumpDictionary(StructuredData::Dictionary &dict, int indent,
+                             CommandReturnObject &result) {
+    dict.ForEach([&](ConstString key, StructuredData::Object *object) {
+      if (StructuredData::Dictionary *child = object->GetAsDictionary()) {
+        result.AppendMessageWithFormat("%*s%s :\n", indent, "",
+                                       key.GetCString());
+        DumpDictionary(*child, indent + 2, result);
+      } else {
+        result.AppendMessageWithFormat("%*s%s : %" PRIu64 "\n", indent, "",
+                                       key.GetCString(),
+                                       object->GetIntegerValue());
+      }
+      return true;
+    });
+  }
+
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     Target *target = GetSelectedOrDummyTarget();
 
-    uint32_t i = 0;
-    for (auto &stat : target->GetStatistics()) {
-      result.AppendMessageWithFormat(
-          "%s : %u\n",
-          lldb_private::GetStatDescription(static_cast<lldb_private::StatisticKind>(i))
-              .c_str(),
-          stat);
-      i += 1;
-    }
+    DumpDictionary(*target->GetStatistics(), 0, result);
     result.SetStatus(eReturnStatusSuccessFinishResult);
     return true;
   }
@@ -156,7 +156,8 @@ DynamicLoader::GetSectionListFromModule(const ModuleSP module) const {
 ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
                                             addr_t link_map_addr,
                                             addr_t base_addr,
-                                            bool base_addr_is_offset) {
+                                            bool base_addr_is_offset,
+                                            bool notify) {
   Target &target = m_process->GetTarget();
   ModuleList &modules = target.GetImages();
   ModuleSpec module_spec(file, target.GetArchitecture());
@@ -168,7 +169,7 @@ ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
     return module_sp;
   }
 
-  if ((module_sp = target.GetSharedModule(module_spec))) {
+  if ((module_sp = target.GetSharedModule(module_spec, nullptr, notify))) {
     UpdateLoadedSections(module_sp, link_map_addr, base_addr,
                          base_addr_is_offset);
     return module_sp;
@@ -205,7 +206,8 @@ ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
         return module_sp;
       }
 
-      if ((module_sp = target.GetSharedModule(new_module_spec))) {
+      if ((module_sp =
+               target.GetSharedModule(new_module_spec, nullptr, notify))) {
         UpdateLoadedSections(module_sp, link_map_addr, base_addr, false);
         return module_sp;
       }
@@ -214,7 +216,7 @@ ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
 
   if ((module_sp = m_process->ReadModuleFromMemory(file, base_addr))) {
     UpdateLoadedSections(module_sp, link_map_addr, base_addr, false);
-    target.GetImages().AppendIfNeeded(module_sp);
+    target.AppendModuleIfNeeded(module_sp, notify);
   }
 
   return module_sp;
@@ -1059,6 +1059,25 @@ SymbolVendor *Module::GetSymbolVendor(bool can_create,
   return m_symfile_ap.get();
 }
 
+uint64_t Module::GetParsedDebugInfoByteSize() {
+  SymbolVendor *sym_vendor = GetSymbolVendor(false);
+  if (!sym_vendor)
+    return 0;
+  SymbolFile *symbol_file = sym_vendor->GetSymbolFile();
+  return symbol_file ? symbol_file->GetParsedDebugInfoByteSize() : 0;
+}
+
+uint32_t
+Module::GetSplitDebugInfoLoadStatistics(std::chrono::nanoseconds &load_time) {
+  load_time = std::chrono::nanoseconds::zero();
+  SymbolVendor *sym_vendor = GetSymbolVendor(false);
+  if (!sym_vendor)
+    return 0;
+  SymbolFile *symbol_file = sym_vendor->GetSymbolFile();
+  return symbol_file ? symbol_file->GetSplitDebugInfoLoadStatistics(load_time)
+                     : 0;
+}
+
 void Module::SetFileSpecAndObjectName(const FileSpec &file,
                                       const ConstString &object_name) {
   // Container objects whose paths do not specify a file directly can call this
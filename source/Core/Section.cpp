@@ -93,6 +93,8 @@ const char *Section::GetTypeAsCString() const {
     return "dwarf-types";
   case eSectionTypeDWARFDebugNames:
     return "dwarf-names";
+  case eSectionTypeGdbIndex:
+    return "gdb-index";
   case eSectionTypeELFSymbolTable:
     return "elf-symbol-table";
   case eSectionTypeELFDynamicSymbols:
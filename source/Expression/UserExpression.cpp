@@ -26,6 +26,7 @@
 #include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Expression/Materializer.h"
 #include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
@@ -99,6 +100,26 @@ bool UserExpression::MatchesContext(ExecutionContext &exe_ctx) {
   return LockAndCheckContext(exe_ctx, target_sp, process_sp, frame_sp);
 }
 
+bool UserExpression::RebindContext(ExecutionContext &exe_ctx) {
+  if (exe_ctx.GetProcessSP() != m_jit_process_wp.lock())
+    return false;
+
+  // Expressions parsed without a frame don't depend on one.
+  if (!m_address.IsValid())
+    return true;
+
+  lldb::StackFrameSP frame_sp = exe_ctx.GetFrameSP();
+  if (!frame_sp)
+    return false;
+
+  Block *block = frame_sp->GetSymbolContext(lldb::eSymbolContextBlock).block;
+  if (!block || block != m_address.CalculateSymbolContextBlock())
+    return false;
+
+  m_address = frame_sp->GetFrameCodeAddress();
+  return true;
+}
+
 lldb::addr_t UserExpression::GetObjectPointer(lldb::StackFrameSP frame_sp,
                                               ConstString &object_name,
                                               Status &err) {
@@ -207,20 +228,6 @@ lldb::ExpressionResults UserExpression::Evaluate(
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, error));
-  if (error.Fail()) {
-    if (log)
-      log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
-                  error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  if (log)
-    log->Printf("== [UserExpression::Evaluate] Parsing expression %s ==",
-                expr.str().c_str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
@@ -231,11 +238,47 @@ lldb::ExpressionResults UserExpression::Evaluate(
     return lldb::eExpressionInterrupted;
   }
 
+  // Top level expressions declare what they define each time they are
+  // parsed, so they are never reused.
+  UserExpressionCache &cache = target->GetUserExpressionCache();
+  const bool use_cache = execution_policy != eExecutionPolicyTopLevel;
+  const UserExpressionCache::Key cache_key = UserExpressionCache::MakeKey(
+      exe_ctx, expr, full_prefix, language, desired_type, execution_policy,
+      generate_debug_info);
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (use_cache)
+    user_expression_sp = cache.Find(cache_key, exe_ctx);
+
   DiagnosticManager diagnostic_manager;
 
-  bool parse_success =
-      user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
-                                keep_expression_in_memory, generate_debug_info);
+  bool parse_success;
+  if (user_expression_sp) {
+    if (log)
+      log->Printf("== [UserExpression::Evaluate] Reusing parsed expression "
+                  "%s ==",
+                  expr.str().c_str());
+    parse_success = true;
+  } else {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, error));
+    if (error.Fail()) {
+      if (log)
+        log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
+                    error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+
+    if (log)
+      log->Printf("== [UserExpression::Evaluate] Parsing expression %s ==",
+                  expr.str().c_str());
+
+    parse_success = user_expression_sp->Parse(
+        diagnostic_manager, exe_ctx, execution_policy,
+        keep_expression_in_memory, generate_debug_info);
+    if (parse_success && use_cache)
+      cache.Insert(cache_key, exe_ctx, user_expression_sp);
+  }
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
@@ -0,0 +1,145 @@
+//===-- UserExpressionCache.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+// C++ Includes
+#include <algorithm>
+#include <tuple>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Module.h"
+#include "lldb/Expression/ExpressionVariable.h"
+#include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool UserExpressionCache::Key::operator<(const Key &rhs) const {
+  return std::tie(text, prefix, language, desired_type, execution_policy,
+                  generate_debug_info, process_id, module_uuid, function_addr,
+                  block_id, images_generation, declaration_generation) <
+         std::tie(rhs.text, rhs.prefix, rhs.language, rhs.desired_type,
+                  rhs.execution_policy, rhs.generate_debug_info,
+                  rhs.process_id, rhs.module_uuid, rhs.function_addr,
+                  rhs.block_id, rhs.images_generation,
+                  rhs.declaration_generation);
+}
+
+static void GetGenerations(Target &target, LanguageType language,
+                           uint32_t &images_generation,
+                           uint32_t &declaration_generation) {
+  images_generation = target.GetImagesGeneration();
+  declaration_generation = 0;
+  if (PersistentExpressionState *persistent_state =
+          target.GetPersistentExpressionStateForLanguage(language))
+    declaration_generation = persistent_state->GetDeclarationGeneration();
+}
+
+UserExpressionCache::Key UserExpressionCache::MakeKey(
+    ExecutionContext &exe_ctx, llvm::StringRef text, llvm::StringRef prefix,
+    LanguageType language, Expression::ResultType desired_type,
+    ExecutionPolicy execution_policy, bool generate_debug_info) {
+  Key key;
+  key.text = text.str();
+  key.prefix = prefix.str();
+  key.language = language;
+  key.desired_type = desired_type;
+  key.execution_policy = execution_policy;
+  key.generate_debug_info = generate_debug_info;
+
+  if (Target *target = exe_ctx.GetTargetPtr())
+    GetGenerations(*target, language, key.images_generation,
+                   key.declaration_generation);
+
+  if (Process *process = exe_ctx.GetProcessPtr())
+    key.process_id = process->GetUniqueID();
+
+  if (StackFrame *frame = exe_ctx.GetFramePtr()) {
+    const SymbolContext &sc = frame->GetSymbolContext(
+        eSymbolContextModule | eSymbolContextFunction | eSymbolContextBlock);
+    if (sc.module_sp)
+      key.module_uuid = sc.module_sp->GetUUID();
+    if (sc.function)
+      key.function_addr =
+          sc.function->GetAddressRange().GetBaseAddress().GetLoadAddress(
+              exe_ctx.GetTargetPtr());
+    if (sc.block)
+      key.block_id = sc.block->GetID();
+  }
+  return key;
+}
+
+UserExpressionSP UserExpressionCache::Find(const Key &key,
+                                           ExecutionContext &exe_ctx) {
+  Target *target = exe_ctx.GetTargetPtr();
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = m_entries.find(key);
+  // An expression held by anyone else is being executed, or was left in the
+  // middle of its execution, and can't be run again until it is done.
+  if (pos == m_entries.end() || pos->second.expr_sp.use_count() != 1 ||
+      !pos->second.expr_sp->RebindContext(exe_ctx)) {
+    if (target)
+      target->IncrementStats(StatisticKind::ExpressionCacheMiss);
+    return UserExpressionSP();
+  }
+  if (target)
+    target->IncrementStats(StatisticKind::ExpressionCacheHit);
+  pos->second.last_use = ++m_use_count;
+  return pos->second.expr_sp;
+}
+
+bool UserExpressionCache::IsCurrent(const Key &key,
+                                    ExecutionContext &exe_ctx) {
+  Target *target = exe_ctx.GetTargetPtr();
+  if (!target)
+    return true;
+  uint32_t images_generation;
+  uint32_t declaration_generation;
+  GetGenerations(*target, key.language, images_generation,
+                 declaration_generation);
+  return images_generation == key.images_generation &&
+         declaration_generation == key.declaration_generation;
+}
+
+void UserExpressionCache::Insert(const Key &key, ExecutionContext &exe_ctx,
+                                 const UserExpressionSP &expr_sp) {
+  if (!IsCurrent(key, exe_ctx))
+    return;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_capacity == 0)
+    return;
+  if (m_entries.size() >= m_capacity && !m_entries.count(key)) {
+    auto oldest = std::min_element(
+        m_entries.begin(), m_entries.end(),
+        [](const std::pair<const Key, Entry> &lhs,
+           const std::pair<const Key, Entry> &rhs) {
+          return lhs.second.last_use < rhs.second.last_use;
+        });
+    m_entries.erase(oldest);
+    if (Target *target = exe_ctx.GetTargetPtr())
+      target->IncrementStats(StatisticKind::ExpressionCacheEviction);
+  }
+  Entry &entry = m_entries[key];
+  entry.expr_sp = expr_sp;
+  entry.last_use = ++m_use_count;
+}
+
+void UserExpressionCache::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries.clear();
+}
@@ -55,6 +55,33 @@ NativeProcessProtocol::GetMemoryRegionInfo(lldb::addr_t load_addr,
   return Status("not implemented");
 }
 
+Status NativeProcessProtocol::ReadMemoryRanges(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  for (MemoryReadRange &range : ranges) {
+    range.bytes_read = 0;
+    if (range.size != 0)
+      ReadMemory(range.addr, range.buf, range.size, range.bytes_read);
+  }
+  return Status();
+}
+
+Status NativeProcessProtocol::ReadMemoryRangesWithoutTrap(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  Status error = ReadMemoryRanges(ranges);
+  if (error.Fail())
+    return error;
+
+  for (const MemoryReadRange &range : ranges) {
+    if (range.bytes_read == 0)
+      continue;
+    error = m_breakpoint_list.RemoveTrapsFromBuffer(range.addr, range.buf,
+                                                    range.bytes_read);
+    if (error.Fail())
+      return error;
+  }
+  return Status();
+}
+
 llvm::Optional<WaitStatus> NativeProcessProtocol::GetExitStatus() {
   if (m_state == lldb::eStateExited)
     return m_exit_status;
@@ -10,9 +10,12 @@
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Host/ThreadLauncher.h"
 
-#include <cstdint> // for uint32_t
-#include <queue>   // for queue
-#include <thread>  // for thread
+#include <atomic>             // for atomic
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint32_t
+#include <deque>              // for deque
+#include <thread>             // for thread
+#include <vector>             // for vector
 
 namespace lldb_private {
 
@@ -23,97 +26,205 @@ public:
 
   void AddTask(std::function<void()> &&task_fn);
 
+  bool RunPendingTask();
+
+  static bool IsWorkerThread() { return g_worker_index != kNotAWorker; }
+
 private:
   TaskPoolImpl();
 
-  static lldb::thread_result_t WorkerPtr(void *pool);
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  struct WorkerArgs {
+    TaskPoolImpl *pool;
+    uint32_t index;
+  };
+
+  static lldb::thread_result_t WorkerPtr(void *args);
+
+  void Worker(uint32_t index);
+
+  // Take the next task for the worker at 'index': first from the back of its
+  // own queue, then from the queue of tasks added by non-worker threads and
+  // finally from the front of the other workers' queues.
+  bool PopTask(uint32_t index, std::function<void()> &task);
 
-  static void Worker(TaskPoolImpl *pool);
+  static const uint32_t kNotAWorker = UINT32_MAX;
+  static thread_local uint32_t g_worker_index;
 
-  std::queue<std::function<void()>> m_tasks;
-  std::mutex m_tasks_mutex;
-  uint32_t m_thread_count;
+  const uint32_t m_thread_count;
+  // One queue per worker, followed by the queue of tasks added from threads
+  // outside of the pool.
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+  std::atomic<size_t> m_num_queued;
+  std::atomic<uint32_t> m_num_sleeping;
+  std::mutex m_wake_mutex;
+  std::condition_variable m_wake_cv;
 };
 
 } // end of anonymous namespace
 
+thread_local uint32_t TaskPoolImpl::g_worker_index = TaskPoolImpl::kNotAWorker;
+
 TaskPoolImpl &TaskPoolImpl::GetInstance() {
-  static TaskPoolImpl g_task_pool_impl;
-  return g_task_pool_impl;
+  // The workers never exit, so the pool is intentionally leaked rather than
+  // destroyed underneath them at process exit.
+  static TaskPoolImpl *g_task_pool_impl = new TaskPoolImpl();
+  return *g_task_pool_impl;
 }
 
 void TaskPool::AddTaskImpl(std::function<void()> &&task_fn) {
   TaskPoolImpl::GetInstance().AddTask(std::move(task_fn));
 }
 
-TaskPoolImpl::TaskPoolImpl() : m_thread_count(0) {}
+bool TaskPool::IsWorkerThread() { return TaskPoolImpl::IsWorkerThread(); }
+
+bool TaskPool::RunPendingTask() {
+  return TaskPoolImpl::GetInstance().RunPendingTask();
+}
 
 unsigned GetHardwareConcurrencyHint() {
   // std::thread::hardware_concurrency may return 0 if the value is not well
   // defined or not computable.
-  static const unsigned g_hardware_concurrency = 
+  static const unsigned g_hardware_concurrency =
     std::max(1u, std::thread::hardware_concurrency());
   return g_hardware_concurrency;
 }
 
-void TaskPoolImpl::AddTask(std::function<void()> &&task_fn) {
+TaskPoolImpl::TaskPoolImpl()
+    : m_thread_count(GetHardwareConcurrencyHint()), m_num_queued(0),
+      m_num_sleeping(0) {
   const size_t min_stack_size = 8 * 1024 * 1024;
 
-  std::unique_lock<std::mutex> lock(m_tasks_mutex);
-  m_tasks.emplace(std::move(task_fn));
-  if (m_thread_count < GetHardwareConcurrencyHint()) {
-    m_thread_count++;
-    // Note that this detach call needs to happen with the m_tasks_mutex held.
-    // This prevents the thread from exiting prematurely and triggering a linux
-    // libc bug (https://sourceware.org/bugzilla/show_bug.cgi?id=19951).
-    lldb_private::ThreadLauncher::LaunchThread("task-pool.worker", WorkerPtr,
-                                               this, nullptr, min_stack_size)
+  for (uint32_t i = 0; i <= m_thread_count; ++i)
+    m_queues.emplace_back(new TaskQueue());
+
+  for (uint32_t i = 0; i < m_thread_count; ++i) {
+    lldb_private::ThreadLauncher::LaunchThread(
+        "task-pool.worker", WorkerPtr, new WorkerArgs{this, i}, nullptr,
+        min_stack_size)
         .Release();
   }
 }
 
-lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *pool) {
-  Worker((TaskPoolImpl *)pool);
+void TaskPoolImpl::AddTask(std::function<void()> &&task_fn) {
+  // Tasks spawned by a worker stay on its own queue where they are likely to
+  // be picked up again by the same thread while their inputs are still hot in
+  // its cache.
+  TaskQueue &queue = *m_queues[IsWorkerThread() ? g_worker_index
+                                                : m_thread_count];
+  {
+    std::lock_guard<std::mutex> guard(queue.mutex);
+    queue.tasks.push_back(std::move(task_fn));
+  }
+  ++m_num_queued;
+
+  // A worker going to sleep registers itself in m_num_sleeping before it
+  // checks m_num_queued, so either it sees the new task or we see it and
+  // wake it up.
+  if (m_num_sleeping != 0) {
+    std::lock_guard<std::mutex> guard(m_wake_mutex);
+    m_wake_cv.notify_one();
+  }
+}
+
+bool TaskPoolImpl::PopTask(uint32_t index, std::function<void()> &task) {
+  if (m_num_queued == 0)
+    return false;
+
+  auto pop = [this, &task](uint32_t queue_index, bool from_back) {
+    TaskQueue &queue = *m_queues[queue_index];
+    std::lock_guard<std::mutex> guard(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    if (from_back) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --m_num_queued;
+    return true;
+  };
+
+  if (pop(index, true) || pop(m_thread_count, false))
+    return true;
+  for (uint32_t i = 1; i < m_thread_count; ++i) {
+    if (pop((index + i) % m_thread_count, false))
+      return true;
+  }
+  return false;
+}
+
+bool TaskPoolImpl::RunPendingTask() {
+  if (!IsWorkerThread())
+    return false;
+
+  std::function<void()> task;
+  if (!PopTask(g_worker_index, task))
+    return false;
+  task();
+  return true;
+}
+
+lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *args) {
+  std::unique_ptr<WorkerArgs> worker_args(static_cast<WorkerArgs *>(args));
+  worker_args->pool->Worker(worker_args->index);
   return 0;
 }
 
-void TaskPoolImpl::Worker(TaskPoolImpl *pool) {
+void TaskPoolImpl::Worker(uint32_t index) {
+  g_worker_index = index;
+
   while (true) {
-    std::unique_lock<std::mutex> lock(pool->m_tasks_mutex);
-    if (pool->m_tasks.empty()) {
-      pool->m_thread_count--;
-      break;
+    std::function<void()> task;
+    if (PopTask(index, task)) {
+      task();
+      continue;
     }
 
-    std::function<void()> f = std::move(pool->m_tasks.front());
-    pool->m_tasks.pop();
-    lock.unlock();
-
-    f();
+    std::unique_lock<std::mutex> lock(m_wake_mutex);
+    ++m_num_sleeping;
+    m_wake_cv.wait(lock, [this] { return m_num_queued != 0; });
+    --m_num_sleeping;
   }
 }
 
 void TaskMapOverInt(size_t begin, size_t end,
                     const llvm::function_ref<void(size_t)> &func) {
-  const size_t num_workers = std::min<size_t>(end, GetHardwareConcurrencyHint());
+  if (begin >= end)
+    return;
+
+  const size_t num_items = end - begin;
+  const size_t num_workers =
+      std::min<size_t>(num_items, GetHardwareConcurrencyHint());
+  const size_t batch_size = std::max<size_t>(1, num_items / (num_workers * 8));
   std::atomic<size_t> idx{begin};
-  
-  auto wrapper = [&idx, end, &func]() {
+
+  auto wrapper = [&idx, end, batch_size, &func]() {
     while (true) {
-      size_t i = idx.fetch_add(1);
-      if (i >= end)
+      size_t batch_begin = idx.fetch_add(batch_size);
+      if (batch_begin >= end)
         break;
-      func(i);
+      size_t batch_end = std::min(end, batch_begin + batch_size);
+      for (size_t i = batch_begin; i < batch_end; ++i)
+        func(i);
     }
   };
 
+  // The calling thread takes part in the work, so only spawn tasks for the
+  // remaining workers.
   std::vector<std::future<void>> futures;
-  futures.reserve(num_workers);
-  for (size_t i = 0; i < num_workers; i++)
+  futures.reserve(num_workers - 1);
+  for (size_t i = 1; i < num_workers; i++)
     futures.push_back(TaskPool::AddTask(wrapper));
-  for (size_t i = 0; i < num_workers; i++)
-    futures[i].wait();
+  wrapper();
+  for (std::future<void> &future : futures)
+    TaskPool::Wait(future);
 }
 
 } // namespace lldb_private
-
@@ -19,6 +19,7 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
@@ -428,12 +429,21 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
+    std::vector<FileSpec> module_names;
     E = m_rendezvous.loaded_end();
+    for (I = m_rendezvous.loaded_begin(); I != E; ++I)
+      module_names.push_back(I->file_spec);
+    m_process->PrefetchModuleSpecs(
+        module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+    std::vector<ModuleSP> preloaded_modules = PreloadModules(module_names);
+
+    // Add the modules to the target one at a time and announce them all at
+    // once.
     for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
-      ModuleSP module_sp =
-          LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
+      ModuleSP module_sp = LoadModuleAtAddress(I->file_spec, I->link_addr,
+                                               I->base_addr, true, false);
       if (module_sp.get()) {
-        loaded_modules.AppendIfNeeded(module_sp);
+        loaded_modules.AppendIfNeeded(module_sp, false);
         new_modules.Append(module_sp);
       }
     }
@@ -458,6 +468,46 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   }
 }
 
+std::vector<ModuleSP>
+DynamicLoaderPOSIXDYLD::PreloadModules(const std::vector<FileSpec> &files) {
+  std::vector<ModuleSP> modules(files.size());
+  Target &target = m_process->GetTarget();
+  PlatformSP platform_sp = target.GetPlatform();
+  // Image search paths make Target::GetSharedModule look for the modules in
+  // other places than the platform does, so don't bother in that case.
+  if (!platform_sp || files.size() < 2 ||
+      target.GetImageSearchPathList().GetSize() != 0)
+    return modules;
+
+  const ArchSpec &arch = target.GetArchitecture();
+  const FileSpecList &search_paths = target.GetExecutableSearchPaths();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
+
+  TaskMapOverInt(0, files.size(), [&](size_t i) {
+    ModuleSpec module_spec(files[i], arch);
+    if (target.GetImages().FindFirstModule(module_spec))
+      return;
+
+    ModuleSP module_sp;
+    Status error = platform_sp->GetSharedModule(
+        module_spec, m_process, module_sp, &search_paths, nullptr, nullptr);
+    if (!module_sp) {
+      LLDB_LOG(log, "unable to preload {0}: {1}", files[i], error);
+      return;
+    }
+
+    // Parsing the object file and locating its symbol file (which may mean
+    // checksumming a .gnu_debuglink target) is what takes the most time, do
+    // it here rather than when the module is added to the target.
+    module_sp->GetSymbolVendor();
+    if (preload_symbols)
+      module_sp->PreloadSymbols();
+    modules[i] = std::move(module_sp);
+  });
+  return modules;
+}
+
 ThreadPlanSP
 DynamicLoaderPOSIXDYLD::GetStepThroughTrampolinePlan(Thread &thread,
                                                      bool stop) {
@@ -580,10 +630,11 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
     module_names.push_back(I->file_spec);
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+  std::vector<ModuleSP> preloaded_modules = PreloadModules(module_names);
 
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
-    ModuleSP module_sp =
-        LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
+    ModuleSP module_sp = LoadModuleAtAddress(I->file_spec, I->link_addr,
+                                             I->base_addr, true, false);
     if (module_sp.get()) {
       LLDB_LOG(log, "LoadAllCurrentModules loading module: {0}",
                I->file_spec.GetFilename());
@@ -107,6 +107,16 @@ protected:
   /// of loaded modules.
   void RefreshModules();
 
+  /// Finds or creates the modules for @p files and parses their object and
+  /// symbol files, spread over the task pool. The modules are not added to
+  /// the target, this is left to LoadModuleAtAddress which then finds them
+  /// in the shared module list.
+  ///
+  /// @return The modules that were found, which must be kept alive until
+  /// they have been loaded into the target.
+  std::vector<lldb::ModuleSP>
+  PreloadModules(const std::vector<lldb_private::FileSpec> &files);
+
   /// Updates the load address of every allocatable section in @p module.
   ///
   /// @param module The module to traverse.
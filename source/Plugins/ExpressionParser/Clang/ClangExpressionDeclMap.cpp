@@ -390,13 +390,15 @@ bool ClangExpressionDeclMap::AddPersistentVariable(const NamedDecl *decl,
 
   var->m_frozen_sp->SetHasCompleteType();
 
-  if (is_result)
+  if (is_result) {
     var->m_flags |= ClangExpressionVariable::EVNeedsFreezeDry;
-  else
+  } else {
     var->m_flags |=
         ClangExpressionVariable::EVKeepInTarget; // explicitly-declared
                                                  // persistent variables should
                                                  // persist
+    m_parser_vars->m_persistent_vars->DidDeclare();
+  }
 
   if (is_lvalue) {
     var->m_flags |= ClangExpressionVariable::EVIsProgramReference;
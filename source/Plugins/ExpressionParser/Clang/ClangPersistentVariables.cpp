@@ -65,6 +65,8 @@ void ClangPersistentVariables::RegisterPersistentDecl(const ConstString &name,
           enumerator_decl));
     }
   }
+
+  DidDeclare();
 }
 
 clang::NamedDecl *
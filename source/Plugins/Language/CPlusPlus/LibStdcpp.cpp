@@ -11,6 +11,8 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/ValueObject.h"
@@ -18,8 +20,10 @@
 #include "lldb/DataFormatters/StringPrinter.h"
 #include "lldb/DataFormatters/VectorIterator.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Endian.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/Stream.h"
@@ -426,3 +430,31 @@ bool lldb_private::formatters::LibStdcppSmartPointerSummaryProvider(
   stream.Printf("ptr = 0x%" PRIx64, ptr_sp->GetValueAsUnsigned(0));
   return true;
 }
+
+bool lldb_private::formatters::ReadNodePointers(
+    Process &process, lldb::addr_t node_addr, llvm::ArrayRef<uint64_t> offsets,
+    llvm::MutableArrayRef<lldb::addr_t> pointers) {
+  if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS || offsets.empty() ||
+      pointers.size() < offsets.size())
+    return false;
+
+  const uint32_t ptr_size = process.GetAddressByteSize();
+  const uint64_t read_size =
+      *std::max_element(offsets.begin(), offsets.end()) + ptr_size;
+  // The links of a node are a handful of words at its start.
+  uint8_t buffer[64];
+  if (read_size > sizeof(buffer))
+    return false;
+
+  Status error;
+  if (process.ReadMemory(node_addr, buffer, read_size, error) != read_size ||
+      error.Fail())
+    return false;
+
+  DataExtractor data(buffer, read_size, process.GetByteOrder(), ptr_size);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    lldb::offset_t offset = offsets[i];
+    pointers[i] = data.GetAddress(&offset);
+  }
+  return true;
+}
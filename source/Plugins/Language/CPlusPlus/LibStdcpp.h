@@ -15,6 +15,8 @@
 #include "lldb/DataFormatters/TypeSynthetic.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace lldb_private {
 namespace formatters {
 bool LibStdcppStringSummaryProvider(
@@ -54,6 +56,29 @@ SyntheticChildrenFrontEnd *
 LibStdcppUniquePtrSyntheticFrontEndCreator(CXXSyntheticChildren *,
                                            lldb::ValueObjectSP);
 
+SyntheticChildrenFrontEnd *
+LibStdcppVectorSyntheticFrontEndCreator(CXXSyntheticChildren *,
+                                        lldb::ValueObjectSP);
+
+SyntheticChildrenFrontEnd *
+LibStdcppListSyntheticFrontEndCreator(CXXSyntheticChildren *,
+                                      lldb::ValueObjectSP);
+
+SyntheticChildrenFrontEnd *
+LibStdcppMapSyntheticFrontEndCreator(CXXSyntheticChildren *,
+                                     lldb::ValueObjectSP); // map, set, multi*
+
+SyntheticChildrenFrontEnd *
+LibStdcppUnorderedMapSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP); // unordered_(multi)map/set
+
+// Read the pointer-sized fields at 'offsets' in the node at 'node_addr' of a
+// node based container with a single memory read. Returns false if the node
+// couldn't be read.
+bool ReadNodePointers(Process &process, lldb::addr_t node_addr,
+                      llvm::ArrayRef<uint64_t> offsets,
+                      llvm::MutableArrayRef<lldb::addr_t> pointers);
+
 } // namespace formatters
 } // namespace lldb_private
 
@@ -0,0 +1,192 @@
+//===-- LibStdcppList.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibStdcpp.h"
+
+#include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/DataFormatters/TypeSynthetic.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Utility/ConstString.h"
+
+#include "llvm/ADT/Optional.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace {
+
+/*
+ (std::__cxx11::list<int, std::allocator<int> >) l = {
+   std::__cxx11::_List_base<int, std::allocator<int> > = {
+     _M_impl = {
+       _M_node = {
+         std::__detail::_List_node_base = {
+           _M_next = 0x0000000000614c20
+           _M_prev = 0x0000000000614c60
+         }
+         _M_size = 3
+       }
+     }
+   }
+ }
+ */
+class LibStdcppListSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  explicit LibStdcppListSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override;
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(const ConstString &name) override;
+
+private:
+  // Follow the links until the address of the node at index 'idx' is known or
+  // the end of the list (or a loop) has been reached. The nodes found on the
+  // way are kept, so children are found without walking the list again.
+  bool FetchNodesUpTo(size_t idx);
+
+  CompilerType m_element_type;
+  // The address of the sentinel node in the list object.
+  lldb::addr_t m_head = LLDB_INVALID_ADDRESS;
+  uint64_t m_value_offset = 0;
+  // The number of elements recorded in the list, if it records it (C++11
+  // ABI).
+  llvm::Optional<size_t> m_size;
+  std::vector<lldb::addr_t> m_nodes;
+  bool m_done = false;
+};
+
+} // end of anonymous namespace
+
+LibStdcppListSyntheticFrontEnd::LibStdcppListSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp)
+    Update();
+}
+
+bool LibStdcppListSyntheticFrontEnd::Update() {
+  m_head = LLDB_INVALID_ADDRESS;
+  m_size.reset();
+  m_nodes.clear();
+  m_done = true;
+
+  CompilerType type = m_backend.GetCompilerType();
+  if (type.IsReferenceType())
+    type = type.GetNonReferenceType();
+  if (type.GetNumTemplateArguments() == 0)
+    return false;
+  m_element_type = type.GetTypeTemplateArgument(0);
+
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return false;
+
+  ValueObjectSP node_sp(m_backend.GetChildAtNamePath(
+      {ConstString("_M_impl"), ConstString("_M_node")}));
+  if (!node_sp)
+    return false;
+  m_head = node_sp->GetAddressOf();
+  if (m_head == 0 || m_head == LLDB_INVALID_ADDRESS)
+    return false;
+
+  // Newer libstdc++ keep the size in a _List_node_header, GCC 5 and 6 in the
+  // data of a _List_node<size_t>.
+  ValueObjectSP size_sp(
+      node_sp->GetChildMemberWithName(ConstString("_M_size"), true));
+  if (!size_sp)
+    size_sp = node_sp->GetChildMemberWithName(ConstString("_M_data"), true);
+  if (size_sp)
+    m_size = size_sp->GetValueAsUnsigned(0);
+
+  // The value follows the _M_next and _M_prev links of the node.
+  const uint32_t ptr_size = process_sp->GetAddressByteSize();
+  const uint64_t align =
+      std::max<uint64_t>(1, m_element_type.GetTypeBitAlign() / 8);
+  m_value_offset = llvm::alignTo(2 * ptr_size, align);
+  m_done = false;
+  return false;
+}
+
+bool LibStdcppListSyntheticFrontEnd::FetchNodesUpTo(size_t idx) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    m_done = true;
+
+  while (!m_done && m_nodes.size() <= idx) {
+    const lldb::addr_t prev = m_nodes.empty() ? m_head : m_nodes.back();
+    lldb::addr_t next;
+    if (!ReadNodePointers(*process_sp, prev, {0}, next) || next == 0 ||
+        next == m_head) {
+      m_done = true;
+      break;
+    }
+    // A list which doesn't link back to its head would have us walk forever.
+    // Like Floyd's algorithm, compare the node at index i with the one at
+    // index i / 2 which is already known, and bail out on a loop.
+    if (!m_nodes.empty() && next == m_nodes[m_nodes.size() / 2]) {
+      m_nodes.clear();
+      m_done = true;
+      break;
+    }
+    // Don't trust a garbage list to end before the recorded size does.
+    if (m_size && m_nodes.size() >= *m_size) {
+      m_done = true;
+      break;
+    }
+    m_nodes.push_back(next);
+  }
+  return idx < m_nodes.size();
+}
+
+size_t LibStdcppListSyntheticFrontEnd::CalculateNumChildren() {
+  if (m_head == LLDB_INVALID_ADDRESS)
+    return 0;
+  if (m_size) {
+    // A list whose first link is null hasn't been constructed yet.
+    FetchNodesUpTo(0);
+    return m_nodes.empty() ? 0 : *m_size;
+  }
+  FetchNodesUpTo(SIZE_MAX);
+  return m_nodes.size();
+}
+
+lldb::ValueObjectSP
+LibStdcppListSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  if (!FetchNodesUpTo(idx))
+    return lldb::ValueObjectSP();
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  return CreateValueObjectFromAddress(
+      name.GetString(), m_nodes[idx] + m_value_offset,
+      m_backend.GetExecutionContextRef(), m_element_type);
+}
+
+size_t LibStdcppListSyntheticFrontEnd::GetIndexOfChildWithName(
+    const ConstString &name) {
+  return ExtractIndexFromString(name.GetCString());
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibStdcppListSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP valobj_sp) {
+  return (valobj_sp ? new LibStdcppListSyntheticFrontEnd(valobj_sp) : nullptr);
+}
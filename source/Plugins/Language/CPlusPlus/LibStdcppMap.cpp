@@ -0,0 +1,219 @@
+//===-- LibStdcppMap.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibStdcpp.h"
+
+#include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/DataFormatters/TypeSynthetic.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Utility/ConstString.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace {
+
+/*
+ (std::map<int, int, std::less<int>, ...>) m = {
+   _M_t = {
+     _M_impl = {
+       std::_Rb_tree_header = {
+         _M_header = {
+           _M_color = _S_red
+           _M_parent = 0x0000000000614c50
+           _M_left = 0x0000000000614c20
+           _M_right = 0x0000000000614c80
+         }
+         _M_node_count = 3
+       }
+     }
+   }
+ }
+ */
+// Provides the children of std::map, std::multimap, std::set and
+// std::multiset which are all implemented by a std::_Rb_tree.
+class LibStdcppMapSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  explicit LibStdcppMapSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override { return m_count; }
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(const ConstString &name) override;
+
+private:
+  // Continue the in-order traversal of the tree until the address of the node
+  // at index 'idx' is known. The nodes found on the way are kept, so the
+  // children are found without walking the tree again.
+  bool FetchNodesUpTo(size_t idx);
+
+  // Push 'node' and the chain of its left descendants on the traversal stack.
+  bool PushLeftChain(lldb::addr_t node);
+
+  CompilerType m_element_type;
+  size_t m_count = 0;
+  uint64_t m_left_offset = 0;
+  uint64_t m_right_offset = 0;
+  uint64_t m_value_offset = 0;
+  lldb::addr_t m_root = 0;
+  std::vector<lldb::addr_t> m_nodes;
+  // The nodes whose left subtree has been visited and which come next in the
+  // traversal, the next one at the back.
+  std::vector<lldb::addr_t> m_stack;
+  bool m_started = false;
+  bool m_done = false;
+};
+
+} // end of anonymous namespace
+
+LibStdcppMapSyntheticFrontEnd::LibStdcppMapSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp)
+    Update();
+}
+
+bool LibStdcppMapSyntheticFrontEnd::Update() {
+  m_count = 0;
+  m_root = 0;
+  m_nodes.clear();
+  m_stack.clear();
+  m_started = false;
+  m_done = true;
+
+  ValueObjectSP tree_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_t"), true));
+  if (!tree_sp)
+    return false;
+  // The value type is the second template argument of
+  // _Rb_tree<_Key, _Val, _KeyOfValue, _Compare, _Alloc> for all the
+  // containers.
+  CompilerType tree_type = tree_sp->GetCompilerType().GetCanonicalType();
+  if (tree_type.GetNumTemplateArguments() < 2)
+    return false;
+  m_element_type = tree_type.GetTypeTemplateArgument(1);
+
+  ValueObjectSP impl_sp(
+      tree_sp->GetChildMemberWithName(ConstString("_M_impl"), true));
+  if (!impl_sp)
+    return false;
+  ValueObjectSP header_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_header"), true));
+  ValueObjectSP count_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_node_count"), true));
+  if (!header_sp || !count_sp)
+    return false;
+  ValueObjectSP parent_sp(
+      header_sp->GetChildMemberWithName(ConstString("_M_parent"), true));
+  ValueObjectSP left_sp(
+      header_sp->GetChildMemberWithName(ConstString("_M_left"), true));
+  ValueObjectSP right_sp(
+      header_sp->GetChildMemberWithName(ConstString("_M_right"), true));
+  if (!parent_sp || !left_sp || !right_sp)
+    return false;
+
+  // The nodes are _Rb_tree_node<_Val> which store the value after the
+  // _Rb_tree_node_base links, the type of the header.
+  const uint64_t header_size =
+      header_sp->GetCompilerType().GetByteSize(nullptr);
+  const uint64_t align =
+      std::max<uint64_t>(1, m_element_type.GetTypeBitAlign() / 8);
+  if (header_size == 0)
+    return false;
+  m_value_offset = llvm::alignTo(header_size, align);
+  m_left_offset = left_sp->GetByteOffset();
+  m_right_offset = right_sp->GetByteOffset();
+
+  m_root = parent_sp->GetValueAsUnsigned(0);
+  m_count = count_sp->GetValueAsUnsigned(0);
+  if (m_root == 0)
+    m_count = 0;
+  m_done = m_count == 0;
+  return false;
+}
+
+bool LibStdcppMapSyntheticFrontEnd::PushLeftChain(lldb::addr_t node) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return false;
+  while (node != 0) {
+    // The stack can't be deeper than the number of nodes, unless the tree is
+    // garbage or has a loop.
+    if (m_stack.size() + m_nodes.size() >= m_count)
+      return false;
+    m_stack.push_back(node);
+    if (!ReadNodePointers(*process_sp, node, {m_left_offset}, node))
+      return false;
+  }
+  return true;
+}
+
+bool LibStdcppMapSyntheticFrontEnd::FetchNodesUpTo(size_t idx) {
+  if (!m_started) {
+    m_started = true;
+    if (!PushLeftChain(m_root))
+      m_done = true;
+  }
+
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  while (!m_done && m_nodes.size() <= idx) {
+    if (m_stack.empty() || !process_sp) {
+      m_done = true;
+      break;
+    }
+    const lldb::addr_t node = m_stack.back();
+    m_stack.pop_back();
+    m_nodes.push_back(node);
+    if (m_nodes.size() == m_count) {
+      m_done = true;
+      break;
+    }
+
+    lldb::addr_t right;
+    if (!ReadNodePointers(*process_sp, node, {m_right_offset}, right) ||
+        !PushLeftChain(right))
+      m_done = true;
+  }
+  return idx < m_nodes.size();
+}
+
+lldb::ValueObjectSP
+LibStdcppMapSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  if (idx >= m_count || !FetchNodesUpTo(idx))
+    return lldb::ValueObjectSP();
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  return CreateValueObjectFromAddress(
+      name.GetString(), m_nodes[idx] + m_value_offset,
+      m_backend.GetExecutionContextRef(), m_element_type);
+}
+
+size_t LibStdcppMapSyntheticFrontEnd::GetIndexOfChildWithName(
+    const ConstString &name) {
+  return ExtractIndexFromString(name.GetCString());
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibStdcppMapSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP valobj_sp) {
+  return (valobj_sp ? new LibStdcppMapSyntheticFrontEnd(valobj_sp) : nullptr);
+}
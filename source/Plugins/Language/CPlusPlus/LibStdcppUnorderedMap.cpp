@@ -0,0 +1,171 @@
+//===-- LibStdcppUnorderedMap.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibStdcpp.h"
+
+#include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/DataFormatters/TypeSynthetic.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Utility/ConstString.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace {
+
+/*
+ (std::unordered_map<int, int, ...>) um = {
+   _M_h = {
+     _M_buckets = 0x0000000000614c20
+     _M_bucket_count = 7
+     _M_before_begin = {
+       _M_nxt = 0x0000000000614c80
+     }
+     _M_element_count = 3
+     ...
+   }
+ }
+ */
+// Provides the children of std::unordered_map, std::unordered_multimap,
+// std::unordered_set and std::unordered_multiset which are all implemented by
+// a std::_Hashtable whose nodes form a single list.
+class LibStdcppUnorderedMapSyntheticFrontEnd
+    : public SyntheticChildrenFrontEnd {
+public:
+  explicit LibStdcppUnorderedMapSyntheticFrontEnd(
+      lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override { return m_count; }
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(const ConstString &name) override;
+
+private:
+  // Follow the links until the address of the node at index 'idx' is known.
+  // The nodes found on the way are kept, so children are found without
+  // walking the list again.
+  bool FetchNodesUpTo(size_t idx);
+
+  CompilerType m_element_type;
+  size_t m_count = 0;
+  uint64_t m_value_offset = 0;
+  lldb::addr_t m_first = 0;
+  std::vector<lldb::addr_t> m_nodes;
+  bool m_done = false;
+};
+
+} // end of anonymous namespace
+
+LibStdcppUnorderedMapSyntheticFrontEnd::LibStdcppUnorderedMapSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp)
+    Update();
+}
+
+bool LibStdcppUnorderedMapSyntheticFrontEnd::Update() {
+  m_count = 0;
+  m_first = 0;
+  m_nodes.clear();
+  m_done = true;
+
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return false;
+
+  ValueObjectSP table_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_h"), true));
+  if (!table_sp)
+    return false;
+  // The value type is the second template argument of
+  // _Hashtable<_Key, _Value, _Alloc, ...> for all the containers.
+  CompilerType table_type = table_sp->GetCompilerType().GetCanonicalType();
+  if (table_type.GetNumTemplateArguments() < 2)
+    return false;
+  m_element_type = table_type.GetTypeTemplateArgument(1);
+
+  ValueObjectSP first_sp(table_sp->GetChildAtNamePath(
+      {ConstString("_M_before_begin"), ConstString("_M_nxt")}));
+  ValueObjectSP count_sp(
+      table_sp->GetChildMemberWithName(ConstString("_M_element_count"), true));
+  if (!first_sp || !count_sp)
+    return false;
+
+  // The nodes store the value after their _M_nxt link, and possibly the
+  // cached hash code after it.
+  const uint64_t align =
+      std::max<uint64_t>(1, m_element_type.GetTypeBitAlign() / 8);
+  m_value_offset = llvm::alignTo(process_sp->GetAddressByteSize(), align);
+
+  m_first = first_sp->GetValueAsUnsigned(0);
+  m_count = count_sp->GetValueAsUnsigned(0);
+  if (m_first == 0)
+    m_count = 0;
+  m_done = m_count == 0;
+  return false;
+}
+
+bool LibStdcppUnorderedMapSyntheticFrontEnd::FetchNodesUpTo(size_t idx) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    m_done = true;
+
+  while (!m_done && m_nodes.size() <= idx) {
+    lldb::addr_t next = m_first;
+    if (!m_nodes.empty() &&
+        !ReadNodePointers(*process_sp, m_nodes.back(), {0}, next))
+      next = 0;
+    if (next == 0) {
+      m_done = true;
+      break;
+    }
+    m_nodes.push_back(next);
+    // Stopping at the recorded count also stops us from looping forever on
+    // garbage.
+    if (m_nodes.size() == m_count)
+      m_done = true;
+  }
+  return idx < m_nodes.size();
+}
+
+lldb::ValueObjectSP
+LibStdcppUnorderedMapSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  if (idx >= m_count || !FetchNodesUpTo(idx))
+    return lldb::ValueObjectSP();
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  return CreateValueObjectFromAddress(
+      name.GetString(), m_nodes[idx] + m_value_offset,
+      m_backend.GetExecutionContextRef(), m_element_type);
+}
+
+size_t LibStdcppUnorderedMapSyntheticFrontEnd::GetIndexOfChildWithName(
+    const ConstString &name) {
+  return ExtractIndexFromString(name.GetCString());
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibStdcppUnorderedMapSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP valobj_sp) {
+  return (valobj_sp ? new LibStdcppUnorderedMapSyntheticFrontEnd(valobj_sp)
+                    : nullptr);
+}
@@ -0,0 +1,406 @@
+//===-- LibStdcppVector.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibStdcpp.h"
+
+#include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/DataFormatters/TypeSynthetic.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+namespace {
+
+// The number of bytes of vector<bool> words read at once when a bit past
+// the ones read so far is requested.
+const size_t kWordReadSize = 16 * 1024;
+
+// The number of std::string elements whose characters are read at once when
+// an element past the ones read so far is requested.
+const size_t kStringReadCount = 256;
+
+// The size of the chunks ValueObject::ReadPointedString reads the characters
+// of a string summary in.
+const size_t kStringSummaryChunkSize = 64;
+
+/*
+ (std::vector<int, std::allocator<int> >) v = {
+   _M_impl = {
+     _M_start = 0x0000000000614c20
+     _M_finish = 0x0000000000614c2c
+     _M_end_of_storage = 0x0000000000614c2c
+   }
+ }
+ */
+class LibStdcppVectorSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  explicit LibStdcppVectorSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override;
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(const ConstString &name) override;
+
+private:
+  // If the elements are std::strings, read the characters of the ones
+  // starting at 'idx' with a single Process::ReadMemoryRanges call, so that
+  // their summaries find them in the memory cache. 'element' is the element
+  // at 'idx'.
+  void ReadStringsFrom(size_t idx, ValueObject &element);
+
+  CompilerType m_element_type;
+  uint64_t m_element_size = 0;
+  lldb::addr_t m_start = 0;
+  size_t m_count = 0;
+  // The elements before this one had their characters read, or aren't
+  // strings.
+  size_t m_strings_read_end = 0;
+};
+
+/*
+ (std::vector<bool, std::allocator<bool> >) vb = {
+   std::_Bvector_base<std::allocator<bool> > = {
+     _M_impl = {
+       _M_start = (_M_p = 0x0000000000614c20, _M_offset = 0)
+       _M_finish = (_M_p = 0x0000000000614c20, _M_offset = 5)
+       _M_end_of_storage = 0x0000000000614c28
+     }
+   }
+ }
+ */
+class LibStdcppVectorBoolSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  explicit LibStdcppVectorBoolSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override { return m_count; }
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(const ConstString &name) override;
+
+private:
+  // Make sure the word holding bit 'idx' has been read, reading the
+  // following words in the same memory read.
+  bool ReadWordsUpTo(size_t idx);
+
+  CompilerType m_bool_type;
+  ExecutionContextRef m_exe_ctx_ref;
+  lldb::addr_t m_start = 0;
+  size_t m_count = 0;
+  // The size of a _Bit_type word.
+  uint32_t m_word_size = 0;
+  lldb::ByteOrder m_byte_order = lldb::eByteOrderInvalid;
+  // The words read so far from the start of the storage.
+  std::vector<uint8_t> m_words;
+  std::map<size_t, lldb::ValueObjectSP> m_children;
+};
+
+} // end of anonymous namespace
+
+LibStdcppVectorSyntheticFrontEnd::LibStdcppVectorSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp)
+    Update();
+}
+
+bool LibStdcppVectorSyntheticFrontEnd::Update() {
+  m_start = 0;
+  m_count = 0;
+  m_strings_read_end = 0;
+
+  ValueObjectSP impl_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+  if (!impl_sp)
+    return false;
+  ValueObjectSP start_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_start"), true));
+  ValueObjectSP finish_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_finish"), true));
+  ValueObjectSP end_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_end_of_storage"), true));
+  if (!start_sp || !finish_sp || !end_sp)
+    return false;
+
+  m_element_type = start_sp->GetCompilerType().GetPointeeType();
+  m_element_size = m_element_type.GetByteSize(nullptr);
+  if (m_element_size == 0)
+    return false;
+
+  const lldb::addr_t start = start_sp->GetValueAsUnsigned(0);
+  const lldb::addr_t finish = finish_sp->GetValueAsUnsigned(0);
+  const lldb::addr_t end = end_sp->GetValueAsUnsigned(0);
+  // An uninitialized or corrupted vector shows up as having no children.
+  if (start == 0 || finish == 0 || end == 0 || start > finish ||
+      finish > end || (finish - start) % m_element_size != 0)
+    return false;
+
+  m_start = start;
+  m_count = (finish - start) / m_element_size;
+  return false;
+}
+
+size_t LibStdcppVectorSyntheticFrontEnd::CalculateNumChildren() {
+  return m_count;
+}
+
+lldb::ValueObjectSP
+LibStdcppVectorSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  if (idx >= m_count)
+    return lldb::ValueObjectSP();
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  ValueObjectSP child_sp(CreateValueObjectFromAddress(
+      name.GetString(), m_start + idx * m_element_size,
+      m_backend.GetExecutionContextRef(), m_element_type));
+  if (child_sp && idx >= m_strings_read_end)
+    ReadStringsFrom(idx, *child_sp);
+  return child_sp;
+}
+
+void LibStdcppVectorSyntheticFrontEnd::ReadStringsFrom(size_t idx,
+                                                       ValueObject &element) {
+  const size_t end = std::min(m_count, idx + kStringReadCount);
+  m_strings_read_end = end;
+
+  // Only the C++11 std::string knows the length of its characters. Find
+  // where its pointer and length are from the first element.
+  ValueObjectSP pointer_sp(element.GetChildAtNamePath(
+      {ConstString("_M_dataplus"), ConstString("_M_p")}));
+  ValueObjectSP length_sp(
+      element.GetChildMemberWithName(ConstString("_M_string_length"), true));
+  if (!pointer_sp || !length_sp ||
+      !pointer_sp->GetCompilerType().GetPointeeType().IsCharType())
+    return;
+  const lldb::addr_t element_addr = element.GetAddressOf();
+  const lldb::addr_t pointer_addr = pointer_sp->GetAddressOf();
+  const lldb::addr_t length_addr = length_sp->GetAddressOf();
+  const uint64_t pointer_size = pointer_sp->GetByteSize();
+  const uint64_t length_size = length_sp->GetByteSize();
+  if (element_addr == LLDB_INVALID_ADDRESS ||
+      pointer_addr == LLDB_INVALID_ADDRESS ||
+      length_addr == LLDB_INVALID_ADDRESS || pointer_addr < element_addr ||
+      length_addr < element_addr ||
+      pointer_addr - element_addr + pointer_size > m_element_size ||
+      length_addr - element_addr + length_size > m_element_size)
+    return;
+  const lldb::offset_t pointer_offset = pointer_addr - element_addr;
+  const lldb::offset_t length_offset = length_addr - element_addr;
+
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  if (!process_sp)
+    return;
+
+  // Read the strings themselves, then all of their characters at once.
+  const lldb::addr_t strings_addr = m_start + idx * m_element_size;
+  const size_t strings_size = (end - idx) * m_element_size;
+  DataBufferHeap strings(strings_size, 0);
+  Status error;
+  if (process_sp->ReadMemory(strings_addr, strings.GetBytes(), strings_size,
+                             error) != strings_size)
+    return;
+  DataExtractor data(strings.GetBytes(), strings_size,
+                     process_sp->GetByteOrder(),
+                     process_sp->GetAddressByteSize());
+
+  const uint64_t max_length =
+      process_sp->GetTarget().GetMaximumSizeOfStringSummary();
+  const uint64_t line_size = process_sp->GetMemoryCacheLineSize();
+  std::vector<Process::MemoryRange> ranges;
+  size_t total_size = 0;
+  for (lldb::offset_t offset = 0; offset < strings_size;
+       offset += m_element_size) {
+    lldb::offset_t field_offset = offset + pointer_offset;
+    const lldb::addr_t chars_addr = data.GetMaxU64(&field_offset, pointer_size);
+    field_offset = offset + length_offset;
+    const uint64_t length =
+        std::min(data.GetMaxU64(&field_offset, length_size), max_length);
+    // Short strings keep their characters inside of themselves, which were
+    // just read.
+    if (chars_addr == 0 || (chars_addr >= strings_addr &&
+                            chars_addr < strings_addr + strings_size))
+      continue;
+    // Cover the chunks the summary reads the characters and their terminator
+    // in, up to the end of the cache line, like
+    // Process::ReadCStringFromMemory does.
+    const lldb::addr_t chars_end = llvm::alignTo(
+        chars_addr + llvm::alignTo(length + 1, kStringSummaryChunkSize),
+        line_size);
+    ranges.push_back(Process::MemoryRange(chars_addr, chars_end - chars_addr));
+    total_size += chars_end - chars_addr;
+  }
+  if (ranges.empty())
+    return;
+
+  std::vector<uint8_t> buffer(total_size);
+  process_sp->ReadMemoryRanges(ranges, buffer);
+}
+
+size_t LibStdcppVectorSyntheticFrontEnd::GetIndexOfChildWithName(
+    const ConstString &name) {
+  if (m_count == 0)
+    return UINT32_MAX;
+  return ExtractIndexFromString(name.GetCString());
+}
+
+LibStdcppVectorBoolSyntheticFrontEnd::LibStdcppVectorBoolSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp) {
+    m_bool_type =
+        valobj_sp->GetCompilerType().GetBasicTypeFromAST(lldb::eBasicTypeBool);
+    Update();
+  }
+}
+
+bool LibStdcppVectorBoolSyntheticFrontEnd::Update() {
+  m_children.clear();
+  m_words.clear();
+  m_start = 0;
+  m_count = 0;
+
+  m_exe_ctx_ref = m_backend.GetExecutionContextRef();
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return false;
+  m_byte_order = process_sp->GetByteOrder();
+
+  ValueObjectSP impl_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+  if (!impl_sp)
+    return false;
+  ValueObjectSP start_sp(impl_sp->GetChildAtNamePath(
+      {ConstString("_M_start"), ConstString("_M_p")}));
+  ValueObjectSP finish_sp(impl_sp->GetChildAtNamePath(
+      {ConstString("_M_finish"), ConstString("_M_p")}));
+  ValueObjectSP offset_sp(impl_sp->GetChildAtNamePath(
+      {ConstString("_M_finish"), ConstString("_M_offset")}));
+  if (!start_sp || !finish_sp || !offset_sp)
+    return false;
+
+  m_word_size =
+      start_sp->GetCompilerType().GetPointeeType().GetByteSize(nullptr);
+  if (m_word_size == 0 || m_word_size > sizeof(uint64_t))
+    return false;
+
+  const lldb::addr_t start = start_sp->GetValueAsUnsigned(0);
+  const lldb::addr_t finish = finish_sp->GetValueAsUnsigned(0);
+  const uint64_t offset = offset_sp->GetValueAsUnsigned(0);
+  if (start == 0 || finish < start || (finish - start) % m_word_size != 0 ||
+      offset >= m_word_size * 8)
+    return false;
+
+  m_start = start;
+  m_count = (finish - start) * 8 + offset;
+  return false;
+}
+
+bool LibStdcppVectorBoolSyntheticFrontEnd::ReadWordsUpTo(size_t idx) {
+  const size_t bits_per_word = m_word_size * 8;
+  const size_t needed = (idx / bits_per_word + 1) * m_word_size;
+  if (needed <= m_words.size())
+    return true;
+
+  ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
+  if (!process_sp)
+    return false;
+
+  const size_t total = (m_count + bits_per_word - 1) / bits_per_word *
+                       m_word_size;
+  const size_t read_end =
+      std::min(total, std::max(needed, m_words.size() + kWordReadSize));
+  const size_t read_begin = m_words.size();
+  m_words.resize(read_end);
+  Status error;
+  const size_t bytes_read = process_sp->ReadMemory(
+      m_start + read_begin, m_words.data() + read_begin, read_end - read_begin,
+      error);
+  // Only keep whole words.
+  m_words.resize(read_begin + bytes_read / m_word_size * m_word_size);
+  return needed <= m_words.size();
+}
+
+lldb::ValueObjectSP
+LibStdcppVectorBoolSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  auto iter = m_children.find(idx);
+  if (iter != m_children.end())
+    return iter->second;
+  if (idx >= m_count || !m_bool_type || !ReadWordsUpTo(idx))
+    return lldb::ValueObjectSP();
+
+  const size_t bits_per_word = m_word_size * 8;
+  DataExtractor words(m_words.data(), m_words.size(), m_byte_order,
+                      m_word_size);
+  lldb::offset_t offset = idx / bits_per_word * m_word_size;
+  const uint64_t word = words.GetMaxU64(&offset, m_word_size);
+  const bool bit_set = (word >> (idx % bits_per_word)) & 1;
+
+  DataBufferSP buffer_sp(
+      new DataBufferHeap(m_bool_type.GetByteSize(nullptr), 0));
+  // Regardless of endianness, anything non-zero is true.
+  if (bit_set && buffer_sp->GetByteSize() > 0)
+    *buffer_sp->GetBytes() = 1;
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  ValueObjectSP child_sp(CreateValueObjectFromData(
+      name.GetString(), DataExtractor(buffer_sp, m_byte_order, m_word_size),
+      m_exe_ctx_ref, m_bool_type));
+  if (child_sp)
+    m_children[idx] = child_sp;
+  return child_sp;
+}
+
+size_t LibStdcppVectorBoolSyntheticFrontEnd::GetIndexOfChildWithName(
+    const ConstString &name) {
+  if (m_count == 0)
+    return UINT32_MAX;
+  size_t idx = ExtractIndexFromString(name.GetCString());
+  if (idx < UINT32_MAX && idx >= m_count)
+    return UINT32_MAX;
+  return idx;
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP valobj_sp) {
+  if (!valobj_sp)
+    return nullptr;
+  CompilerType type = valobj_sp->GetCompilerType();
+  if (type.IsReferenceType())
+    type = type.GetNonReferenceType();
+  if (!type.IsValid() || type.GetNumTemplateArguments() == 0)
+    return nullptr;
+  if (type.GetTypeTemplateArgument(0).GetTypeName() == ConstString("bool"))
+    return new LibStdcppVectorBoolSyntheticFrontEnd(valobj_sp);
+  return new LibStdcppVectorSyntheticFrontEnd(valobj_sp);
+}
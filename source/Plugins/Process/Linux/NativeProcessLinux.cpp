@@ -1443,6 +1443,35 @@ Status NativeProcessLinux::PopulateMemoryRegionCache() {
   return Status();
 }
 
+size_t NativeProcessLinux::GetMappedSize(lldb::addr_t addr, size_t size) {
+  if (m_supports_mem_region == LazyBool::eLazyBoolNo ||
+      PopulateMemoryRegionCache().Fail())
+    return size;
+
+  // The regions are sorted by address. Find the last one starting at or
+  // before addr and extend the mapped range over the regions adjacent to it.
+  auto pos = std::upper_bound(
+      m_mem_region_cache.begin(), m_mem_region_cache.end(), addr,
+      [](lldb::addr_t addr,
+         const std::pair<MemoryRegionInfo, FileSpec> &entry) {
+        return addr < entry.first.GetRange().GetRangeBase();
+      });
+  if (pos == m_mem_region_cache.begin())
+    return 0;
+  --pos;
+
+  lldb::addr_t mapped_end = addr;
+  for (; pos != m_mem_region_cache.end(); ++pos) {
+    const MemoryRegionInfo::RangeType &range = pos->first.GetRange();
+    if (range.GetRangeBase() > mapped_end)
+      break;
+    mapped_end = std::max(mapped_end, range.GetRangeEnd());
+    if (mapped_end - addr >= size)
+      return size;
+  }
+  return mapped_end - addr;
+}
+
 void NativeProcessLinux::DoStopIDBumped(uint32_t newBumpId) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   LLDB_LOG(log, "newBumpId={0}", newBumpId);
@@ -1624,33 +1653,127 @@ Status NativeProcessLinux::GetSoftwareBreakpointTrapOpcode(
 
 Status NativeProcessLinux::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                                       size_t &bytes_read) {
-  if (ProcessVmReadvSupported()) {
-    // The process_vm_readv path is about 50 times faster than ptrace api. We
-    // want to use this syscall if it is supported.
+  if (!ProcessVmReadvSupported())
+    return ReadMemoryWithPtrace(addr, buf, size, bytes_read);
 
-    const ::pid_t pid = GetID();
+  // The process_vm_readv path is about 50 times faster than ptrace api. We
+  // want to use this syscall if it is supported.
+  const ::pid_t pid = GetID();
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  unsigned char *dst = static_cast<unsigned char *>(buf);
 
-    struct iovec local_iov, remote_iov;
-    local_iov.iov_base = buf;
-    local_iov.iov_len = size;
-    remote_iov.iov_base = reinterpret_cast<void *>(addr);
-    remote_iov.iov_len = size;
+  bytes_read = 0;
+  while (bytes_read < size) {
+    const lldb::addr_t curr_addr = addr + bytes_read;
+    const size_t curr_size = size - bytes_read;
 
-    bytes_read = process_vm_readv(pid, &local_iov, 1, &remote_iov, 1, 0);
-    const bool success = bytes_read == size;
+    struct iovec local_iov, remote_iov;
+    local_iov.iov_base = dst + bytes_read;
+    local_iov.iov_len = curr_size;
+    remote_iov.iov_base = reinterpret_cast<void *>(curr_addr);
+    remote_iov.iov_len = curr_size;
 
-    Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+    const ssize_t res = process_vm_readv(pid, &local_iov, 1, &remote_iov, 1, 0);
     LLDB_LOG(log,
              "using process_vm_readv to read {0} bytes from inferior "
              "address {1:x}: {2}",
-             size, addr, success ? "Success" : llvm::sys::StrError(errno));
+             curr_size, curr_addr,
+             res == ssize_t(curr_size) ? "Success"
+                                       : llvm::sys::StrError(errno));
+    if (res > 0) {
+      bytes_read += res;
+      continue;
+    }
 
-    if (success)
-      return Status();
-    // else the call failed for some reason, let's retry the read using ptrace
-    // api.
+    // process_vm_readv stops at the first page it can't read. Only that page
+    // is retried with the much slower ptrace api, which can also read pages
+    // without read permission, and unmapped pages end the read.
+    const size_t page_bytes =
+        std::min<size_t>(curr_size, page_size - curr_addr % page_size);
+    if (GetMappedSize(curr_addr, page_bytes) == 0)
+      return Status("memory at address 0x%" PRIx64 " is not mapped",
+                    curr_addr);
+
+    size_t page_bytes_read = 0;
+    Status error = ReadMemoryWithPtrace(curr_addr, dst + bytes_read,
+                                        page_bytes, page_bytes_read);
+    bytes_read += page_bytes_read;
+    if (error.Fail())
+      return error;
+  }
+  return Status();
+}
+
+Status NativeProcessLinux::ReadMemoryRanges(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  if (!ProcessVmReadvSupported())
+    return NativeProcessProtocol::ReadMemoryRanges(ranges);
+
+  // process_vm_readv gives up at the first byte it fails to read, so leave
+  // out the memory that /proc/{pid}/maps says isn't mapped and read the rest
+  // of the ranges with as few calls as possible.
+  std::vector<struct iovec> local_iovs;
+  std::vector<struct iovec> remote_iovs;
+  std::vector<size_t> range_indexes;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    MemoryReadRange &range = ranges[i];
+    range.bytes_read = 0;
+    const size_t size = GetMappedSize(range.addr, range.size);
+    if (size == 0)
+      continue;
+
+    struct iovec local_iov, remote_iov;
+    local_iov.iov_base = range.buf;
+    local_iov.iov_len = size;
+    remote_iov.iov_base = reinterpret_cast<void *>(range.addr);
+    remote_iov.iov_len = size;
+    local_iovs.push_back(local_iov);
+    remote_iovs.push_back(remote_iov);
+    range_indexes.push_back(i);
   }
 
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+  LLDB_LOG(log, "reading {0} of {1} ranges with process_vm_readv",
+           remote_iovs.size(), ranges.size());
+
+  // The kernel rejects calls with more than UIO_MAXIOV (1024) iovecs.
+  const size_t max_iovecs = 1024;
+  const ::pid_t pid = GetID();
+  size_t next = 0;
+  while (next < remote_iovs.size()) {
+    const size_t count =
+        std::min<size_t>(remote_iovs.size() - next, max_iovecs);
+    const ssize_t res = process_vm_readv(pid, &local_iovs[next], count,
+                                         &remote_iovs[next], count, 0);
+
+    // The bytes read fill the ranges in order.
+    size_t remaining = res > 0 ? res : 0;
+    const size_t end = next + count;
+    for (; next < end && remaining >= remote_iovs[next].iov_len; ++next) {
+      ranges[range_indexes[next]].bytes_read = remote_iovs[next].iov_len;
+      remaining -= remote_iovs[next].iov_len;
+    }
+    if (next == end)
+      continue;
+
+    // The read stopped inside this range. Finish it on its own, page by page
+    // if needed, and resume the vectored reads with the next one.
+    MemoryReadRange &range = ranges[range_indexes[next]];
+    size_t rest_bytes_read = 0;
+    ReadMemory(range.addr + remaining,
+               static_cast<unsigned char *>(range.buf) + remaining,
+               remote_iovs[next].iov_len - remaining, rest_bytes_read);
+    range.bytes_read = remaining + rest_bytes_read;
+    ++next;
+  }
+
+  return Status();
+}
+
+Status NativeProcessLinux::ReadMemoryWithPtrace(lldb::addr_t addr, void *buf,
+                                                size_t size,
+                                                size_t &bytes_read) {
   unsigned char *dst = static_cast<unsigned char *>(buf);
   size_t remainder;
   long data;
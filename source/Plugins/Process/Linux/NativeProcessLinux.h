@@ -74,6 +74,9 @@ public:
   Status ReadMemoryWithoutTrap(lldb::addr_t addr, void *buf, size_t size,
                                size_t &bytes_read) override;
 
+  Status
+  ReadMemoryRanges(llvm::MutableArrayRef<MemoryReadRange> ranges) override;
+
   Status WriteMemory(lldb::addr_t addr, const void *buf, size_t size,
                      size_t &bytes_written) override;
 
@@ -229,6 +232,13 @@ private:
 
   Status PopulateMemoryRegionCache();
 
+  // Returns how many of the size bytes starting at addr are mapped in the
+  // process according to /proc/{pid}/maps, or size if that is unknown.
+  size_t GetMappedSize(lldb::addr_t addr, size_t size);
+
+  Status ReadMemoryWithPtrace(lldb::addr_t addr, void *buf, size_t size,
+                              size_t &bytes_read);
+
   lldb::user_id_t StartTraceGroup(const TraceOptions &config,
                                          Status &error);
 
@@ -0,0 +1,607 @@
+//===-- BreakpointConditionCompiler.cpp -------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BreakpointConditionCompiler.h"
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointOptions.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/ThreadSpec.h"
+#include "lldb/Utility/DataExtractor.h"
+
+#include <ctype.h>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::process_gdb_remote;
+
+bool BreakpointConditionCompiler::Compile(BreakpointLocation &bp_loc,
+                                          RegisterContext &reg_ctx,
+                                          AgentExpression &expr) {
+  const char *condition = bp_loc.GetConditionText();
+  if (condition == nullptr || condition[0] == '\0' ||
+      HasDebuggerOnlyOptions(bp_loc))
+    return false;
+
+  SymbolContext sc;
+  bp_loc.GetAddress().CalculateSymbolContext(&sc, eSymbolContextEverything);
+  return Compile(condition, bp_loc.GetBreakpoint().GetTarget(), reg_ctx, sc,
+                 expr);
+}
+
+bool BreakpointConditionCompiler::Compile(llvm::StringRef condition,
+                                          Target &target,
+                                          RegisterContext &reg_ctx,
+                                          const SymbolContext &sc,
+                                          AgentExpression &expr) {
+  AgentExpression condition_expr;
+  BreakpointConditionCompiler compiler(target, reg_ctx, sc, condition,
+                                       condition_expr);
+  if (!compiler.Compile())
+    return false;
+  expr = condition_expr;
+  return true;
+}
+
+bool BreakpointConditionCompiler::HasDebuggerOnlyOptions(
+    BreakpointLocation &bp_loc) {
+  // The stub only knows about the condition. The ignore counts and
+  // synchronous callbacks act on every hit, and the thread and precondition
+  // tests need the debugger.
+  if (bp_loc.GetIgnoreCount() != 0 ||
+      bp_loc.GetBreakpoint().GetIgnoreCount() != 0 ||
+      bp_loc.GetBreakpoint().GetPrecondition())
+    return true;
+  const BreakpointOptions *options =
+      bp_loc.GetOptionsSpecifyingKind(BreakpointOptions::eThreadSpec);
+  const ThreadSpec *thread_spec =
+      options ? options->GetThreadSpecNoCreate() : nullptr;
+  if (thread_spec && thread_spec->HasSpecification())
+    return true;
+  options = bp_loc.GetOptionsSpecifyingKind(BreakpointOptions::eCallback);
+  return options && options->HasCallback() && options->IsCallbackSynchronous();
+}
+
+bool BreakpointConditionCompiler::Compile() {
+  ValueKind kind;
+  if (!ParseLogicalOr(kind))
+    return false;
+  SkipSpaces();
+  if (!m_text.empty())
+    return false;
+  m_expr.Emit(AgentExpression::eOpEnd);
+  return true;
+}
+
+void BreakpointConditionCompiler::SkipSpaces() {
+  m_text = m_text.ltrim();
+}
+
+bool BreakpointConditionCompiler::Peek(llvm::StringRef token) {
+  SkipSpaces();
+  return m_text.startswith(token);
+}
+
+bool BreakpointConditionCompiler::Consume(llvm::StringRef token) {
+  if (!Peek(token))
+    return false;
+  m_text = m_text.drop_front(token.size());
+  return true;
+}
+
+llvm::StringRef BreakpointConditionCompiler::ConsumeWord() {
+  SkipSpaces();
+  size_t size = 0;
+  while (size < m_text.size() &&
+         (isalnum(static_cast<unsigned char>(m_text[size])) ||
+          m_text[size] == '_'))
+    ++size;
+  llvm::StringRef word = m_text.take_front(size);
+  m_text = m_text.drop_front(size);
+  return word;
+}
+
+void BreakpointConditionCompiler::EmitNormalize(ValueKind kind) {
+  if (kind.bits == 64)
+    return;
+  if (kind.is_signed)
+    m_expr.EmitExt(kind.bits);
+  else
+    m_expr.EmitZeroExt(kind.bits);
+}
+
+BreakpointConditionCompiler::ValueKind
+BreakpointConditionCompiler::EmitConversions(ValueKind lhs, ValueKind rhs) {
+  // The usual arithmetic conversions of C, with 32 bit ints and 64 bit longs
+  // and pointers: a long can hold any unsigned int.
+  ValueKind common;
+  if (lhs.bits == rhs.bits) {
+    common.bits = lhs.bits;
+    common.is_signed = lhs.is_signed && rhs.is_signed;
+  } else {
+    common = lhs.bits > rhs.bits ? lhs : rhs;
+  }
+  // Only an int converted to an unsigned int changes its representation.
+  if (common.bits == 32 && !common.is_signed) {
+    if (rhs.is_signed)
+      m_expr.EmitZeroExt(32);
+    if (lhs.is_signed) {
+      m_expr.Emit(AgentExpression::eOpSwap);
+      m_expr.EmitZeroExt(32);
+      m_expr.Emit(AgentExpression::eOpSwap);
+    }
+  }
+  return common;
+}
+
+bool BreakpointConditionCompiler::ParseLogicalOr(ValueKind &kind) {
+  if (!ParseLogicalAnd(kind))
+    return false;
+  while (Consume("||")) {
+    // Only evaluate the right hand side if the left hand side is false.
+    const size_t if_true = m_expr.EmitGoto(AgentExpression::eOpIfGoto);
+    if (!ParseLogicalAnd(kind))
+      return false;
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    const size_t to_end = m_expr.EmitGoto(AgentExpression::eOpGoto);
+    m_expr.SetGotoTarget(if_true, m_expr.GetSize());
+    m_expr.EmitConst(1);
+    m_expr.SetGotoTarget(to_end, m_expr.GetSize());
+    kind = {32, true};
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseLogicalAnd(ValueKind &kind) {
+  if (!ParseBitwise(kind, 0))
+    return false;
+  while (Consume("&&")) {
+    // Only evaluate the right hand side if the left hand side is true.
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    const size_t if_false = m_expr.EmitGoto(AgentExpression::eOpIfGoto);
+    if (!ParseBitwise(kind, 0))
+      return false;
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    const size_t to_end = m_expr.EmitGoto(AgentExpression::eOpGoto);
+    m_expr.SetGotoTarget(if_false, m_expr.GetSize());
+    m_expr.EmitConst(0);
+    m_expr.SetGotoTarget(to_end, m_expr.GetSize());
+    kind = {32, true};
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseBitwise(ValueKind &kind, int level) {
+  // The levels of '|', '^' and '&', from the lowest precedence.
+  static const char g_operators[] = {'|', '^', '&'};
+  static const AgentExpression::Opcode g_opcodes[] = {
+      AgentExpression::eOpBitOr, AgentExpression::eOpBitXor,
+      AgentExpression::eOpBitAnd};
+  if (level == 3)
+    return ParseEquality(kind);
+
+  if (!ParseBitwise(kind, level + 1))
+    return false;
+  const char op[] = {g_operators[level], '\0'};
+  const char logical_op[] = {g_operators[level], g_operators[level], '\0'};
+  while (!Peek(logical_op) && Consume(op)) {
+    ValueKind rhs;
+    if (!ParseBitwise(rhs, level + 1))
+      return false;
+    kind = EmitConversions(kind, rhs);
+    m_expr.Emit(g_opcodes[level]);
+    EmitNormalize(kind);
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseEquality(ValueKind &kind) {
+  if (!ParseRelational(kind))
+    return false;
+  while (true) {
+    bool negate;
+    if (Consume("=="))
+      negate = false;
+    else if (Consume("!="))
+      negate = true;
+    else
+      return true;
+    ValueKind rhs;
+    if (!ParseRelational(rhs))
+      return false;
+    EmitConversions(kind, rhs);
+    m_expr.Emit(AgentExpression::eOpEqual);
+    if (negate)
+      m_expr.Emit(AgentExpression::eOpLogNot);
+    kind = {32, true};
+  }
+}
+
+bool BreakpointConditionCompiler::ParseRelational(ValueKind &kind) {
+  if (!ParseAdditive(kind))
+    return false;
+  while (!Peek("<<") && !Peek(">>")) {
+    // a > b is b < a, and a <= b is !(b < a).
+    bool swap, negate;
+    if (Consume("<=")) {
+      swap = true;
+      negate = true;
+    } else if (Consume(">=")) {
+      swap = false;
+      negate = true;
+    } else if (Consume("<")) {
+      swap = false;
+      negate = false;
+    } else if (Consume(">")) {
+      swap = true;
+      negate = false;
+    } else {
+      return true;
+    }
+    ValueKind rhs;
+    if (!ParseAdditive(rhs))
+      return false;
+    const ValueKind common = EmitConversions(kind, rhs);
+    if (swap)
+      m_expr.Emit(AgentExpression::eOpSwap);
+    m_expr.Emit(common.is_signed ? AgentExpression::eOpLessSigned
+                                 : AgentExpression::eOpLessUnsigned);
+    if (negate)
+      m_expr.Emit(AgentExpression::eOpLogNot);
+    kind = {32, true};
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseAdditive(ValueKind &kind) {
+  if (!ParseMultiplicative(kind))
+    return false;
+  while (true) {
+    AgentExpression::Opcode opcode;
+    if (Consume("+"))
+      opcode = AgentExpression::eOpAdd;
+    else if (Consume("-"))
+      opcode = AgentExpression::eOpSub;
+    else
+      return true;
+    ValueKind rhs;
+    if (!ParseMultiplicative(rhs))
+      return false;
+    kind = EmitConversions(kind, rhs);
+    m_expr.Emit(opcode);
+    EmitNormalize(kind);
+  }
+}
+
+bool BreakpointConditionCompiler::ParseMultiplicative(ValueKind &kind) {
+  if (!ParseUnary(kind))
+    return false;
+  while (Consume("*")) {
+    ValueKind rhs;
+    if (!ParseUnary(rhs))
+      return false;
+    kind = EmitConversions(kind, rhs);
+    m_expr.Emit(AgentExpression::eOpMul);
+    EmitNormalize(kind);
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseUnary(ValueKind &kind) {
+  if (Consume("!")) {
+    if (!ParseUnary(kind))
+      return false;
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    kind = {32, true};
+    return true;
+  }
+  if (Consume("~")) {
+    if (!ParseUnary(kind))
+      return false;
+    m_expr.Emit(AgentExpression::eOpBitNot);
+    EmitNormalize(kind);
+    return true;
+  }
+  if (Consume("-")) {
+    if (!ParseUnary(kind))
+      return false;
+    m_expr.EmitConst(0);
+    m_expr.Emit(AgentExpression::eOpSwap);
+    m_expr.Emit(AgentExpression::eOpSub);
+    EmitNormalize(kind);
+    return true;
+  }
+  if (Consume("+"))
+    return ParseUnary(kind);
+  return ParsePrimary(kind);
+}
+
+bool BreakpointConditionCompiler::ParsePrimary(ValueKind &kind) {
+  if (Consume("(")) {
+    if (!ParseLogicalOr(kind))
+      return false;
+    return Consume(")");
+  }
+  if (Consume("$"))
+    return ParseRegister(kind);
+  SkipSpaces();
+  if (m_text.empty())
+    return false;
+  if (isdigit(static_cast<unsigned char>(m_text.front())))
+    return ParseNumber(kind);
+  return ParseVariable(kind);
+}
+
+bool BreakpointConditionCompiler::ParseNumber(ValueKind &kind) {
+  llvm::StringRef word = ConsumeWord();
+  // Find the type of the literal from its suffix, value and radix.
+  bool is_unsigned = false;
+  bool is_long = false;
+  while (!word.empty()) {
+    const char suffix = tolower(word.back());
+    if (suffix == 'u')
+      is_unsigned = true;
+    else if (suffix == 'l')
+      is_long = true;
+    else
+      break;
+    word = word.drop_back();
+  }
+  uint64_t value;
+  if (word.getAsInteger(0, value))
+    return false;
+  const bool is_decimal = word.size() == 1 || word.front() != '0';
+  if (!is_long && value <= INT32_MAX && !is_unsigned)
+    kind = {32, true};
+  else if (!is_long && value <= UINT32_MAX && (is_unsigned || !is_decimal))
+    kind = {32, false};
+  else if (value <= INT64_MAX && !is_unsigned)
+    kind = {64, true};
+  else
+    kind = {64, false};
+  m_expr.EmitConst(value);
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseRegister(ValueKind &kind) {
+  llvm::StringRef name = ConsumeWord();
+  if (name.empty())
+    return false;
+  const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoByName(name);
+  if (reg_info == nullptr || reg_info->byte_size > 8 ||
+      (reg_info->encoding != eEncodingUint &&
+       reg_info->encoding != eEncodingSint))
+    return false;
+  const uint32_t reg = reg_info->kinds[eRegisterKindProcessPlugin];
+  if (reg == LLDB_INVALID_REGNUM || reg > UINT16_MAX)
+    return false;
+  m_expr.EmitReg(reg);
+  // The stub zero extends the registers.
+  if (reg_info->byte_size < 4)
+    kind = {32, true};
+  else
+    kind = {reg_info->byte_size == 4 ? 32u : 64u, false};
+  return true;
+}
+
+bool BreakpointConditionCompiler::ParseVariable(ValueKind &kind) {
+  llvm::StringRef name = ConsumeWord();
+  if (name.empty())
+    return false;
+  if (name == "true" || name == "false") {
+    m_expr.EmitConst(name == "true");
+    kind = {32, true};
+    return true;
+  }
+  if (name == "nullptr") {
+    m_expr.EmitConst(0);
+    kind = {64, false};
+    return true;
+  }
+
+  // Look for the variable in the blocks around the breakpoint, up to the
+  // function it is in, then in its compile unit and the whole target.
+  ConstString const_name(name);
+  VariableSP var_sp;
+  for (Block *block = m_sc.block; block && !var_sp;) {
+    VariableListSP vars_sp = block->GetBlockVariableList(true);
+    if (vars_sp)
+      var_sp = vars_sp->FindVariable(const_name);
+    block = block->GetInlinedFunctionInfo() ? nullptr : block->GetParent();
+  }
+  if (!var_sp && m_sc.comp_unit) {
+    VariableListSP vars_sp = m_sc.comp_unit->GetVariableList(true);
+    if (vars_sp)
+      var_sp = vars_sp->FindVariable(const_name);
+  }
+  if (!var_sp) {
+    VariableList globals;
+    if (m_target.GetImages().FindGlobalVariables(const_name, 2, globals) != 1)
+      return false;
+    var_sp = globals.GetVariableAtIndex(0);
+  }
+  return var_sp && EmitVariable(*var_sp, kind);
+}
+
+bool BreakpointConditionCompiler::EmitVariable(Variable &var,
+                                               ValueKind &kind) {
+  Type *type = var.GetType();
+  if (type == nullptr)
+    return false;
+  CompilerType compiler_type = type->GetFullCompilerType();
+  bool is_signed = false;
+  if (!compiler_type.IsIntegerOrEnumerationType(is_signed) &&
+      !compiler_type.IsPointerType())
+    return false;
+  const uint64_t byte_size = compiler_type.GetByteSize(nullptr);
+  if (byte_size != 1 && byte_size != 2 && byte_size != 4 && byte_size != 8)
+    return false;
+
+  uint32_t reg = LLDB_INVALID_REGNUM;
+  if (!EmitVariableLocation(var, reg))
+    return false;
+  if (reg != LLDB_INVALID_REGNUM)
+    m_expr.EmitReg(reg);
+  else
+    m_expr.EmitRef(byte_size);
+  if (byte_size < 8) {
+    if (is_signed)
+      m_expr.EmitExt(byte_size * 8);
+    else if (reg != LLDB_INVALID_REGNUM)
+      m_expr.EmitZeroExt(byte_size * 8);
+  }
+
+  // The integer promotions make the narrower types ints.
+  if (byte_size < 4)
+    kind = {32, true};
+  else
+    kind = {static_cast<uint32_t>(byte_size * 8), is_signed};
+  return true;
+}
+
+bool BreakpointConditionCompiler::GetRegisterNumber(lldb::RegisterKind kind,
+                                                    uint32_t dwarf_reg,
+                                                    uint32_t &reg) {
+  const uint32_t lldb_reg =
+      m_reg_ctx.ConvertRegisterKindToRegisterNumber(kind, dwarf_reg);
+  if (lldb_reg == LLDB_INVALID_REGNUM)
+    return false;
+  const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(lldb_reg);
+  if (reg_info == nullptr || reg_info->byte_size > 8)
+    return false;
+  reg = reg_info->kinds[eRegisterKindProcessPlugin];
+  return reg != LLDB_INVALID_REGNUM && reg <= UINT16_MAX;
+}
+
+// Decode the location expressions made of a single operation which names a
+// register, or a register and an offset.
+static bool DecodeRegisterLocation(const DataExtractor &data, uint8_t &op,
+                                   uint32_t &dwarf_reg, int64_t &offset) {
+  lldb::offset_t data_offset = 0;
+  op = data.GetU8(&data_offset);
+  offset = 0;
+  if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+    dwarf_reg = op - DW_OP_reg0;
+    op = DW_OP_regx;
+  } else if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+    dwarf_reg = op - DW_OP_breg0;
+    offset = data.GetSLEB128(&data_offset);
+    op = DW_OP_bregx;
+  } else if (op == DW_OP_regx) {
+    dwarf_reg = data.GetULEB128(&data_offset);
+  } else if (op == DW_OP_bregx) {
+    dwarf_reg = data.GetULEB128(&data_offset);
+    offset = data.GetSLEB128(&data_offset);
+  } else if (op == DW_OP_fbreg) {
+    offset = data.GetSLEB128(&data_offset);
+  } else {
+    return false;
+  }
+  return data_offset == data.GetByteSize();
+}
+
+bool BreakpointConditionCompiler::EmitFrameBase() {
+  if (m_sc.function == nullptr)
+    return false;
+  DWARFExpression &frame_base = m_sc.function->GetFrameBaseExpression();
+  DataExtractor data;
+  if (frame_base.IsLocationList() || !frame_base.GetExpressionData(data))
+    return false;
+  uint8_t op;
+  uint32_t dwarf_reg, reg;
+  int64_t offset;
+  if (!DecodeRegisterLocation(data, op, dwarf_reg, offset) ||
+      (op != DW_OP_regx && op != DW_OP_bregx) ||
+      !GetRegisterNumber(
+          static_cast<lldb::RegisterKind>(frame_base.GetRegisterKind()),
+          dwarf_reg, reg))
+    return false;
+  m_expr.EmitReg(reg);
+  if (offset != 0) {
+    m_expr.EmitConst(offset);
+    m_expr.Emit(AgentExpression::eOpAdd);
+  }
+  return true;
+}
+
+bool BreakpointConditionCompiler::EmitVariableLocation(Variable &var,
+                                                       uint32_t &reg) {
+  DWARFExpression &location = var.LocationExpression();
+  DataExtractor data;
+  if (var.GetLocationIsConstantValueData() || location.IsLocationList() ||
+      !location.GetExpressionData(data) || data.GetByteSize() == 0)
+    return false;
+
+  // A global or static variable: its address is the load address of the
+  // file address in the expression.
+  lldb::offset_t data_offset = 0;
+  if (data.GetU8(&data_offset) == DW_OP_addr) {
+    const lldb::addr_t file_addr = data.GetAddress(&data_offset);
+    if (data_offset != data.GetByteSize())
+      return false;
+    SymbolContext var_sc;
+    var.CalculateSymbolContext(&var_sc);
+    Address so_addr;
+    if (!var_sc.module_sp ||
+        !var_sc.module_sp->ResolveFileAddress(file_addr, so_addr))
+      return false;
+    const lldb::addr_t load_addr = so_addr.GetLoadAddress(&m_target);
+    if (load_addr == LLDB_INVALID_ADDRESS)
+      return false;
+    m_expr.EmitConst(load_addr);
+    return true;
+  }
+
+  uint8_t op;
+  uint32_t dwarf_reg;
+  int64_t offset;
+  if (!DecodeRegisterLocation(data, op, dwarf_reg, offset))
+    return false;
+  const lldb::RegisterKind reg_kind =
+      static_cast<lldb::RegisterKind>(location.GetRegisterKind());
+  switch (op) {
+  case DW_OP_regx:
+    return GetRegisterNumber(reg_kind, dwarf_reg, reg);
+  case DW_OP_bregx:
+    if (!GetRegisterNumber(reg_kind, dwarf_reg, reg))
+      return false;
+    m_expr.EmitReg(reg);
+    reg = LLDB_INVALID_REGNUM;
+    break;
+  case DW_OP_fbreg:
+    if (!EmitFrameBase())
+      return false;
+    break;
+  default:
+    return false;
+  }
+  if (offset != 0) {
+    m_expr.EmitConst(offset);
+    m_expr.Emit(AgentExpression::eOpAdd);
+  }
+  return true;
+}
@@ -0,0 +1,125 @@
+//===-- BreakpointConditionCompiler.h ---------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_BreakpointConditionCompiler_h_
+#define liblldb_BreakpointConditionCompiler_h_
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+#include "llvm/ADT/StringRef.h"
+
+// Project includes
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+namespace process_gdb_remote {
+
+//----------------------------------------------------------------------
+/// @class BreakpointConditionCompiler BreakpointConditionCompiler.h
+/// Compiles the conditions of breakpoint locations to the agent expressions
+/// a stub tests before reporting a stop, so the stops at breakpoints whose
+/// conditions are false don't make a round trip to the debugger.
+///
+/// Only the conditions made of integer literals, registers ($rax) and
+/// integer or pointer variables whose location is a register or memory at a
+/// fixed address or relative to a register are compiled, combined with the
+/// C arithmetic, bitwise, comparison and logical operators. The other
+/// conditions are tested by the debugger, which then sees every stop.
+//----------------------------------------------------------------------
+class BreakpointConditionCompiler {
+public:
+  //------------------------------------------------------------------
+  /// Compile the condition of \a bp_loc to \a expr, reading registers the
+  /// way \a reg_ctx names and numbers them. Returns false if the location
+  /// has no condition, can't be compiled, or has other options deciding
+  /// whether it stops, like an ignore count or a thread, which the stub
+  /// doesn't know about.
+  //------------------------------------------------------------------
+  static bool Compile(BreakpointLocation &bp_loc, RegisterContext &reg_ctx,
+                      AgentExpression &expr);
+
+  //------------------------------------------------------------------
+  /// Compile \a condition, whose names are looked up from \a sc and in
+  /// the modules of \a target, to \a expr. Returns false if it can't be
+  /// compiled.
+  //------------------------------------------------------------------
+  static bool Compile(llvm::StringRef condition, Target &target,
+                      RegisterContext &reg_ctx, const SymbolContext &sc,
+                      AgentExpression &expr);
+
+  //------------------------------------------------------------------
+  /// Returns true if \a bp_loc has options only the debugger can act on,
+  /// so the stub has to report each of its stops.
+  //------------------------------------------------------------------
+  static bool HasDebuggerOnlyOptions(BreakpointLocation &bp_loc);
+
+private:
+  // How C sees the value on top of the stack. Values narrower than 64 bits
+  // are kept sign or zero extended to 64 bits.
+  struct ValueKind {
+    uint32_t bits;
+    bool is_signed;
+  };
+
+  BreakpointConditionCompiler(Target &target, RegisterContext &reg_ctx,
+                              const SymbolContext &sc, llvm::StringRef text,
+                              AgentExpression &expr)
+      : m_target(target), m_reg_ctx(reg_ctx), m_sc(sc), m_text(text),
+        m_expr(expr) {}
+
+  bool Compile();
+
+  // The recursive descent parser, one function per precedence level, which
+  // emits the code of what it parsed and returns its kind.
+  bool ParseLogicalOr(ValueKind &kind);
+  bool ParseLogicalAnd(ValueKind &kind);
+  bool ParseBitwise(ValueKind &kind, int level);
+  bool ParseEquality(ValueKind &kind);
+  bool ParseRelational(ValueKind &kind);
+  bool ParseAdditive(ValueKind &kind);
+  bool ParseMultiplicative(ValueKind &kind);
+  bool ParseUnary(ValueKind &kind);
+  bool ParsePrimary(ValueKind &kind);
+  bool ParseNumber(ValueKind &kind);
+  bool ParseRegister(ValueKind &kind);
+  bool ParseVariable(ValueKind &kind);
+
+  // Emit the code pushing the value of 'var'.
+  bool EmitVariable(Variable &var, ValueKind &kind);
+  // Emit the code pushing the address of the value of 'var' or, if it lives
+  // in a register, the number of the register in 'reg'.
+  bool EmitVariableLocation(Variable &var, uint32_t &reg);
+  bool EmitFrameBase();
+  bool GetRegisterNumber(lldb::RegisterKind kind, uint32_t dwarf_reg,
+                         uint32_t &reg);
+
+  // Combine the two values on top of the stack, of kinds 'lhs' and 'rhs',
+  // converting them to their common type first.
+  ValueKind EmitConversions(ValueKind lhs, ValueKind rhs);
+  void EmitNormalize(ValueKind kind);
+
+  void SkipSpaces();
+  bool Peek(llvm::StringRef token);
+  bool Consume(llvm::StringRef token);
+  llvm::StringRef ConsumeWord();
+
+  Target &m_target;
+  RegisterContext &m_reg_ctx;
+  const SymbolContext &m_sc;
+  llvm::StringRef m_text;
+  AgentExpression &m_expr;
+};
+
+} // namespace process_gdb_remote
+} // namespace lldb_private
+
+#endif // liblldb_BreakpointConditionCompiler_h_
@@ -17,6 +17,7 @@
 // C++ Includes
 // Other libraries and framework includes
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Host/Config.h"
 #include "lldb/Host/ConnectionFileDescriptor.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
@@ -27,6 +28,7 @@
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/HexCodec.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/StreamString.h"
@@ -50,6 +52,10 @@
 #include <zlib.h>
 #endif
 
+#if defined(HAVE_LIBLZ4)
+#include <lz4.h>
+#endif
+
 using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::process_gdb_remote;
@@ -139,7 +145,8 @@ GDBRemoteCommunication::GDBRemoteCommunication(const char *comm_name,
 #endif
       m_echo_number(0), m_supports_qEcho(eLazyBoolCalculate), m_history(512),
       m_send_acks(true), m_compression_type(CompressionType::None),
-      m_listen_url() {
+      m_send_compression_type(CompressionType::None),
+      m_send_compression_minsize(384), m_listen_url() {
 }
 
 //----------------------------------------------------------------------
@@ -190,6 +197,12 @@ size_t GDBRemoteCommunication::SendNack() {
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunication::SendPacketNoLock(llvm::StringRef payload) {
   if (IsConnected()) {
+    std::string compressed_payload;
+    if (m_send_compression_type != CompressionType::None) {
+      CompressPayload(payload, compressed_payload);
+      payload = compressed_payload;
+    }
+
     StreamString packet(0, 4, eByteOrderBig);
 
     packet.PutChar('$');
@@ -476,6 +489,95 @@ GDBRemoteCommunication::WaitForPacketNoLock(StringExtractorGDBRemote &packet,
     return PacketResult::ErrorReplyFailed;
 }
 
+// Compress 'src' into 'dst' with 'type', returns false if this side can't
+// compress with it or the compression failed.
+static bool CompressBuffer(CompressionType type, llvm::StringRef src,
+                           std::vector<uint8_t> &dst) {
+#if defined(HAVE_LIBZ)
+  if (type == CompressionType::ZlibDeflate) {
+    // Raw deflate data, without the zlib header, like debugserver sends.
+    z_stream stream;
+    memset(&stream, 0, sizeof(z_stream));
+    if (deflateInit2(&stream, 5, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) !=
+        Z_OK)
+      return false;
+    dst.resize(deflateBound(&stream, src.size()));
+    stream.next_in = (Bytef *)src.data();
+    stream.avail_in = (uInt)src.size();
+    stream.next_out = (Bytef *)dst.data();
+    stream.avail_out = (uInt)dst.size();
+    int status = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END)
+      return false;
+    dst.resize(stream.total_out);
+    return true;
+  }
+#endif
+
+#if defined(HAVE_LIBLZ4)
+  if (type == CompressionType::LZ4) {
+    // LZ4 blocks, which libcompression calls COMPRESSION_LZ4_RAW.
+    dst.resize(LZ4_compressBound(src.size()));
+    int size = LZ4_compress_default(src.data(), (char *)dst.data(),
+                                    src.size(), dst.size());
+    if (size <= 0)
+      return false;
+    dst.resize(size);
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+std::string GDBRemoteCommunication::GetSupportedCompressions() {
+  std::string names;
+#if defined(HAVE_LIBZ)
+  names += "zlib-deflate,";
+#endif
+#if defined(HAVE_LIBLZ4)
+  names += "lz4,";
+#endif
+  if (!names.empty())
+    names.pop_back();
+  return names;
+}
+
+CompressionType
+GDBRemoteCommunication::GetSupportedCompressionType(llvm::StringRef name) {
+#if defined(HAVE_LIBZ)
+  if (name == "zlib-deflate")
+    return CompressionType::ZlibDeflate;
+#endif
+#if defined(HAVE_LIBLZ4)
+  if (name == "lz4")
+    return CompressionType::LZ4;
+#endif
+  return CompressionType::None;
+}
+
+void GDBRemoteCommunication::CompressPayload(llvm::StringRef payload,
+                                             std::string &packet) {
+  std::vector<uint8_t> compressed;
+  if (payload.size() > m_send_compression_minsize &&
+      CompressBuffer(m_send_compression_type, payload, compressed)) {
+    char header[32];
+    const int header_len =
+        ::snprintf(header, sizeof(header), "C%zu:", payload.size());
+    packet.resize(header_len + 2 * compressed.size());
+    memcpy(&packet[0], header, header_len);
+    packet.resize(header_len +
+                  HexCodec::Escape(compressed, &packet[header_len]));
+    // Escaping can make random looking data grow past the payload.
+    if (packet.size() < payload.size())
+      return;
+  }
+
+  packet.assign("N");
+  packet.append(payload.data(), payload.size());
+}
+
 bool GDBRemoteCommunication::DecompressPacket() {
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PACKETS));
 
@@ -580,18 +682,11 @@ bool GDBRemoteCommunication::DecompressPacket() {
 
   // Reverse the gdb-remote binary escaping that was done to the compressed
   // text to guard characters like '$', '#', '}', etc.
-  std::vector<uint8_t> unescaped_content;
-  unescaped_content.reserve(content_length);
-  size_t i = content_start;
-  while (i < hash_mark_idx) {
-    if (m_bytes[i] == '}') {
-      i++;
-      unescaped_content.push_back(m_bytes[i] ^ 0x20);
-    } else {
-      unescaped_content.push_back(m_bytes[i]);
-    }
-    i++;
-  }
+  llvm::StringRef escaped_content =
+      llvm::StringRef(m_bytes).substr(content_start, content_length);
+  std::vector<uint8_t> unescaped_content(escaped_content.size());
+  unescaped_content.resize(
+      HexCodec::Unescape(escaped_content, unescaped_content.data()));
 
   uint8_t *decompressed_buffer = nullptr;
   size_t decompressed_bytes = 0;
@@ -660,6 +755,19 @@ bool GDBRemoteCommunication::DecompressPacket() {
   }
 #endif
 
+#if defined(HAVE_LIBLZ4)
+  if (decompressed_bytes == 0 && decompressed_bufsize != ULONG_MAX &&
+      decompressed_buffer != nullptr &&
+      m_compression_type == CompressionType::LZ4) {
+    int size = LZ4_decompress_safe((const char *)unescaped_content.data(),
+                                   (char *)decompressed_buffer,
+                                   (int)unescaped_content.size(),
+                                   (int)decompressed_bufsize);
+    if (size > 0)
+      decompressed_bytes = size;
+  }
+#endif
+
   if (decompressed_bytes == 0 || decompressed_buffer == nullptr) {
     if (decompressed_buffer)
       free(decompressed_buffer);
@@ -227,8 +227,28 @@ protected:
 
   CompressionType m_compression_type;
 
+  // The compression of the packets we send, which a server turns on when the
+  // client asks for it with QEnableCompression, and the size above which a
+  // packet is worth compressing.
+  CompressionType m_send_compression_type;
+  size_t m_send_compression_minsize;
+
   PacketResult SendPacketNoLock(llvm::StringRef payload);
 
+  // The names of the compressions this side can send packets with, separated
+  // by commas as in the SupportedCompressions feature of qSupported.
+  static std::string GetSupportedCompressions();
+
+  // Returns the compression called 'name' if packets can be sent with it, or
+  // CompressionType::None.
+  static CompressionType GetSupportedCompressionType(llvm::StringRef name);
+
+  // Put into 'packet' the contents of a packet sending 'payload' with
+  // m_send_compression_type: 'C', the size of the payload and ':' followed by
+  // the escaped compressed payload, or 'N' followed by the payload when it is
+  // too small or doesn't compress.
+  void CompressPayload(llvm::StringRef payload, std::string &packet);
+
   PacketResult ReadPacket(StringExtractorGDBRemote &response,
                           Timeout<std::micro> timeout, bool sync_on_timeout);
 
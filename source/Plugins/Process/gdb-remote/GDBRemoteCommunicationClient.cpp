@@ -88,6 +88,8 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_conditional_breakpoints(eLazyBoolCalculate),
+      m_supports_tracepoints(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -97,6 +99,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_QEnvironmentHexEncoded(true), m_supports_qSymbol(true),
       m_qSymbol_requests_done(false), m_supports_qModuleInfo(true),
       m_supports_jThreadsInfo(true), m_supports_jModulesInfo(true),
+      m_supports_jMultiMemRead(true),
       m_curr_pid(LLDB_INVALID_PROCESS_ID), m_curr_tid(LLDB_INVALID_THREAD_ID),
       m_curr_tid_run(LLDB_INVALID_THREAD_ID),
       m_num_supported_hardware_watchpoints(0), m_host_arch(), m_process_arch(),
@@ -159,6 +162,20 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported() {
+  if (m_supports_conditional_breakpoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_conditional_breakpoints == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetTracepointsSupported() {
+  if (m_supports_tracepoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_tracepoints == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -334,6 +351,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supported_async_json_packets_is_valid = false;
     m_supported_async_json_packets_sp.reset();
     m_supports_jModulesInfo = true;
+    m_supports_jMultiMemRead = true;
   }
 
   // These flags should be reset when we first connect to a GDB server and when
@@ -390,44 +408,41 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     // Look for a list of compressions in the features list e.g.
     // qXfer:features:read+;PacketSize=20000;qEcho+;SupportedCompressions=zlib-
     // deflate,lzma
-    const char *features_list = ::strstr(response_cstr, "qXfer:features:");
-    if (features_list) {
-      const char *compressions =
-          ::strstr(features_list, "SupportedCompressions=");
-      if (compressions) {
-        std::vector<std::string> supported_compressions;
-        compressions += sizeof("SupportedCompressions=") - 1;
-        const char *end_of_compressions = strchr(compressions, ';');
-        if (end_of_compressions == NULL) {
-          end_of_compressions = strchr(compressions, '\0');
+    const char *compressions =
+        ::strstr(response_cstr, "SupportedCompressions=");
+    if (compressions) {
+      std::vector<std::string> supported_compressions;
+      compressions += sizeof("SupportedCompressions=") - 1;
+      const char *end_of_compressions = strchr(compressions, ';');
+      if (end_of_compressions == NULL) {
+        end_of_compressions = strchr(compressions, '\0');
+      }
+      const char *current_compression = compressions;
+      while (current_compression < end_of_compressions) {
+        const char *next_compression_name = strchr(current_compression, ',');
+        const char *end_of_this_word = next_compression_name;
+        if (next_compression_name == NULL ||
+            end_of_compressions < next_compression_name) {
+          end_of_this_word = end_of_compressions;
         }
-        const char *current_compression = compressions;
-        while (current_compression < end_of_compressions) {
-          const char *next_compression_name = strchr(current_compression, ',');
-          const char *end_of_this_word = next_compression_name;
-          if (next_compression_name == NULL ||
-              end_of_compressions < next_compression_name) {
-            end_of_this_word = end_of_compressions;
-          }
 
-          if (end_of_this_word) {
-            if (end_of_this_word == current_compression) {
-              current_compression++;
-            } else {
-              std::string this_compression(
-                  current_compression, end_of_this_word - current_compression);
-              supported_compressions.push_back(this_compression);
-              current_compression = end_of_this_word + 1;
-            }
+        if (end_of_this_word) {
+          if (end_of_this_word == current_compression) {
+            current_compression++;
           } else {
-            supported_compressions.push_back(current_compression);
-            current_compression = end_of_compressions;
+            std::string this_compression(
+                current_compression, end_of_this_word - current_compression);
+            supported_compressions.push_back(this_compression);
+            current_compression = end_of_this_word + 1;
           }
+        } else {
+          supported_compressions.push_back(current_compression);
+          current_compression = end_of_compressions;
         }
+      }
 
-        if (supported_compressions.size() > 0) {
-          MaybeEnableCompression(supported_compressions);
-        }
+      if (supported_compressions.size() > 0) {
+        MaybeEnableCompression(supported_compressions);
       }
     }
 
@@ -441,6 +456,16 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "ConditionalBreakpoints+"))
+      m_supports_conditional_breakpoints = eLazyBoolYes;
+    else
+      m_supports_conditional_breakpoints = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "Tracepoints+"))
+      m_supports_tracepoints = eLazyBoolYes;
+    else
+      m_supports_tracepoints = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -1064,7 +1089,7 @@ void GDBRemoteCommunicationClient::MaybeEnableCompression(
   }
 #endif
 
-#if defined(HAVE_LIBCOMPRESSION)
+#if defined(HAVE_LIBCOMPRESSION) || defined(HAVE_LIBLZ4)
   if (avail_type == CompressionType::None) {
     for (auto compression : supported_compressions) {
       if (compression == "lz4") {
@@ -2653,29 +2678,42 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 }
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
-    GDBStoppointType type, bool insert, addr_t addr, uint32_t length) {
+    GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
+    llvm::ArrayRef<AgentExpression> conditions,
+    llvm::ArrayRef<TracepointCollect> collects) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
   if (log)
-    log->Printf("GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
-                __FUNCTION__, insert ? "add" : "remove", addr);
+    log->Printf("GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64
+                " with %zu conditions and %zu collected items",
+                __FUNCTION__, insert ? "add" : "remove", addr,
+                conditions.size(), collects.size());
 
   // Check if the stub is known not to support this breakpoint type
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
-  // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  // Construct the breakpoint packet, followed by the bytecode of the
+  // conditions the stub tests before reporting a stop and what it records
+  // instead if it is a tracepoint.
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr,
+                length);
+  for (const AgentExpression &condition : conditions) {
+    packet.Printf(";X%zx,", condition.GetSize());
+    packet.PutBytesAsRawHex8(condition.GetBytes().data(), condition.GetSize());
+  }
+  for (const TracepointCollect &collect : collects) {
+    if (collect.kind == TracepointCollect::eRegister)
+      packet.Printf(";R%x,%x", collect.reg, collect.size);
+    else
+      packet.Printf(";M%x,%" PRIx64 ",%x", collect.reg,
+                    static_cast<uint64_t>(collect.offset), collect.size);
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, true) ==
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
       PacketResult::Success) {
     // Receive and OK packet when the breakpoint successfully placed
     if (response.IsOKResponse())
@@ -2713,6 +2751,49 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   return UINT8_MAX;
 }
 
+Status GDBRemoteCommunicationClient::ReadTracepointBuffer(
+    std::vector<TracepointBuffer::Entry> &entries, uint64_t &num_dropped) {
+  num_dropped = 0;
+  if (!GetTracepointsSupported())
+    return Status("the remote stub doesn't support tracepoints");
+
+  // Each response holds the oldest entries up to a size, ask for more until
+  // one has none.
+  while (true) {
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse("qTracepointBuffer", response, false) !=
+        PacketResult::Success)
+      return Status("failed to send qTracepointBuffer packet");
+    if (response.IsErrorResponse())
+      return response.GetStatus();
+
+    num_dropped += response.GetHexMaxU64(false, 0);
+    if (response.GetChar() != ';')
+      return Status("invalid qTracepointBuffer response");
+    size_t num_entries = 0;
+    while (response.GetBytesLeft() > 0) {
+      TracepointBuffer::Entry entry;
+      entry.addr = response.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+      if (response.GetChar() != ',')
+        return Status("invalid qTracepointBuffer response");
+      entry.tid = response.GetHexMaxU64(false, LLDB_INVALID_THREAD_ID);
+      if (response.GetChar() != ',')
+        return Status("invalid qTracepointBuffer response");
+      llvm::StringRef hex = response.GetStringRef().substr(
+          response.GetFilePos());
+      hex = hex.take_until([](char c) { return c == ';'; });
+      entry.data.resize(hex.size() / 2);
+      if (response.GetHexBytes(entry.data, 0) != entry.data.size() ||
+          response.GetChar() != ';')
+        return Status("invalid qTracepointBuffer response");
+      entries.push_back(std::move(entry));
+      ++num_entries;
+    }
+    if (num_entries == 0)
+      return Status();
+  }
+}
+
 size_t GDBRemoteCommunicationClient::GetCurrentThreadIDs(
     std::vector<lldb::tid_t> &thread_ids, bool &sequence_mutex_unavailable) {
   thread_ids.clear();
@@ -3659,6 +3740,68 @@ GDBRemoteCommunicationClient::GetModulesInfo(
   return result;
 }
 
+llvm::Optional<std::vector<size_t>>
+GDBRemoteCommunicationClient::ReadMemoryRanges(
+    llvm::ArrayRef<Process::MemoryRange> ranges,
+    llvm::MutableArrayRef<uint8_t> buffer) {
+  if (!m_supports_jMultiMemRead)
+    return llvm::None;
+
+  JSONArray::SP range_array_sp = std::make_shared<JSONArray>();
+  for (const Process::MemoryRange &range : ranges) {
+    JSONObject::SP range_sp = std::make_shared<JSONObject>();
+    range_array_sp->AppendObject(range_sp);
+    range_sp->SetObject("address",
+                        std::make_shared<JSONNumber>(range.GetRangeBase()));
+    range_sp->SetObject("length", std::make_shared<JSONNumber>(
+                                      uint64_t(range.GetByteSize())));
+  }
+  StreamString unescaped_payload;
+  unescaped_payload.PutCString("jMultiMemRead:");
+  range_array_sp->Write(unescaped_payload);
+  StreamGDBRemote payload;
+  payload.PutEscapedBytes(unescaped_payload.GetString().data(),
+                          unescaped_payload.GetSize());
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(payload.GetString(), response, true) !=
+          PacketResult::Success ||
+      response.IsErrorResponse())
+    return llvm::None;
+
+  if (response.IsUnsupportedResponse()) {
+    m_supports_jMultiMemRead = false;
+    return llvm::None;
+  }
+
+  // The response is the comma separated list of the number of bytes read for
+  // each range, followed by a semicolon and the bytes themselves. The lower
+  // level packet receive layer has already removed the binary escaping.
+  std::vector<size_t> bytes_read;
+  size_t total_bytes_read = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (i > 0 && response.GetChar() != ',')
+      return llvm::None;
+    uint64_t count = response.GetHexMaxU64(false, UINT64_MAX);
+    if (count > ranges[i].GetByteSize())
+      return llvm::None;
+    bytes_read.push_back(count);
+    total_bytes_read += count;
+  }
+  if (response.GetChar() != ';' || response.GetBytesLeft() != total_bytes_read)
+    return llvm::None;
+
+  llvm::StringRef data =
+      response.GetStringRef().substr(response.GetFilePos());
+  uint8_t *dst = buffer.data();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    memcpy(dst, data.data(), bytes_read[i]);
+    data = data.drop_front(bytes_read[i]);
+    dst += ranges[i].GetByteSize();
+  }
+  return bytes_read;
+}
+
 // query the target remote for extended information using the qXfer packet
 //
 // example: object='features', annex='target.xml', out=<xml output> return:
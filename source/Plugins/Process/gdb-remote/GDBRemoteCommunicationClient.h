@@ -21,6 +21,8 @@
 #include <vector>
 
 #include "lldb/Target/Process.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/TracepointBuffer.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/StreamGDBRemote.h"
 #include "lldb/Utility/StructuredData.h"
@@ -318,7 +320,9 @@ public:
       GDBStoppointType type, // Type of breakpoint or watchpoint
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
-      uint32_t length);      // Byte Size of breakpoint or watchpoint
+      uint32_t length,       // Byte Size of breakpoint or watchpoint
+      llvm::ArrayRef<AgentExpression> conditions = {}, // Stop if one is true
+      llvm::ArrayRef<TracepointCollect> collects = {}); // Record, don't stop
 
   bool SetNonStopMode(const bool enable);
 
@@ -351,6 +355,18 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetConditionalBreakpointsSupported();
+
+  bool GetTracepointsSupported();
+
+  //------------------------------------------------------------------
+  /// Move all the hits the stub recorded at tracepoints to \a entries,
+  /// oldest first, and return how many it dropped because its buffer was
+  /// full in \a num_dropped.
+  //------------------------------------------------------------------
+  Status ReadTracepointBuffer(std::vector<TracepointBuffer::Entry> &entries,
+                              uint64_t &num_dropped);
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -449,6 +465,16 @@ public:
   GetModulesInfo(llvm::ArrayRef<FileSpec> module_file_specs,
                  const llvm::Triple &triple);
 
+  bool GetMultiMemReadSupported() const { return m_supports_jMultiMemRead; }
+
+  // Reads all the given memory ranges with a single jMultiMemRead packet.
+  // The bytes of the ranges are stored one after the other in buffer. Returns
+  // the number of bytes read for each range, or None if the server doesn't
+  // support the packet or the read failed.
+  llvm::Optional<std::vector<size_t>>
+  ReadMemoryRanges(llvm::ArrayRef<Process::MemoryRange> ranges,
+                   llvm::MutableArrayRef<uint8_t> buffer);
+
   bool ReadExtFeature(const lldb_private::ConstString object,
                       const lldb_private::ConstString annex, std::string &out,
                       lldb_private::Status &err);
@@ -552,6 +578,8 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_conditional_breakpoints;
+  LazyBool m_supports_tracepoints;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
@@ -561,7 +589,7 @@ protected:
       m_supports_QEnvironment : 1, m_supports_QEnvironmentHexEncoded : 1,
       m_supports_qSymbol : 1, m_qSymbol_requests_done : 1,
       m_supports_qModuleInfo : 1, m_supports_jThreadsInfo : 1,
-      m_supports_jModulesInfo : 1;
+      m_supports_jModulesInfo : 1, m_supports_jMultiMemRead : 1;
 
   lldb::pid_t m_curr_pid;
   lldb::tid_t m_curr_tid; // Current gdb remote protocol thread index for all
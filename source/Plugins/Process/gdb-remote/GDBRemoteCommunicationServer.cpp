@@ -33,6 +33,10 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(
       StringExtractorGDBRemote::eServerPacketType_QEnableErrorStrings,
       [this](StringExtractorGDBRemote packet, Status &error, bool &interrupt,
              bool &quit) { return this->Handle_QErrorStringEnable(packet); });
+  RegisterPacketHandler(
+      StringExtractorGDBRemote::eServerPacketType_QEnableCompression,
+      [this](StringExtractorGDBRemote packet, Status &error, bool &interrupt,
+             bool &quit) { return this->Handle_QEnableCompression(packet); });
 }
 
 GDBRemoteCommunicationServer::~GDBRemoteCommunicationServer() {}
@@ -123,6 +127,35 @@ GDBRemoteCommunicationServer::Handle_QErrorStringEnable(
   return SendOKResponse();
 }
 
+// QEnableCompression:type:<COMPRESSION-TYPE>;[minsize:<MINIMUM PACKET SIZE TO
+// COMPRESS>;]
+//
+// The type must be one of the SupportedCompressions listed in the reply to
+// qSupported, and minsize defaults to its DefaultCompressionMinSize.
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_QEnableCompression(
+    StringExtractorGDBRemote &packet) {
+  packet.SetFilePos(::strlen("QEnableCompression:"));
+  CompressionType type = CompressionType::None;
+  size_t minsize = m_send_compression_minsize;
+  llvm::StringRef name;
+  llvm::StringRef value;
+  while (packet.GetNameColonValue(name, value)) {
+    if (name == "type")
+      type = GetSupportedCompressionType(value);
+    else if (name == "minsize" && value.getAsInteger(10, minsize))
+      return SendIllFormedResponse(packet, "Invalid minsize");
+  }
+  if (type == CompressionType::None)
+    return SendErrorResponse(0x88);
+
+  // The client expects the packets following this reply to be compressed.
+  PacketResult result = SendOKResponse();
+  m_send_compression_type = type;
+  m_send_compression_minsize = minsize;
+  return result;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServer::SendIllFormedResponse(
     const StringExtractorGDBRemote &failed_packet, const char *message) {
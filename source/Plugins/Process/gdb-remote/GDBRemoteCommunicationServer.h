@@ -62,6 +62,8 @@ protected:
 
   PacketResult Handle_QErrorStringEnable(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_QEnableCompression(StringExtractorGDBRemote &packet);
+
   PacketResult SendErrorResponse(const Status &error);
 
   PacketResult SendUnimplementedResponse(const char *packet);
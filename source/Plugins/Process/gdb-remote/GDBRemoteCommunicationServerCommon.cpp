@@ -837,6 +837,13 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   response.PutCString(";QPassSignals+");
   response.PutCString(";qXfer:auxv:read+");
 #endif
+  AppendSupportedFeatures(response);
+
+  const std::string compressions = GetSupportedCompressions();
+  if (!compressions.empty())
+    response.Printf(
+        ";SupportedCompressions=%s;DefaultCompressionMinSize=%" PRIu64,
+        compressions.c_str(), (uint64_t)m_send_compression_minsize);
 
   return SendPacketNoLock(response.GetString());
 }
@@ -1267,6 +1274,9 @@ FileSpec GDBRemoteCommunicationServerCommon::FindModuleFile(
 #endif
 }
 
+void GDBRemoteCommunicationServerCommon::AppendSupportedFeatures(
+    Stream &response) {}
+
 ModuleSpec
 GDBRemoteCommunicationServerCommon::GetModuleInfo(llvm::StringRef module_path,
                                                   llvm::StringRef triple) {
@@ -152,6 +152,10 @@ protected:
   virtual FileSpec FindModuleFile(const std::string &module_path,
                                   const ArchSpec &arch);
 
+  // Append the qSupported features, each starting with a ';', which only
+  // this kind of server implements.
+  virtual void AppendSupportedFeatures(Stream &response);
+
 private:
   ModuleSpec GetModuleInfo(llvm::StringRef module_path, llvm::StringRef triple);
 };
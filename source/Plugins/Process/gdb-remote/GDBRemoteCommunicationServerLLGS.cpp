@@ -16,6 +16,7 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <thread>
@@ -35,6 +36,7 @@
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Endian.h"
 #include "lldb/Utility/JSON.h"
 #include "lldb/Utility/LLDBAssert.h"
@@ -70,6 +72,16 @@ enum GDBRemoteServerError {
 };
 }
 
+// The most bytes a tracepoint records of a register or memory range, and
+// the most bytes of tracepoint data a qTracepointBuffer response holds, which
+// its hex encoding keeps well under the packet size.
+static const uint32_t g_max_tracepoint_collect_size = 4096;
+static const size_t g_max_tracepoint_response_size = 32 * 1024;
+
+// The most bytes a jMultiMemRead packet reads in all, the packet size
+// advertised by qSupported, which clients keep their requests under.
+static const uint64_t g_max_multi_mem_read_size = 128 * 1024;
+
 //----------------------------------------------------------------------
 // GDBRemoteCommunicationServerLLGS constructor
 //----------------------------------------------------------------------
@@ -149,9 +161,15 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_jThreadsInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_jMultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_jMultiMemRead);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qWatchpointSupportInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qTracepointBuffer,
+      &GDBRemoteCommunicationServerLLGS::Handle_qTracepointBuffer);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qXfer_auxv_read,
       &GDBRemoteCommunicationServerLLGS::Handle_qXfer_auxv_read);
@@ -825,7 +843,11 @@ void GDBRemoteCommunicationServerLLGS::HandleInferiorState_Stopped(
   case eStateAttaching:
     // Don't send anything per debugserver behavior.
     break;
-  default:
+  default: {
+    // Don't report the stops at breakpoints whose conditions are false, or
+    // at tracepoints.
+    if (ResumeAtSilentBreakpoint(*process))
+      break;
     // In all other cases, send the stop reason.
     PacketResult result = SendStopReasonForState(StateType::eStateStopped);
     if (result != PacketResult::Success) {
@@ -836,6 +858,253 @@ void GDBRemoteCommunicationServerLLGS::HandleInferiorState_Stopped(
     }
     break;
   }
+  }
+}
+
+namespace {
+// Gives the breakpoint conditions access to the registers of the thread which
+// hit the breakpoint and to the memory of its process.
+class ThreadConditionContext : public AgentExpression::Context {
+public:
+  ThreadConditionContext(NativeProcessProtocol &process,
+                         NativeThreadProtocol &thread)
+      : m_process(process), m_thread(thread) {}
+
+  Status ReadRegister(uint32_t reg, uint64_t &value) override {
+    NativeRegisterContext &reg_ctx = m_thread.GetRegisterContext();
+    const RegisterInfo *reg_info = reg_ctx.GetRegisterInfoAtIndex(reg);
+    if (!reg_info)
+      return Status("invalid register %u", reg);
+    RegisterValue reg_value;
+    Status error = reg_ctx.ReadRegister(reg_info, reg_value);
+    if (error.Fail())
+      return error;
+    bool success = false;
+    value = reg_value.GetAsUInt64(0, &success);
+    if (!success)
+      return Status("register %s isn't an integer", reg_info->name);
+    return Status();
+  }
+
+  Status ReadMemory(lldb::addr_t addr, size_t size, uint64_t &value) override {
+    uint8_t buf[8];
+    size_t bytes_read = 0;
+    if (size > sizeof(buf))
+      return Status("can't read %zu bytes", size);
+    Status error =
+        m_process.ReadMemoryWithoutTrap(addr, buf, size, bytes_read);
+    if (error.Fail())
+      return error;
+    if (bytes_read != size)
+      return Status("failed to read memory at 0x%" PRIx64, addr);
+    DataExtractor data(buf, size, m_process.GetByteOrder(),
+                       m_process.GetArchitecture().GetAddressByteSize());
+    lldb::offset_t offset = 0;
+    value = data.GetMaxU64(&offset, size);
+    return Status();
+  }
+
+private:
+  NativeProcessProtocol &m_process;
+  NativeThreadProtocol &m_thread;
+};
+} // namespace
+
+bool GDBRemoteCommunicationServerLLGS::ResumeAtSilentBreakpoint(
+    NativeProcessProtocol &process) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+
+  // Find the threads with a reason to stop.
+  std::vector<std::pair<NativeThreadProtocol *, ThreadStopInfo>>
+      stopped_threads;
+  std::string description;
+  NativeThreadProtocol *thread;
+  for (uint32_t i = 0; (thread = process.GetThreadAtIndex(i)) != nullptr; ++i) {
+    ThreadStopInfo stop_info;
+    if (!thread->GetStopReason(stop_info, description) ||
+        stop_info.reason == eStopReasonNone)
+      continue;
+    stopped_threads.emplace_back(thread, stop_info);
+  }
+
+  if (!m_silent_steps.empty()) {
+    // This is the end of the step of the first thread over its breakpoint,
+    // unless something else happened on the way. The threads waiting for
+    // their steps are still stopped at their breakpoints.
+    const SilentStep step = m_silent_steps.front();
+    m_silent_steps.pop_front();
+    Status error = process.EnableBreakpoint(step.addr);
+    if (error.Fail())
+      LLDB_LOG(log, "failed to re-enable breakpoint at {0:x}: {1}", step.addr,
+               error);
+    for (const auto &stopped : stopped_threads) {
+      const lldb::tid_t tid = stopped.first->GetID();
+      const bool expected =
+          tid == step.tid
+              ? stopped.second.reason == eStopReasonTrace
+              : std::any_of(m_silent_steps.begin(), m_silent_steps.end(),
+                            [tid](const SilentStep &pending) {
+                              return pending.tid == tid;
+                            });
+      if (!expected) {
+        m_silent_steps.clear();
+        return false;
+      }
+    }
+    return StepOverSilentBreakpoint(process);
+  }
+
+  if (m_breakpoint_actions.empty() || m_condition_resume_actions.IsEmpty() ||
+      stopped_threads.empty())
+    return false;
+
+  // The stop is only skipped if every thread stopped at a breakpoint whose
+  // conditions are false, or at a tracepoint. Otherwise the client is told
+  // about all of them, and records the hits of the tracepoints itself.
+  for (const auto &stopped : stopped_threads) {
+    NativeThreadProtocol &stopped_thread = *stopped.first;
+    if (stopped.second.reason != eStopReasonBreakpoint) {
+      m_silent_steps.clear();
+      return false;
+    }
+    const lldb::addr_t pc = stopped_thread.GetRegisterContext().GetPC();
+    auto pos = m_breakpoint_actions.find(pc);
+    if (pos == m_breakpoint_actions.end()) {
+      m_silent_steps.clear();
+      return false;
+    }
+    const BreakpointActions &actions = pos->second;
+
+    // Stop if any condition is true, or can't be evaluated.
+    ThreadConditionContext context(process, stopped_thread);
+    bool condition_true = actions.conditions.empty();
+    for (const AgentExpression &condition : actions.conditions) {
+      uint64_t result = 0;
+      Status error = condition.Evaluate(context, result);
+      if (error.Fail()) {
+        LLDB_LOG(log, "failed to evaluate condition at {0:x}: {1}", pc, error);
+        m_silent_steps.clear();
+        return false;
+      }
+      if (result != 0) {
+        condition_true = true;
+        break;
+      }
+    }
+    // Tracepoints record the stop instead of reporting it.
+    if (actions.collects.empty() && condition_true) {
+      m_silent_steps.clear();
+      return false;
+    }
+    m_silent_steps.push_back({stopped_thread.GetID(), pc, condition_true});
+  }
+  return StepOverSilentBreakpoint(process);
+}
+
+bool GDBRemoteCommunicationServerLLGS::StepOverSilentBreakpoint(
+    NativeProcessProtocol &process) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+
+  if (m_silent_steps.empty()) {
+    Status error = process.Resume(m_condition_resume_actions);
+    if (error.Fail()) {
+      LLDB_LOG(log, "failed to resume after the silent breakpoints: {0}",
+               error);
+      return false;
+    }
+    return true;
+  }
+
+  // Step the next thread over its breakpoint, the other threads staying
+  // stopped, recording the hit of a tracepoint just before, so that a stop
+  // reported on the way doesn't leave the hits of the threads still waiting
+  // recorded twice.
+  const SilentStep &step = m_silent_steps.front();
+  NativeThreadProtocol *step_thread = process.GetThreadByID(step.tid);
+  if (!step_thread) {
+    m_silent_steps.clear();
+    return false;
+  }
+  if (step.collect)
+    CollectTracepoint(process, *step_thread, step.addr,
+                      m_breakpoint_actions[step.addr].collects);
+
+  Status error = process.DisableBreakpoint(step.addr);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to disable breakpoint at {0:x}: {1}", step.addr,
+             error);
+    m_silent_steps.clear();
+    return false;
+  }
+  ResumeActionList step_actions;
+  step_actions.AppendAction(step.tid, eStateStepping);
+  error = process.Resume(step_actions);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to step over breakpoint at {0:x}: {1}", step.addr,
+             error);
+    process.EnableBreakpoint(step.addr);
+    m_silent_steps.clear();
+    return false;
+  }
+  LLDB_LOG(log, "not reporting the stop at {0:x}, stepping thread {1} over it",
+           step.addr, step.tid);
+  return true;
+}
+
+void GDBRemoteCommunicationServerLLGS::CollectTracepoint(
+    NativeProcessProtocol &process, NativeThreadProtocol &thread,
+    lldb::addr_t addr, llvm::ArrayRef<TracepointCollect> collects) {
+  TracepointBuffer::Entry entry;
+  entry.addr = addr;
+  entry.tid = thread.GetID();
+  entry.data.reserve(TracepointBuffer::GetEntryDataSize(collects));
+  NativeRegisterContext &reg_ctx = thread.GetRegisterContext();
+  ThreadConditionContext context(process, thread);
+  for (const TracepointCollect &collect : collects) {
+    // The flag saying whether the item could be read, then its bytes.
+    const size_t flag_offset = entry.data.size();
+    entry.data.resize(flag_offset + 1 + collect.size, 0);
+    uint8_t *dst = entry.data.data() + flag_offset + 1;
+    bool success = false;
+    if (collect.kind == TracepointCollect::eRegister) {
+      const RegisterInfo *reg_info =
+          reg_ctx.GetRegisterInfoAtIndex(collect.reg);
+      RegisterValue reg_value;
+      Status error;
+      success = reg_info && reg_info->byte_size == collect.size &&
+                reg_ctx.ReadRegister(reg_info, reg_value).Success() &&
+                reg_value.GetAsMemoryData(reg_info, dst, collect.size,
+                                          process.GetByteOrder(),
+                                          error) == collect.size;
+    } else {
+      uint64_t base = 0;
+      size_t bytes_read = 0;
+      success = (collect.reg == LLDB_INVALID_REGNUM ||
+                 context.ReadRegister(collect.reg, base).Success()) &&
+                process
+                    .ReadMemoryWithoutTrap(base + collect.offset, dst,
+                                           collect.size, bytes_read)
+                    .Success() &&
+                bytes_read == collect.size;
+    }
+    if (success)
+      entry.data[flag_offset] = 1;
+    else
+      std::fill(dst, dst + collect.size, 0);
+  }
+  m_tracepoint_buffer.Append(std::move(entry));
+}
+
+void GDBRemoteCommunicationServerLLGS::SetConditionResumeActions(
+    const ResumeActionList &actions) {
+  // The signals were delivered by this resume, the next one only resumes
+  // the threads again. A thread still stepping after a stop at a silent
+  // breakpoint hasn't finished its step, or it would have reported it, so it
+  // steps again.
+  m_condition_resume_actions.Clear();
+  const ResumeAction *action = actions.GetFirst();
+  for (size_t i = 0; i < actions.GetSize(); ++i, ++action)
+    m_condition_resume_actions.AppendAction(action->tid, action->state);
 }
 
 void GDBRemoteCommunicationServerLLGS::ProcessStateChanged(
@@ -1426,6 +1695,7 @@ GDBRemoteCommunicationServerLLGS::Handle_C(StringExtractorGDBRemote &packet) {
 
     return SendErrorResponse(0x38);
   }
+  SetConditionResumeActions(resume_actions);
 
   // Don't send an "OK" packet; response is the stopped/exited message.
   return PacketResult::Success;
@@ -1465,6 +1735,7 @@ GDBRemoteCommunicationServerLLGS::Handle_c(StringExtractorGDBRemote &packet) {
              m_debugged_process_up->GetID(), error);
     return SendErrorResponse(GDBRemoteServerError::eErrorResume);
   }
+  SetConditionResumeActions(actions);
 
   LLDB_LOG(log, "continued process {0}", m_debugged_process_up->GetID());
   // No response required from continue.
@@ -1578,6 +1849,7 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
              m_debugged_process_up->GetID(), error);
     return SendErrorResponse(GDBRemoteServerError::eErrorResume);
   }
+  SetConditionResumeActions(thread_actions);
 
   LLDB_LOG(log, "continued process {0}", m_debugged_process_up->GetID());
   // No response required from vCont.
@@ -2281,6 +2553,73 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_jMultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOG(log, "failed, no process available");
+    return SendErrorResponse(0x15);
+  }
+
+  packet.SetFilePos(::strlen("jMultiMemRead:"));
+  StructuredData::ObjectSP object_sp = StructuredData::ParseJSON(packet.Peek());
+  if (!object_sp)
+    return SendIllFormedResponse(packet, "jMultiMemRead: invalid JSON");
+
+  StructuredData::Array *range_array = object_sp->GetAsArray();
+  if (!range_array)
+    return SendIllFormedResponse(packet, "jMultiMemRead: expected an array");
+
+  // Read all the ranges in one go into a single buffer, each range starting
+  // right after the end of the previous one.
+  std::vector<NativeProcessProtocol::MemoryReadRange> ranges;
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < range_array->GetSize(); ++i) {
+    StructuredData::Dictionary *range_dict =
+        range_array->GetItemAtIndex(i)->GetAsDictionary();
+    NativeProcessProtocol::MemoryReadRange range = {0, nullptr, 0, 0};
+    uint64_t size = 0;
+    if (!range_dict ||
+        !range_dict->GetValueForKeyAsInteger("address", range.addr) ||
+        !range_dict->GetValueForKeyAsInteger("length", size))
+      return SendIllFormedResponse(packet,
+                                   "jMultiMemRead: invalid memory range");
+    if (size > g_max_multi_mem_read_size - total_size)
+      return SendErrorResponse(0x78);
+    range.size = size;
+    total_size += size;
+    ranges.push_back(range);
+  }
+
+  std::string buf(total_size, '\0');
+  size_t buf_offset = 0;
+  for (NativeProcessProtocol::MemoryReadRange &range : ranges) {
+    range.buf = &buf[0] + buf_offset;
+    buf_offset += range.size;
+  }
+
+  Status error = m_debugged_process_up->ReadMemoryRangesWithoutTrap(ranges);
+  if (error.Fail()) {
+    LLDB_LOG(log, "pid {0}: failed to read memory ranges. Error: {1}",
+             m_debugged_process_up->GetID(), error);
+    return SendErrorResponse(0x08);
+  }
+
+  // The response lists the number of bytes read for each range, followed by
+  // the bytes that were read.
+  StreamGDBRemote response;
+  for (size_t i = 0; i < ranges.size(); ++i)
+    response.Printf("%s%" PRIx64, i == 0 ? "" : ",",
+                    uint64_t(ranges[i].bytes_read));
+  response.PutChar(';');
+  for (const NativeProcessProtocol::MemoryReadRange &range : ranges)
+    response.PutEscapedBytes(range.buf, range.bytes_read);
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_M(StringExtractorGDBRemote &packet) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
@@ -2535,12 +2874,63 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the conditions of a software breakpoint, as ";X<len>,<bytecode>"
+  // for each of them, and what it collects if it is a tracepoint, as
+  // ";R<reg>,<size>" for a register and ";M<reg>,<offset>,<size>" for memory,
+  // the register being ffffffff for a fixed address.
+  BreakpointActions actions;
+  while (stoppoint_type == eBreakpointSoftware && packet.GetBytesLeft() > 0 &&
+         *packet.Peek() == ';') {
+    packet.GetChar();
+    const char kind = packet.GetChar();
+    if (kind == 'R' || kind == 'M') {
+      TracepointCollect collect;
+      collect.reg = packet.GetHexMaxU32(false, LLDB_INVALID_REGNUM);
+      if (packet.GetChar() != ',')
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, failed to parse collected register");
+      if (kind == 'M') {
+        collect.kind = TracepointCollect::eMemory;
+        collect.offset = packet.GetHexMaxU64(false, 0);
+        if (packet.GetChar() != ',')
+          return SendIllFormedResponse(
+              packet, "Malformed Z packet, failed to parse collected offset");
+      } else if (collect.reg == LLDB_INVALID_REGNUM) {
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, failed to parse collected register");
+      }
+      collect.size = packet.GetHexMaxU32(false, 0);
+      if (collect.size == 0 || collect.size > g_max_tracepoint_collect_size)
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, invalid collected size");
+      actions.collects.push_back(collect);
+      continue;
+    }
+    if (kind != 'X')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, expecting condition after ';'");
+    const uint32_t length = packet.GetHexMaxU32(false, 0);
+    if (length == 0 || packet.GetChar() != ',')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition length");
+    std::vector<uint8_t> bytes(length);
+    if (packet.GetHexBytes(bytes, 0) != length)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition bytecode");
+    actions.conditions.emplace_back(bytes);
+  }
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
     const Status error =
         m_debugged_process_up->SetBreakpoint(addr, size, want_hardware);
-    if (error.Success())
+    if (error.Success()) {
+      if (actions.conditions.empty() && actions.collects.empty())
+        m_breakpoint_actions.erase(addr);
+      else
+        m_breakpoint_actions[addr] = std::move(actions);
       return SendOKResponse();
+    }
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
     LLDB_LOG(log, "pid {0} failed to set breakpoint: {1}",
              m_debugged_process_up->GetID(), error);
@@ -2627,8 +3017,11 @@ GDBRemoteCommunicationServerLLGS::Handle_z(StringExtractorGDBRemote &packet) {
     // Try to clear the breakpoint.
     const Status error =
         m_debugged_process_up->RemoveBreakpoint(addr, want_hardware);
-    if (error.Success())
+    if (error.Success()) {
+      if (!want_hardware)
+        m_breakpoint_actions.erase(addr);
       return SendOKResponse();
+    }
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
     LLDB_LOG(log, "pid {0} failed to remove breakpoint: {1}",
              m_debugged_process_up->GetID(), error);
@@ -2691,6 +3084,7 @@ GDBRemoteCommunicationServerLLGS::Handle_s(StringExtractorGDBRemote &packet) {
                   error.AsCString());
     return SendErrorResponse(0x49);
   }
+  SetConditionResumeActions(actions);
 
   // No response here - the stop or exit will come from the resulting action.
   return PacketResult::Success;
@@ -3047,6 +3441,29 @@ GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qTracepointBuffer(
+    StringExtractorGDBRemote &packet) {
+  // Fail if we don't have a current process.
+  if (!m_debugged_process_up ||
+      m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)
+    return SendErrorResponse(68);
+
+  // Send the number of entries dropped since the last response, then the
+  // oldest entries as "<addr>,<tid>,<data>;", removing them from the buffer.
+  // The client asks again until there are none left.
+  std::vector<TracepointBuffer::Entry> entries;
+  m_tracepoint_buffer.Drain(g_max_tracepoint_response_size, entries);
+  StreamGDBRemote response;
+  response.Printf("%" PRIx64 ";", m_tracepoint_buffer.TakeNumDropped());
+  for (const TracepointBuffer::Entry &entry : entries) {
+    response.Printf("%" PRIx64 ",%" PRIx64 ",", entry.addr, entry.tid);
+    response.PutBytesAsRawHex8(entry.data.data(), entry.data.size());
+    response.PutChar(';');
+  }
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_qFileLoadAddress(
     StringExtractorGDBRemote &packet) {
@@ -3210,6 +3627,11 @@ void GDBRemoteCommunicationServerLLGS::ClearProcessSpecificData() {
 
   LLDB_LOG(log, "clearing auxv buffer: {0}", m_active_auxv_buffer_up.get());
   m_active_auxv_buffer_up.reset();
+
+  m_breakpoint_actions.clear();
+  m_tracepoint_buffer.Clear();
+  m_condition_resume_actions.Clear();
+  m_silent_steps.clear();
 }
 
 FileSpec
@@ -3227,3 +3649,10 @@ GDBRemoteCommunicationServerLLGS::FindModuleFile(const std::string &module_path,
 
   return GDBRemoteCommunicationServerCommon::FindModuleFile(module_path, arch);
 }
+
+void GDBRemoteCommunicationServerLLGS::AppendSupportedFeatures(
+    Stream &response) {
+  // The conditions and actions of Z0 packets.
+  response.PutCString(";ConditionalBreakpoints+");
+  response.PutCString(";Tracepoints+");
+}
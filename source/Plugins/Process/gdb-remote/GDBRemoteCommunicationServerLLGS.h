@@ -12,13 +12,18 @@
 
 // C Includes
 // C++ Includes
+#include <deque>
+#include <map>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 // Other libraries and framework includes
 #include "lldb/Core/Communication.h"
 #include "lldb/Host/MainLoop.h"
 #include "lldb/Host/common/NativeProcessProtocol.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/TracepointBuffer.h"
 #include "lldb/lldb-private-forward.h"
 
 // Project includes
@@ -101,6 +106,34 @@ protected:
   uint32_t m_next_saved_registers_id = 1;
   bool m_handshake_completed = false;
 
+  // What the Z packets asked to do at a software breakpoint instead of
+  // always reporting its stops.
+  struct BreakpointActions {
+    // The stop is only reported, or recorded, if one of these is true or if
+    // there are none.
+    std::vector<AgentExpression> conditions;
+    // If there are any, the stop is recorded in m_tracepoint_buffer instead
+    // of being reported.
+    std::vector<TracepointCollect> collects;
+  };
+  std::map<lldb::addr_t, BreakpointActions> m_breakpoint_actions;
+  // The hits of the tracepoints, until the client asks for them.
+  TracepointBuffer m_tracepoint_buffer{1024 * 1024};
+  // How the client last resumed the threads, without the signals it
+  // delivered. The threads are resumed this way after stopping at
+  // breakpoints whose conditions are false, or at tracepoints.
+  ResumeActionList m_condition_resume_actions;
+  // A thread which stopped at such a breakpoint, and has to step over it
+  // with the breakpoint disabled, recording the hit first if it is a
+  // tracepoint whose condition is true. The first one is stepping, the
+  // others wait for their turns.
+  struct SilentStep {
+    lldb::tid_t tid;
+    lldb::addr_t addr;
+    bool collect;
+  };
+  std::deque<SilentStep> m_silent_steps;
+
   PacketResult SendONotification(const char *buffer, uint32_t len);
 
   PacketResult SendWResponse(NativeProcessProtocol *process);
@@ -150,6 +183,8 @@ protected:
   // Handles $m and $x packets.
   PacketResult Handle_memory_read(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_jMultiMemRead(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_M(StringExtractorGDBRemote &packet);
 
   PacketResult
@@ -187,6 +222,8 @@ protected:
 
   PacketResult Handle_qWatchpointSupportInfo(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_qTracepointBuffer(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_qFileLoadAddress(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_QPassSignals(StringExtractorGDBRemote &packet);
@@ -204,11 +241,29 @@ protected:
   FileSpec FindModuleFile(const std::string &module_path,
                           const ArchSpec &arch) override;
 
+  void AppendSupportedFeatures(Stream &response) override;
+
 private:
   void HandleInferiorState_Exited(NativeProcessProtocol *process);
 
   void HandleInferiorState_Stopped(NativeProcessProtocol *process);
 
+  // Called before a stop is reported. Returns true if all the threads
+  // stopped at breakpoints whose conditions are false, or at tracepoints,
+  // and the process resumed instead.
+  bool ResumeAtSilentBreakpoint(NativeProcessProtocol &process);
+
+  // Steps the first thread of m_silent_steps over its breakpoint, or
+  // resumes the process if there are none left. Returns false if it
+  // couldn't, and the stop has to be reported.
+  bool StepOverSilentBreakpoint(NativeProcessProtocol &process);
+
+  void CollectTracepoint(NativeProcessProtocol &process,
+                         NativeThreadProtocol &thread, lldb::addr_t addr,
+                         llvm::ArrayRef<TracepointCollect> collects);
+
+  void SetConditionResumeActions(const ResumeActionList &actions);
+
   NativeThreadProtocol *GetThreadFromSuffix(StringExtractorGDBRemote &packet);
 
   uint32_t GetNextSavedRegistersID();
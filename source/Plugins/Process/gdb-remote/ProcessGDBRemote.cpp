@@ -29,6 +29,9 @@
 #include <mutex>
 #include <sstream>
 
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointOptions.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
@@ -63,15 +66,18 @@
 #include "lldb/Target/SystemRuntime.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/TargetList.h"
+#include "lldb/Target/ThreadSpec.h"
 #include "lldb/Target/ThreadPlanCallFunction.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/CleanUp.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/State.h"
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
 
 // Project includes
+#include "BreakpointConditionCompiler.h"
 #include "GDBRemoteRegisterContext.h"
 #include "Plugins/Platform/MacOSX/PlatformRemoteiOS.h"
 #include "Plugins/Process/Utility/GDBRemoteSignals.h"
@@ -1273,6 +1279,7 @@ Status ProcessGDBRemote::WillResume() {
   m_continue_S_tids.clear();
   m_jstopinfo_sp.reset();
   m_jthreadsinfo_sp.reset();
+  UpdateBreakpointSiteConditions();
   return Status();
 }
 
@@ -2768,6 +2775,65 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   return 0;
 }
 
+std::vector<size_t>
+ProcessGDBRemote::DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                     uint8_t *buf) {
+  GetMaxMemorySize();
+  // Leave room for the hex byte count of each range at the start of the
+  // response.
+  const size_t range_overhead = 17;
+
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  uint8_t *dst = buf;
+  size_t index = 0;
+  while (index < ranges.size()) {
+    // Group as many ranges as fit in one response.
+    size_t end = index;
+    size_t batch_size = 0;
+    while (end < ranges.size() &&
+           batch_size + ranges[end].GetByteSize() + range_overhead <=
+               m_max_memory_size) {
+      batch_size += ranges[end].GetByteSize() + range_overhead;
+      ++end;
+    }
+
+    llvm::ArrayRef<MemoryRange> batch = ranges.slice(index, end - index);
+    size_t batch_buf_size = 0;
+    for (const MemoryRange &range : batch)
+      batch_buf_size += range.GetByteSize();
+
+    llvm::Optional<std::vector<size_t>> batch_bytes_read;
+    if (!batch.empty())
+      batch_bytes_read = m_gdb_comm.ReadMemoryRanges(
+          batch, llvm::MutableArrayRef<uint8_t>(dst, batch_buf_size));
+
+    if (batch_bytes_read) {
+      bytes_read.insert(bytes_read.end(), batch_bytes_read->begin(),
+                        batch_bytes_read->end());
+      dst += batch_buf_size;
+      index = end;
+      continue;
+    }
+
+    // Let lldb_private::Process read the ranges one by one if the remote
+    // debug server doesn't support batched reads at all.
+    if (bytes_read.empty() && !batch.empty() &&
+        !m_gdb_comm.GetMultiMemReadSupported())
+      return std::vector<size_t>();
+
+    // Otherwise read the first range on its own. This also covers ranges
+    // that are too large to fit in a single response.
+    const MemoryRange &range = ranges[index];
+    Status error;
+    bytes_read.push_back(ReadMemoryFromInferior(
+        range.GetRangeBase(), dst, range.GetByteSize(), error));
+    dst += range.GetByteSize();
+    ++index;
+  }
+  return bytes_read;
+}
+
 Status ProcessGDBRemote::WriteObjectFile(
     std::vector<ObjectFile::LoadableData> entries) {
   Status error;
@@ -3084,6 +3150,324 @@ size_t ProcessGDBRemote::PutSTDIN(const char *src, size_t src_len,
   return 0;
 }
 
+// Summarize the options of the owners of 'bp_site' deciding what
+// BreakpointConditionCompiler compiles, to notice when they change.
+static std::string GetBreakpointSiteConditionKey(BreakpointSite &bp_site) {
+  StreamString key;
+  const size_t num_owners = bp_site.GetNumberOfOwners();
+  for (size_t i = 0; i < num_owners; ++i) {
+    BreakpointLocationSP loc_sp = bp_site.GetOwnerAtIndex(i);
+    if (!loc_sp)
+      continue;
+    Breakpoint &bp = loc_sp->GetBreakpoint();
+    const char *condition = loc_sp->GetConditionText();
+    const BreakpointOptions *options =
+        loc_sp->GetOptionsSpecifyingKind(BreakpointOptions::eThreadSpec);
+    const ThreadSpec *thread_spec =
+        options ? options->GetThreadSpecNoCreate() : nullptr;
+    options = loc_sp->GetOptionsSpecifyingKind(BreakpointOptions::eCallback);
+    key.Printf("%d.%d:%u:%u:%d:%d:%d:%s:", bp.GetID(), loc_sp->GetID(),
+               loc_sp->GetIgnoreCount(), bp.GetIgnoreCount(),
+               thread_spec && thread_spec->HasSpecification(),
+               bp.GetPrecondition() != nullptr,
+               options && options->HasCallback() &&
+                   options->IsCallbackSynchronous(),
+               condition ? condition : "");
+    for (const Breakpoint::CollectedItem &item : bp.GetCollectedItems()) {
+      item.GetDescription(key);
+      key.PutChar(' ');
+    }
+    key.PutChar(';');
+  }
+  return key.GetString();
+}
+
+// Find how the stub numbers the register 'name' and its size.
+static bool GetStubRegister(RegisterContext &reg_ctx, llvm::StringRef name,
+                            uint32_t &reg, uint32_t &byte_size) {
+  const RegisterInfo *reg_info = reg_ctx.GetRegisterInfoByName(name);
+  if (reg_info == nullptr)
+    return false;
+  reg = reg_info->kinds[eRegisterKindProcessPlugin];
+  byte_size = reg_info->byte_size;
+  return reg != LLDB_INVALID_REGNUM;
+}
+
+void ProcessGDBRemote::GetBreakpointSiteActions(
+    BreakpointSite &bp_site, std::vector<AgentExpression> &conditions,
+    TracepointLayout &layout) {
+  conditions.clear();
+  layout = TracepointLayout();
+  // The conditions name the registers the way the threads' register
+  // contexts do, which is the same for all of them.
+  ThreadSP thread_sp = GetThreadList().GetThreadAtIndex(0, false);
+  RegisterContextSP reg_ctx_sp =
+      thread_sp ? thread_sp->GetRegisterContext() : RegisterContextSP();
+  if (!reg_ctx_sp)
+    return;
+
+  // The stub stops if any condition is true, so it can only test them if
+  // every owner has one. It can only skip the stops at tracepoints if all
+  // the owners are tracepoints, recording their hits if any condition is
+  // true or an owner has none.
+  const size_t num_owners = bp_site.GetNumberOfOwners();
+  bool all_compiled = num_owners > 0;
+  bool all_tracepoints =
+      num_owners > 0 && m_gdb_comm.GetTracepointsSupported();
+  bool any_unconditional = false;
+  std::vector<Breakpoint *> tracepoints;
+  for (size_t i = 0; i < num_owners; ++i) {
+    BreakpointLocationSP loc_sp = bp_site.GetOwnerAtIndex(i);
+    if (!loc_sp) {
+      all_compiled = all_tracepoints = false;
+      continue;
+    }
+    const char *condition_text = loc_sp->GetConditionText();
+    const bool has_condition = condition_text && condition_text[0];
+    AgentExpression condition;
+    const bool compiled =
+        has_condition &&
+        BreakpointConditionCompiler::Compile(*loc_sp, *reg_ctx_sp, condition);
+    if (compiled)
+      conditions.push_back(condition);
+    else
+      all_compiled = false;
+
+    Breakpoint &bp = loc_sp->GetBreakpoint();
+    if (!bp.IsTracepoint() || (has_condition && !compiled) ||
+        BreakpointConditionCompiler::HasDebuggerOnlyOptions(*loc_sp))
+      all_tracepoints = false;
+    if (!has_condition)
+      any_unconditional = true;
+    if (std::find(tracepoints.begin(), tracepoints.end(), &bp) ==
+        tracepoints.end())
+      tracepoints.push_back(&bp);
+  }
+
+  if (all_tracepoints) {
+    for (Breakpoint *bp : tracepoints) {
+      for (const Breakpoint::CollectedItem &item : bp->GetCollectedItems()) {
+        TracepointCollect collect;
+        uint32_t reg_size = 0;
+        if (!item.reg_name.empty() &&
+            !GetStubRegister(*reg_ctx_sp, item.reg_name, collect.reg,
+                             reg_size)) {
+          layout = TracepointLayout();
+          all_tracepoints = false;
+          break;
+        }
+        if (item.is_memory) {
+          collect.kind = TracepointCollect::eMemory;
+          collect.offset = item.offset;
+          collect.size = item.size;
+        } else {
+          collect.size = reg_size;
+        }
+        if (std::find(layout.collects.begin(), layout.collects.end(),
+                      collect) != layout.collects.end())
+          continue;
+        StreamString label;
+        item.GetDescription(label);
+        layout.collects.push_back(collect);
+        layout.labels.push_back(label.GetString());
+      }
+      if (!all_tracepoints)
+        break;
+    }
+  }
+  if (all_tracepoints) {
+    if (any_unconditional)
+      conditions.clear();
+  } else if (!all_compiled) {
+    conditions.clear();
+  }
+}
+
+void ProcessGDBRemote::UpdateBreakpointSiteConditions() {
+  if (m_bp_site_condition_keys.empty())
+    return;
+
+  // Changing the options of a breakpoint doesn't always tell the process, so
+  // look for the sites whose options changed before each resume and place
+  // them again with their new conditions.
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  GetBreakpointSiteList().ForEach([this, log](BreakpointSite *bp_site) {
+    auto pos = m_bp_site_condition_keys.find(bp_site->GetID());
+    if (pos == m_bp_site_condition_keys.end())
+      return;
+    std::string key = GetBreakpointSiteConditionKey(*bp_site);
+    if (key == pos->second)
+      return;
+
+    const addr_t addr = bp_site->GetLoadAddress();
+    const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
+    std::vector<AgentExpression> conditions;
+    TracepointLayout layout;
+    GetBreakpointSiteActions(*bp_site, conditions, layout);
+    if (log)
+      log->Printf("ProcessGDBRemote::UpdateBreakpointSiteConditions (site_id "
+                  "= %" PRIu64 ") address = 0x%" PRIx64
+                  ", %zu conditions, %zu collected items",
+                  (uint64_t)bp_site->GetID(), (uint64_t)addr,
+                  conditions.size(), layout.collects.size());
+    // Read the hits recorded the old way before the stub forgets about them.
+    if (m_tracepoint_layouts.count(addr))
+      ReadTracepointHits();
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                              bp_op_size) != 0)
+      return;
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                              bp_op_size, conditions,
+                                              layout.collects) != 0) {
+      if (log)
+        log->Printf("ProcessGDBRemote::UpdateBreakpointSiteConditions "
+                    "(site_id = %" PRIu64 ") -- FAILED to place it again",
+                    (uint64_t)bp_site->GetID());
+      bp_site->SetEnabled(false);
+      m_bp_site_condition_keys.erase(pos);
+      m_tracepoint_layouts.erase(addr);
+      return;
+    }
+    pos->second = std::move(key);
+    SetTracepointLayout(addr, std::move(layout));
+  });
+}
+
+void ProcessGDBRemote::SetTracepointLayout(lldb::addr_t addr,
+                                           TracepointLayout layout) {
+  if (layout.collects.empty())
+    m_tracepoint_layouts.erase(addr);
+  else
+    m_tracepoint_layouts[addr] =
+        std::make_shared<TracepointLayout>(std::move(layout));
+}
+
+Status ProcessGDBRemote::ReadTracepointHits() {
+  std::vector<TracepointBuffer::Entry> entries;
+  uint64_t num_dropped = 0;
+  Status error = m_gdb_comm.ReadTracepointBuffer(entries, num_dropped);
+  m_num_dropped_tracepoint_hits += num_dropped;
+  for (TracepointBuffer::Entry &entry : entries) {
+    TracepointHit hit;
+    auto pos = m_tracepoint_layouts.find(entry.addr);
+    if (pos != m_tracepoint_layouts.end())
+      hit.layout_sp = pos->second;
+    hit.entry = std::move(entry);
+    m_tracepoint_hits.push_back(std::move(hit));
+  }
+  return error;
+}
+
+void ProcessGDBRemote::DumpTracepointHits(Stream &s) {
+  if (m_num_dropped_tracepoint_hits > 0)
+    s.Printf("%" PRIu64 " tracepoint hits were dropped, the stub's buffer "
+             "being full.\n",
+             m_num_dropped_tracepoint_hits);
+  const ByteOrder byte_order = GetByteOrder();
+  const uint32_t addr_byte_size = GetAddressByteSize();
+  for (const TracepointHit &hit : m_tracepoint_hits) {
+    const TracepointBuffer::Entry &entry = hit.entry;
+    s.Printf("0x%" PRIx64 " tid 0x%" PRIx64 ":", entry.addr, entry.tid);
+    const TracepointLayout *layout = hit.layout_sp.get();
+    if (!layout || entry.data.size() !=
+                       TracepointBuffer::GetEntryDataSize(layout->collects)) {
+      s.PutChar(' ');
+      s.PutBytesAsRawHex8(entry.data.data(), entry.data.size());
+      s.EOL();
+      continue;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < layout->collects.size(); ++i) {
+      const TracepointCollect &collect = layout->collects[i];
+      const bool available = entry.data[offset] != 0;
+      const uint8_t *bytes = entry.data.data() + offset + 1;
+      offset += 1 + collect.size;
+      s.Printf("%s %s = ", i == 0 ? "" : ",", layout->labels[i].c_str());
+      if (!available) {
+        s.PutCString("<unavailable>");
+      } else if (collect.kind == TracepointCollect::eRegister &&
+                 collect.size <= 8) {
+        DataExtractor data(bytes, collect.size, byte_order, addr_byte_size);
+        lldb::offset_t data_offset = 0;
+        s.Printf("0x%*.*" PRIx64, collect.size * 2, collect.size * 2,
+                 data.GetMaxU64(&data_offset, collect.size));
+      } else {
+        s.PutChar('{');
+        for (uint32_t j = 0; j < collect.size; ++j)
+          s.Printf(j == 0 ? "%2.2x" : " %2.2x", bytes[j]);
+        s.PutChar('}');
+      }
+    }
+    s.EOL();
+  }
+  m_tracepoint_hits.clear();
+  m_num_dropped_tracepoint_hits = 0;
+}
+
+bool ProcessGDBRemote::RecordTracepointHit(Thread &thread, Breakpoint &bp) {
+  RegisterContextSP reg_ctx_sp = thread.GetRegisterContext();
+  if (!reg_ctx_sp)
+    return false;
+  // Keep the hits in the order they happened, the ones the stub recorded
+  // before this stop first.
+  if (!m_tracepoint_layouts.empty())
+    ReadTracepointHits();
+
+  // Record the hit the way the stub would have, each item being the flag
+  // saying whether it could be read followed by its bytes.
+  auto layout_sp = std::make_shared<TracepointLayout>();
+  TracepointHit hit;
+  hit.entry.addr = reg_ctx_sp->GetPC();
+  hit.entry.tid = thread.GetID();
+  const ByteOrder byte_order = GetByteOrder();
+  for (const Breakpoint::CollectedItem &item : bp.GetCollectedItems()) {
+    const RegisterInfo *reg_info =
+        item.reg_name.empty()
+            ? nullptr
+            : reg_ctx_sp->GetRegisterInfoByName(item.reg_name);
+    TracepointCollect collect;
+    if (reg_info)
+      collect.reg = reg_info->kinds[eRegisterKindProcessPlugin];
+    if (item.is_memory) {
+      collect.kind = TracepointCollect::eMemory;
+      collect.offset = item.offset;
+      collect.size = item.size;
+    } else if (reg_info) {
+      collect.size = reg_info->byte_size;
+    }
+
+    const size_t flag_offset = hit.entry.data.size();
+    hit.entry.data.resize(flag_offset + 1 + collect.size, 0);
+    uint8_t *dst = hit.entry.data.data() + flag_offset + 1;
+    bool success = false;
+    Status error;
+    if (!item.is_memory) {
+      RegisterValue reg_value;
+      success = reg_info && reg_ctx_sp->ReadRegister(reg_info, reg_value) &&
+                reg_value.GetAsMemoryData(reg_info, dst, collect.size,
+                                          byte_order,
+                                          error) == collect.size;
+    } else if (item.reg_name.empty() || reg_info) {
+      addr_t addr = collect.offset;
+      if (reg_info)
+        addr += reg_ctx_sp->ReadRegisterAsUnsigned(reg_info, 0);
+      success = ReadMemory(addr, dst, collect.size, error) == collect.size;
+    }
+    if (success)
+      hit.entry.data[flag_offset] = 1;
+    else
+      std::fill(dst, dst + collect.size, 0);
+
+    StreamString label;
+    item.GetDescription(label);
+    layout_sp->collects.push_back(collect);
+    layout_sp->labels.push_back(label.GetString());
+  }
+  hit.layout_sp = std::move(layout_sp);
+  m_tracepoint_hits.push_back(std::move(hit));
+  return true;
+}
+
 Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   Status error;
   assert(bp_site != NULL);
@@ -3124,13 +3508,26 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   // breakpoints.
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
-    // Try to send off a software breakpoint packet ($Z0)
+    // Try to send off a software breakpoint packet ($Z0), with the
+    // conditions the stub can test itself
+    const bool send_conditions =
+        m_gdb_comm.GetConditionalBreakpointsSupported();
+    std::vector<AgentExpression> conditions;
+    TracepointLayout layout;
+    if (send_conditions)
+      GetBreakpointSiteActions(*bp_site, conditions, layout);
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size);
+        eBreakpointSoftware, true, addr, bp_op_size, conditions,
+        layout.collects);
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
       bp_site->SetType(BreakpointSite::eExternal);
+      if (send_conditions) {
+        m_bp_site_condition_keys[site_id] =
+            GetBreakpointSiteConditionKey(*bp_site);
+        SetTracepointLayout(addr, std::move(layout));
+      }
       return error;
     }
 
@@ -3243,13 +3640,20 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
       else
         stoppoint_type = eBreakpointSoftware;
 
+      // Read the hits of a tracepoint before the stub forgets about it.
+      if (m_tracepoint_layouts.count(addr))
+        ReadTracepointHits();
+
       if (m_gdb_comm.SendGDBStoppointTypePacket(stoppoint_type, false, addr,
                                                 bp_op_size))
         error.SetErrorToGenericError();
     } break;
     }
-    if (error.Success())
+    if (error.Success()) {
       bp_site->SetEnabled(false);
+      m_bp_site_condition_keys.erase(site_id);
+      m_tracepoint_layouts.erase(addr);
+    }
   } else {
     if (log)
       log->Printf("ProcessGDBRemote::DisableBreakpointSite (site_id = %" PRIu64
@@ -4201,10 +4605,13 @@ bool ProcessGDBRemote::GetModuleSpec(const FileSpec &module_file_spec,
 
   const ModuleCacheKey key(module_file_spec.GetPath(),
                            arch.GetTriple().getTriple());
-  auto cached = m_cached_module_specs.find(key);
-  if (cached != m_cached_module_specs.end()) {
-    module_spec = cached->second;
-    return bool(module_spec);
+  {
+    std::lock_guard<std::mutex> guard(m_cached_module_specs_mutex);
+    auto cached = m_cached_module_specs.find(key);
+    if (cached != m_cached_module_specs.end()) {
+      module_spec = cached->second;
+      return bool(module_spec);
+    }
   }
 
   if (!m_gdb_comm.GetModuleInfo(module_file_spec, arch, module_spec)) {
@@ -4223,6 +4630,7 @@ bool ProcessGDBRemote::GetModuleSpec(const FileSpec &module_file_spec,
                 arch.GetTriple().getTriple().c_str(), stream.GetData());
   }
 
+  std::lock_guard<std::mutex> guard(m_cached_module_specs_mutex);
   m_cached_module_specs[key] = module_spec;
   return true;
 }
@@ -4231,6 +4639,7 @@ void ProcessGDBRemote::PrefetchModuleSpecs(
     llvm::ArrayRef<FileSpec> module_file_specs, const llvm::Triple &triple) {
   auto module_specs = m_gdb_comm.GetModulesInfo(module_file_specs, triple);
   if (module_specs) {
+    std::lock_guard<std::mutex> guard(m_cached_module_specs_mutex);
     for (const FileSpec &spec : module_file_specs)
       m_cached_module_specs[ModuleCacheKey(spec.GetPath(),
                                            triple.getTriple())] = ModuleSpec();
@@ -5308,6 +5717,120 @@ public:
   ~CommandObjectProcessGDBRemotePacket() {}
 };
 
+class CommandObjectProcessGDBRemoteTracepointCollect
+    : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTracepointCollect(
+      CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "process plugin tracepoint collect",
+            "Make a breakpoint a tracepoint, which the remote stub records "
+            "the given registers and memory at each time it is hit instead "
+            "of stopping, or a plain breakpoint again if no items are given. "
+            "Items are a register name, or \"<address>,<size>\" or "
+            "\"<register>[+-<offset>],<size>\" for memory. The breakpoint's "
+            "condition decides which hits are recorded.",
+            "process plugin tracepoint collect <breakpoint-id> [<item> ...]",
+            eCommandRequiresTarget) {}
+
+  ~CommandObjectProcessGDBRemoteTracepointCollect() {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    const size_t argc = command.GetArgumentCount();
+    break_id_t bp_id = LLDB_INVALID_BREAK_ID;
+    if (argc == 0 || command[0].ref.getAsInteger(0, bp_id)) {
+      result.AppendErrorWithFormat("'%s' takes a breakpoint ID followed by "
+                                   "the items to collect",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    BreakpointSP bp_sp = m_exe_ctx.GetTargetRef().GetBreakpointByID(bp_id);
+    if (!bp_sp) {
+      result.AppendErrorWithFormat("invalid breakpoint ID: %d", bp_id);
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    std::vector<Breakpoint::CollectedItem> items;
+    for (size_t i = 1; i < argc; ++i) {
+      Breakpoint::CollectedItem item;
+      if (!Breakpoint::CollectedItem::Parse(command[i].ref, item)) {
+        result.AppendErrorWithFormat("invalid item to collect: '%s'",
+                                     command[i].c_str());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+      items.push_back(item);
+    }
+    bp_sp->SetCollectedItems(std::move(items));
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteTracepointDump : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTracepointDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin tracepoint dump",
+                            "Read the hits the remote stub recorded at "
+                            "tracepoints, print them with the ones recorded "
+                            "at stops, then forget them.",
+                            NULL,
+                            eCommandRequiresProcess |
+                                eCommandProcessMustBePaused) {}
+
+  ~CommandObjectProcessGDBRemoteTracepointDump() {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("'%s' takes no arguments",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    if (!process) {
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    // Without the stub's support, the hits are only the ones the debugger
+    // recorded at the stops.
+    Status error;
+    if (process->GetGDBRemote().GetTracepointsSupported())
+      error = process->ReadTracepointHits();
+    process->DumpTracepointHits(result.GetOutputStream());
+    if (error.Fail()) {
+      result.AppendError(error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteTracepoint : public CommandObjectMultiword {
+public:
+  CommandObjectProcessGDBRemoteTracepoint(CommandInterpreter &interpreter)
+      : CommandObjectMultiword(interpreter, "process plugin tracepoint",
+                               "Commands for the tracepoints the remote stub "
+                               "records hits of without stopping.",
+                               "process plugin tracepoint <subcommand> "
+                               "[<subcommand-options>]") {
+    LoadSubCommand(
+        "collect",
+        CommandObjectSP(
+            new CommandObjectProcessGDBRemoteTracepointCollect(interpreter)));
+    LoadSubCommand(
+        "dump", CommandObjectSP(new CommandObjectProcessGDBRemoteTracepointDump(
+                    interpreter)));
+  }
+
+  ~CommandObjectProcessGDBRemoteTracepoint() {}
+};
+
 class CommandObjectMultiwordProcessGDBRemote : public CommandObjectMultiword {
 public:
   CommandObjectMultiwordProcessGDBRemote(CommandInterpreter &interpreter)
@@ -5318,6 +5841,9 @@ public:
     LoadSubCommand(
         "packet",
         CommandObjectSP(new CommandObjectProcessGDBRemotePacket(interpreter)));
+    LoadSubCommand(
+        "tracepoint",
+        CommandObjectSP(new CommandObjectProcessGDBRemoteTracepoint(interpreter)));
   }
 
   ~CommandObjectMultiwordProcessGDBRemote() {}
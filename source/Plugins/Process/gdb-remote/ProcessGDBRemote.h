@@ -144,6 +144,9 @@ public:
   size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                       Status &error) override;
 
+  std::vector<size_t> DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                         uint8_t *buf) override;
+
   Status
   WriteObjectFile(std::vector<ObjectFile::LoadableData> entries) override;
 
@@ -202,6 +205,18 @@ public:
 
   GDBRemoteCommunicationClient &GetGDBRemote() { return m_gdb_comm; }
 
+  //------------------------------------------------------------------
+  /// Read the hits the stub recorded at tracepoints, to show them later.
+  //------------------------------------------------------------------
+  Status ReadTracepointHits();
+
+  //------------------------------------------------------------------
+  /// Show the hits read from the stub, then forget them.
+  //------------------------------------------------------------------
+  void DumpTracepointHits(Stream &s);
+
+  bool RecordTracepointHit(Thread &thread, Breakpoint &bp) override;
+
   Status SendEventData(const char *data) override;
 
   //----------------------------------------------------------------------
@@ -308,6 +323,24 @@ protected:
   using FlashRangeVector = lldb_private::RangeVector<lldb::addr_t, size_t>;
   using FlashRange = FlashRangeVector::Entry;
   FlashRangeVector m_erased_flash_ranges;
+  // The software breakpoint sites the stub tests the conditions of, with a
+  // summary of the options their conditions were compiled from.
+  std::map<lldb::break_id_t, std::string> m_bp_site_condition_keys;
+  // What the stub records at each tracepoint, and how to show it.
+  struct TracepointLayout {
+    std::vector<TracepointCollect> collects;
+    std::vector<std::string> labels;
+  };
+  typedef std::shared_ptr<const TracepointLayout> TracepointLayoutSP;
+  std::map<lldb::addr_t, TracepointLayoutSP> m_tracepoint_layouts;
+  // The hits read from the stub, or recorded at the stops it reported, and
+  // not shown yet.
+  struct TracepointHit {
+    TracepointBuffer::Entry entry;
+    TracepointLayoutSP layout_sp;
+  };
+  std::vector<TracepointHit> m_tracepoint_hits;
+  uint64_t m_num_dropped_tracepoint_hits = 0;
 
   //----------------------------------------------------------------------
   // Accessors
@@ -421,6 +454,19 @@ protected:
 
   bool HasErased(FlashRange range);
 
+  // Compile the conditions of the owners of 'bp_site' for the stub, and
+  // find what it records if they are all tracepoints. Leaves 'conditions'
+  // empty unless the stub can decide by itself when to report a stop.
+  void GetBreakpointSiteActions(BreakpointSite &bp_site,
+                                std::vector<AgentExpression> &conditions,
+                                TracepointLayout &layout);
+
+  void SetTracepointLayout(lldb::addr_t addr, TracepointLayout layout);
+
+  // Send the conditions of the breakpoint sites whose options changed since
+  // they were last sent.
+  void UpdateBreakpointSiteConditions();
+
 private:
   //------------------------------------------------------------------
   // For ProcessGDBRemote only
@@ -465,6 +511,9 @@ private:
     }
   };
 
+  // Modules can be located from several threads at once (see
+  // DynamicLoaderPOSIXDYLD), so the cache is protected by a mutex.
+  std::mutex m_cached_module_specs_mutex;
   llvm::DenseMap<ModuleCacheKey, ModuleSpec, ModuleCacheInfo>
       m_cached_module_specs;
 
@@ -318,89 +318,126 @@ const MinidumpExceptionStream *MinidumpParser::GetExceptionStream() {
   return MinidumpExceptionStream::Parse(data);
 }
 
-llvm::Optional<minidump::Range>
-MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+void MinidumpParser::ParseMemoryRanges() {
   llvm::ArrayRef<uint8_t> data = GetStream(MinidumpStreamType::MemoryList);
   llvm::ArrayRef<uint8_t> data64 = GetStream(MinidumpStreamType::Memory64List);
-
-  if (data.empty() && data64.empty())
-    return llvm::None;
+  const uint64_t file_size = GetData().size();
 
   if (!data.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor> memory_list =
         MinidumpMemoryDescriptor::ParseMemoryList(data);
 
-    if (memory_list.empty())
-      return llvm::None;
-
+    m_memory_ranges.reserve(memory_list.size());
     for (const auto &memory_desc : memory_list) {
       const MinidumpLocationDescriptor &loc_desc = memory_desc.memory;
-      const lldb::addr_t range_start = memory_desc.start_of_memory_range;
-      const size_t range_size = loc_desc.data_size;
+      const uint64_t range_size = loc_desc.data_size;
 
-      if (loc_desc.rva + loc_desc.data_size > GetData().size())
-        return llvm::None;
+      if (range_size == 0 || loc_desc.rva + range_size > file_size)
+        continue;
 
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(loc_desc.rva, range_size));
-      }
+      m_memory_ranges.emplace_back(memory_desc.start_of_memory_range,
+                                   GetData().slice(loc_desc.rva, range_size));
     }
   }
 
   // Some Minidumps have a Memory64ListStream that captures all the heap memory
-  // (full-memory Minidumps).  We can't exactly use the same loop as above,
-  // because the Minidump uses slightly different data structures to describe
-  // those
-
+  // (full-memory Minidumps). Its descriptors don't have an RVA of their own:
+  // the ranges are stored back to back starting at base_rva.
   if (!data64.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor64> memory64_list;
     uint64_t base_rva;
     std::tie(memory64_list, base_rva) =
         MinidumpMemoryDescriptor64::ParseMemory64List(data64);
 
-    if (memory64_list.empty())
-      return llvm::None;
-
+    m_memory_ranges.reserve(m_memory_ranges.size() + memory64_list.size());
     for (const auto &memory_desc64 : memory64_list) {
-      const lldb::addr_t range_start = memory_desc64.start_of_memory_range;
-      const size_t range_size = memory_desc64.data_size;
+      const uint64_t range_size = memory_desc64.data_size;
 
-      if (base_rva + range_size > GetData().size())
-        return llvm::None;
+      // The RVAs of all the following ranges depend on this one, so there is
+      // no point in looking at them once a range is truncated.
+      if (base_rva + range_size > file_size || base_rva + range_size < base_rva)
+        break;
 
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(base_rva, range_size));
-      }
+      if (range_size != 0)
+        m_memory_ranges.emplace_back(memory_desc64.start_of_memory_range,
+                                     GetData().slice(base_rva, range_size));
       base_rva += range_size;
     }
   }
 
-  return llvm::None;
+  // The lists are usually sorted already, but nothing guarantees it. The sort
+  // is stable so that the MemoryList ranges take precedence over the
+  // Memory64List ones starting at the same address.
+  std::stable_sort(m_memory_ranges.begin(), m_memory_ranges.end(),
+                   [](const Range &lhs, const Range &rhs) {
+                     return lhs.start < rhs.start;
+                   });
+
+  // Trim the overlapping parts of the ranges so that the range containing an
+  // address is always the last one starting at or before it.
+  size_t num_ranges = 0;
+  for (const Range &range : m_memory_ranges) {
+    if (num_ranges == 0) {
+      m_memory_ranges[num_ranges++] = range;
+      continue;
+    }
+    const Range &prev = m_memory_ranges[num_ranges - 1];
+    const lldb::addr_t prev_end = prev.start + prev.range_ref.size();
+    const lldb::addr_t end = range.start + range.range_ref.size();
+    if (end <= prev_end)
+      continue;
+    if (range.start >= prev_end) {
+      m_memory_ranges[num_ranges++] = range;
+      continue;
+    }
+    m_memory_ranges[num_ranges++] =
+        Range(prev_end, range.range_ref.drop_front(prev_end - range.start));
+  }
+  m_memory_ranges.erase(m_memory_ranges.begin() + num_ranges,
+                        m_memory_ranges.end());
+}
+
+llvm::Optional<minidump::Range>
+MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+  auto pos = std::upper_bound(
+      m_memory_ranges.begin(), m_memory_ranges.end(), addr,
+      [](lldb::addr_t addr, const Range &range) { return addr < range.start; });
+  if (pos == m_memory_ranges.begin())
+    return llvm::None;
+  --pos;
+
+  if (addr - pos->start >= pos->range_ref.size())
+    return llvm::None;
+  return *pos;
 }
 
 llvm::ArrayRef<uint8_t> MinidumpParser::GetMemory(lldb::addr_t addr,
                                                   size_t size) {
-  // I don't have a sense of how frequently this is called or how many memory
-  // ranges a Minidump typically has, so I'm not sure if searching for the
-  // appropriate range linearly each time is stupid.  Perhaps we should build
-  // an index for faster lookups.
-  llvm::Optional<minidump::Range> range = FindMemoryRange(addr);
-  if (!range)
+  auto pos = std::upper_bound(
+      m_memory_ranges.begin(), m_memory_ranges.end(), addr,
+      [](lldb::addr_t addr, const Range &range) { return addr < range.start; });
+  if (pos == m_memory_ranges.begin())
     return {};
+  --pos;
 
-  // There's at least some overlap between the beginning of the desired range
-  // (addr) and the current range.  Figure out where the overlap begins and how
-  // much overlap there is.
-
-  const size_t offset = addr - range->start;
-
-  if (addr < range->start || offset >= range->range_ref.size())
+  const size_t offset = addr - pos->start;
+  if (offset >= pos->range_ref.size())
     return {};
 
-  const size_t overlap = std::min(size, range->range_ref.size() - offset);
-  return range->range_ref.slice(offset, overlap);
+  // Extend the read into the following ranges while they continue both the
+  // address range and the bytes in the file, which is common for the
+  // Memory64List of full-memory minidumps.
+  const uint8_t *begin = pos->range_ref.data() + offset;
+  size_t available = pos->range_ref.size() - offset;
+  for (auto next = std::next(pos);
+       available < size && next != m_memory_ranges.end(); ++next) {
+    if (next->start != addr + available ||
+        next->range_ref.data() != begin + available)
+      break;
+    available += next->range_ref.size();
+  }
+
+  return llvm::makeArrayRef(begin, std::min(size, available));
 }
 
 llvm::Optional<MemoryRegionInfo>
@@ -574,5 +611,7 @@ Status MinidumpParser::Initialize() {
     return error;
   }
 
+  ParseMemoryRanges();
+
   return error;
 }
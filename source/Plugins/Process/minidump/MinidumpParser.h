@@ -29,6 +29,7 @@
 // C++ includes
 #include <cstring>
 #include <unordered_map>
+#include <vector>
 
 namespace lldb_private {
 
@@ -85,6 +86,10 @@ public:
 
   llvm::Optional<Range> FindMemoryRange(lldb::addr_t addr);
 
+  // Returns the bytes captured at [addr, addr + size). The result may be
+  // shorter than requested if the captured memory ends before addr + size. A
+  // read continues into the following ranges as long as they are adjacent
+  // both in memory and in the minidump file.
   llvm::ArrayRef<uint8_t> GetMemory(lldb::addr_t addr, size_t size);
 
   llvm::Optional<MemoryRegionInfo> GetMemoryRegionInfo(lldb::addr_t);
@@ -95,10 +100,17 @@ public:
 private:
   MinidumpParser(const lldb::DataBufferSP &data_buf_sp);
 
+  // Collect the ranges of the MemoryList and Memory64List streams into
+  // m_memory_ranges.
+  void ParseMemoryRanges();
+
 private:
   lldb::DataBufferSP m_data_sp;
   llvm::DenseMap<uint32_t, MinidumpLocationDescriptor> m_directory_map;
   ArchSpec m_arch;
+  // All the captured memory ranges, sorted by start address and trimmed so
+  // that they don't overlap.
+  std::vector<Range> m_memory_ranges;
 };
 
 } // end namespace minidump
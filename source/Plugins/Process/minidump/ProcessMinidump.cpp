@@ -262,14 +262,22 @@ size_t ProcessMinidump::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
 size_t ProcessMinidump::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                                      Status &error) {
 
-  llvm::ArrayRef<uint8_t> mem = m_minidump_parser.GetMemory(addr, size);
-  if (mem.empty()) {
-    error.SetErrorString("could not parse memory info");
-    return 0;
+  // The requested memory may be split over several ranges which are adjacent
+  // in the address space but not in the minidump file.
+  size_t bytes_read = 0;
+  while (bytes_read < size) {
+    llvm::ArrayRef<uint8_t> mem =
+        m_minidump_parser.GetMemory(addr + bytes_read, size - bytes_read);
+    if (mem.empty())
+      break;
+    std::memcpy(static_cast<uint8_t *>(buf) + bytes_read, mem.data(),
+                mem.size());
+    bytes_read += mem.size();
   }
 
-  std::memcpy(buf, mem.data(), mem.size());
-  return mem.size();
+  if (bytes_read == 0)
+    error.SetErrorString("could not parse memory info");
+  return bytes_read;
 }
 
 ArchSpec ProcessMinidump::GetArchitecture() {
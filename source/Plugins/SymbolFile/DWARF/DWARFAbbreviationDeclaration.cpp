@@ -13,16 +13,18 @@
 #include "lldb/Utility/Stream.h"
 
 #include "DWARFFormValue.h"
+#include "DWARFUnit.h"
 
 using namespace lldb_private;
 
 DWARFAbbreviationDeclaration::DWARFAbbreviationDeclaration()
-    : m_code(InvalidCode), m_tag(0), m_has_children(0), m_attributes() {}
+    : m_code(InvalidCode), m_tag(0), m_has_children(0), m_attributes(),
+      m_attribute_offsets(1, AttributeOffset{0, 0, 0}) {}
 
 DWARFAbbreviationDeclaration::DWARFAbbreviationDeclaration(dw_tag_t tag,
                                                            uint8_t has_children)
     : m_code(InvalidCode), m_tag(tag), m_has_children(has_children),
-      m_attributes() {}
+      m_attributes(), m_attribute_offsets(1, AttributeOffset{0, 0, 0}) {}
 
 bool DWARFAbbreviationDeclaration::Extract(const DWARFDataExtractor &data,
                                            lldb::offset_t *offset_ptr) {
@@ -34,6 +36,8 @@ bool DWARFAbbreviationDeclaration::Extract(const DWARFDataExtractor &data,
                                            dw_uleb128_t code) {
   m_code = code;
   m_attributes.clear();
+  m_attribute_offsets.assign(1, AttributeOffset{0, 0, 0});
+  m_num_fixed_size_attributes = 0;
   if (m_code) {
     m_tag = data.GetULEB128(offset_ptr);
     m_has_children = data.GetU8(offset_ptr);
@@ -43,7 +47,7 @@ bool DWARFAbbreviationDeclaration::Extract(const DWARFDataExtractor &data,
       dw_form_t form = data.GetULEB128(offset_ptr);
 
       if (attr && form)
-        m_attributes.push_back(DWARFAttribute(attr, form));
+        AddAttribute(DWARFAttribute(attr, form));
       else
         break;
     }
@@ -88,6 +92,71 @@ DWARFAbbreviationDeclaration::FindAttributeIndex(dw_attr_t attr) const {
   return DW_INVALID_INDEX;
 }
 
+void DWARFAbbreviationDeclaration::AppendAttributeOffset(dw_form_t form) {
+  AttributeOffset next = m_attribute_offsets.back();
+  if (next.fixed_size != kVariableOffset) {
+    uint16_t size = kVariableOffset;
+    switch (form) {
+    case DW_FORM_flag_present:
+      size = 0;
+      break;
+    case DW_FORM_data1:
+    case DW_FORM_flag:
+    case DW_FORM_ref1:
+      size = 1;
+      break;
+    case DW_FORM_data2:
+    case DW_FORM_ref2:
+      size = 2;
+      break;
+    case DW_FORM_data4:
+    case DW_FORM_ref4:
+      size = 4;
+      break;
+    case DW_FORM_data8:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_sig8:
+      size = 8;
+      break;
+    case DW_FORM_addr:
+      size = 0;
+      ++next.num_addresses;
+      break;
+    case DW_FORM_sec_offset:
+    case DW_FORM_strp:
+      size = 0;
+      ++next.num_offsets;
+      break;
+    default:
+      // Strings, blocks and LEB128 values (and DW_FORM_ref_addr whose size
+      // also depends on the DWARF version).
+      break;
+    }
+    if (size == kVariableOffset || next.num_addresses == UINT8_MAX ||
+        next.num_offsets == UINT8_MAX ||
+        next.fixed_size + size >= kVariableOffset)
+      next.fixed_size = kVariableOffset;
+    else {
+      next.fixed_size += size;
+      ++m_num_fixed_size_attributes;
+    }
+  }
+  m_attribute_offsets.push_back(next);
+}
+
+dw_offset_t
+DWARFAbbreviationDeclaration::GetAttributeOffset(uint32_t idx,
+                                                 const DWARFUnit *cu) const {
+  if (idx > m_attributes.size())
+    return DW_INVALID_OFFSET;
+  const AttributeOffset &offset = m_attribute_offsets[idx];
+  if (offset.fixed_size == kVariableOffset)
+    return DW_INVALID_OFFSET;
+  return offset.fixed_size +
+         offset.num_addresses * DWARFUnit::GetAddressByteSize(cu) +
+         offset.num_offsets * (DWARFUnit::IsDWARF64(cu) ? 8 : 4);
+}
+
 bool DWARFAbbreviationDeclaration::
 operator==(const DWARFAbbreviationDeclaration &rhs) const {
   return Tag() == rhs.Tag() && HasChildren() == rhs.HasChildren() &&
@@ -22,6 +22,7 @@ public:
   DWARFAbbreviationDeclaration(dw_tag_t tag, uint8_t has_children);
   void AddAttribute(const DWARFAttribute &attr) {
     m_attributes.push_back(attr);
+    AppendAttributeOffset(attr.get_form());
   }
 
   dw_uleb128_t Code() const { return m_code; }
@@ -54,6 +55,19 @@ public:
     return m_attributes[idx].get_form();
   }
   uint32_t FindAttributeIndex(dw_attr_t attr) const;
+  // Returns the offset of the value of the attribute at "idx" (or of the end
+  // of the values if "idx" is NumAttributes()) from the end of the
+  // abbreviation code of a DIE of "cu" using this declaration, or
+  // DW_INVALID_OFFSET if the size of a value before it varies between DIEs.
+  dw_offset_t GetAttributeOffset(uint32_t idx, const DWARFUnit *cu) const;
+  // Returns the number of leading attributes whose values have a size which
+  // only depends on the unit, and sets "byte_size" to their total size in a
+  // DIE of "cu". DIE extraction skips them all at once.
+  uint32_t GetFixedSizeAttributes(const DWARFUnit *cu,
+                                  dw_offset_t &byte_size) const {
+    byte_size = GetAttributeOffset(m_num_fixed_size_attributes, cu);
+    return m_num_fixed_size_attributes;
+  }
   bool Extract(const lldb_private::DWARFDataExtractor &data,
                lldb::offset_t *offset_ptr);
   bool Extract(const lldb_private::DWARFDataExtractor &data,
@@ -64,10 +78,26 @@ public:
   const DWARFAttribute::collection &Attributes() const { return m_attributes; }
 
 protected:
+  // The offset of an attribute value when the values before it all have a
+  // size which only depends on the address and offset sizes of the unit:
+  // fixed_size + num_addresses * address size + num_offsets * offset size.
+  struct AttributeOffset {
+    uint16_t fixed_size;
+    uint8_t num_addresses;
+    uint8_t num_offsets;
+  };
+  enum : uint16_t { kVariableOffset = UINT16_MAX };
+
+  void AppendAttributeOffset(dw_form_t form);
+
   dw_uleb128_t m_code;
   dw_tag_t m_tag;
   uint8_t m_has_children;
   DWARFAttribute::collection m_attributes;
+  // The offset of each attribute in m_attributes, and the offset right after
+  // the last one.
+  std::vector<AttributeOffset> m_attribute_offsets;
+  uint32_t m_num_fixed_size_attributes = 0;
 };
 
 #endif // liblldb_DWARFAbbreviationDeclaration_h_
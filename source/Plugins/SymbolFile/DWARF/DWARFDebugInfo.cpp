@@ -13,6 +13,7 @@
 #include <set>
 
 #include "lldb/Host/PosixApi.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
@@ -69,21 +70,44 @@ DWARFDebugAranges &DWARFDebugInfo::GetCompileUnitAranges() {
 
     // Manually build arange data for everything that wasn't in the
     // .debug_aranges table.
-    bool printed = false;
+    std::vector<DWARFUnit *> units_to_parse;
     const size_t num_compile_units = GetNumCompileUnits();
     for (size_t idx = 0; idx < num_compile_units; ++idx) {
       DWARFUnit *cu = GetCompileUnitAtIndex(idx);
+      if (cus_with_data.find(cu->GetOffset()) == cus_with_data.end())
+        units_to_parse.push_back(cu);
+    }
+    if (log && !units_to_parse.empty())
+      log->Printf(
+          "DWARFDebugInfo::GetCompileUnitAranges() for \"%s\" by parsing",
+          m_dwarf2Data->GetObjectFile()->GetFileSpec().GetPath().c_str());
 
-      dw_offset_t offset = cu->GetOffset();
-      if (cus_with_data.find(offset) == cus_with_data.end()) {
-        if (log) {
-          if (!printed)
-            log->Printf(
-                "DWARFDebugInfo::GetCompileUnitAranges() for \"%s\" by parsing",
-                m_dwarf2Data->GetObjectFile()->GetFileSpec().GetPath().c_str());
-          printed = true;
-        }
-        cu->BuildAddressRangeTable(m_dwarf2Data, m_cu_aranges_ap.get());
+    // Most units have their ranges in their unit DIE, and the others in the
+    // DIEs of their functions. Each unit reads them into its own table in
+    // parallel. The .debug_ranges are loaded before as this isn't done in a
+    // thread safe way.
+    m_dwarf2Data->DebugRanges();
+    std::vector<DWARFDebugAranges> unit_aranges(units_to_parse.size());
+    auto build_fn = [&](size_t idx) {
+      units_to_parse[idx]->BuildAddressRangeTableFromDIEs(m_dwarf2Data,
+                                                          &unit_aranges[idx]);
+    };
+    TaskMapOverInt(0, units_to_parse.size(), build_fn);
+
+    // Merge the tables in the order of the units. Units without any range in
+    // their DIEs fall back to their line table, which can't be parsed in
+    // parallel here.
+    for (size_t idx = 0; idx < units_to_parse.size(); ++idx) {
+      const DWARFDebugAranges &aranges = unit_aranges[idx];
+      if (aranges.IsEmpty()) {
+        units_to_parse[idx]->BuildAddressRangeTableFromLineTable(
+            m_dwarf2Data, m_cu_aranges_ap.get());
+        continue;
+      }
+      for (size_t n = 0; n < aranges.GetNumRanges(); ++n) {
+        const DWARFDebugAranges::Range *range = aranges.RangeAtIndex(n);
+        m_cu_aranges_ap->AppendRange(range->data, range->GetRangeBase(),
+                                     range->GetRangeEnd());
       }
     }
 
@@ -93,6 +117,16 @@ DWARFDebugAranges &DWARFDebugInfo::GetCompileUnitAranges() {
   return *m_cu_aranges_ap.get();
 }
 
+void DWARFDebugInfo::ExtractUnitDIEs() {
+  llvm::call_once(m_extract_unit_dies_flag, [this] {
+    const size_t num_compile_units = GetNumCompileUnits();
+    auto extract_fn = [this](size_t idx) {
+      m_compile_units[idx]->ExtractUnitDIEIfNeeded();
+    };
+    TaskMapOverInt(0, num_compile_units, extract_fn);
+  });
+}
+
 void DWARFDebugInfo::ParseCompileUnitHeadersIfNeeded() {
   if (m_compile_units.empty()) {
     if (m_dwarf2Data != NULL) {
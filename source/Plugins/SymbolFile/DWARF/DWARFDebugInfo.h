@@ -18,6 +18,7 @@
 #include "SymbolFileDWARF.h"
 #include "lldb/Core/STLUtils.h"
 #include "lldb/lldb-private.h"
+#include "llvm/Support/Threading.h"
 
 typedef std::multimap<const char *, dw_offset_t, CStringCompareFunctionObject>
     CStringToDIEMap;
@@ -34,6 +35,7 @@ public:
 
   DWARFDebugInfo();
   void SetDwarfData(SymbolFileDWARF *dwarf2Data);
+  SymbolFileDWARF *GetDWARF() const { return m_dwarf2Data; }
 
   size_t GetNumCompileUnits();
   bool ContainsCompileUnit(const DWARFUnit *cu) const;
@@ -53,6 +55,11 @@ public:
 
   DWARFDebugAranges &GetCompileUnitAranges();
 
+  // Extract the unit DIE of all the units at once on the task pool, for
+  // callers about to look at all of them. With split DWARF this opens all
+  // the .dwo files in parallel instead of one after the other.
+  void ExtractUnitDIEs();
+
 protected:
   static bool OffsetLessThanCompileUnitOffset(dw_offset_t offset,
                                               const DWARFUnitSP &cu_sp);
@@ -66,6 +73,7 @@ protected:
   CompileUnitColl m_compile_units;
   std::unique_ptr<DWARFDebugAranges>
       m_cu_aranges_ap; // A quick address to compile unit table
+  llvm::once_flag m_extract_unit_dies_flag;
 
 private:
   // All parsing needs to be done partially any managed by this class as
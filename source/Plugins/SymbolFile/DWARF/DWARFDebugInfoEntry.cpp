@@ -65,11 +65,14 @@ bool DWARFDebugInfoEntry::FastExtract(
     }
     m_tag = abbrevDecl->Tag();
     m_has_children = abbrevDecl->HasChildren();
-    // Skip all data in the .debug_info for the attributes
+    // Skip all data in the .debug_info for the attributes, starting with the
+    // ones with a fixed size all at once.
     const uint32_t numAttributes = abbrevDecl->NumAttributes();
-    uint32_t i;
+    dw_offset_t fixed_size;
+    uint32_t i = abbrevDecl->GetFixedSizeAttributes(cu, fixed_size);
+    offset += fixed_size;
     dw_form_t form;
-    for (i = 0; i < numAttributes; ++i) {
+    for (; i < numAttributes; ++i) {
       form = abbrevDecl->GetFormByIndexUnchecked(i);
 
       const uint8_t fixed_skip_size = fixed_form_sizes.GetSize(form);
@@ -223,12 +226,19 @@ bool DWARFDebugInfoEntry::Extract(SymbolFileDWARF *dwarf2Data,
         if (cu && isCompileUnitTag)
           const_cast<DWARFUnit *>(cu)->SetBaseAddress(0);
 
-        // Skip all data in the .debug_info for the attributes
+        // Skip all data in the .debug_info for the attributes, starting with
+        // the ones with a fixed size all at once unless we need the base
+        // address of the unit.
         const uint32_t numAttributes = abbrevDecl->NumAttributes();
-        uint32_t i;
+        uint32_t i = 0;
+        if (!isCompileUnitTag) {
+          dw_offset_t fixed_size;
+          i = abbrevDecl->GetFixedSizeAttributes(cu, fixed_size);
+          offset += fixed_size;
+        }
         dw_attr_t attr;
         dw_form_t form;
-        for (i = 0; i < numAttributes; ++i) {
+        for (; i < numAttributes; ++i) {
           abbrevDecl->GetAttrAndFormByIndexUnchecked(i, attr, form);
 
           if (isCompileUnitTag &&
@@ -863,7 +873,14 @@ dw_offset_t DWARFDebugInfoEntry::GetAttributeValue(
     if (attr_idx != DW_INVALID_INDEX) {
       const DWARFDataExtractor &debug_info_data = cu->GetData();
 
+      // Jump straight to the value when the ones before it have a fixed size.
       uint32_t idx = 0;
+      const dw_offset_t value_offset =
+          abbrevDecl->GetAttributeOffset(attr_idx, cu);
+      if (value_offset != DW_INVALID_OFFSET) {
+        offset += value_offset;
+        idx = attr_idx;
+      }
       while (idx < attr_idx)
         DWARFFormValue::SkipValue(abbrevDecl->GetFormByIndex(idx++),
                                   debug_info_data, &offset, cu);
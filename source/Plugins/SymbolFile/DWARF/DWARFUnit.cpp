@@ -417,29 +417,36 @@ void DWARFUnit::BuildAddressRangeTable(SymbolFileDWARF *dwarf,
   // This function is usually called if there in no .debug_aranges section in
   // order to produce a compile unit level set of address ranges that is
   // accurate.
+  if (!BuildAddressRangeTableFromDIEs(dwarf, debug_aranges))
+    BuildAddressRangeTableFromLineTable(dwarf, debug_aranges);
+}
 
+bool DWARFUnit::BuildAddressRangeTableFromDIEs(
+    SymbolFileDWARF *dwarf, DWARFDebugAranges *debug_aranges) {
   size_t num_debug_aranges = debug_aranges->GetNumRanges();
 
-  // First get the compile unit DIE only and check if it has a DW_AT_ranges
+  // First get the compile unit DIE only and check if it has a DW_AT_ranges,
+  // or a DW_AT_low_pc and DW_AT_high_pc
   const DWARFDebugInfoEntry *die = GetUnitDIEPtrOnly();
 
   const dw_offset_t cu_offset = GetOffset();
   if (die) {
     DWARFRangeList ranges;
     const size_t num_ranges =
-        die->GetAttributeAddressRanges(dwarf, this, ranges, false);
+        die->GetAttributeAddressRanges(dwarf, this, ranges, true);
     if (num_ranges > 0) {
       // This compile unit has DW_AT_ranges, assume this is correct if it is
       // present since clang no longer makes .debug_aranges by default and it
       // emits DW_AT_ranges for DW_TAG_compile_units. GCC also does this with
-      // recent GCC builds.
+      // recent GCC builds, and uses DW_AT_low_pc and DW_AT_high_pc when the
+      // code of the unit is contiguous.
       for (size_t i = 0; i < num_ranges; ++i) {
         const DWARFRangeList::Entry &range = ranges.GetEntryRef(i);
         debug_aranges->AppendRange(cu_offset, range.GetRangeBase(),
                                    range.GetRangeEnd());
       }
 
-      return; // We got all of our ranges from the DW_AT_ranges attribute
+      return true; // We got all of our ranges from the unit DIE
     }
   }
   // We don't have a DW_AT_ranges attribute, so we need to parse the DWARF
@@ -452,33 +459,38 @@ void DWARFUnit::BuildAddressRangeTable(SymbolFileDWARF *dwarf,
   die = DIEPtr();
   if (die)
     die->BuildAddressRangeTable(dwarf, this, debug_aranges);
+  return debug_aranges->GetNumRanges() != num_debug_aranges;
+}
 
-  if (debug_aranges->GetNumRanges() == num_debug_aranges) {
-    // We got nothing from the functions, maybe we have a line tables only
-    // situation. Check the line tables and build the arange table from this.
-    SymbolContext sc;
-    sc.comp_unit = dwarf->GetCompUnitForDWARFCompUnit(this);
-    if (sc.comp_unit) {
-      SymbolFileDWARFDebugMap *debug_map_sym_file =
-          m_dwarf->GetDebugMapSymfile();
-      if (debug_map_sym_file == NULL) {
-        LineTable *line_table = sc.comp_unit->GetLineTable();
-
-        if (line_table) {
-          LineTable::FileAddressRanges file_ranges;
-          const bool append = true;
-          const size_t num_ranges =
-              line_table->GetContiguousFileAddressRanges(file_ranges, append);
-          for (uint32_t idx = 0; idx < num_ranges; ++idx) {
-            const LineTable::FileAddressRanges::Entry &range =
-                file_ranges.GetEntryRef(idx);
-            debug_aranges->AppendRange(cu_offset, range.GetRangeBase(),
-                                       range.GetRangeEnd());
-          }
+void DWARFUnit::BuildAddressRangeTableFromLineTable(
+    SymbolFileDWARF *dwarf, DWARFDebugAranges *debug_aranges) {
+  size_t num_debug_aranges = debug_aranges->GetNumRanges();
+  const dw_offset_t cu_offset = GetOffset();
+
+  // We got nothing from the functions, maybe we have a line tables only
+  // situation. Check the line tables and build the arange table from this.
+  SymbolContext sc;
+  sc.comp_unit = dwarf->GetCompUnitForDWARFCompUnit(this);
+  if (sc.comp_unit) {
+    SymbolFileDWARFDebugMap *debug_map_sym_file =
+        m_dwarf->GetDebugMapSymfile();
+    if (debug_map_sym_file == NULL) {
+      LineTable *line_table = sc.comp_unit->GetLineTable();
+
+      if (line_table) {
+        LineTable::FileAddressRanges file_ranges;
+        const bool append = true;
+        const size_t num_ranges =
+            line_table->GetContiguousFileAddressRanges(file_ranges, append);
+        for (uint32_t idx = 0; idx < num_ranges; ++idx) {
+          const LineTable::FileAddressRanges::Entry &range =
+              file_ranges.GetEntryRef(idx);
+          debug_aranges->AppendRange(cu_offset, range.GetRangeBase(),
+                                     range.GetRangeEnd());
         }
-      } else
-        debug_map_sym_file->AddOSOARanges(dwarf, debug_aranges);
-    }
+      }
+    } else
+      debug_map_sym_file->AddOSOARanges(dwarf, debug_aranges);
   }
 
   if (debug_aranges->GetNumRanges() == num_debug_aranges) {
@@ -569,6 +581,17 @@ uint8_t DWARFUnit::GetAddressByteSize(const DWARFUnit *cu) {
   return DWARFUnit::GetDefaultAddressSize();
 }
 
+size_t DWARFUnit::GetParsedDIEsByteSize() const {
+  size_t byte_size = 0;
+  {
+    llvm::sys::ScopedReader lock(m_die_array_mutex);
+    byte_size = m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+  }
+  if (m_dwo_symbol_file)
+    byte_size += m_dwo_symbol_file->GetParsedDebugInfoByteSize();
+  return byte_size;
+}
+
 bool DWARFUnit::IsDWARF64(const DWARFUnit *cu) {
   if (cu)
     return cu->IsDWARF64();
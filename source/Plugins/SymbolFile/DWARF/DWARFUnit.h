@@ -115,6 +115,14 @@ public:
                    dw_offset_t base_obj_offset);
   void BuildAddressRangeTable(SymbolFileDWARF *dwarf,
                               DWARFDebugAranges *debug_aranges);
+  // The two steps of BuildAddressRangeTable(). Getting the ranges from the
+  // unit DIE, or from the DIEs of the functions, can run for several units
+  // at once and returns false if no range was found. Getting them from the
+  // line table can't.
+  bool BuildAddressRangeTableFromDIEs(SymbolFileDWARF *dwarf,
+                                      DWARFDebugAranges *debug_aranges);
+  void BuildAddressRangeTableFromLineTable(SymbolFileDWARF *dwarf,
+                                           DWARFDebugAranges *debug_aranges);
 
   lldb::ByteOrder GetByteOrder() const;
 
@@ -170,6 +178,10 @@ public:
 
   dw_offset_t GetBaseObjOffset() const;
 
+  // The number of bytes held by the DIEs extracted from this unit and its
+  // .dwo file.
+  size_t GetParsedDIEsByteSize() const;
+
   die_iterator_range dies() {
     ExtractDIEsIfNeeded();
     return die_iterator_range(m_die_array.begin(), m_die_array.end());
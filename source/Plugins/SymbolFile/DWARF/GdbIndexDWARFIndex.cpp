@@ -0,0 +1,432 @@
+//===-- GdbIndexDWARFIndex.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/SymbolFile/DWARF/GdbIndexDWARFIndex.h"
+#include "Plugins/Language/CPlusPlus/CPlusPlusLanguage.h"
+#include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
+#include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
+#include "lldb/Core/Mangled.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/Stream.h"
+#include "llvm/Support/MathExtras.h"
+
+using namespace lldb_private;
+using namespace lldb;
+
+// The header consists of the version followed by the offsets of the CU list,
+// the type unit list, the address area, the symbol table and the constant
+// pool.
+static const lldb::offset_t g_header_size = 6 * 4;
+
+static llvm::Error MakeError(const char *message) {
+  return llvm::make_error<llvm::StringError>(message,
+                                             llvm::inconvertibleErrorCode());
+}
+
+// The hash function used for the symbol table of version 5 and later indexes
+// (mapped_index_string_hash in gdb).
+static uint32_t HashName(llvm::StringRef name) {
+  uint32_t hash = 0;
+  for (unsigned char c : name)
+    hash = hash * 67 + tolower(c) - 113;
+  return hash;
+}
+
+// Returns the last component of a qualified name, e.g. "bar<a::b>" for
+// "foo::bar<a::b>".
+static llvm::StringRef GetUnqualifiedName(llvm::StringRef name) {
+  int depth = 0;
+  size_t start = 0;
+  for (size_t i = 0; i < name.size(); ++i) {
+    switch (name[i]) {
+    case '<':
+    case '(':
+      ++depth;
+      break;
+    case '>':
+    case ')':
+      if (depth > 0)
+        --depth;
+      break;
+    case ':':
+      if (depth == 0 && i + 1 < name.size() && name[i + 1] == ':') {
+        start = i + 2;
+        ++i;
+      }
+      break;
+    }
+  }
+  return name.drop_front(start);
+}
+
+static void FinalizeSet(ManualDWARFIndex::IndexSet &set) {
+  set.function_basenames.Finalize();
+  set.function_fullnames.Finalize();
+  set.function_methods.Finalize();
+  set.function_selectors.Finalize();
+  set.objc_class_selectors.Finalize();
+  set.globals.Finalize();
+  set.types.Finalize();
+  set.namespaces.Finalize();
+}
+
+llvm::Expected<std::unique_ptr<GdbIndexDWARFIndex>>
+GdbIndexDWARFIndex::Create(Module &module, const DWARFDataExtractor &gdb_index,
+                           DWARFDebugInfo *debug_info) {
+  if (!debug_info)
+    return MakeError("debug info null");
+
+  // The section is little endian regardless of the target.
+  DataExtractor data(gdb_index, 0, gdb_index.GetByteSize());
+  data.SetByteOrder(eByteOrderLittle);
+  if (!data.ValidOffsetForDataOfSize(0, g_header_size))
+    return MakeError(".gdb_index section too small");
+
+  lldb::offset_t offset = 0;
+  const uint32_t version = data.GetU32(&offset);
+  // Version 4 used a different hash function and versions before that are
+  // long obsolete.
+  if (version < 5 || version > 8)
+    return MakeError("unsupported .gdb_index version");
+
+  const uint32_t cu_list_offset = data.GetU32(&offset);
+  const uint32_t types_cu_list_offset = data.GetU32(&offset);
+  const uint32_t address_area_offset = data.GetU32(&offset);
+  const uint32_t symbol_table_offset = data.GetU32(&offset);
+  const uint32_t constant_pool_offset = data.GetU32(&offset);
+  if (cu_list_offset < g_header_size ||
+      cu_list_offset > types_cu_list_offset ||
+      types_cu_list_offset > address_area_offset ||
+      address_area_offset > symbol_table_offset ||
+      symbol_table_offset > constant_pool_offset ||
+      constant_pool_offset > data.GetByteSize())
+    return MakeError("malformed .gdb_index header");
+
+  const uint32_t symbol_table_size =
+      (constant_pool_offset - symbol_table_offset) / 8;
+  if (!llvm::isPowerOf2_32(symbol_table_size))
+    return MakeError("malformed .gdb_index symbol table");
+
+  // Each CU list entry is the offset and the length of the unit in
+  // .debug_info. Units we can't find keep their slot so that the CU indexes
+  // in the constant pool stay valid.
+  std::vector<DWARFUnit *> units;
+  llvm::DenseSet<dw_offset_t> unit_offsets;
+  offset = cu_list_offset;
+  while (offset + 16 <= types_cu_list_offset) {
+    const uint64_t cu_offset = data.GetU64(&offset);
+    data.GetU64(&offset); // Unit length.
+    DWARFUnit *cu = cu_offset < DW_INVALID_OFFSET
+                        ? debug_info->GetCompileUnit(cu_offset)
+                        : nullptr;
+    units.push_back(cu);
+    if (cu)
+      unit_offsets.insert(cu->GetOffset());
+  }
+  if (unit_offsets.empty())
+    return MakeError(".gdb_index does not describe any compile units");
+
+  return std::unique_ptr<GdbIndexDWARFIndex>(new GdbIndexDWARFIndex(
+      module, data, *debug_info, version, std::move(units),
+      std::move(unit_offsets), symbol_table_offset, symbol_table_size,
+      constant_pool_offset));
+}
+
+llvm::StringRef GdbIndexDWARFIndex::GetSlotName(uint32_t slot) const {
+  lldb::offset_t offset = m_symbol_table_offset + slot * 8ull;
+  const uint32_t name_offset = m_data.GetU32(&offset);
+  const uint32_t vec_offset = m_data.GetU32(&offset);
+  if (name_offset == 0 && vec_offset == 0)
+    return llvm::StringRef();
+
+  lldb::offset_t str_offset = m_constant_pool_offset + name_offset;
+  const char *name = m_data.GetCStr(&str_offset);
+  return name ? llvm::StringRef(name) : llvm::StringRef();
+}
+
+uint32_t GdbIndexDWARFIndex::FindSlot(llvm::StringRef name) const {
+  const uint32_t mask = m_symbol_table_size - 1;
+  const uint32_t hash = HashName(name);
+  const uint32_t step = ((hash * 17) & mask) | 1;
+  uint32_t slot = hash & mask;
+  for (uint32_t i = 0; i < m_symbol_table_size; ++i) {
+    llvm::StringRef slot_name = GetSlotName(slot);
+    if (slot_name.empty())
+      return UINT32_MAX;
+    if (slot_name == name)
+      return slot;
+    slot = (slot + step) & mask;
+  }
+  return UINT32_MAX;
+}
+
+void GdbIndexDWARFIndex::AppendUnits(uint32_t slot, uint32_t kind_mask,
+                                     std::vector<uint32_t> &cu_indexes) const {
+  lldb::offset_t offset = m_symbol_table_offset + slot * 8ull + 4;
+  lldb::offset_t vec_offset = m_constant_pool_offset + m_data.GetU32(&offset);
+  const uint32_t count = m_data.GetU32(&vec_offset);
+  if (!m_data.ValidOffsetForDataOfSize(vec_offset, count * 4ull))
+    return;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t entry = m_data.GetU32(&vec_offset);
+    const uint32_t cu_index = entry & 0x00ffffff;
+    const SymbolKind kind =
+        m_version >= 7 ? SymbolKind((entry >> 28) & 0x7) : eSymbolKindNone;
+    if (kind != eSymbolKindNone && (kind_mask & KindMask(kind)) == 0)
+      continue;
+    // Indexes past the end of the CU list refer to .debug_types units, which
+    // we don't support.
+    if (cu_index < m_units.size() && m_units[cu_index])
+      cu_indexes.push_back(cu_index);
+  }
+}
+
+void GdbIndexDWARFIndex::BuildBasenameIndexIfNeeded() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_basenames_built)
+    return;
+  m_basenames_built = true;
+
+  for (uint32_t slot = 0; slot < m_symbol_table_size; ++slot) {
+    llvm::StringRef name = GetSlotName(slot);
+    if (!name.empty())
+      m_basenames.emplace_back(GetUnqualifiedName(name), slot);
+  }
+  std::sort(m_basenames.begin(), m_basenames.end());
+}
+
+std::vector<uint32_t> GdbIndexDWARFIndex::GetUnitsForName(ConstString name,
+                                                          uint32_t kind_mask) {
+  BuildBasenameIndexIfNeeded();
+
+  std::vector<uint32_t> cu_indexes;
+  llvm::StringRef name_ref = name.GetStringRef();
+  auto range = std::equal_range(
+      m_basenames.begin(), m_basenames.end(), std::make_pair(name_ref, 0u),
+      [](const std::pair<llvm::StringRef, uint32_t> &lhs,
+         const std::pair<llvm::StringRef, uint32_t> &rhs) {
+        return lhs.first < rhs.first;
+      });
+  for (auto pos = range.first; pos != range.second; ++pos)
+    AppendUnits(pos->second, kind_mask, cu_indexes);
+
+  // The index only contains demangled names. Look up the name a mangled name
+  // demangles to, the unit index will then find the DIE by its linkage name.
+  if (name_ref.startswith("_Z")) {
+    Mangled mangled(name, true);
+    CPlusPlusLanguage::MethodName method(
+        mangled.GetDemangledName(eLanguageTypeC_plus_plus));
+    if (method.IsValid()) {
+      uint32_t slot = FindSlot(method.GetScopeQualifiedName());
+      if (slot != UINT32_MAX)
+        AppendUnits(slot, kind_mask, cu_indexes);
+    }
+  }
+
+  std::sort(cu_indexes.begin(), cu_indexes.end());
+  cu_indexes.erase(std::unique(cu_indexes.begin(), cu_indexes.end()),
+                   cu_indexes.end());
+  return cu_indexes;
+}
+
+std::vector<uint32_t>
+GdbIndexDWARFIndex::GetUnitsForRegex(const RegularExpression &regex,
+                                     uint32_t kind_mask) {
+  std::vector<uint32_t> cu_indexes;
+  for (uint32_t slot = 0; slot < m_symbol_table_size; ++slot) {
+    llvm::StringRef name = GetSlotName(slot);
+    if (name.empty())
+      continue;
+    if (regex.Execute(name) || regex.Execute(GetUnqualifiedName(name)))
+      AppendUnits(slot, kind_mask, cu_indexes);
+  }
+
+  std::sort(cu_indexes.begin(), cu_indexes.end());
+  cu_indexes.erase(std::unique(cu_indexes.begin(), cu_indexes.end()),
+                   cu_indexes.end());
+  return cu_indexes;
+}
+
+std::vector<const ManualDWARFIndex::IndexSet *>
+GdbIndexDWARFIndex::GetUnitSets(const std::vector<uint32_t> &cu_indexes) {
+  std::vector<uint32_t> missing;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (uint32_t cu_index : cu_indexes) {
+      if (!m_unit_sets[cu_index])
+        missing.push_back(cu_index);
+    }
+  }
+
+  // Common names like "size" can be defined in thousands of units, so index
+  // the ones we haven't seen yet in parallel. The lock isn't held meanwhile:
+  // waiting for the tasks can run other ones on this thread, which may look
+  // names up in this index too.
+  std::vector<std::unique_ptr<ManualDWARFIndex::IndexSet>> new_sets(
+      missing.size());
+  auto index_fn = [this, &missing, &new_sets](size_t i) {
+    auto set_up = llvm::make_unique<ManualDWARFIndex::IndexSet>();
+    m_fallback.IndexUnit(*m_units[missing[i]], *set_up);
+    FinalizeSet(*set_up);
+    new_sets[i] = std::move(set_up);
+  };
+  TaskMapOverInt(0, missing.size(), index_fn);
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  // Another thread may have indexed some of the same units meanwhile; keep
+  // its sets, which callers may already be using.
+  for (size_t i = 0; i < missing.size(); ++i) {
+    if (!m_unit_sets[missing[i]])
+      m_unit_sets[missing[i]] = std::move(new_sets[i]);
+  }
+
+  std::vector<const ManualDWARFIndex::IndexSet *> sets;
+  sets.reserve(cu_indexes.size());
+  for (uint32_t cu_index : cu_indexes)
+    sets.push_back(m_unit_sets[cu_index].get());
+  return sets;
+}
+
+void GdbIndexDWARFIndex::GetGlobalVariables(ConstString basename,
+                                            DIEArray &offsets) {
+  m_fallback.GetGlobalVariables(basename, offsets);
+
+  for (const ManualDWARFIndex::IndexSet *set : GetUnitSets(
+           GetUnitsForName(basename, KindMask(eSymbolKindVariable))))
+    set->globals.Find(basename, offsets);
+}
+
+void GdbIndexDWARFIndex::GetGlobalVariables(const RegularExpression &regex,
+                                            DIEArray &offsets) {
+  m_fallback.GetGlobalVariables(regex, offsets);
+
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForRegex(regex, KindMask(eSymbolKindVariable))))
+    set->globals.Find(regex, offsets);
+}
+
+void GdbIndexDWARFIndex::GetGlobalVariables(const DWARFUnit &cu,
+                                            DIEArray &offsets) {
+  m_fallback.GetGlobalVariables(cu, offsets);
+
+  auto pos = std::find(m_units.begin(), m_units.end(), &cu);
+  if (pos == m_units.end())
+    return;
+
+  std::vector<uint32_t> cu_indexes(1, pos - m_units.begin());
+  for (const ManualDWARFIndex::IndexSet *set : GetUnitSets(cu_indexes))
+    set->globals.FindAllEntriesForCompileUnit(cu.GetOffset(), offsets);
+}
+
+void GdbIndexDWARFIndex::GetObjCMethods(ConstString class_name,
+                                        DIEArray &offsets) {
+  m_fallback.GetObjCMethods(class_name, offsets);
+
+  // Methods are indexed under their full "-[Class selector]" names, so use
+  // the units defining the class itself.
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForName(class_name, eAllKinds)))
+    set->objc_class_selectors.Find(class_name, offsets);
+}
+
+void GdbIndexDWARFIndex::GetCompleteObjCClass(ConstString class_name,
+                                              bool must_be_implementation,
+                                              DIEArray &offsets) {
+  GetTypes(class_name, offsets);
+}
+
+void GdbIndexDWARFIndex::GetTypes(ConstString name, DIEArray &offsets) {
+  m_fallback.GetTypes(name, offsets);
+
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForName(name, KindMask(eSymbolKindType))))
+    set->types.Find(name, offsets);
+}
+
+void GdbIndexDWARFIndex::GetTypes(const DWARFDeclContext &context,
+                                  DIEArray &offsets) {
+  GetTypes(ConstString(context[0].name), offsets);
+}
+
+void GdbIndexDWARFIndex::GetNamespaces(ConstString name, DIEArray &offsets) {
+  m_fallback.GetNamespaces(name, offsets);
+
+  // Producers differ in the kind they record for namespaces.
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForName(name, eAllKinds)))
+    set->namespaces.Find(name, offsets);
+}
+
+void GdbIndexDWARFIndex::GetFunctions(
+    ConstString name, DWARFDebugInfo &info,
+    const CompilerDeclContext &parent_decl_ctx, uint32_t name_type_mask,
+    std::vector<DWARFDIE> &dies) {
+  m_fallback.GetFunctions(name, info, parent_decl_ctx, name_type_mask, dies);
+
+  DIEArray offsets;
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForName(name, KindMask(eSymbolKindFunction)))) {
+    set->function_basenames.Find(name, offsets);
+    set->function_methods.Find(name, offsets);
+    set->function_fullnames.Find(name, offsets);
+    set->function_selectors.Find(name, offsets);
+  }
+
+  // A function without a linkage name is listed under its name both as a
+  // basename and a full name.
+  std::sort(offsets.begin(), offsets.end(),
+            [](const DIERef &lhs, const DIERef &rhs) {
+              return std::make_pair(lhs.cu_offset, lhs.die_offset) <
+                     std::make_pair(rhs.cu_offset, rhs.die_offset);
+            });
+  offsets.erase(std::unique(offsets.begin(), offsets.end(),
+                            [](const DIERef &lhs, const DIERef &rhs) {
+                              return lhs.cu_offset == rhs.cu_offset &&
+                                     lhs.die_offset == rhs.die_offset;
+                            }),
+                offsets.end());
+
+  for (const DIERef &die_ref : offsets)
+    ProcessFunctionDIE(name.GetStringRef(), die_ref, info, parent_decl_ctx,
+                       name_type_mask, dies);
+}
+
+void GdbIndexDWARFIndex::GetFunctions(const RegularExpression &regex,
+                                      DIEArray &offsets) {
+  m_fallback.GetFunctions(regex, offsets);
+
+  for (const ManualDWARFIndex::IndexSet *set :
+       GetUnitSets(GetUnitsForRegex(regex, KindMask(eSymbolKindFunction)))) {
+    set->function_basenames.Find(regex, offsets);
+    set->function_fullnames.Find(regex, offsets);
+  }
+}
+
+void GdbIndexDWARFIndex::Dump(Stream &s) {
+  m_fallback.Dump(s);
+
+  s.Format("\nGDB index version {0} for ({1}) '{2:F}':\n", m_version,
+           m_module.GetArchitecture().GetArchitectureName(),
+           m_module.GetObjectFile()->GetFileSpec());
+  for (uint32_t slot = 0; slot < m_symbol_table_size; ++slot) {
+    llvm::StringRef name = GetSlotName(slot);
+    if (name.empty())
+      continue;
+    std::vector<uint32_t> cu_indexes;
+    AppendUnits(slot, eAllKinds, cu_indexes);
+    s.Format("\"{0}\":", name);
+    for (uint32_t cu_index : cu_indexes)
+      s.Printf(" 0x%8.8x", m_units[cu_index]->GetOffset());
+    s.EOL();
+  }
+}
@@ -0,0 +1,139 @@
+//===-- GdbIndexDWARFIndex.h -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_GDBINDEXDWARFINDEX_H
+#define LLDB_GDBINDEXDWARFINDEX_H
+
+#include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
+#include "Plugins/SymbolFile/DWARF/ManualDWARFIndex.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
+
+#include <mutex>
+
+namespace lldb_private {
+
+/// A DWARF index backed by the .gdb_index section emitted by gold and lld
+/// (--gdb-index) or gdb-add-index.
+///
+/// The section maps (qualified) names to the compile units defining them, so
+/// a lookup only has to index the DIEs of the few units containing the name
+/// instead of the whole .debug_info section. The per-unit name tables are
+/// built on first use and kept for later lookups. Units that are not listed
+/// in the section are indexed manually.
+class GdbIndexDWARFIndex : public DWARFIndex {
+public:
+  static llvm::Expected<std::unique_ptr<GdbIndexDWARFIndex>>
+  Create(Module &module, const DWARFDataExtractor &gdb_index,
+         DWARFDebugInfo *debug_info);
+
+  void Preload() override { m_fallback.Preload(); }
+
+  void GetGlobalVariables(ConstString basename, DIEArray &offsets) override;
+  void GetGlobalVariables(const RegularExpression &regex,
+                          DIEArray &offsets) override;
+  void GetGlobalVariables(const DWARFUnit &cu, DIEArray &offsets) override;
+  void GetObjCMethods(ConstString class_name, DIEArray &offsets) override;
+  void GetCompleteObjCClass(ConstString class_name, bool must_be_implementation,
+                            DIEArray &offsets) override;
+  void GetTypes(ConstString name, DIEArray &offsets) override;
+  void GetTypes(const DWARFDeclContext &context, DIEArray &offsets) override;
+  void GetNamespaces(ConstString name, DIEArray &offsets) override;
+  void GetFunctions(ConstString name, DWARFDebugInfo &info,
+                    const CompilerDeclContext &parent_decl_ctx,
+                    uint32_t name_type_mask,
+                    std::vector<DWARFDIE> &dies) override;
+  void GetFunctions(const RegularExpression &regex,
+                    DIEArray &offsets) override;
+
+  void ReportInvalidDIEOffset(dw_offset_t offset,
+                              llvm::StringRef name) override {}
+  void Dump(Stream &s) override;
+
+private:
+  /// The symbol kinds stored in the attributes of a CU vector entry
+  /// (GDB_INDEX_SYMBOL_KIND_*). Indexes older than version 7 don't record a
+  /// kind and use eSymbolKindNone for everything.
+  enum SymbolKind : uint32_t {
+    eSymbolKindNone = 0,
+    eSymbolKindType = 1,
+    eSymbolKindVariable = 2,
+    eSymbolKindFunction = 3,
+    eSymbolKindOther = 4,
+  };
+
+  static constexpr uint32_t KindMask(SymbolKind kind) { return 1u << kind; }
+
+  static constexpr uint32_t eAllKinds = UINT32_MAX;
+
+  GdbIndexDWARFIndex(Module &module, const DataExtractor &data,
+                     DWARFDebugInfo &debug_info, uint32_t version,
+                     std::vector<DWARFUnit *> units,
+                     llvm::DenseSet<dw_offset_t> unit_offsets,
+                     lldb::offset_t symbol_table_offset,
+                     uint32_t symbol_table_size,
+                     lldb::offset_t constant_pool_offset)
+      : DWARFIndex(module), m_data(data), m_version(version),
+        m_units(std::move(units)), m_symbol_table_offset(symbol_table_offset),
+        m_symbol_table_size(symbol_table_size),
+        m_constant_pool_offset(constant_pool_offset),
+        m_fallback(module, &debug_info, std::move(unit_offsets)),
+        m_unit_sets(m_units.size()) {}
+
+  /// Returns the name stored in the symbol table slot \a slot, or an empty
+  /// string if the slot is unused.
+  llvm::StringRef GetSlotName(uint32_t slot) const;
+
+  /// Returns the slot holding \a name, or UINT32_MAX if there is none.
+  uint32_t FindSlot(llvm::StringRef name) const;
+
+  /// Add the indexes of the compile units that define the symbol in \a slot
+  /// with one of the kinds in \a kind_mask to \a cu_indexes.
+  void AppendUnits(uint32_t slot, uint32_t kind_mask,
+                   std::vector<uint32_t> &cu_indexes) const;
+
+  /// Returns the indexes of the units that may contain DIEs named \a name.
+  std::vector<uint32_t> GetUnitsForName(ConstString name, uint32_t kind_mask);
+
+  /// Returns the indexes of the units that may contain DIEs whose name
+  /// matches \a regex.
+  std::vector<uint32_t> GetUnitsForRegex(const RegularExpression &regex,
+                                         uint32_t kind_mask);
+
+  /// Build the name tables of the units in \a cu_indexes which haven't been
+  /// indexed yet and return the tables for all of them.
+  std::vector<const ManualDWARFIndex::IndexSet *>
+  GetUnitSets(const std::vector<uint32_t> &cu_indexes);
+
+  void BuildBasenameIndexIfNeeded();
+
+  DataExtractor m_data;
+  uint32_t m_version;
+  /// The compile units of the CU list, indexed by their position in it.
+  std::vector<DWARFUnit *> m_units;
+  lldb::offset_t m_symbol_table_offset;
+  /// The number of slots in the symbol hash table, a power of two.
+  uint32_t m_symbol_table_size;
+  lldb::offset_t m_constant_pool_offset;
+  /// Indexes the units that are missing from the CU list.
+  ManualDWARFIndex m_fallback;
+
+  std::mutex m_mutex;
+  /// The finalized name tables of each unit in m_units, built on demand.
+  std::vector<std::unique_ptr<ManualDWARFIndex::IndexSet>> m_unit_sets;
+  /// The unqualified name of each symbol (e.g. "bar" for "foo::bar") and its
+  /// slot, sorted by name. DWARF lookups are done by base name while the
+  /// symbol table is keyed by qualified names.
+  std::vector<std::pair<llvm::StringRef, uint32_t>> m_basenames;
+  bool m_basenames_built = false;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_GDBINDEXDWARFINDEX_H
@@ -14,14 +14,28 @@
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb_private;
 using namespace lldb;
 
+// "LDIX" in host byte order. A cache written on a host with a different byte
+// order fails the magic check and is simply rebuilt.
+static const uint32_t g_index_cache_magic = 0x4c444958;
+// Bump this whenever the cache layout or the contents of IndexSet change.
+static const uint32_t g_index_cache_version = 2;
+
 void ManualDWARFIndex::Index() {
   if (!m_debug_info)
     return;
@@ -32,6 +46,14 @@ void ManualDWARFIndex::Index() {
   static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
   Timer scoped_timer(func_cat, "%p", static_cast<void *>(&debug_info));
 
+  const FileSpec cache_file = GetCacheFile(debug_info);
+  std::string cache_key;
+  if (cache_file) {
+    cache_key = GetCacheKey(debug_info);
+    if (LoadFromCache(cache_file, cache_key))
+      return;
+  }
+
   std::vector<DWARFUnit *> units_to_index;
   units_to_index.reserve(debug_info.GetNumCompileUnits());
   for (size_t U = 0; U < debug_info.GetNumCompileUnits(); ++U) {
@@ -42,6 +64,9 @@ void ManualDWARFIndex::Index() {
   if (units_to_index.empty())
     return;
 
+  // The names only live in the builder tables until they are frozen, keep
+  // them out of the global string pool.
+  ConstStringArena names;
   std::vector<IndexSet> sets(units_to_index.size());
 
   //----------------------------------------------------------------------
@@ -51,7 +76,7 @@ void ManualDWARFIndex::Index() {
   std::vector<llvm::Optional<DWARFUnit::ScopedExtractDIEs>> clear_cu_dies(
       units_to_index.size());
   auto parser_fn = [&](size_t cu_idx) {
-    IndexUnit(*units_to_index[cu_idx], sets[cu_idx]);
+    IndexUnit(*units_to_index[cu_idx], sets[cu_idx], &names);
   };
 
   auto extract_fn = [&units_to_index, &clear_cu_dies](size_t cu_idx) {
@@ -90,9 +115,247 @@ void ManualDWARFIndex::Index() {
                      [&]() { finalize_fn(&IndexSet::globals); },
                      [&]() { finalize_fn(&IndexSet::types); },
                      [&]() { finalize_fn(&IndexSet::namespaces); });
+
+  // Freeze the tables into the flat form they are cached in, which is much
+  // more compact than the maps they were built in, and doesn't need them.
+  std::string index_data = Encode(cache_key);
+  auto buffer_sp =
+      std::make_shared<DataBufferHeap>(index_data.data(), index_data.size());
+  if (index_data.empty() || !Decode(buffer_sp, cache_key, "built index")) {
+    // Keep the builder tables, with names which outlive the arena.
+    auto move_to_string_pool = [this](NameToDIE(IndexSet::*index)) {
+      NameToDIE result;
+      (m_set.*index).ForEach([&result](ConstString name, const DIERef &ref) {
+        result.Insert(ConstString(name.GetStringRef()), ref);
+        return true;
+      });
+      result.Finalize();
+      m_set.*index = std::move(result);
+    };
+    move_to_string_pool(&IndexSet::function_basenames);
+    move_to_string_pool(&IndexSet::function_fullnames);
+    move_to_string_pool(&IndexSet::function_methods);
+    move_to_string_pool(&IndexSet::function_selectors);
+    move_to_string_pool(&IndexSet::objc_class_selectors);
+    move_to_string_pool(&IndexSet::globals);
+    move_to_string_pool(&IndexSet::types);
+    move_to_string_pool(&IndexSet::namespaces);
+    return;
+  }
+  if (cache_file)
+    SaveToCache(cache_file, index_data);
+}
+
+FileSpec ManualDWARFIndex::GetCacheFile(DWARFDebugInfo &debug_info) const {
+  // An index that skips some units only complements another index and is
+  // cheap to rebuild, so it is never cached.
+  if (!m_index_cache_dir || !m_units_to_avoid.empty())
+    return FileSpec();
+
+  SymbolFileDWARF *dwarf = debug_info.GetDWARF();
+  ObjectFile *objfile = dwarf ? dwarf->GetObjectFile() : nullptr;
+  if (!objfile)
+    return FileSpec();
+
+  // The file name only needs to tell different modules apart, the cache key
+  // stored inside the file decides whether its contents are still valid.
+  llvm::MD5 md5;
+  md5.update(m_module.GetFileSpec().GetPath());
+  md5.update(m_module.GetObjectName().GetStringRef());
+  md5.update(m_module.GetArchitecture().GetTriple().str());
+  md5.update(objfile->GetFileSpec().GetPath());
+  llvm::MD5::MD5Result md5_result;
+  md5.final(md5_result);
+
+  std::string filename = m_module.GetFileSpec().GetFilename().AsCString("");
+  filename += "-";
+  filename += md5_result.digest().str();
+  filename += ".lldbindex";
+
+  FileSpec cache_file = m_index_cache_dir;
+  cache_file.AppendPathComponent(filename);
+  return cache_file;
+}
+
+std::string ManualDWARFIndex::GetCacheKey(DWARFDebugInfo &debug_info) const {
+  auto to_ns = [](const llvm::sys::TimePoint<> &time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               time.time_since_epoch())
+        .count();
+  };
+
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  os << "uuid=" << m_module.GetUUID().GetAsString()
+     << ";mtime=" << to_ns(m_module.GetModificationTime())
+     << ";object-mtime=" << to_ns(m_module.GetObjectModificationTime());
+  // The DWARF may live in a separate file (e.g. a .debug file found through
+  // .gnu_debuglink) which can change independently of the module itself.
+  // Split DWARF .dwo files are not part of the key, they are identified by
+  // the dwo_id in the skeleton unit which changes whenever they are rebuilt.
+  if (SymbolFileDWARF *dwarf = debug_info.GetDWARF()) {
+    if (ObjectFile *objfile = dwarf->GetObjectFile())
+      os << ";dwarf-mtime="
+         << to_ns(FileSystem::GetModificationTime(objfile->GetFileSpec()));
+  }
+  return os.str();
+}
+
+bool ManualDWARFIndex::LoadFromCache(const FileSpec &cache_file,
+                                     llvm::StringRef key) {
+  // The file is mapped, the frozen tables read it in place.
+  auto buffer_sp = DataBufferLLVM::CreateFromPath(cache_file.GetPath());
+  if (!buffer_sp)
+    return false;
+  if (!Decode(buffer_sp, key, cache_file.GetPath()))
+    return false;
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+  LLDB_LOG(log, "loaded index for {0} from cache {1}",
+           m_module.GetFileSpec().GetPath(), cache_file.GetPath());
+  return true;
+}
+
+bool ManualDWARFIndex::Decode(const DataBufferSP &buffer_sp,
+                              llvm::StringRef key, llvm::StringRef source) {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+
+  DataExtractor data(buffer_sp, endian::InlHostByteOrder(),
+                     sizeof(void *));
+  lldb::offset_t offset = 0;
+  if (data.GetU32(&offset) != g_index_cache_magic ||
+      data.GetU32(&offset) != g_index_cache_version) {
+    LLDB_LOG(log, "ignoring index cache {0}: unsupported version", source);
+    return false;
+  }
+
+  const uint32_t key_size = data.GetU32(&offset);
+  const char *key_data =
+      static_cast<const char *>(data.GetData(&offset, key_size));
+  if (!key_data || llvm::StringRef(key_data, key_size) != key) {
+    LLDB_LOG(log, "ignoring index cache {0}: module has changed", source);
+    return false;
+  }
+
+  const uint32_t strtab_size = data.GetU32(&offset);
+  if (!data.ValidOffsetForDataOfSize(offset, strtab_size))
+    return false;
+  DataExtractor strtab(data, offset, strtab_size);
+  offset += strtab_size;
+
+  IndexSet set;
+  if (!set.function_basenames.Decode(data, &offset, strtab) ||
+      !set.function_fullnames.Decode(data, &offset, strtab) ||
+      !set.function_methods.Decode(data, &offset, strtab) ||
+      !set.function_selectors.Decode(data, &offset, strtab) ||
+      !set.objc_class_selectors.Decode(data, &offset, strtab) ||
+      !set.globals.Decode(data, &offset, strtab) ||
+      !set.types.Decode(data, &offset, strtab) ||
+      !set.namespaces.Decode(data, &offset, strtab)) {
+    LLDB_LOG(log, "ignoring index cache {0}: malformed data", source);
+    return false;
+  }
+
+  m_set = std::move(set);
+  return true;
 }
 
-void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set) {
+std::string ManualDWARFIndex::Encode(llvm::StringRef key) const {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+
+  // Encode the tables first so we know which strings they refer to. Names
+  // that appear in several tables are stored only once.
+  llvm::DenseMap<const char *, uint32_t> string_offsets;
+  std::string strtab;
+  auto get_string_offset = [&](ConstString name) -> uint32_t {
+    auto insertion =
+        string_offsets.insert(std::make_pair(name.GetCString(), 0));
+    if (insertion.second) {
+      insertion.first->second = strtab.size();
+      strtab.append(name.AsCString(""), name.GetLength());
+      strtab.push_back('\0');
+    }
+    return insertion.first->second;
+  };
+
+  std::string tables;
+  llvm::raw_string_ostream tables_os(tables);
+  m_set.function_basenames.Encode(tables_os, get_string_offset);
+  m_set.function_fullnames.Encode(tables_os, get_string_offset);
+  m_set.function_methods.Encode(tables_os, get_string_offset);
+  m_set.function_selectors.Encode(tables_os, get_string_offset);
+  m_set.objc_class_selectors.Encode(tables_os, get_string_offset);
+  m_set.globals.Encode(tables_os, get_string_offset);
+  m_set.types.Encode(tables_os, get_string_offset);
+  m_set.namespaces.Encode(tables_os, get_string_offset);
+  tables_os.flush();
+
+  if (strtab.size() > UINT32_MAX || tables.size() > UINT32_MAX) {
+    LLDB_LOG(log, "not freezing index for {0}: string table too large",
+             m_module.GetFileSpec().GetPath());
+    return std::string();
+  }
+
+  std::string index_data;
+  index_data.reserve(16 + key.size() + strtab.size() + tables.size());
+  llvm::raw_string_ostream os(index_data);
+  auto write_u32 = [&os](uint32_t value) {
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  write_u32(g_index_cache_magic);
+  write_u32(g_index_cache_version);
+  write_u32(key.size());
+  os << key;
+  write_u32(strtab.size());
+  os << strtab;
+  os << tables;
+  return os.str();
+}
+
+void ManualDWARFIndex::SaveToCache(const FileSpec &cache_file,
+                                   llvm::StringRef index_data) const {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+
+  const std::string cache_dir = m_index_cache_dir.GetPath();
+  if (std::error_code ec = llvm::sys::fs::create_directories(cache_dir)) {
+    LLDB_LOG(log, "unable to create index cache directory {0}: {1}",
+             cache_dir, ec.message());
+    return;
+  }
+
+  // Write to a temporary file and move it into place so that concurrent
+  // debug sessions never observe a partially written cache.
+  const std::string cache_path = cache_file.GetPath();
+  int temp_fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code ec = llvm::sys::fs::createUniqueFile(
+          cache_path + "-%%%%%%.tmp", temp_fd, temp_path)) {
+    LLDB_LOG(log, "unable to create index cache file {0}: {1}", cache_path,
+             ec.message());
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream os(temp_fd, /*shouldClose=*/true);
+    os << index_data;
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      LLDB_LOG(log, "unable to write index cache file {0}", cache_path);
+      return;
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(temp_path, cache_path)) {
+    llvm::sys::fs::remove(temp_path);
+    LLDB_LOG(log, "unable to write index cache file {0}: {1}", cache_path,
+             ec.message());
+  }
+}
+
+void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set,
+                                 ConstStringArena *names) {
   Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
 
   if (log) {
@@ -104,19 +367,29 @@ void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set) {
   const LanguageType cu_language = unit.GetLanguageType();
   DWARFFormValue::FixedFormSizes fixed_form_sizes = unit.GetFixedFormSizes();
 
-  IndexUnitImpl(unit, cu_language, fixed_form_sizes, unit.GetOffset(), set);
+  IndexUnitImpl(unit, cu_language, fixed_form_sizes, unit.GetOffset(), set,
+                names);
 
   SymbolFileDWARFDwo *dwo_symbol_file = unit.GetDwoSymbolFile();
   if (dwo_symbol_file && dwo_symbol_file->GetCompileUnit()) {
     IndexUnitImpl(*dwo_symbol_file->GetCompileUnit(), cu_language,
-                  fixed_form_sizes, unit.GetOffset(), set);
+                  fixed_form_sizes, unit.GetOffset(), set, names);
   }
 }
 
 void ManualDWARFIndex::IndexUnitImpl(
     DWARFUnit &unit, const LanguageType cu_language,
     const DWARFFormValue::FixedFormSizes &fixed_form_sizes,
-    const dw_offset_t cu_offset, IndexSet &set) {
+    const dw_offset_t cu_offset, IndexSet &set, ConstStringArena *names) {
+  // All the names of a table must come from the same pool, so the ones we
+  // get as ConstStrings move to the arena too.
+  auto get_name = [names](llvm::StringRef name) {
+    return names ? names->GetString(name) : ConstString(name);
+  };
+  auto get_arena_name = [names](ConstString name) {
+    return names && name ? names->GetString(name.GetStringRef()) : name;
+  };
+
   for (const DWARFDebugInfoEntry &die : unit.dies()) {
     const dw_tag_t tag = die.Tag();
 
@@ -255,12 +528,14 @@ void ManualDWARFIndex::IndexUnitImpl(
           ObjCLanguage::MethodName objc_method(name, true);
           if (objc_method.IsValid(true)) {
             ConstString objc_class_name_with_category(
-                objc_method.GetClassNameWithCategory());
-            ConstString objc_selector_name(objc_method.GetSelector());
-            ConstString objc_fullname_no_category_name(
-                objc_method.GetFullNameWithoutCategory(true));
-            ConstString objc_class_name_no_category(objc_method.GetClassName());
-            set.function_fullnames.Insert(ConstString(name),
+                get_arena_name(objc_method.GetClassNameWithCategory()));
+            ConstString objc_selector_name(
+                get_arena_name(objc_method.GetSelector()));
+            ConstString objc_fullname_no_category_name(get_arena_name(
+                objc_method.GetFullNameWithoutCategory(true)));
+            ConstString objc_class_name_no_category(
+                get_arena_name(objc_method.GetClassName()));
+            set.function_fullnames.Insert(get_name(name),
                                           DIERef(cu_offset, die.GetOffset()));
             if (objc_class_name_with_category)
               set.objc_class_selectors.Insert(
@@ -283,14 +558,14 @@ void ManualDWARFIndex::IndexUnitImpl(
           bool is_method = DWARFDIE(&unit, &die).IsMethod();
 
           if (is_method)
-            set.function_methods.Insert(ConstString(name),
+            set.function_methods.Insert(get_name(name),
                                         DIERef(cu_offset, die.GetOffset()));
           else
-            set.function_basenames.Insert(ConstString(name),
+            set.function_basenames.Insert(get_name(name),
                                           DIERef(cu_offset, die.GetOffset()));
 
           if (!is_method && !mangled_cstr && !objc_method.IsValid(true))
-            set.function_fullnames.Insert(ConstString(name),
+            set.function_fullnames.Insert(get_name(name),
                                           DIERef(cu_offset, die.GetOffset()));
         }
         if (mangled_cstr) {
@@ -301,7 +576,7 @@ void ManualDWARFIndex::IndexUnitImpl(
           if (name && name != mangled_cstr &&
               ((mangled_cstr[0] == '_') ||
                (::strcmp(name, mangled_cstr) != 0))) {
-            set.function_fullnames.Insert(ConstString(mangled_cstr),
+            set.function_fullnames.Insert(get_name(mangled_cstr),
                                           DIERef(cu_offset, die.GetOffset()));
           }
         }
@@ -320,21 +595,21 @@ void ManualDWARFIndex::IndexUnitImpl(
     case DW_TAG_union_type:
     case DW_TAG_unspecified_type:
       if (name && !is_declaration)
-        set.types.Insert(ConstString(name), DIERef(cu_offset, die.GetOffset()));
+        set.types.Insert(get_name(name), DIERef(cu_offset, die.GetOffset()));
       if (mangled_cstr && !is_declaration)
-        set.types.Insert(ConstString(mangled_cstr),
+        set.types.Insert(get_name(mangled_cstr),
                          DIERef(cu_offset, die.GetOffset()));
       break;
 
     case DW_TAG_namespace:
       if (name)
-        set.namespaces.Insert(ConstString(name),
+        set.namespaces.Insert(get_name(name),
                               DIERef(cu_offset, die.GetOffset()));
       break;
 
     case DW_TAG_variable:
       if (name && has_location_or_const_value && is_global_or_static_variable) {
-        set.globals.Insert(ConstString(name),
+        set.globals.Insert(get_name(name),
                            DIERef(cu_offset, die.GetOffset()));
         // Be sure to include variables by their mangled and demangled names if
         // they have any since a variable can have a basename "i", a mangled
@@ -347,7 +622,7 @@ void ManualDWARFIndex::IndexUnitImpl(
         // entries
         if (mangled_cstr && name != mangled_cstr &&
             ((mangled_cstr[0] == '_') || (::strcmp(name, mangled_cstr) != 0))) {
-          set.globals.Insert(ConstString(mangled_cstr),
+          set.globals.Insert(get_name(mangled_cstr),
                              DIERef(cu_offset, die.GetOffset()));
         }
       }
@@ -397,7 +672,7 @@ void ManualDWARFIndex::GetTypes(ConstString name, DIEArray &offsets) {
 void ManualDWARFIndex::GetTypes(const DWARFDeclContext &context,
                                 DIEArray &offsets) {
   Index();
-  m_set.types.Find(ConstString(context[0].name), offsets);
+  m_set.types.Find(llvm::StringRef(context[0].name), offsets);
 }
 
 void ManualDWARFIndex::GetNamespaces(ConstString name, DIEArray &offsets) {
@@ -12,15 +12,18 @@
 
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+#include "lldb/Utility/FileSpec.h"
 #include "llvm/ADT/DenseSet.h"
 
 namespace lldb_private {
 class ManualDWARFIndex : public DWARFIndex {
 public:
   ManualDWARFIndex(Module &module, DWARFDebugInfo *debug_info,
-                   llvm::DenseSet<dw_offset_t> units_to_avoid = {})
+                   llvm::DenseSet<dw_offset_t> units_to_avoid = {},
+                   FileSpec index_cache_dir = FileSpec())
       : DWARFIndex(module), m_debug_info(debug_info),
-        m_units_to_avoid(std::move(units_to_avoid)) {}
+        m_units_to_avoid(std::move(units_to_avoid)),
+        m_index_cache_dir(std::move(index_cache_dir)) {}
 
   void Preload() override { Index(); }
 
@@ -44,7 +47,6 @@ public:
                               llvm::StringRef name) override {}
   void Dump(Stream &s) override;
 
-private:
   struct IndexSet {
     NameToDIE function_basenames;
     NameToDIE function_fullnames;
@@ -55,18 +57,57 @@ private:
     NameToDIE types;
     NameToDIE namespaces;
   };
+
+  /// Add the names of the DIEs in \a unit, and in its split DWARF unit if it
+  /// has one, to \a set. The tables in \a set are not finalized. The names
+  /// are taken from \a names if it isn't null, and the global string pool
+  /// otherwise.
+  void IndexUnit(DWARFUnit &unit, IndexSet &set,
+                 ConstStringArena *names = nullptr);
+
+private:
   void Index();
-  void IndexUnit(DWARFUnit &unit, IndexSet &set);
+
+  /// Returns the file the finalized index of \a debug_info is cached in, or
+  /// an invalid FileSpec if the index should not be cached.
+  FileSpec GetCacheFile(DWARFDebugInfo &debug_info) const;
+
+  /// Returns the string that identifies the exact contents of the DWARF we
+  /// are indexing. A cache entry is only used if its key matches this one.
+  std::string GetCacheKey(DWARFDebugInfo &debug_info) const;
+
+  /// Fill m_set from \a cache_file. Returns false, leaving m_set empty, if
+  /// the file is missing, has a different version or key, or is malformed.
+  bool LoadFromCache(const FileSpec &cache_file, llvm::StringRef key);
+
+  /// Make m_set the frozen tables of the index in \a buffer_sp, which was
+  /// written by Encode(). Returns false, leaving m_set unchanged, if the
+  /// data has a different version or key, or is malformed. \a source names
+  /// the data in the log.
+  bool Decode(const lldb::DataBufferSP &buffer_sp, llvm::StringRef key,
+              llvm::StringRef source);
+
+  /// Returns the finalized contents of m_set, which must not be frozen, as
+  /// a single flat blob, or an empty string if they can't be encoded.
+  std::string Encode(llvm::StringRef key) const;
+
+  /// Write \a index_data, as returned by Encode(), to \a cache_file.
+  void SaveToCache(const FileSpec &cache_file,
+                   llvm::StringRef index_data) const;
 
   static void
   IndexUnitImpl(DWARFUnit &unit, const lldb::LanguageType cu_language,
                 const DWARFFormValue::FixedFormSizes &fixed_form_sizes,
-                const dw_offset_t cu_offset, IndexSet &set);
+                const dw_offset_t cu_offset, IndexSet &set,
+                ConstStringArena *names);
 
   /// Non-null value means we haven't built the index yet.
   DWARFDebugInfo *m_debug_info;
   /// Which dwarf units should we skip while building the index.
   llvm::DenseSet<dw_offset_t> m_units_to_avoid;
+  /// The directory finalized indexes are cached in across debug sessions.
+  /// Caching is disabled if this is empty.
+  FileSpec m_index_cache_dir;
 
   IndexSet m_set;
 };
@@ -10,6 +10,7 @@
 #include "NameToDIE.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
@@ -18,6 +19,12 @@
 #include "DWARFDebugInfoEntry.h"
 #include "SymbolFileDWARF.h"
 
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -27,21 +34,73 @@ void NameToDIE::Finalize() {
 }
 
 void NameToDIE::Insert(const ConstString &name, const DIERef &die_ref) {
+  assert(!m_frozen && "inserting into a frozen map");
   m_map.Append(name, die_ref);
 }
 
 size_t NameToDIE::Find(const ConstString &name, DIEArray &info_array) const {
+  if (m_frozen)
+    return Find(name.GetStringRef(), info_array);
   return m_map.GetValues(name, info_array);
 }
 
+size_t NameToDIE::Find(llvm::StringRef name, DIEArray &info_array) const {
+  if (!m_frozen)
+    return m_map.GetValues(ConstString(name), info_array);
+
+  const size_t initial_size = info_array.size();
+  const uint32_t bucket = llvm::djbHash(name) % m_num_buckets;
+  lldb::offset_t bucket_offset = bucket * 4;
+  const uint32_t begin = m_table.GetU32(&bucket_offset);
+  const uint32_t end = m_table.GetU32(&bucket_offset);
+  const lldb::offset_t records_offset = (m_num_buckets + 1) * 4;
+  ForEachRecord(records_offset + begin, records_offset + end,
+                [&](const char *record_name, lldb::offset_t refs_offset,
+                    uint64_t num_refs) {
+                  if (strncmp(record_name, name.data(), name.size()) != 0 ||
+                      record_name[name.size()] != '\0')
+                    return true;
+                  ExtractDIERefs(refs_offset, num_refs, info_array);
+                  return false;
+                });
+  return info_array.size() - initial_size;
+}
+
 size_t NameToDIE::Find(const RegularExpression &regex,
                        DIEArray &info_array) const {
-  return m_map.GetValues(regex, info_array);
+  if (!m_frozen)
+    return m_map.GetValues(regex, info_array);
+
+  const size_t initial_size = info_array.size();
+  ForEachRecord((m_num_buckets + 1) * 4, m_table.GetByteSize(),
+                [&](const char *name, lldb::offset_t refs_offset,
+                    uint64_t num_refs) {
+                  if (regex.Execute(name))
+                    ExtractDIERefs(refs_offset, num_refs, info_array);
+                  return true;
+                });
+  return info_array.size() - initial_size;
 }
 
 size_t NameToDIE::FindAllEntriesForCompileUnit(dw_offset_t cu_offset,
                                                DIEArray &info_array) const {
   const size_t initial_size = info_array.size();
+  if (m_frozen) {
+    DIEArray die_refs;
+    ForEachRecord((m_num_buckets + 1) * 4, m_table.GetByteSize(),
+                  [&](const char *name, lldb::offset_t refs_offset,
+                      uint64_t num_refs) {
+                    die_refs.clear();
+                    ExtractDIERefs(refs_offset, num_refs, die_refs);
+                    for (const DIERef &die_ref : die_refs) {
+                      if (cu_offset == die_ref.cu_offset)
+                        info_array.push_back(die_ref);
+                    }
+                    return true;
+                  });
+    return info_array.size() - initial_size;
+  }
+
   const uint32_t size = m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
@@ -52,18 +111,49 @@ size_t NameToDIE::FindAllEntriesForCompileUnit(dw_offset_t cu_offset,
 }
 
 void NameToDIE::Dump(Stream *s) {
-  const uint32_t size = m_map.GetSize();
-  for (uint32_t i = 0; i < size; ++i) {
-    ConstString cstr = m_map.GetCStringAtIndex(i);
-    const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
+  if (m_frozen) {
+    DIEArray die_refs;
+    ForEachRecord((m_num_buckets + 1) * 4, m_table.GetByteSize(),
+                  [&](const char *name, lldb::offset_t refs_offset,
+                      uint64_t num_refs) {
+                    die_refs.clear();
+                    ExtractDIERefs(refs_offset, num_refs, die_refs);
+                    for (const DIERef &die_ref : die_refs)
+                      s->Printf("%p: {0x%8.8x/0x%8.8x} \"%s\"\n",
+                                (const void *)name, die_ref.cu_offset,
+                                die_ref.die_offset, name);
+                    return true;
+                  });
+    return;
+  }
+
+  ForEach([s](ConstString cstr, const DIERef &die_ref) {
     s->Printf("%p: {0x%8.8x/0x%8.8x} \"%s\"\n", (const void *)cstr.GetCString(),
               die_ref.cu_offset, die_ref.die_offset, cstr.GetCString());
-  }
+    return true;
+  });
 }
 
 void NameToDIE::ForEach(
     std::function<bool(ConstString name, const DIERef &die_ref)> const
         &callback) const {
+  if (m_frozen) {
+    DIEArray die_refs;
+    ForEachRecord((m_num_buckets + 1) * 4, m_table.GetByteSize(),
+                  [&](const char *name, lldb::offset_t refs_offset,
+                      uint64_t num_refs) {
+                    die_refs.clear();
+                    ExtractDIERefs(refs_offset, num_refs, die_refs);
+                    const ConstString const_name(name);
+                    for (const DIERef &die_ref : die_refs) {
+                      if (!callback(const_name, die_ref))
+                        return false;
+                    }
+                    return true;
+                  });
+    return;
+  }
+
   const uint32_t size = m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     if (!callback(m_map.GetCStringAtIndexUnchecked(i),
@@ -73,9 +163,173 @@ void NameToDIE::ForEach(
 }
 
 void NameToDIE::Append(const NameToDIE &other) {
+  assert(!m_frozen && "appending to a frozen map");
+  if (other.m_frozen) {
+    // The map is keyed by ConstStrings, so each name of the other map has to
+    // be interned, but only once for all its DIEs.
+    DIEArray die_refs;
+    other.ForEachRecord(
+        (other.m_num_buckets + 1) * 4, other.m_table.GetByteSize(),
+        [&](const char *name, lldb::offset_t refs_offset, uint64_t num_refs) {
+          die_refs.clear();
+          other.ExtractDIERefs(refs_offset, num_refs, die_refs);
+          const ConstString const_name(name);
+          for (const DIERef &die_ref : die_refs)
+            m_map.Append(const_name, die_ref);
+          return true;
+        });
+    return;
+  }
+
   const uint32_t size = other.m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     m_map.Append(other.m_map.GetCStringAtIndexUnchecked(i),
                  other.m_map.GetValueAtIndexUnchecked(i));
   }
 }
+
+bool NameToDIE::ForEachRecord(
+    lldb::offset_t offset, lldb::offset_t end,
+    llvm::function_ref<bool(const char *name, lldb::offset_t refs_offset,
+                            uint64_t num_refs)>
+        callback) const {
+  while (offset < end) {
+    const char *name = m_strtab.PeekCStr(m_table.GetULEB128(&offset));
+    const uint64_t num_refs = m_table.GetULEB128(&offset);
+    const lldb::offset_t refs_offset = offset;
+    // Skip the unit and DIE offset of each reference.
+    for (uint64_t i = 0; i < num_refs && offset < end; ++i) {
+      m_table.Skip_LEB128(&offset);
+      m_table.Skip_LEB128(&offset);
+    }
+    if (name && !callback(name, refs_offset, num_refs))
+      return false;
+  }
+  return true;
+}
+
+void NameToDIE::ExtractDIERefs(lldb::offset_t refs_offset, uint64_t num_refs,
+                               DIEArray &info_array) const {
+  dw_offset_t cu_offset = 0;
+  dw_offset_t die_offset = 0;
+  for (uint64_t i = 0; i < num_refs; ++i) {
+    const dw_offset_t cu_delta = m_table.GetULEB128(&refs_offset);
+    const dw_offset_t die_value = m_table.GetULEB128(&refs_offset);
+    cu_offset += cu_delta;
+    die_offset = cu_delta == 0 ? die_offset + die_value : die_value;
+    info_array.push_back(DIERef(cu_offset, die_offset));
+  }
+}
+
+static void WriteU32(llvm::raw_ostream &os, uint32_t value) {
+  os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void NameToDIE::Encode(
+    llvm::raw_ostream &os,
+    llvm::function_ref<uint32_t(ConstString)> get_string_offset) const {
+  assert(!m_frozen && "encoding a frozen map");
+
+  // The entries of each name are next to each other in the sorted map.
+  struct NameRange {
+    uint32_t bucket;
+    uint32_t begin;
+    uint32_t end;
+  };
+  std::vector<NameRange> names;
+  const uint32_t size = m_map.GetSize();
+  for (uint32_t i = 0; i < size; ++i) {
+    if (i == 0 || m_map.GetCStringAtIndexUnchecked(i) !=
+                      m_map.GetCStringAtIndexUnchecked(i - 1))
+      names.push_back({0, i, i + 1});
+    else
+      names.back().end = i + 1;
+  }
+
+  const uint32_t num_buckets = std::max<size_t>(1, (names.size() + 1) / 2);
+  for (NameRange &range : names)
+    range.bucket =
+        llvm::djbHash(m_map.GetCStringAtIndexUnchecked(range.begin)
+                          .GetStringRef()) %
+        num_buckets;
+  std::stable_sort(names.begin(), names.end(),
+                   [](const NameRange &lhs, const NameRange &rhs) {
+                     return lhs.bucket < rhs.bucket;
+                   });
+
+  std::string records;
+  llvm::raw_string_ostream records_os(records);
+  std::vector<uint32_t> bucket_offsets;
+  bucket_offsets.reserve(num_buckets + 1);
+  DIEArray die_refs;
+  for (const NameRange &range : names) {
+    while (bucket_offsets.size() <= range.bucket)
+      bucket_offsets.push_back(records_os.tell());
+
+    die_refs.clear();
+    for (uint32_t i = range.begin; i < range.end; ++i)
+      die_refs.push_back(m_map.GetValueAtIndexUnchecked(i));
+    std::sort(die_refs.begin(), die_refs.end(),
+              [](const DIERef &lhs, const DIERef &rhs) {
+                return std::make_pair(lhs.cu_offset, lhs.die_offset) <
+                       std::make_pair(rhs.cu_offset, rhs.die_offset);
+              });
+
+    llvm::encodeULEB128(
+        get_string_offset(m_map.GetCStringAtIndexUnchecked(range.begin)),
+        records_os);
+    llvm::encodeULEB128(die_refs.size(), records_os);
+    DIERef prev(dw_offset_t(0), dw_offset_t(0));
+    for (const DIERef &die_ref : die_refs) {
+      const dw_offset_t cu_delta = die_ref.cu_offset - prev.cu_offset;
+      llvm::encodeULEB128(cu_delta, records_os);
+      llvm::encodeULEB128(cu_delta == 0
+                              ? die_ref.die_offset - prev.die_offset
+                              : die_ref.die_offset,
+                          records_os);
+      prev = die_ref;
+    }
+  }
+  records_os.flush();
+  bucket_offsets.resize(num_buckets + 1, records.size());
+
+  WriteU32(os, num_buckets);
+  WriteU32(os, records.size());
+  for (uint32_t bucket_offset : bucket_offsets)
+    WriteU32(os, bucket_offset);
+  os << records;
+}
+
+bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                       const DataExtractor &strtab) {
+  lldb::offset_t offset = *offset_ptr;
+  const uint32_t num_buckets = data.GetU32(&offset);
+  const uint32_t records_size = data.GetU32(&offset);
+  const uint64_t table_size = (num_buckets + 1ull) * 4 + records_size;
+  if (num_buckets == 0 || !data.ValidOffsetForDataOfSize(offset, table_size))
+    return false;
+  // Every offset into the string table is then followed by a terminator.
+  if (strtab.GetByteSize() > 0 &&
+      strtab.GetDataStart()[strtab.GetByteSize() - 1] != '\0')
+    return false;
+
+  DataExtractor table(data, offset, table_size);
+  lldb::offset_t bucket_offset = 0;
+  uint32_t prev_record_offset = 0;
+  for (uint32_t i = 0; i <= num_buckets; ++i) {
+    const uint32_t record_offset = table.GetU32(&bucket_offset);
+    if (record_offset < prev_record_offset || record_offset > records_size)
+      return false;
+    prev_record_offset = record_offset;
+  }
+  if (prev_record_offset != records_size)
+    return false;
+
+  m_map = UniqueCStringMap<DIERef>();
+  m_table = table;
+  m_strtab = strtab;
+  m_num_buckets = num_buckets;
+  m_frozen = true;
+  *offset_ptr = offset + table_size;
+  return true;
+}
@@ -15,10 +15,41 @@
 #include "DIERef.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
 
 class SymbolFileDWARF;
 
+namespace llvm {
+class raw_ostream;
+}
+
+//----------------------------------------------------------------------
+// A map from names to the DIEs that have them.
+//
+// The map is first built with Insert() or Append() and Finalize(). It can
+// then be written to a flat table with Encode() and read back with
+// Decode(). A decoded map is "frozen": it reads the table in place, it
+// doesn't create a ConstString for each name, and stores each name once
+// with the DIE references that have it, delta encoded as ULEB128 numbers.
+// The table is a hash table with a bucket for about every two names. It
+// is laid out as follows, all the numbers in host byte order:
+//
+//   uint32_t num_buckets
+//   uint32_t records_size
+//   uint32_t bucket_offsets[num_buckets + 1]
+//   uint8_t records[records_size]
+//
+// The records of the names which hash to bucket 'b' are found between
+// bucket_offsets[b] and bucket_offsets[b + 1]. Each record is the ULEB128
+// offset of the name in the string table, the number of DIE references and
+// the DIE references sorted by unit and DIE offset. Each DIE reference is
+// the unit offset minus the one of the previous reference, followed by the
+// DIE offset, minus the one of the previous reference if they are in the
+// same unit.
+//----------------------------------------------------------------------
 class NameToDIE {
 public:
   NameToDIE() : m_map() {}
@@ -33,22 +64,71 @@ public:
 
   void Finalize();
 
+  bool IsFrozen() const { return m_frozen; }
+
   size_t Find(const lldb_private::ConstString &name,
               DIEArray &info_array) const;
 
+  size_t Find(llvm::StringRef name, DIEArray &info_array) const;
+
   size_t Find(const lldb_private::RegularExpression &regex,
               DIEArray &info_array) const;
 
   size_t FindAllEntriesForCompileUnit(dw_offset_t cu_offset,
                                       DIEArray &info_array) const;
 
+  //------------------------------------------------------------------
+  // Write the contents of this finalized, not frozen, map to \a os as the
+  // table described above. Names are emitted as string table offsets handed
+  // out by \a get_string_offset so that strings shared between several maps
+  // only need to be stored once.
+  //------------------------------------------------------------------
+  void Encode(llvm::raw_ostream &os,
+              llvm::function_ref<uint32_t(lldb_private::ConstString)>
+                  get_string_offset) const;
+
+  //------------------------------------------------------------------
+  // Make this map a frozen view of a table that was written with
+  // NameToDIE::Encode(). \a data and \a strtab, which contains the NUL
+  // terminated strings the encoded offsets refer to, must share the buffer
+  // holding the table, which this map keeps a reference to. Returns false,
+  // leaving the map unchanged, if the table is truncated or malformed.
+  //------------------------------------------------------------------
+  bool Decode(const lldb_private::DataExtractor &data,
+              lldb::offset_t *offset_ptr,
+              const lldb_private::DataExtractor &strtab);
+
+  // Call 'callback' with each name and DIE reference until it returns false.
+  // The names of a frozen map are interned to be passed as ConstStrings, so
+  // the queries above, which don't, are better suited to it.
   void
   ForEach(std::function<bool(lldb_private::ConstString name,
                              const DIERef &die_ref)> const
               &callback) const;
 
 protected:
+  // Call 'callback' with the name and DIE references of the records of the
+  // frozen table found between the offsets 'offset' and 'end', until it
+  // returns false. Returns false if it did.
+  bool ForEachRecord(
+      lldb::offset_t offset, lldb::offset_t end,
+      llvm::function_ref<bool(const char *name, lldb::offset_t refs_offset,
+                              uint64_t num_refs)>
+          callback) const;
+
+  // Append the 'num_refs' DIE references found at 'refs_offset' in the frozen
+  // table to 'info_array'.
+  void ExtractDIERefs(lldb::offset_t refs_offset, uint64_t num_refs,
+                      DIEArray &info_array) const;
+
   lldb_private::UniqueCStringMap<DIERef> m_map;
+
+  // The frozen table, from its bucket offsets on, and the strings it refers
+  // to.
+  lldb_private::DataExtractor m_table;
+  lldb_private::DataExtractor m_strtab;
+  uint32_t m_num_buckets = 0;
+  bool m_frozen = false;
 };
 
 #endif // SymbolFileDWARF_NameToDIE_h_
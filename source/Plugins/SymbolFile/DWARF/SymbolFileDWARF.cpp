@@ -32,7 +32,9 @@
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/Symbols.h"
+#include "lldb/Host/TaskPool.h"
 
+#include "lldb/Interpreter/OptionValueFileSpec.h"
 #include "lldb/Interpreter/OptionValueFileSpecList.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 
@@ -66,6 +68,7 @@
 #include "DWARFFormValue.h"
 #include "DWARFUnit.h"
 #include "DebugNamesDWARFIndex.h"
+#include "GdbIndexDWARFIndex.h"
 #include "LogChannelDWARF.h"
 #include "ManualDWARFIndex.h"
 #include "SymbolFileDWARFDebugMap.h"
@@ -120,12 +123,16 @@ PropertyDefinition g_properties[] = {
      nullptr,
      "Ignore indexes present in the object files and always index DWARF "
      "manually."},
+    {"index-cache-path", OptionValue::eTypeFileSpec, true, 0, nullptr, nullptr,
+     "The directory in which manually built DWARF indexes are cached across "
+     "debug sessions. Caching is disabled when this is empty."},
     {nullptr, OptionValue::eTypeInvalid, false, 0, nullptr, nullptr, nullptr},
 };
 
 enum {
   ePropertySymLinkPaths,
   ePropertyIgnoreIndexes,
+  ePropertyIndexCachePath,
 };
 
 class PluginProperties : public Properties {
@@ -151,6 +158,13 @@ public:
     return m_collection_sp->GetPropertyAtIndexAsBoolean(
         nullptr, ePropertyIgnoreIndexes, false);
   }
+
+  FileSpec GetIndexCachePath() const {
+    return m_collection_sp
+        ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                  ePropertyIndexCachePath)
+        ->GetCurrentValue();
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
@@ -410,12 +424,13 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile *objfile)
                                   << 32), // Used by SymbolFileDWARFDebugMap to
                                           // when this class parses .o files to
                                           // contain the .o file index/ID
-      m_debug_map_module_wp(), m_debug_map_symfile(NULL), m_data_debug_abbrev(),
-      m_data_debug_aranges(), m_data_debug_frame(), m_data_debug_info(),
-      m_data_debug_line(), m_data_debug_macro(), m_data_debug_loc(),
-      m_data_debug_ranges(), m_data_debug_str(), m_data_apple_names(),
-      m_data_apple_types(), m_data_apple_namespaces(), m_abbr(), m_info(),
-      m_line(), m_fetched_external_modules(false),
+      m_debug_map_module_wp(), m_debug_map_symfile(NULL),
+      m_num_dwo_symfiles_loaded(0), m_dwo_load_time_ns(0),
+      m_data_debug_abbrev(), m_data_debug_aranges(), m_data_debug_frame(),
+      m_data_debug_info(), m_data_debug_line(), m_data_debug_macro(),
+      m_data_debug_loc(), m_data_debug_ranges(), m_data_debug_str(),
+      m_data_apple_names(), m_data_apple_types(), m_data_apple_namespaces(),
+      m_abbr(), m_info(), m_line(), m_fetched_external_modules(false),
       m_supports_DW_AT_APPLE_objc_complete_type(eLazyBoolCalculate), m_ranges(),
       m_unique_ast_type_map() {}
 
@@ -487,10 +502,25 @@ void SymbolFileDWARF::InitializeObject() {
       LLDB_LOG_ERROR(log, index_or.takeError(),
                      "Unable to read .debug_names data: {0}");
     }
+
+    DWARFDataExtractor gdb_index;
+    LoadSectionData(eSectionTypeGdbIndex, gdb_index);
+    if (gdb_index.GetByteSize() > 0) {
+      llvm::Expected<std::unique_ptr<GdbIndexDWARFIndex>> index_or =
+          GdbIndexDWARFIndex::Create(*GetObjectFile()->GetModule(), gdb_index,
+                                     DebugInfo());
+      if (index_or) {
+        m_index = std::move(*index_or);
+        return;
+      }
+      LLDB_LOG_ERROR(log, index_or.takeError(),
+                     "Unable to read .gdb_index data: {0}");
+    }
   }
 
-  m_index = llvm::make_unique<ManualDWARFIndex>(*GetObjectFile()->GetModule(),
-                                                DebugInfo());
+  m_index = llvm::make_unique<ManualDWARFIndex>(
+      *GetObjectFile()->GetModule(), DebugInfo(), llvm::DenseSet<dw_offset_t>(),
+      GetGlobalPluginProperties()->GetIndexCachePath());
 }
 
 bool SymbolFileDWARF::SupportedVersion(uint16_t version) {
@@ -991,6 +1021,7 @@ bool SymbolFileDWARF::ParseImportedModules(
 struct ParseDWARFLineTableCallbackInfo {
   LineTable *line_table;
   std::unique_ptr<LineSequence> sequence_ap;
+  std::vector<std::unique_ptr<LineSequence>> sequences;
   lldb::addr_t addr_mask;
 };
 
@@ -1019,75 +1050,119 @@ static void ParseDWARFLineTableCallback(dw_offset_t offset,
         state.column, state.file, state.is_stmt, state.basic_block,
         state.prologue_end, state.epilogue_begin, state.end_sequence);
     if (state.end_sequence) {
-      // First, put the current sequence into the line table.
-      line_table->InsertSequence(info->sequence_ap.get());
-      // Then, empty it to prepare for the next sequence.
-      info->sequence_ap->Clear();
+      // Keep the sequence, they are all put into the line table at once when
+      // we are done.
+      info->sequences.push_back(std::move(info->sequence_ap));
     }
   }
 }
 
+lldb::addr_t SymbolFileDWARF::GetLineTableAddressMask() {
+  /*
+   * MIPS:
+   * The SymbolContext may not have a valid target, thus we may not be able
+   * to call Address::GetOpcodeLoadAddress() which would clear the bit #0
+   * for MIPS. Use ArchSpec to clear the bit #0.
+  */
+  ArchSpec arch;
+  GetObjectFile()->GetArchitecture(arch);
+  switch (arch.GetMachine()) {
+  case llvm::Triple::mips:
+  case llvm::Triple::mipsel:
+  case llvm::Triple::mips64:
+  case llvm::Triple::mips64el:
+    return ~((lldb::addr_t)1);
+  default:
+    return ~((lldb::addr_t)0);
+  }
+}
+
+dw_offset_t SymbolFileDWARF::GetLineTableOffset(CompileUnit *comp_unit) {
+  DWARFUnit *dwarf_cu = GetDWARFCompileUnit(comp_unit);
+  if (dwarf_cu) {
+    const DWARFBaseDIE dwarf_cu_die = dwarf_cu->GetUnitDIEOnly();
+    if (dwarf_cu_die)
+      return dwarf_cu_die.GetAttributeValueAsUnsigned(DW_AT_stmt_list,
+                                                      DW_INVALID_OFFSET);
+  }
+  return DW_INVALID_OFFSET;
+}
+
+std::unique_ptr<LineTable>
+SymbolFileDWARF::ParseLineTable(CompileUnit *comp_unit,
+                                dw_offset_t cu_line_offset,
+                                lldb::addr_t addr_mask) {
+  std::unique_ptr<LineTable> line_table_ap(new LineTable(comp_unit));
+  ParseDWARFLineTableCallbackInfo info;
+  info.line_table = line_table_ap.get();
+  info.addr_mask = addr_mask;
+
+  lldb::offset_t offset = cu_line_offset;
+  DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset,
+                                      ParseDWARFLineTableCallback, &info);
+  line_table_ap->InsertSequences(info.sequences);
+  return line_table_ap;
+}
+
+bool SymbolFileDWARF::SetCompileUnitLineTable(
+    CompileUnit &comp_unit, std::unique_ptr<LineTable> line_table_ap) {
+  SymbolFileDWARFDebugMap *debug_map_symfile = GetDebugMapSymfile();
+  if (debug_map_symfile) {
+    // We have an object file that has a line table with addresses that are
+    // not linked. We need to link the line table and convert the addresses
+    // that are relative to the .o file into addresses for the main
+    // executable.
+    comp_unit.SetLineTable(
+        debug_map_symfile->LinkOSOLineTable(this, line_table_ap.get()));
+    return false;
+  }
+  comp_unit.SetLineTable(line_table_ap.release());
+  return true;
+}
+
 bool SymbolFileDWARF::ParseCompileUnitLineTable(const SymbolContext &sc) {
   assert(sc.comp_unit);
   if (sc.comp_unit->GetLineTable() != NULL)
     return true;
 
-  DWARFUnit *dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
-  if (dwarf_cu) {
-    const DWARFBaseDIE dwarf_cu_die = dwarf_cu->GetUnitDIEOnly();
-    if (dwarf_cu_die) {
-      const dw_offset_t cu_line_offset =
-          dwarf_cu_die.GetAttributeValueAsUnsigned(DW_AT_stmt_list,
-                                                   DW_INVALID_OFFSET);
-      if (cu_line_offset != DW_INVALID_OFFSET) {
-        std::unique_ptr<LineTable> line_table_ap(new LineTable(sc.comp_unit));
-        if (line_table_ap.get()) {
-          ParseDWARFLineTableCallbackInfo info;
-          info.line_table = line_table_ap.get();
-
-          /*
-           * MIPS:
-           * The SymbolContext may not have a valid target, thus we may not be
-           * able
-           * to call Address::GetOpcodeLoadAddress() which would clear the bit
-           * #0
-           * for MIPS. Use ArchSpec to clear the bit #0.
-          */
-          ArchSpec arch;
-          GetObjectFile()->GetArchitecture(arch);
-          switch (arch.GetMachine()) {
-          case llvm::Triple::mips:
-          case llvm::Triple::mipsel:
-          case llvm::Triple::mips64:
-          case llvm::Triple::mips64el:
-            info.addr_mask = ~((lldb::addr_t)1);
-            break;
-          default:
-            info.addr_mask = ~((lldb::addr_t)0);
-            break;
-          }
+  const dw_offset_t cu_line_offset = GetLineTableOffset(sc.comp_unit);
+  if (cu_line_offset == DW_INVALID_OFFSET)
+    return false;
+  return SetCompileUnitLineTable(
+      *sc.comp_unit, ParseLineTable(sc.comp_unit, cu_line_offset,
+                                    GetLineTableAddressMask()));
+}
 
-          lldb::offset_t offset = cu_line_offset;
-          DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset,
-                                              ParseDWARFLineTableCallback,
-                                              &info);
-          SymbolFileDWARFDebugMap *debug_map_symfile = GetDebugMapSymfile();
-          if (debug_map_symfile) {
-            // We have an object file that has a line table with addresses that
-            // are not linked. We need to link the line table and convert the
-            // addresses that are relative to the .o file into addresses for
-            // the main executable.
-            sc.comp_unit->SetLineTable(
-                debug_map_symfile->LinkOSOLineTable(this, line_table_ap.get()));
-          } else {
-            sc.comp_unit->SetLineTable(line_table_ap.release());
-            return true;
-          }
-        }
-      }
-    }
+void SymbolFileDWARF::ParseLineTables(
+    llvm::ArrayRef<CompileUnit *> comp_units) {
+  std::vector<CompileUnit *> units_to_parse;
+  std::vector<dw_offset_t> line_offsets;
+  for (CompileUnit *comp_unit : comp_units) {
+    if (comp_unit->HasParsedLineTable())
+      continue;
+    const dw_offset_t cu_line_offset = GetLineTableOffset(comp_unit);
+    if (cu_line_offset == DW_INVALID_OFFSET)
+      continue;
+    units_to_parse.push_back(comp_unit);
+    line_offsets.push_back(cu_line_offset);
   }
-  return false;
+  if (units_to_parse.size() < 2)
+    return;
+
+  // Running the line programs only reads .debug_line and fills the new line
+  // tables, so they can all run at once. Handing the tables to the compile
+  // units, which links them when we are part of a debug map, is done after.
+  const lldb::addr_t addr_mask = GetLineTableAddressMask();
+  std::vector<std::unique_ptr<LineTable>> line_tables(units_to_parse.size());
+  auto parser_fn = [&](size_t idx) {
+    line_tables[idx] =
+        ParseLineTable(units_to_parse[idx], line_offsets[idx], addr_mask);
+  };
+  TaskMapOverInt(0, units_to_parse.size(), parser_fn);
+
+  for (size_t idx = 0; idx < units_to_parse.size(); ++idx)
+    SetCompileUnitLineTable(*units_to_parse[idx],
+                            std::move(line_tables[idx]));
 }
 
 lldb_private::DebugMacrosSP
@@ -1563,6 +1638,21 @@ SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
   if (GetDebugMapSymfile())
     return nullptr;
 
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_ptr<SymbolFileDWARFDwo> dwo_symfile =
+      OpenDwoSymbolFile(dwarf_cu, cu_die);
+  if (dwo_symfile) {
+    ++m_num_dwo_symfiles_loaded;
+    m_dwo_load_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+  }
+  return dwo_symfile;
+}
+
+std::unique_ptr<SymbolFileDWARFDwo>
+SymbolFileDWARF::OpenDwoSymbolFile(DWARFUnit &dwarf_cu,
+                                   const DWARFDebugInfoEntry &cu_die) {
   const char *dwo_name = cu_die.GetAttributeValueAsString(
       this, &dwarf_cu, DW_AT_GNU_dwo_name, nullptr);
   if (!dwo_name)
@@ -1610,6 +1700,9 @@ void SymbolFileDWARF::UpdateExternalModuleListIfNeeded() {
   m_fetched_external_modules = true;
 
   DWARFDebugInfo *debug_info = DebugInfo();
+  // We are about to look at the DIE of every unit, get them all at once.
+  if (debug_info)
+    debug_info->ExtractUnitDIEs();
 
   const uint32_t num_compile_units = GetNumCompileUnits();
   for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx) {
@@ -1868,12 +1961,31 @@ uint32_t SymbolFileDWARF::ResolveSymbolContext(const FileSpec &file_spec,
     if (debug_info) {
       uint32_t cu_idx;
       DWARFUnit *dwarf_cu = NULL;
+      const bool full_match = (bool)file_spec.GetDirectory();
+
+      // Parse the line tables of all the units we are going to look at at
+      // once, instead of one after the other in the loop below.
+      if (line != 0) {
+        debug_info->ExtractUnitDIEs();
+        std::vector<CompileUnit *> comp_units;
+        for (cu_idx = 0;
+             (dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx)) != NULL;
+             ++cu_idx) {
+          CompileUnit *dc_cu = GetCompUnitForDWARFCompUnit(dwarf_cu, cu_idx);
+          if (dc_cu == NULL)
+            continue;
+          if (check_inlines ? dc_cu->GetSupportFiles().FindFileIndex(
+                                  1, file_spec, true) != UINT32_MAX
+                            : FileSpec::Equal(file_spec, *dc_cu, full_match))
+            comp_units.push_back(dc_cu);
+        }
+        ParseLineTables(comp_units);
+      }
 
       for (cu_idx = 0;
            (dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx)) != NULL;
            ++cu_idx) {
         CompileUnit *dc_cu = GetCompUnitForDWARFCompUnit(dwarf_cu, cu_idx);
-        const bool full_match = (bool)file_spec.GetDirectory();
         bool file_spec_matches_cu_file_spec =
             dc_cu != NULL && FileSpec::Equal(file_spec, *dc_cu, full_match);
         if (check_inlines || file_spec_matches_cu_file_spec) {
@@ -3745,6 +3857,23 @@ uint32_t SymbolFileDWARF::GetPluginVersion() { return 1; }
 
 void SymbolFileDWARF::Dump(lldb_private::Stream &s) { m_index->Dump(s); }
 
+uint64_t SymbolFileDWARF::GetParsedDebugInfoByteSize() {
+  // Don't parse the unit headers just to report that nothing was parsed.
+  if (!m_info)
+    return 0;
+  uint64_t byte_size = 0;
+  const size_t num_units = m_info->GetNumCompileUnits();
+  for (size_t i = 0; i < num_units; ++i)
+    byte_size += m_info->GetCompileUnitAtIndex(i)->GetParsedDIEsByteSize();
+  return byte_size;
+}
+
+uint32_t SymbolFileDWARF::GetSplitDebugInfoLoadStatistics(
+    std::chrono::nanoseconds &load_time) {
+  load_time = std::chrono::nanoseconds(m_dwo_load_time_ns.load());
+  return m_num_dwo_symfiles_loaded;
+}
+
 SymbolFileDWARFDebugMap *SymbolFileDWARF::GetDebugMapSymfile() {
   if (m_debug_map_symfile == NULL && !m_debug_map_module_wp.expired()) {
     lldb::ModuleSP module_sp(m_debug_map_module_wp.lock());
@@ -12,14 +12,18 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 // Other libraries and framework includes
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Threading.h"
 
@@ -318,6 +322,11 @@ public:
 
   void Dump(lldb_private::Stream &s) override;
 
+  uint64_t GetParsedDebugInfoByteSize() override;
+
+  uint32_t
+  GetSplitDebugInfoLoadStatistics(std::chrono::nanoseconds &load_time) override;
+
 protected:
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, lldb_private::Type *>
       DIEToTypePtr;
@@ -350,6 +359,30 @@ protected:
 
   DWARFUnit *GetNextUnparsedDWARFCompileUnit(DWARFUnit *prev_cu);
 
+  // The mask to apply to the addresses of the line tables.
+  lldb::addr_t GetLineTableAddressMask();
+
+  // The offset of the line program of "comp_unit" in .debug_line, or
+  // DW_INVALID_OFFSET if it doesn't have one.
+  dw_offset_t GetLineTableOffset(lldb_private::CompileUnit *comp_unit);
+
+  // Run the line program at "cu_line_offset" into a new line table for
+  // "comp_unit". This can run for several units at once.
+  std::unique_ptr<lldb_private::LineTable>
+  ParseLineTable(lldb_private::CompileUnit *comp_unit,
+                 dw_offset_t cu_line_offset, lldb::addr_t addr_mask);
+
+  // Give a parsed line table to "comp_unit", after linking it if this is the
+  // symbol file of an object file of a debug map. Returns false in that case,
+  // like ParseCompileUnitLineTable().
+  bool
+  SetCompileUnitLineTable(lldb_private::CompileUnit &comp_unit,
+                          std::unique_ptr<lldb_private::LineTable> line_table);
+
+  // Parse the line tables of all of "comp_units" which don't have one yet, in
+  // parallel.
+  void ParseLineTables(llvm::ArrayRef<lldb_private::CompileUnit *> comp_units);
+
   bool GetFunction(const DWARFDIE &die, lldb_private::SymbolContext &sc);
 
   lldb_private::Function *
@@ -452,11 +485,17 @@ protected:
 
   SymbolFileDWARFDwp *GetDwpSymbolFile();
 
+  std::unique_ptr<SymbolFileDWARFDwo>
+  OpenDwoSymbolFile(DWARFUnit &dwarf_cu, const DWARFDebugInfoEntry &cu_die);
+
   lldb::ModuleWP m_debug_map_module_wp;
   SymbolFileDWARFDebugMap *m_debug_map_symfile;
 
   llvm::once_flag m_dwp_symfile_once_flag;
   std::unique_ptr<SymbolFileDWARFDwp> m_dwp_symfile;
+  // The .dwo files are opened from the threads extracting the unit DIEs.
+  std::atomic<uint32_t> m_num_dwo_symfiles_loaded;
+  std::atomic<uint64_t> m_dwo_load_time_ns;
 
   lldb_private::DWARFDataExtractor m_dwarf_data;
 
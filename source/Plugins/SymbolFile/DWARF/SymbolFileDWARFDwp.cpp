@@ -75,6 +75,7 @@ SymbolFileDWARFDwp::Create(lldb::ModuleSP module_sp,
 
 void SymbolFileDWARFDwp::InitDebugCUIndexMap() {
   m_debug_cu_index_map.clear();
+  m_debug_cu_index_map.reserve(m_debug_cu_index.getRows().size());
   for (const auto &entry : m_debug_cu_index.getRows())
     m_debug_cu_index_map.emplace(entry.getSignature(), &entry);
 }
@@ -87,6 +88,8 @@ SymbolFileDWARFDwp::SymbolFileDWARFDwp(lldb::ModuleSP module_sp,
 std::unique_ptr<SymbolFileDWARFDwo>
 SymbolFileDWARFDwp::GetSymbolFileForDwoId(DWARFUnit *dwarf_cu,
                                           uint64_t dwo_id) {
+  if (m_debug_cu_index_map.count(dwo_id) == 0)
+    return nullptr;
   return std::unique_ptr<SymbolFileDWARFDwo>(
       new SymbolFileDWARFDwoDwp(this, m_obj_file, dwarf_cu, dwo_id));
 }
@@ -13,6 +13,7 @@
 // C Includes
 // C++ Includes
 #include <memory>
+#include <unordered_map>
 
 // Other libraries and framework includes
 #include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
@@ -28,6 +29,8 @@ public:
   static std::unique_ptr<SymbolFileDWARFDwp>
   Create(lldb::ModuleSP module_sp, const lldb_private::FileSpec &file_spec);
 
+  // Returns nullptr if the package doesn't contain the unit 'dwo_id', so
+  // that the caller can look for a .dwo file instead.
   std::unique_ptr<SymbolFileDWARFDwo>
   GetSymbolFileForDwoId(DWARFUnit *dwarf_cu, uint64_t dwo_id);
 
@@ -49,7 +52,10 @@ private:
   std::map<lldb::SectionType, lldb_private::DWARFDataExtractor> m_sections;
 
   llvm::DWARFUnitIndex m_debug_cu_index;
-  std::map<uint64_t, const llvm::DWARFUnitIndex::Entry *> m_debug_cu_index_map;
+  // The rows of m_debug_cu_index by unit signature. This is looked up for
+  // every section of every unit, which a hash table does in constant time.
+  std::unordered_map<uint64_t, const llvm::DWARFUnitIndex::Entry *>
+      m_debug_cu_index_map;
 };
 
 #endif // SymbolFileDWARFDwp_SymbolFileDWARFDwp_h_
@@ -206,6 +206,11 @@ LineTable *CompileUnit::GetLineTable() {
   return m_line_table_ap.get();
 }
 
+bool CompileUnit::HasParsedLineTable() const {
+  return m_line_table_ap.get() != nullptr ||
+         m_flags.Test(flagsParsedLineTable);
+}
+
 void CompileUnit::SetLineTable(LineTable *line_table) {
   if (line_table == nullptr)
     m_flags.Clear(flagsParsedLineTable);
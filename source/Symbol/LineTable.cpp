@@ -22,7 +22,7 @@ using namespace lldb_private;
 // LineTable constructor
 //----------------------------------------------------------------------
 LineTable::LineTable(CompileUnit *comp_unit)
-    : m_comp_unit(comp_unit), m_entries() {}
+    : m_comp_unit(comp_unit), m_entries(), m_sequence_index() {}
 
 //----------------------------------------------------------------------
 // Destructor
@@ -45,6 +45,7 @@ void LineTable::InsertLineEntry(lldb::addr_t file_addr, uint32_t line,
   entry_collection::iterator pos =
       upper_bound(begin_pos, end_pos, entry, less_than_bp);
 
+  m_sequence_index.Clear();
   //  Stream s(stdout);
   //  s << "\n\nBefore:\n";
   //  Dump (&s, Address::DumpStyleFileAddress);
@@ -103,6 +104,7 @@ void LineTable::InsertSequence(LineSequence *sequence) {
   if (seq->m_entries.empty())
     return;
   Entry &entry = seq->m_entries.front();
+  m_sequence_index.Clear();
 
   // If the first entry address in this sequence is greater than or equal to
   // the address of the last item in our entry collection, just append.
@@ -137,6 +139,92 @@ void LineTable::InsertSequence(LineSequence *sequence) {
   m_entries.insert(pos, seq->m_entries.begin(), seq->m_entries.end());
 }
 
+void LineTable::InsertSequences(
+    std::vector<std::unique_ptr<LineSequence>> &sequences) {
+  LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
+  auto get_entries = [](const std::unique_ptr<LineSequence> &sequence)
+      -> const entry_collection & {
+    return static_cast<LineSequenceImpl *>(sequence.get())->m_entries;
+  };
+  // Sequences with the same first entry stay in the order of the line
+  // program, like when they are inserted one by one.
+  std::stable_sort(sequences.begin(), sequences.end(),
+                   [&](const std::unique_ptr<LineSequence> &lhs,
+                       const std::unique_ptr<LineSequence> &rhs) {
+                     const entry_collection &lhs_entries = get_entries(lhs);
+                     const entry_collection &rhs_entries = get_entries(rhs);
+                     if (lhs_entries.empty() || rhs_entries.empty())
+                       return !rhs_entries.empty();
+                     return less_than_bp(lhs_entries.front(),
+                                         rhs_entries.front());
+                   });
+
+  size_t num_entries = m_entries.size();
+  for (const auto &sequence : sequences)
+    num_entries += get_entries(sequence).size();
+  m_entries.reserve(num_entries);
+  for (const auto &sequence : sequences)
+    InsertSequence(sequence.get());
+  IndexSequences();
+}
+
+void LineTable::IndexSequences() {
+  m_sequence_index.Clear();
+  uint32_t first_idx = 0;
+  const uint32_t count = m_entries.size();
+  for (uint32_t idx = 0; idx < count; ++idx) {
+    if (!m_entries[idx].is_terminal_entry)
+      continue;
+    const lldb::addr_t base = m_entries[first_idx].file_addr;
+    if (first_idx < idx && m_entries[idx].file_addr > base)
+      m_sequence_index.Append(SequenceIndex::Entry(
+          base, m_entries[idx].file_addr - base, {first_idx, idx}));
+    first_idx = idx + 1;
+  }
+  // Entries which aren't terminated can't be indexed, use the sorted entries
+  // alone to find addresses then. Do the same when sequences overlap, like the
+  // ones of functions removed by the linker which all start at zero, so which
+  // one an address resolves to doesn't change.
+  if (first_idx != count) {
+    m_sequence_index.Clear();
+    return;
+  }
+  m_sequence_index.Sort();
+  for (size_t idx = 1; idx < m_sequence_index.GetSize(); ++idx) {
+    if (m_sequence_index.GetEntryRef(idx).GetRangeBase() <
+        m_sequence_index.GetEntryRef(idx - 1).GetRangeEnd()) {
+      m_sequence_index.Clear();
+      return;
+    }
+  }
+}
+
+uint32_t LineTable::FindEntryIndexInSequences(lldb::addr_t file_addr) const {
+  const SequenceIndex::Entry *sequence =
+      m_sequence_index.FindEntryThatContains(file_addr);
+  if (sequence == nullptr)
+    return UINT32_MAX;
+  // The entries of a sequence have increasing addresses, and the sequence
+  // range starts at the first one, so the entry for the address is the last
+  // one at or before it. If several are at that address, use the first of
+  // them.
+  Entry search_entry;
+  search_entry.file_addr = file_addr;
+  entry_collection::const_iterator begin_pos =
+      m_entries.begin() + sequence->data.first;
+  entry_collection::const_iterator end_pos =
+      m_entries.begin() + sequence->data.second;
+  entry_collection::const_iterator pos = std::lower_bound(
+      begin_pos, end_pos, search_entry, Entry::EntryAddressLessThan);
+  if (pos == end_pos || pos->file_addr != file_addr) {
+    assert(pos != begin_pos);
+    --pos;
+    while (pos != begin_pos && (pos - 1)->file_addr == pos->file_addr)
+      --pos;
+  }
+  return std::distance(m_entries.begin(), pos);
+}
+
 //----------------------------------------------------------------------
 LineTable::Entry::LessThanBinaryPredicate::LessThanBinaryPredicate(
     LineTable *line_table)
@@ -184,7 +272,17 @@ bool LineTable::FindLineEntryByAddress(const Address &so_addr,
   if (so_addr.GetModule().get() == m_comp_unit->GetModule().get()) {
     Entry search_entry;
     search_entry.file_addr = so_addr.GetFileAddress();
-    if (search_entry.file_addr != LLDB_INVALID_ADDRESS) {
+    if (search_entry.file_addr != LLDB_INVALID_ADDRESS &&
+        !m_sequence_index.IsEmpty()) {
+      // Only look at the entries of the sequence containing the address.
+      const uint32_t match_idx =
+          FindEntryIndexInSequences(search_entry.file_addr);
+      if (match_idx != UINT32_MAX) {
+        success = ConvertEntryAtIndexToLineEntry(match_idx, line_entry);
+        if (index_ptr != nullptr && success)
+          *index_ptr = match_idx;
+      }
+    } else if (search_entry.file_addr != LLDB_INVALID_ADDRESS) {
       entry_collection::const_iterator begin_pos = m_entries.begin();
       entry_collection::const_iterator end_pos = m_entries.end();
       entry_collection::const_iterator pos = lower_bound(
@@ -535,5 +633,6 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   }
   if (line_table_ap->m_entries.empty())
     return nullptr;
+  line_table_ap->IndexSequences();
   return line_table_ap.release();
 }
@@ -16,6 +16,7 @@
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/STLUtils.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -257,121 +258,139 @@ void Symtab::InitNameIndexes() {
     m_name_indexes_computed = true;
     static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
     Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
-    // Create the name index vector to be able to quickly search by name
-    const size_t num_symbols = m_symbols.size();
-#if 1
-    m_name_to_index.Reserve(num_symbols);
-#else
-    // TODO: benchmark this to see if we save any memory. Otherwise we
-    // will always keep the memory reserved in the vector unless we pull some
-    // STL swap magic and then recopy...
-    uint32_t actual_count = 0;
-    for (const_iterator pos = m_symbols.begin(), end = m_symbols.end();
-         pos != end; ++pos) {
-      const Mangled &mangled = pos->GetMangled();
-      if (mangled.GetMangledName())
-        ++actual_count;
-
-      if (mangled.GetDemangledName())
-        ++actual_count;
-    }
-
-    m_name_to_index.Reserve(actual_count);
-#endif
-
-    // The "const char *" in "class_contexts" and backlog::value_type::second
-    // must come from a ConstString::GetCString()
+    const uint32_t num_symbols = m_symbols.size();
+
+    // Demangling the symbols is by far the most expensive part, so split the
+    // symbols in ranges that are indexed in parallel. Every range gets its
+    // own maps and demangler, which is expensive to instantiate, so we don't
+    // create more ranges than needed to keep the workers busy.
+    const uint32_t min_symbols_per_range = 1024;
+    const uint32_t num_ranges = std::max<uint32_t>(
+        1, std::min<uint32_t>(num_symbols / min_symbols_per_range,
+                              4 * GetHardwareConcurrencyHint()));
+    std::vector<NameIndexSet> sets(num_ranges);
+    TaskMapOverInt(0, num_ranges, [&](size_t i) {
+      InitNameIndexesForRange(uint64_t(num_symbols) * i / num_ranges,
+                              uint64_t(num_symbols) * (i + 1) / num_ranges,
+                              sets[i]);
+    });
+
+    // Merge the maps of all the ranges in symbol order.
+    auto merge = [&sets](NameToIndexMap &map,
+                         NameToIndexMap NameIndexSet::*member) {
+      size_t num_entries = 0;
+      for (const NameIndexSet &set : sets)
+        num_entries += (set.*member).GetSize();
+      map.Reserve(num_entries);
+      for (NameIndexSet &set : sets) {
+        map.Append(set.*member);
+        (set.*member).Clear();
+      }
+    };
+    merge(m_name_to_index, &NameIndexSet::name_to_index);
+    merge(m_basename_to_index, &NameIndexSet::basename_to_index);
+    merge(m_method_to_index, &NameIndexSet::method_to_index);
+    merge(m_selector_to_index, &NameIndexSet::selector_to_index);
+
+    // Methods whose declaration context wasn't known to be a class when they
+    // were indexed can be resolved now that we have seen all the symbols.
     std::set<const char *> class_contexts;
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
-    backlog.reserve(num_symbols / 2);
-
-    // Instantiation of the demangler is expensive, so better use a single one
-    // for all entries during batch processing.
-    RichManglingContext rmc;
-    NameToIndexMap::Entry entry;
-
-    for (entry.value = 0; entry.value < num_symbols; ++entry.value) {
-      Symbol *symbol = &m_symbols[entry.value];
-
-      // Don't let trampolines get into the lookup by name map If we ever need
-      // the trampoline symbols to be searchable by name we can remove this and
-      // then possibly add a new bool to any of the Symtab functions that
-      // lookup symbols by name to indicate if they want trampolines.
-      if (symbol->IsTrampoline())
-        continue;
+    for (const NameIndexSet &set : sets)
+      class_contexts.insert(set.class_contexts.begin(),
+                            set.class_contexts.end());
+    for (const NameIndexSet &set : sets) {
+      for (const auto &record : set.backlog)
+        RegisterBacklogEntry(record.first, record.second, class_contexts);
+    }
 
-      // If the symbol's name string matched a Mangled::ManglingScheme, it is
-      // stored in the mangled field.
-      Mangled &mangled = symbol->GetMangled();
-      entry.cstring = mangled.GetMangledName();
-      if (entry.cstring) {
-        m_name_to_index.Append(entry);
-
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(
-                                        entry.cstring.GetStringRef()));
-          m_name_to_index.Append(entry);
-        }
+    m_name_to_index.ParallelSort();
+    m_name_to_index.SizeToFit();
+    m_selector_to_index.ParallelSort();
+    m_selector_to_index.SizeToFit();
+    m_basename_to_index.ParallelSort();
+    m_basename_to_index.SizeToFit();
+    m_method_to_index.ParallelSort();
+    m_method_to_index.SizeToFit();
+  }
+}
 
-        const SymbolType type = symbol->GetType();
-        if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
-          if (mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
-            RegisterMangledNameEntry(entry, class_contexts, backlog, rmc);
-        }
+void Symtab::InitNameIndexesForRange(uint32_t begin, uint32_t end,
+                                     NameIndexSet &set) {
+  set.name_to_index.Reserve(end - begin);
+  set.backlog.reserve((end - begin) / 2);
+
+  // Instantiation of the demangler is expensive, so better use a single one
+  // for all entries during batch processing.
+  RichManglingContext rmc;
+  NameToIndexMap::Entry entry;
+
+  for (entry.value = begin; entry.value < end; ++entry.value) {
+    Symbol *symbol = &m_symbols[entry.value];
+
+    // Don't let trampolines get into the lookup by name map If we ever need
+    // the trampoline symbols to be searchable by name we can remove this and
+    // then possibly add a new bool to any of the Symtab functions that
+    // lookup symbols by name to indicate if they want trampolines.
+    if (symbol->IsTrampoline())
+      continue;
+
+    // If the symbol's name string matched a Mangled::ManglingScheme, it is
+    // stored in the mangled field.
+    Mangled &mangled = symbol->GetMangled();
+    entry.cstring = mangled.GetMangledName();
+    if (entry.cstring) {
+      set.name_to_index.Append(entry);
+
+      if (symbol->ContainsLinkerAnnotations()) {
+        // If the symbol has linker annotations, also add the version without
+        // the annotations.
+        entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(
+                                      entry.cstring.GetStringRef()));
+        set.name_to_index.Append(entry);
       }
 
-      // Symbol name strings that didn't match a Mangled::ManglingScheme, are
-      // stored in the demangled field.
-      entry.cstring = mangled.GetDemangledName(symbol->GetLanguage());
-      if (entry.cstring) {
-        m_name_to_index.Append(entry);
-
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(
-                                        entry.cstring.GetStringRef()));
-          m_name_to_index.Append(entry);
-        }
+      const SymbolType type = symbol->GetType();
+      if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
+        if (mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
+          RegisterMangledNameEntry(entry, set, rmc);
       }
+    }
 
-      // If the demangled name turns out to be an ObjC name, and is a category
-      // name, add the version without categories to the index too.
-      ObjCLanguage::MethodName objc_method(entry.cstring.GetStringRef(), true);
-      if (objc_method.IsValid(true)) {
-        entry.cstring = objc_method.GetSelector();
-        m_selector_to_index.Append(entry);
-
-        ConstString objc_method_no_category(
-            objc_method.GetFullNameWithoutCategory(true));
-        if (objc_method_no_category) {
-          entry.cstring = objc_method_no_category;
-          m_name_to_index.Append(entry);
-        }
+    // Symbol name strings that didn't match a Mangled::ManglingScheme, are
+    // stored in the demangled field.
+    entry.cstring = mangled.GetDemangledName(symbol->GetLanguage());
+    if (entry.cstring) {
+      set.name_to_index.Append(entry);
+
+      if (symbol->ContainsLinkerAnnotations()) {
+        // If the symbol has linker annotations, also add the version without
+        // the annotations.
+        entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(
+                                      entry.cstring.GetStringRef()));
+        set.name_to_index.Append(entry);
       }
     }
 
-    for (const auto &record : backlog) {
-      RegisterBacklogEntry(record.first, record.second, class_contexts);
+    // If the demangled name turns out to be an ObjC name, and is a category
+    // name, add the version without categories to the index too.
+    ObjCLanguage::MethodName objc_method(entry.cstring.GetStringRef(), true);
+    if (objc_method.IsValid(true)) {
+      entry.cstring = objc_method.GetSelector();
+      set.selector_to_index.Append(entry);
+
+      ConstString objc_method_no_category(
+          objc_method.GetFullNameWithoutCategory(true));
+      if (objc_method_no_category) {
+        entry.cstring = objc_method_no_category;
+        set.name_to_index.Append(entry);
+      }
     }
-
-    m_name_to_index.Sort();
-    m_name_to_index.SizeToFit();
-    m_selector_to_index.Sort();
-    m_selector_to_index.SizeToFit();
-    m_basename_to_index.Sort();
-    m_basename_to_index.SizeToFit();
-    m_method_to_index.Sort();
-    m_method_to_index.SizeToFit();
   }
 }
 
-void Symtab::RegisterMangledNameEntry(
-    NameToIndexMap::Entry &entry, std::set<const char *> &class_contexts,
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-    RichManglingContext &rmc) {
+void Symtab::RegisterMangledNameEntry(NameToIndexMap::Entry &entry,
+                                      NameIndexSet &set,
+                                      RichManglingContext &rmc) {
   // Only register functions that have a base name.
   rmc.ParseFunctionBaseName();
   llvm::StringRef base_name = rmc.GetBufferRef();
@@ -387,36 +406,36 @@ void Symtab::RegisterMangledNameEntry(
   // Register functions with no context.
   if (decl_context.empty()) {
     // This has to be a basename
-    m_basename_to_index.Append(entry);
+    set.basename_to_index.Append(entry);
     // If there is no context (no namespaces or class scopes that come before
     // the function name) then this also could be a fullname.
-    m_name_to_index.Append(entry);
+    set.name_to_index.Append(entry);
     return;
   }
 
   // Make sure we have a pool-string pointer and see if we already know the
   // context name.
   const char *decl_context_ccstr = ConstString(decl_context).GetCString();
-  auto it = class_contexts.find(decl_context_ccstr);
+  auto it = set.class_contexts.find(decl_context_ccstr);
 
   // Register constructors and destructors. They are methods and create
   // declaration contexts.
   if (rmc.IsCtorOrDtor()) {
-    m_method_to_index.Append(entry);
-    if (it == class_contexts.end())
-      class_contexts.insert(it, decl_context_ccstr);
+    set.method_to_index.Append(entry);
+    if (it == set.class_contexts.end())
+      set.class_contexts.insert(it, decl_context_ccstr);
     return;
   }
 
   // Register regular methods with a known declaration context.
-  if (it != class_contexts.end()) {
-    m_method_to_index.Append(entry);
+  if (it != set.class_contexts.end()) {
+    set.method_to_index.Append(entry);
     return;
   }
 
   // Regular methods in unknown declaration contexts are put to the backlog. We
   // will revisit them once we processed all remaining symbols.
-  backlog.push_back(std::make_pair(entry, decl_context_ccstr));
+  set.backlog.push_back(std::make_pair(entry, decl_context_ccstr));
 }
 
 void Symtab::RegisterBacklogEntry(
@@ -1064,7 +1083,8 @@ void Symtab::SymbolIndicesToSymbolContextList(
   size_t num_indices = symbol_indexes.size();
   if (num_indices > 0) {
     SymbolContext sc;
-    sc.module_sp = m_objfile->GetModule();
+    if (m_objfile)
+      sc.module_sp = m_objfile->GetModule();
     for (size_t i = 0; i < num_indices; i++) {
       sc.symbol = SymbolAtIndex(symbol_indexes[i]);
       if (sc.symbol)
@@ -11,6 +11,7 @@
 // C Includes
 #include <inttypes.h>
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/RangeMap.h"
@@ -28,7 +29,10 @@ using namespace lldb_private;
 MemoryCache::MemoryCache(Process &process)
     : m_mutex(), m_L1_cache(), m_L2_cache(), m_invalid_ranges(),
       m_process(process),
-      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()) {}
+      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()),
+      m_prefetch_line_count(process.GetMemoryCachePrefetchLines()),
+      m_last_line_addr(LLDB_INVALID_ADDRESS), m_stride(0), m_stride_count(0),
+      m_stats() {}
 
 //----------------------------------------------------------------------
 // Destructor
@@ -42,6 +46,15 @@ void MemoryCache::Clear(bool clear_invalid_ranges) {
   if (clear_invalid_ranges)
     m_invalid_ranges.Clear();
   m_L2_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+  m_prefetch_line_count = m_process.GetMemoryCachePrefetchLines();
+  m_last_line_addr = LLDB_INVALID_ADDRESS;
+  m_stride = 0;
+  m_stride_count = 0;
+}
+
+MemoryCache::Statistics MemoryCache::GetStatistics() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_stats;
 }
 
 void MemoryCache::AddL1CacheData(lldb::addr_t addr, const void *src,
@@ -62,18 +75,24 @@ void MemoryCache::Flush(addr_t addr, size_t size) {
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
-  // Erase any blocks from the L1 cache that intersect with the flush range
+  // Erase any blocks from the L1 cache that intersect with the flush range.
+  // Only the block starting before the flush range can extend into it, all
+  // the other candidates start inside of it.
   if (!m_L1_cache.empty()) {
     AddrRange flush_range(addr, size);
     BlockMap::iterator pos = m_L1_cache.upper_bound(addr);
     if (pos != m_L1_cache.begin()) {
       --pos;
-    }
-    while (pos != m_L1_cache.end()) {
       AddrRange chunk_range(pos->first, pos->second->GetByteSize());
-      if (!chunk_range.DoesIntersect(flush_range))
-        break;
+      if (chunk_range.DoesIntersect(flush_range)) {
+        pos = m_L1_cache.erase(pos);
+        ++m_stats.invalidations;
+      } else
+        ++pos;
+    }
+    while (pos != m_L1_cache.end() && flush_range.Contains(pos->first)) {
       pos = m_L1_cache.erase(pos);
+      ++m_stats.invalidations;
     }
   }
 
@@ -83,23 +102,16 @@ void MemoryCache::Flush(addr_t addr, size_t size) {
     const addr_t first_cache_line_addr = addr - (addr % cache_line_byte_size);
     const addr_t last_cache_line_addr =
         end_addr - (end_addr % cache_line_byte_size);
-    // Watch for overflow where size will cause us to go off the end of the
-    // 64 bit address space
-    uint32_t num_cache_lines;
-    if (last_cache_line_addr >= first_cache_line_addr)
-      num_cache_lines = ((last_cache_line_addr - first_cache_line_addr) /
-                         cache_line_byte_size) +
-                        1;
-    else
-      num_cache_lines =
-          (UINT64_MAX - first_cache_line_addr + 1) / cache_line_byte_size;
-
-    uint32_t cache_idx = 0;
-    for (addr_t curr_addr = first_cache_line_addr; cache_idx < num_cache_lines;
-         curr_addr += cache_line_byte_size, ++cache_idx) {
-      BlockMap::iterator pos = m_L2_cache.find(curr_addr);
-      if (pos != m_L2_cache.end())
-        m_L2_cache.erase(pos);
+    // Only erase the lines that are actually cached instead of looking up
+    // every line of the range, so that large writes stay cheap. Watch for
+    // overflow where size will cause us to go off the end of the 64 bit
+    // address space.
+    BlockMap::iterator pos = m_L2_cache.lower_bound(first_cache_line_addr);
+    while (pos != m_L2_cache.end() &&
+           (last_cache_line_addr < first_cache_line_addr ||
+            pos->first <= last_cache_line_addr)) {
+      pos = m_L2_cache.erase(pos);
+      ++m_stats.invalidations;
     }
   }
 }
@@ -141,6 +153,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // when reading from them (no partial reads from the L1 cache).
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+
   if (!m_L1_cache.empty()) {
     AddrRange read_range(addr, dst_len);
     BlockMap::iterator pos = m_L1_cache.upper_bound(addr);
@@ -151,6 +164,8 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
     if (chunk_range.Contains(read_range)) {
       memcpy(dst, pos->second->GetBytes() + addr - chunk_range.GetRangeBase(),
              dst_len);
+      ++m_stats.l1_hits;
+      m_stats.bytes_from_cache += dst_len;
       return dst_len;
     }
   }
@@ -165,6 +180,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   if (dst && dst_len > m_L2_cache_line_byte_size) {
     size_t bytes_read =
         m_process.ReadMemoryFromInferior(addr, dst, dst_len, error);
+    m_stats.bytes_from_process += bytes_read;
     // Add this non block sized range to the L1 cache if we actually read
     // anything
     if (bytes_read > 0)
@@ -177,6 +193,9 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
     uint8_t *dst_buf = (uint8_t *)dst;
     addr_t curr_addr = addr - (addr % cache_line_byte_size);
     addr_t cache_offset = addr - curr_addr;
+    // The line we just read from the process, so that finding it in the
+    // cache right after isn't counted as a hit.
+    addr_t filled_line_addr = LLDB_INVALID_ADDRESS;
 
     while (bytes_left > 0) {
       if (m_invalid_ranges.FindEntryThatContains(curr_addr)) {
@@ -189,12 +208,18 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
       BlockMap::const_iterator end = m_L2_cache.end();
 
       if (pos != end) {
+        TrackLineAccess(curr_addr);
+        if (curr_addr != filled_line_addr)
+          ++m_stats.l2_hits;
+
         size_t curr_read_size = cache_line_byte_size - cache_offset;
         if (curr_read_size > bytes_left)
           curr_read_size = bytes_left;
 
         memcpy(dst_buf + dst_len - bytes_left,
                pos->second->GetBytes() + cache_offset, curr_read_size);
+        if (curr_addr != filled_line_addr)
+          m_stats.bytes_from_cache += curr_read_size;
 
         bytes_left -= curr_read_size;
         curr_addr += curr_read_size + cache_offset;
@@ -208,12 +233,16 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
             if (pos->first != curr_addr)
               break;
 
+            TrackLineAccess(curr_addr);
+            ++m_stats.l2_hits;
+
             curr_read_size = pos->second->GetByteSize();
             if (curr_read_size > bytes_left)
               curr_read_size = bytes_left;
 
             memcpy(dst_buf + dst_len - bytes_left, pos->second->GetBytes(),
                    curr_read_size);
+            m_stats.bytes_from_cache += curr_read_size;
 
             bytes_left -= curr_read_size;
             curr_addr += curr_read_size;
@@ -231,17 +260,11 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
-        std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(
-            new DataBufferHeap(cache_line_byte_size, 0));
-        size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-            curr_addr, data_buffer_heap_ap->GetBytes(),
-            data_buffer_heap_ap->GetByteSize(), error);
-        if (process_bytes_read == 0)
+        TrackLineAccess(curr_addr);
+        ++m_stats.l2_misses;
+        if (FillL2CacheLine(curr_addr, error) == 0)
           return dst_len - bytes_left;
-
-        if (process_bytes_read != cache_line_byte_size)
-          data_buffer_heap_ap->SetByteSize(process_bytes_read);
-        m_L2_cache[curr_addr] = DataBufferSP(data_buffer_heap_ap.release());
+        filled_line_addr = curr_addr;
         // We have read data and put it into the cache, continue through the
         // loop again to get the data out of the cache...
       }
@@ -251,6 +274,139 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   return dst_len - bytes_left;
 }
 
+void MemoryCache::TrackLineAccess(addr_t line_addr) {
+  if (line_addr == m_last_line_addr)
+    return;
+  if (m_last_line_addr != LLDB_INVALID_ADDRESS) {
+    const int64_t stride = line_addr - m_last_line_addr;
+    if (stride == m_stride) {
+      if (m_stride_count < UINT32_MAX)
+        ++m_stride_count;
+    } else {
+      m_stride = stride;
+      m_stride_count = 1;
+    }
+  }
+  m_last_line_addr = line_addr;
+}
+
+bool MemoryCache::IntersectsInvalidRange(addr_t addr, addr_t size) {
+  const AddrRange range(addr, size);
+  for (size_t i = 0, e = m_invalid_ranges.GetSize(); i < e; ++i) {
+    const InvalidRanges::Entry *entry = m_invalid_ranges.GetEntryAtIndex(i);
+    if (entry->GetRangeBase() >= range.GetRangeEnd())
+      break;
+    if (range.DoesIntersect(*entry))
+      return true;
+  }
+  return false;
+}
+
+std::vector<addr_t> MemoryCache::GetPrefetchLines(addr_t line_addr) {
+  std::vector<addr_t> lines;
+  const uint32_t cache_line_byte_size = m_L2_cache_line_byte_size;
+  // Wait until the same stride was seen twice in a row before reading ahead
+  // and don't try to follow strides spanning more than a few lines, those
+  // are rarely part of a regular access pattern.
+  const int64_t max_stride = 16 * static_cast<int64_t>(cache_line_byte_size);
+  if (m_prefetch_line_count == 0 || m_stride_count < 2 ||
+      m_stride > max_stride || m_stride < -max_stride)
+    return lines;
+
+  addr_t next_addr = line_addr;
+  for (uint32_t i = 0; i < m_prefetch_line_count; ++i) {
+    const addr_t prev_addr = next_addr;
+    next_addr += m_stride;
+    // Stop at the ends of the address space, at lines that are already
+    // cached and before reading anything from an invalid range.
+    if ((m_stride > 0) != (next_addr > prev_addr) ||
+        next_addr + cache_line_byte_size < next_addr ||
+        m_L2_cache.count(next_addr) ||
+        IntersectsInvalidRange(next_addr, cache_line_byte_size))
+      break;
+    lines.push_back(next_addr);
+  }
+  return lines;
+}
+
+size_t MemoryCache::FillL2CacheLine(addr_t line_addr, Status &error) {
+  const uint32_t cache_line_byte_size = m_L2_cache_line_byte_size;
+  std::vector<addr_t> prefetch_lines = GetPrefetchLines(line_addr);
+
+  if (!prefetch_lines.empty()) {
+    const size_t num_lines = prefetch_lines.size() + 1;
+    DataBufferHeap prefetch_buffer(num_lines * cache_line_byte_size, 0);
+    Status prefetch_error;
+    // The bytes read for each of the lines, starting with line_addr
+    std::vector<size_t> bytes_read;
+
+    if (m_stride == cache_line_byte_size) {
+      // Sequential reads: fetch all the lines in a single read
+      const size_t total_bytes_read = m_process.ReadMemoryFromInferior(
+          line_addr, prefetch_buffer.GetBytes(), prefetch_buffer.GetByteSize(),
+          prefetch_error);
+      for (size_t i = 0; i < num_lines; ++i) {
+        const size_t line_offset = i * cache_line_byte_size;
+        bytes_read.push_back(
+            total_bytes_read > line_offset
+                ? std::min<size_t>(total_bytes_read - line_offset,
+                                   cache_line_byte_size)
+                : 0);
+      }
+    } else {
+      // Strided reads: let the process fetch the lines as a list of ranges,
+      // which is done in one round trip when it supports it. Like all the
+      // other reads filling the cache, this bypasses it and removes the
+      // breakpoint traps.
+      std::vector<Process::MemoryRange> ranges;
+      ranges.emplace_back(line_addr, cache_line_byte_size);
+      for (addr_t prefetch_addr : prefetch_lines)
+        ranges.emplace_back(prefetch_addr, cache_line_byte_size);
+      bytes_read = m_process.ReadMemoryRangesFromInferior(
+          ranges, llvm::MutableArrayRef<uint8_t>(
+                      prefetch_buffer.GetBytes(),
+                      prefetch_buffer.GetByteSize()));
+    }
+
+    for (size_t bytes : bytes_read)
+      m_stats.bytes_from_process += bytes;
+    ++m_stats.prefetch_reads;
+
+    // Only keep the prefetched lines that could be read entirely, a short
+    // line limits all reads going through it. If the line we were asked for
+    // couldn't be read entirely, retry it on its own below to get the error
+    // for it.
+    if (bytes_read.size() == num_lines &&
+        bytes_read[0] == cache_line_byte_size) {
+      for (size_t i = 0; i < num_lines; ++i) {
+        if (bytes_read[i] != cache_line_byte_size)
+          continue;
+        const addr_t curr_line_addr = i == 0 ? line_addr : prefetch_lines[i - 1];
+        m_L2_cache[curr_line_addr] = DataBufferSP(new DataBufferHeap(
+            prefetch_buffer.GetBytes() + i * cache_line_byte_size,
+            cache_line_byte_size));
+        if (i > 0)
+          ++m_stats.prefetched_lines;
+      }
+      return cache_line_byte_size;
+    }
+  }
+
+  std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(
+      new DataBufferHeap(cache_line_byte_size, 0));
+  size_t process_bytes_read = m_process.ReadMemoryFromInferior(
+      line_addr, data_buffer_heap_ap->GetBytes(),
+      data_buffer_heap_ap->GetByteSize(), error);
+  m_stats.bytes_from_process += process_bytes_read;
+  if (process_bytes_read == 0)
+    return 0;
+
+  if (process_bytes_read != cache_line_byte_size)
+    data_buffer_heap_ap->SetByteSize(process_bytes_read);
+  m_L2_cache[line_addr] = DataBufferSP(data_buffer_heap_ap.release());
+  return process_bytes_read;
+}
+
 AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
                                uint32_t permissions, uint32_t chunk_size)
     : m_range(addr, byte_size), m_permissions(permissions),
@@ -142,6 +142,10 @@ static PropertyDefinition g_properties[] = {
      nullptr, "If true, detach will attempt to keep the process stopped."},
     {"memory-cache-line-size", OptionValue::eTypeUInt64, false, 512, nullptr,
      nullptr, "The memory cache line size"},
+    {"memory-cache-prefetch-lines", OptionValue::eTypeUInt64, false, 4,
+     nullptr, nullptr, "The number of memory cache lines to read ahead once a "
+                       "sequence of reads with a constant stride has been "
+                       "detected. Zero disables prefetching."},
     {"optimization-warnings", OptionValue::eTypeBoolean, false, true, nullptr,
      nullptr, "If true, warn when stopped in code that is optimized where "
               "stepping and variable availability may not behave as expected."},
@@ -159,6 +163,7 @@ enum {
   ePropertyStopOnSharedLibraryEvents,
   ePropertyDetachKeepsStopped,
   ePropertyMemCacheLineSize,
+  ePropertyMemCachePrefetchLines,
   ePropertyWarningOptimization,
   ePropertyStopOnExec
 };
@@ -205,6 +210,12 @@ uint64_t ProcessProperties::GetMemoryCacheLineSize() const {
       nullptr, idx, g_properties[idx].default_uint_value);
 }
 
+uint64_t ProcessProperties::GetMemoryCachePrefetchLines() const {
+  const uint32_t idx = ePropertyMemCachePrefetchLines;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 Args ProcessProperties::GetExtraStartupCommands() const {
   Args args;
   const uint32_t idx = ePropertyExtraStartCommand;
@@ -2320,6 +2331,63 @@ size_t Process::ReadCStringFromMemory(addr_t addr, char *dst,
   return total_cstr_len;
 }
 
+std::vector<size_t>
+Process::ReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                          llvm::MutableArrayRef<uint8_t> buffer) {
+  return ReadMemoryRangesImpl(ranges, buffer, !GetDisableMemoryCache());
+}
+
+std::vector<size_t>
+Process::ReadMemoryRangesFromInferior(llvm::ArrayRef<MemoryRange> ranges,
+                                      llvm::MutableArrayRef<uint8_t> buffer) {
+  return ReadMemoryRangesImpl(ranges, buffer, false);
+}
+
+std::vector<size_t>
+Process::ReadMemoryRangesImpl(llvm::ArrayRef<MemoryRange> ranges,
+                              llvm::MutableArrayRef<uint8_t> buffer,
+                              bool use_memory_cache) {
+  size_t total_size = 0;
+  for (const MemoryRange &range : ranges)
+    total_size += range.GetByteSize();
+  if (buffer.size() < total_size)
+    return std::vector<size_t>(ranges.size(), 0);
+
+  std::vector<size_t> bytes_read = DoReadMemoryRanges(ranges, buffer.data());
+  if (bytes_read.size() != ranges.size()) {
+    bytes_read.clear();
+    uint8_t *dst = buffer.data();
+    for (const MemoryRange &range : ranges) {
+      Status error;
+      if (use_memory_cache)
+        bytes_read.push_back(
+            ReadMemory(range.GetRangeBase(), dst, range.GetByteSize(), error));
+      else
+        bytes_read.push_back(ReadMemoryFromInferior(
+            range.GetRangeBase(), dst, range.GetByteSize(), error));
+      dst += range.GetByteSize();
+    }
+    return bytes_read;
+  }
+
+  // Replace any software breakpoint opcodes that fall into the ranges back
+  // into the buffer before we return
+  uint8_t *dst = buffer.data();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    bytes_read[i] = std::min(bytes_read[i], ranges[i].GetByteSize());
+    if (bytes_read[i] > 0) {
+      RemoveBreakpointOpcodesFromBuffer(ranges[i].GetRangeBase(), bytes_read[i],
+                                        dst);
+      // Keep what was read the way the memory cache keeps large reads.
+      if (use_memory_cache)
+        m_memory_cache.AddL1CacheData(ranges[i].GetRangeBase(), dst,
+                                      bytes_read[i]);
+    }
+    dst += ranges[i].GetByteSize();
+  }
+  return bytes_read;
+}
+
 size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
                                        Status &error) {
   if (buf == nullptr || size == 0)
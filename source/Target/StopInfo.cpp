@@ -484,6 +484,18 @@ protected:
               auto_continue_says_stop = false;
             }
 
+            // Tracepoints record their hits and continue, when the process
+            // can record them.
+            if (bp_loc_sp->GetBreakpoint().IsTracepoint() &&
+                thread_sp->GetProcess()->RecordTracepointHit(
+                    *thread_sp, bp_loc_sp->GetBreakpoint())) {
+              if (log)
+                log->Printf("Continuing tracepoint %s after recording its "
+                            "hit.",
+                            loc_desc.GetData());
+              auto_continue_says_stop = false;
+            }
+
             bool callback_says_stop = true;
 
             // FIXME: For now the callbacks have to run in async mode - the
@@ -176,6 +176,9 @@ void Target::CleanupProcess() {
   DisableAllWatchpoints(false);
   ClearAllWatchpointHitCounts();
   ClearAllWatchpointHistoricValues();
+  // The compiled conditions and expressions live in the process.
+  m_breakpoint_condition_cache.Clear();
+  m_user_expression_cache.Clear();
 }
 
 void Target::DeleteCurrentProcess() {
@@ -1532,7 +1535,9 @@ bool Target::MergeArchitecture(const ArchSpec &arch_spec) {
   return false;
 }
 
-void Target::WillClearList(const ModuleList &module_list) {}
+void Target::WillClearList(const ModuleList &module_list) {
+  ++m_images_generation;
+}
 
 void Target::ModuleAdded(const ModuleList &module_list,
                          const ModuleSP &module_sp) {
@@ -1559,6 +1564,7 @@ void Target::ModuleUpdated(const ModuleList &module_list,
                            const ModuleSP &old_module_sp,
                            const ModuleSP &new_module_sp) {
   // A module is replacing an already added module
+  ++m_images_generation;
   if (m_valid) {
     m_breakpoint_list.UpdateBreakpointsWhenModuleIsReplaced(old_module_sp,
                                                             new_module_sp);
@@ -1568,6 +1574,7 @@ void Target::ModuleUpdated(const ModuleList &module_list,
 }
 
 void Target::ModulesDidLoad(ModuleList &module_list) {
+  ++m_images_generation;
   if (m_valid && module_list.GetSize()) {
     m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
@@ -1580,6 +1587,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
 }
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
+  ++m_images_generation;
   if (m_valid && module_list.GetSize()) {
     if (m_process_sp) {
       LanguageRuntime *runtime =
@@ -1598,6 +1606,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 }
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
+  ++m_images_generation;
   if (m_valid && module_list.GetSize()) {
     UnloadModuleSections(module_list);
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
@@ -1911,7 +1920,7 @@ bool Target::ReadPointerFromMemory(const Address &addr, bool prefer_file_cache,
 }
 
 ModuleSP Target::GetSharedModule(const ModuleSpec &module_spec,
-                                 Status *error_ptr) {
+                                 Status *error_ptr, bool notify) {
   ModuleSP module_sp;
 
   Status error;
@@ -2045,7 +2054,7 @@ ModuleSP Target::GetSharedModule(const ModuleSpec &module_spec,
           old_module_sp.reset();
           ModuleList::RemoveSharedModuleIfOrphaned(old_module_ptr);
         } else
-          m_images.Append(module_sp);
+          AppendModuleIfNeeded(module_sp, notify);
       } else
         module_sp.reset();
     }
@@ -2055,6 +2064,18 @@ ModuleSP Target::GetSharedModule(const ModuleSpec &module_spec,
   return module_sp;
 }
 
+bool Target::AppendModuleIfNeeded(const ModuleSP &module_sp, bool notify) {
+  if (notify)
+    return m_images.AppendIfNeeded(module_sp);
+
+  // Do what ModuleAdded would, short of calling ModulesDidLoad.
+  if (!m_images.AppendIfNeeded(module_sp, false))
+    return false;
+  if (m_valid)
+    LoadScriptingResourceForModule(module_sp, this);
+  return true;
+}
+
 TargetSP Target::CalculateTarget() { return shared_from_this(); }
 
 ProcessSP Target::CalculateProcess() { return m_process_sp; }
@@ -2227,6 +2248,75 @@ ClangASTImporterSP Target::GetClangASTImporter() {
   return ClangASTImporterSP();
 }
 
+StructuredData::DictionarySP Target::GetStatistics() {
+  auto stats_sp = std::make_shared<StructuredData::Dictionary>();
+  for (uint32_t i = 0; i < m_stats_storage.size(); ++i)
+    stats_sp->AddIntegerItem(
+        GetStatDescription(static_cast<StatisticKind>(i)),
+        m_stats_storage[i]);
+  stats_sp->AddIntegerItem(
+      "Time spent compiling breakpoint conditions (ns)",
+      m_breakpoint_condition_cache.GetCompileTime().count());
+
+  if (ProcessSP process_sp = GetProcessSP()) {
+    const MemoryCache::Statistics stats =
+        process_sp->GetMemoryCacheStatistics();
+    stats_sp->AddIntegerItem("Number of memory cache L1 hits", stats.l1_hits);
+    stats_sp->AddIntegerItem("Number of memory cache L2 hits", stats.l2_hits);
+    stats_sp->AddIntegerItem("Number of memory cache L2 misses",
+                             stats.l2_misses);
+    stats_sp->AddIntegerItem("Bytes read from the memory cache",
+                             stats.bytes_from_cache);
+    stats_sp->AddIntegerItem("Bytes read from the process",
+                             stats.bytes_from_process);
+    stats_sp->AddIntegerItem("Number of memory cache prefetch reads",
+                             stats.prefetch_reads);
+    stats_sp->AddIntegerItem("Number of memory cache lines prefetched",
+                             stats.prefetched_lines);
+    stats_sp->AddIntegerItem("Number of memory cache invalidations",
+                             stats.invalidations);
+  }
+
+  const ConstString::MemoryReport string_pool = ConstString::GetMemoryReport();
+  stats_sp->AddIntegerItem("Number of strings in the string pool",
+                           string_pool.num_strings);
+  stats_sp->AddIntegerItem("Bytes used by the string pool",
+                           string_pool.bytes_used);
+  stats_sp->AddIntegerItem("Bytes allocated by the string pool",
+                           string_pool.bytes_allocated);
+  stats_sp->AddIntegerItem("Number of string pool shards",
+                           string_pool.num_shards);
+  stats_sp->AddIntegerItem("Fewest strings in a string pool shard",
+                           string_pool.min_shard_strings);
+  stats_sp->AddIntegerItem("Most strings in a string pool shard",
+                           string_pool.max_shard_strings);
+
+  auto module_bytes_sp = std::make_shared<StructuredData::Dictionary>();
+  auto split_debug_info_sp = std::make_shared<StructuredData::Dictionary>();
+  GetImages().ForEach([&](const ModuleSP &module_sp) {
+    const std::string path = module_sp->GetFileSpec().GetPath();
+    const uint64_t byte_size = module_sp->GetParsedDebugInfoByteSize();
+    if (byte_size > 0)
+      module_bytes_sp->AddIntegerItem(path, byte_size);
+
+    std::chrono::nanoseconds load_time;
+    const uint32_t num_loaded =
+        module_sp->GetSplitDebugInfoLoadStatistics(load_time);
+    if (num_loaded > 0) {
+      auto module_stats_sp = std::make_shared<StructuredData::Dictionary>();
+      module_stats_sp->AddIntegerItem("Number of files opened", num_loaded);
+      module_stats_sp->AddIntegerItem("Time spent opening files (ns)",
+                                      load_time.count());
+      split_debug_info_sp->AddItem(path, module_stats_sp);
+    }
+    return true;
+  });
+  stats_sp->AddItem("Debug info bytes held per module", module_bytes_sp);
+  stats_sp->AddItem("Split debug info files opened per module",
+                    split_debug_info_sp);
+  return stats_sp;
+}
+
 void Target::SettingsInitialize() { Process::SettingsInitialize(); }
 
 void Target::SettingsTerminate() { Process::SettingsTerminate(); }
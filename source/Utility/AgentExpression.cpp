@@ -0,0 +1,277 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+using namespace lldb_private;
+
+// Conditions are a few dozen opcodes. The limits only stop a broken
+// expression from running forever or growing the stack without bound.
+static const size_t g_max_steps = 10000;
+static const size_t g_max_stack_size = 64;
+
+void AgentExpression::EmitOperand(uint64_t value, size_t byte_size) {
+  for (size_t i = byte_size; i > 0; --i)
+    m_bytes.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+}
+
+void AgentExpression::EmitConst(uint64_t value) {
+  if (llvm::isUInt<8>(value)) {
+    Emit(eOpConst8);
+    EmitOperand(value, 1);
+  } else if (llvm::isUInt<16>(value)) {
+    Emit(eOpConst16);
+    EmitOperand(value, 2);
+  } else if (llvm::isUInt<32>(value)) {
+    Emit(eOpConst32);
+    EmitOperand(value, 4);
+  } else {
+    Emit(eOpConst64);
+    EmitOperand(value, 8);
+  }
+}
+
+void AgentExpression::EmitReg(uint32_t reg) {
+  Emit(eOpReg);
+  EmitOperand(reg, 2);
+}
+
+void AgentExpression::EmitRef(uint32_t byte_size) {
+  switch (byte_size) {
+  case 1:
+    Emit(eOpRef8);
+    break;
+  case 2:
+    Emit(eOpRef16);
+    break;
+  case 4:
+    Emit(eOpRef32);
+    break;
+  default:
+    Emit(eOpRef64);
+    break;
+  }
+}
+
+void AgentExpression::EmitExt(uint8_t bits) {
+  Emit(eOpExt);
+  EmitOperand(bits, 1);
+}
+
+void AgentExpression::EmitZeroExt(uint8_t bits) {
+  Emit(eOpZeroExt);
+  EmitOperand(bits, 1);
+}
+
+size_t AgentExpression::EmitGoto(Opcode op) {
+  Emit(op);
+  const size_t operand_offset = m_bytes.size();
+  EmitOperand(0, 2);
+  return operand_offset;
+}
+
+void AgentExpression::SetGotoTarget(size_t operand_offset, size_t target) {
+  m_bytes[operand_offset] = static_cast<uint8_t>(target >> 8);
+  m_bytes[operand_offset + 1] = static_cast<uint8_t>(target);
+}
+
+Status AgentExpression::Evaluate(Context &context, uint64_t &result) const {
+  std::vector<uint64_t> stack;
+  size_t pc = 0;
+
+  // Read the big endian operand of 'byte_size' bytes following the opcode.
+  auto read_operand = [&](size_t byte_size, uint64_t &value) {
+    if (pc + byte_size > m_bytes.size())
+      return false;
+    value = 0;
+    for (size_t i = 0; i < byte_size; ++i)
+      value = (value << 8) | m_bytes[pc++];
+    return true;
+  };
+
+  for (size_t steps = 0; steps < g_max_steps; ++steps) {
+    if (pc >= m_bytes.size())
+      return Status("agent expression runs past its end");
+    const uint8_t op = m_bytes[pc++];
+
+    // The number of values each opcode pops off the stack.
+    size_t num_args = 0;
+    switch (op) {
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64:
+    case eOpReg:
+    case eOpGoto:
+      break;
+    case eOpLogNot:
+    case eOpBitNot:
+    case eOpExt:
+    case eOpZeroExt:
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64:
+    case eOpIfGoto:
+    case eOpEnd:
+    case eOpDup:
+    case eOpPop:
+      num_args = 1;
+      break;
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned:
+    case eOpSwap:
+      num_args = 2;
+      break;
+    default:
+      return Status("unsupported agent expression opcode 0x%2.2x at offset %zu",
+                    op, pc - 1);
+    }
+    if (stack.size() < num_args)
+      return Status("agent expression stack underflow at offset %zu", pc - 1);
+    if (stack.size() >= g_max_stack_size)
+      return Status("agent expression stack overflow at offset %zu", pc - 1);
+
+    uint64_t operand = 0;
+    switch (op) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned: {
+      const uint64_t b = stack.back();
+      stack.pop_back();
+      const uint64_t a = stack.back();
+      uint64_t &value = stack.back();
+      switch (op) {
+      case eOpAdd:
+        value = a + b;
+        break;
+      case eOpSub:
+        value = a - b;
+        break;
+      case eOpMul:
+        value = a * b;
+        break;
+      case eOpBitAnd:
+        value = a & b;
+        break;
+      case eOpBitOr:
+        value = a | b;
+        break;
+      case eOpBitXor:
+        value = a ^ b;
+        break;
+      case eOpEqual:
+        value = a == b;
+        break;
+      case eOpLessSigned:
+        value = static_cast<int64_t>(a) < static_cast<int64_t>(b);
+        break;
+      default:
+        value = a < b;
+        break;
+      }
+      break;
+    }
+    case eOpLogNot:
+      stack.back() = !stack.back();
+      break;
+    case eOpBitNot:
+      stack.back() = ~stack.back();
+      break;
+    case eOpExt:
+    case eOpZeroExt:
+      if (!read_operand(1, operand))
+        return Status("truncated agent expression");
+      if (operand == 0 || operand >= 64)
+        break;
+      if (op == eOpExt)
+        stack.back() = llvm::SignExtend64(stack.back(), operand);
+      else
+        stack.back() &= llvm::maskTrailingOnes<uint64_t>(operand);
+      break;
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64: {
+      const size_t byte_size = 1u << (op - eOpRef8);
+      Status error = context.ReadMemory(stack.back(), byte_size, stack.back());
+      if (error.Fail())
+        return error;
+      break;
+    }
+    case eOpIfGoto:
+    case eOpGoto: {
+      if (!read_operand(2, operand))
+        return Status("truncated agent expression");
+      bool taken = true;
+      if (op == eOpIfGoto) {
+        taken = stack.back() != 0;
+        stack.pop_back();
+      }
+      if (taken) {
+        if (operand >= m_bytes.size())
+          return Status("agent expression jumps out of bounds to %" PRIu64,
+                        operand);
+        pc = operand;
+      }
+      break;
+    }
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64:
+      if (!read_operand(1u << (op - eOpConst8), operand))
+        return Status("truncated agent expression");
+      stack.push_back(operand);
+      break;
+    case eOpReg: {
+      if (!read_operand(2, operand))
+        return Status("truncated agent expression");
+      uint64_t value;
+      Status error = context.ReadRegister(operand, value);
+      if (error.Fail())
+        return error;
+      stack.push_back(value);
+      break;
+    }
+    case eOpEnd:
+      result = stack.back();
+      return Status();
+    case eOpDup:
+      stack.push_back(stack.back());
+      break;
+    case eOpPop:
+      stack.pop_back();
+      break;
+    case eOpSwap:
+      std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+      break;
+    }
+  }
+  return Status("agent expression didn't end after %zu steps", g_max_steps);
+}
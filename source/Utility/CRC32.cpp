@@ -0,0 +1,158 @@
+//===-- CRC32.cpp -----------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/CRC32.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define LLDB_CRC32_HAVE_PCLMUL 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace lldb_private;
+
+namespace {
+typedef uint32_t (*CRC32Function)(uint32_t crc, const uint8_t *p, size_t size);
+
+// Lookup tables for the slicing-by-8 algorithm. m_table[0] is the classic
+// byte at a time table and m_table[k][b] is the CRC of byte b followed by k
+// zero bytes, which allows folding eight input bytes per step.
+struct CRC32Tables {
+  uint32_t m_table[8][256];
+
+  CRC32Tables() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit)
+        crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+      m_table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+      for (int k = 1; k < 8; ++k)
+        m_table[k][i] = (m_table[k - 1][i] >> 8) ^
+                        m_table[0][m_table[k - 1][i] & 0xff];
+  }
+};
+} // namespace
+
+static const CRC32Tables &GetTables() {
+  static const CRC32Tables g_tables;
+  return g_tables;
+}
+
+// Portable implementation working on the inverted CRC state.
+static uint32_t UpdateSliceBy8(uint32_t crc, const uint8_t *p, size_t size) {
+  const auto &table = GetTables().m_table;
+
+  for (; size >= 8; size -= 8, p += 8) {
+    const uint32_t lo = crc ^ (uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+                               uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+    crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+          table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^ table[3][p[4]] ^
+          table[2][p[5]] ^ table[1][p[6]] ^ table[0][p[7]];
+  }
+  while (size--)
+    crc = table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+  return crc;
+}
+
+#ifdef LLDB_CRC32_HAVE_PCLMUL
+// Folds the input 64 bytes at a time with carry-less multiplications and
+// reduces the result to 32 bits with a Barrett reduction, following Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+// The constants are the bit-reflected ones for the zlib polynomial.
+__attribute__((target("pclmul,sse4.1"))) static inline __m128i
+Fold(__m128i x, __m128i k, __m128i next) {
+  const __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  const __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+__attribute__((target("pclmul,sse4.1"))) static uint32_t
+UpdatePCLMUL(uint32_t crc, const uint8_t *p, size_t size) {
+  if (size < 64)
+    return UpdateSliceBy8(crc, p, size);
+
+  alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+  alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+  alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+  alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+  const size_t tail = size & 15;
+  size -= tail;
+
+  __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16));
+  __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32));
+  __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(crc));
+  p += 64;
+  size -= 64;
+
+  __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+
+  for (; size >= 64; size -= 64, p += 64) {
+    const __m128i *next = reinterpret_cast<const __m128i *>(p);
+    x1 = Fold(x1, k, _mm_loadu_si128(next));
+    x2 = Fold(x2, k, _mm_loadu_si128(next + 1));
+    x3 = Fold(x3, k, _mm_loadu_si128(next + 2));
+    x4 = Fold(x4, k, _mm_loadu_si128(next + 3));
+  }
+
+  // Fold the four lanes and the remaining 16 byte blocks into 128 bits.
+  k = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+  x1 = Fold(x1, k, x2);
+  x1 = Fold(x1, k, x3);
+  x1 = Fold(x1, k, x4);
+  for (; size >= 16; size -= 16, p += 16)
+    x1 = Fold(x1, k, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+
+  // Fold 128 bits to 64 bits.
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits.
+  k = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return UpdateSliceBy8(_mm_extract_epi32(x1, 1), p, tail);
+}
+
+static bool HasPCLMUL() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+  return (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1);
+}
+#endif
+
+static CRC32Function GetUpdateFunction() {
+#ifdef LLDB_CRC32_HAVE_PCLMUL
+  if (HasPCLMUL())
+    return UpdatePCLMUL;
+#endif
+  return UpdateSliceBy8;
+}
+
+void CRC32::Update(llvm::ArrayRef<uint8_t> data) {
+  m_crc = Calculate(data, m_crc);
+}
+
+uint32_t CRC32::Calculate(llvm::ArrayRef<uint8_t> data, uint32_t crc) {
+  static const CRC32Function g_update = GetUpdateFunction();
+  return ~g_update(~crc, data.data(), data.size());
+}
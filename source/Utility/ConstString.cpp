@@ -164,6 +164,27 @@ public:
     return mem_size;
   }
 
+  ConstString::MemoryReport GetMemoryReport() const {
+    ConstString::MemoryReport report;
+    report.num_shards = m_string_pools.size();
+    report.min_shard_strings = UINT64_MAX;
+    for (const auto &pool : m_string_pools) {
+      llvm::sys::SmartScopedReader<false> rlock(pool.m_mutex);
+      const StringPool &map = pool.m_string_map;
+      const uint64_t num_strings = map.getNumItems();
+      report.num_strings += num_strings;
+      report.bytes_used += map.getAllocator().getBytesAllocated();
+      report.bytes_allocated +=
+          map.getAllocator().getTotalMemory() +
+          map.getNumBuckets() * (sizeof(void *) + sizeof(uint32_t));
+      report.min_shard_strings =
+          std::min(report.min_shard_strings, num_strings);
+      report.max_shard_strings =
+          std::max(report.max_shard_strings, num_strings);
+    }
+    return report;
+  }
+
 protected:
   uint8_t hash(const llvm::StringRef &s) const {
     uint32_t h = llvm::djbHash(s);
@@ -327,6 +348,28 @@ size_t ConstString::StaticMemorySize() {
   return StringPool().MemorySize();
 }
 
+ConstString::MemoryReport ConstString::GetMemoryReport() {
+  return StringPool().GetMemoryReport();
+}
+
+struct ConstStringArena::Impl {
+  Pool pool;
+};
+
+ConstStringArena::ConstStringArena() : m_impl_up(new Impl()) {}
+
+ConstStringArena::~ConstStringArena() = default;
+
+ConstString ConstStringArena::GetString(llvm::StringRef s) {
+  ConstString result;
+  result.m_string = m_impl_up->pool.GetConstCStringWithStringRef(s);
+  return result;
+}
+
+ConstString::MemoryReport ConstStringArena::GetMemoryReport() const {
+  return m_impl_up->pool.GetMemoryReport();
+}
+
 void llvm::format_provider<ConstString>::format(const ConstString &CS,
                                                 llvm::raw_ostream &OS,
                                                 llvm::StringRef Options) {
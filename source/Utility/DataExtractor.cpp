@@ -919,6 +919,43 @@ const char *DataExtractor::PeekCStr(offset_t offset) const {
   return (const char *)PeekData(offset, 1);
 }
 
+//----------------------------------------------------------------------
+// Finds the end of the LEB128 number at "src" by looking at eight bytes at
+// once, and decodes its payload into "value". This is only done when eight
+// bytes can be read before "end" and the number fits in them, which is the
+// case of nearly all the numbers found in DWARF.
+//
+// Returns the number of bytes of the number, or zero if it has to be decoded
+// one byte at a time.
+//----------------------------------------------------------------------
+static inline size_t DecodeLEB128Word(const uint8_t *src, const uint8_t *end,
+                                      uint64_t *value) {
+  if (end - src < 8 || endian::InlHostByteOrder() != eByteOrderLittle)
+    return 0;
+  uint64_t word;
+  memcpy(&word, src, sizeof(word));
+  // The last byte of the number is the first one without its high bit set.
+  const uint64_t last_bytes = ~word & 0x8080808080808080ULL;
+  if (last_bytes == 0)
+    return 0;
+  const size_t num_bytes = llvm::countTrailingZeros(last_bytes) / 8 + 1;
+  if (value) {
+    if (num_bytes < 8)
+      word &= (1ULL << (num_bytes * 8)) - 1;
+    // Drop the continuation bits and pack the 7 bit groups together: first
+    // pairs of bytes, then pairs of 14 bit groups and last the two halves.
+    word &= 0x7f7f7f7f7f7f7f7fULL;
+    word = (word & 0x007f007f007f007fULL) |
+           ((word & 0x7f007f007f007f00ULL) >> 1);
+    word = (word & 0x00003fff00003fffULL) |
+           ((word & 0x3fff00003fff0000ULL) >> 2);
+    word = (word & 0x000000000fffffffULL) |
+           ((word & 0x0fffffff00000000ULL) >> 4);
+    *value = word;
+  }
+  return num_bytes;
+}
+
 //----------------------------------------------------------------------
 // Extracts an unsigned LEB128 number from this object's data starting at the
 // offset pointed to by "offset_ptr". The offset pointed to by "offset_ptr"
@@ -934,6 +971,17 @@ uint64_t DataExtractor::GetULEB128(offset_t *offset_ptr) const {
 
   const uint8_t *end = m_end;
 
+  // Most numbers fit in a byte, only look at more of them if they don't.
+  if (*src < 0x80) {
+    ++*offset_ptr;
+    return *src;
+  }
+  uint64_t value;
+  if (size_t num_bytes = DecodeLEB128Word(src, end, &value)) {
+    *offset_ptr += num_bytes;
+    return value;
+  }
+
   if (src < end) {
     uint64_t result = *src++;
     if (result >= 0x80) {
@@ -969,8 +1017,22 @@ int64_t DataExtractor::GetSLEB128(offset_t *offset_ptr) const {
 
   const uint8_t *end = m_end;
 
+  if (*src < 0x80) {
+    ++*offset_ptr;
+    return (int64_t)(int8_t)(*src << 1) >> 1;
+  }
+  uint64_t value;
+  if (size_t num_bytes = DecodeLEB128Word(src, end, &value)) {
+    *offset_ptr += num_bytes;
+    // Sign extend from the high bit of the last 7 bit group.
+    const unsigned num_bits = num_bytes * 7;
+    if (value & (1ULL << (num_bits - 1)))
+      value |= ~0ULL << num_bits;
+    return (int64_t)value;
+  }
+
   if (src < end) {
-    int64_t result = 0;
+    uint64_t result = 0;
     int shift = 0;
     int size = sizeof(int64_t) * 8;
 
@@ -980,7 +1042,8 @@ int64_t DataExtractor::GetSLEB128(offset_t *offset_ptr) const {
     while (src < end) {
       bytecount++;
       byte = *src++;
-      result |= (int64_t)(byte & 0x7f) << shift;
+      if (shift < size)
+        result |= (uint64_t)(byte & 0x7f) << shift;
       shift += 7;
       if ((byte & 0x80) == 0)
         break;
@@ -988,10 +1051,10 @@ int64_t DataExtractor::GetSLEB128(offset_t *offset_ptr) const {
 
     // Sign bit of byte is 2nd high order bit (0x40)
     if (shift < size && (byte & 0x40))
-      result |= -(1 << shift);
+      result |= ~0ULL << shift;
 
     *offset_ptr += bytecount;
-    return result;
+    return (int64_t)result;
   }
   return 0;
 }
@@ -1012,6 +1075,15 @@ uint32_t DataExtractor::Skip_LEB128(offset_t *offset_ptr) const {
 
   const uint8_t *end = m_end;
 
+  if (*src < 0x80) {
+    ++*offset_ptr;
+    return 0;
+  }
+  if (size_t num_bytes = DecodeLEB128Word(src, end, nullptr)) {
+    *offset_ptr += num_bytes;
+    return num_bytes - 1;
+  }
+
   if (src < end) {
     const uint8_t *src_pos = src;
     while ((src_pos < end) && (*src_pos++ & 0x80))
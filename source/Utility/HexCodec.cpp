@@ -0,0 +1,160 @@
+//===-- HexCodec.cpp --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/HexCodec.h"
+
+#include "llvm/Support/Endian.h"
+
+#include <string.h>
+
+using namespace lldb_private;
+using namespace llvm::support;
+
+// The SWAR (SIMD within a register) helpers below work on the eight bytes of
+// a uint64_t at once. No byte of their arguments has its high bit set, so
+// the per byte additions never carry into the next byte.
+static const uint64_t g_ones = 0x0101010101010101ULL;
+static const uint64_t g_high_bits = 0x8080808080808080ULL;
+
+// Returns the high bit of each byte of 'x' set if the byte is within
+// ['lo', 'hi'], all the bytes of 'x' being below 0x80.
+static inline uint64_t BytesInRange(uint64_t x, uint8_t lo, uint8_t hi) {
+  return (x + (0x80 - lo) * g_ones) & ~(x + (0x7f - hi) * g_ones) &
+         g_high_bits;
+}
+
+// Decode the eight hex digits at 'src' into four bytes at 'dst'. Returns
+// false, without writing anything, if they aren't all hex digits.
+static inline bool DecodeWord(const char *src, uint8_t *dst) {
+  const uint64_t chars = endian::read64le(src);
+  if (chars & g_high_bits)
+    return false;
+  const uint64_t digits = BytesInRange(chars, '0', '9');
+  const uint64_t letters = BytesInRange(chars | 0x20 * g_ones, 'a', 'f');
+  if ((digits | letters) != g_high_bits)
+    return false;
+  // '0'-'9' end in 0-9, 'a'-'f' and 'A'-'F' in 1-6.
+  const uint64_t nibbles = (chars & 0x0f * g_ones) + (letters >> 7) * 9;
+  // The first character of each pair has the high nibble of the byte.
+  uint64_t bytes = ((nibbles & 0x000f000f000f000fULL) << 4) |
+                   ((nibbles >> 8) & 0x000f000f000f000fULL);
+  bytes = (bytes | (bytes >> 8)) & 0x0000ffff0000ffffULL;
+  bytes = (bytes | (bytes >> 16)) & 0x00000000ffffffffULL;
+  endian::write32le(dst, bytes);
+  return true;
+}
+
+// Encode the four bytes in 'bytes', first byte in the low bits, as eight hex
+// digits at 'dst'.
+static inline void EncodeWord(uint32_t bytes, char *dst) {
+  uint64_t spread = bytes;
+  spread = (spread | (spread << 16)) & 0x0000ffff0000ffffULL;
+  spread = (spread | (spread << 8)) & 0x00ff00ff00ff00ffULL;
+  const uint64_t nibbles = ((spread >> 4) & 0x000f000f000f000fULL) |
+                           ((spread & 0x000f000f000f000fULL) << 8);
+  // Nibbles above 9 map to 'a'-'f', 0x27 past where '0' + nibble would be.
+  const uint64_t letters = ((nibbles + 0x06 * g_ones) >> 4) & g_ones;
+  endian::write64le(dst, nibbles + 0x30 * g_ones + letters * 0x27);
+}
+
+static inline int DecodeDigit(char ch) {
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  if (ch >= 'a' && ch <= 'f')
+    return 10 + ch - 'a';
+  if (ch >= 'A' && ch <= 'F')
+    return 10 + ch - 'A';
+  return -1;
+}
+
+void HexCodec::Encode(llvm::ArrayRef<uint8_t> src, char *dst, bool reverse) {
+  static const char g_digits[] = "0123456789abcdef";
+  const size_t size = src.size();
+  size_t i = 0;
+  if (reverse) {
+    for (; i + 4 <= size; i += 4, dst += 8) {
+      const uint8_t *p = src.data() + size - i - 4;
+      EncodeWord(endian::read32be(p), dst);
+    }
+    for (; i < size; ++i) {
+      const uint8_t byte = src[size - i - 1];
+      *dst++ = g_digits[byte >> 4];
+      *dst++ = g_digits[byte & 0xf];
+    }
+    return;
+  }
+
+  for (; i + 4 <= size; i += 4, dst += 8)
+    EncodeWord(endian::read32le(src.data() + i), dst);
+  for (; i < size; ++i) {
+    *dst++ = g_digits[src[i] >> 4];
+    *dst++ = g_digits[src[i] & 0xf];
+  }
+}
+
+size_t HexCodec::Decode(llvm::StringRef src,
+                        llvm::MutableArrayRef<uint8_t> dst) {
+  const size_t size = std::min(src.size() / 2, dst.size());
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    if (!DecodeWord(src.data() + 2 * i, dst.data() + i))
+      break;
+  }
+  for (; i < size; ++i) {
+    const int hi = DecodeDigit(src[2 * i]);
+    const int lo = DecodeDigit(src[2 * i + 1]);
+    if (hi < 0 || lo < 0)
+      break;
+    dst[i] = (hi << 4) | lo;
+  }
+  return i;
+}
+
+static inline bool NeedsEscape(uint8_t byte) {
+  return byte == '#' || byte == '$' || byte == '}' || byte == '*';
+}
+
+size_t HexCodec::Escape(llvm::ArrayRef<uint8_t> src, char *dst) {
+  char *const start = dst;
+  const uint8_t *p = src.begin();
+  const uint8_t *const end = src.end();
+  while (p != end) {
+    // Copy the run of bytes that don't need escaping at once.
+    const uint8_t *run_end = p;
+    while (run_end != end && !NeedsEscape(*run_end))
+      ++run_end;
+    memcpy(dst, p, run_end - p);
+    dst += run_end - p;
+    p = run_end;
+    if (p != end) {
+      *dst++ = '}';
+      *dst++ = *p++ ^ 0x20;
+    }
+  }
+  return dst - start;
+}
+
+size_t HexCodec::Unescape(llvm::StringRef src, uint8_t *dst) {
+  uint8_t *const start = dst;
+  const char *p = src.begin();
+  const char *const end = src.end();
+  while (p != end) {
+    const char *escape = static_cast<const char *>(memchr(p, '}', end - p));
+    const char *run_end = escape ? escape : end;
+    memcpy(dst, p, run_end - p);
+    dst += run_end - p;
+    p = run_end;
+    if (escape) {
+      if (++p == end)
+        break;
+      *dst++ = *p++ ^ 0x20;
+    }
+  }
+  return dst - start;
+}
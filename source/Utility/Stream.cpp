@@ -10,10 +10,12 @@
 #include "lldb/Utility/Stream.h"
 
 #include "lldb/Utility/Endian.h"
+#include "lldb/Utility/HexCodec.h"
 #include "lldb/Utility/VASPrintf.h"
 #include "llvm/ADT/SmallString.h" // for SmallString
 #include "llvm/Support/LEB128.h"
 
+#include <algorithm>
 #include <string>
 
 #include <inttypes.h>
@@ -444,21 +446,18 @@ size_t Stream::PutRawBytes(const void *s, size_t src_len,
   if (dst_byte_order == eByteOrderInvalid)
     dst_byte_order = m_byte_order;
 
-  size_t bytes_written = 0;
   const uint8_t *src = (const uint8_t *)s;
-  bool binary_was_set = m_flags.Test(eBinary);
-  if (!binary_was_set)
-    m_flags.Set(eBinary);
-  if (src_byte_order == dst_byte_order) {
-    for (size_t i = 0; i < src_len; ++i)
-      bytes_written += _PutHex8(src[i], false);
-  } else {
-    for (size_t i = src_len - 1; i < src_len; --i)
-      bytes_written += _PutHex8(src[i], false);
-  }
-  if (!binary_was_set)
-    m_flags.Clear(eBinary);
+  if (src_byte_order == dst_byte_order)
+    return Write(src, src_len);
 
+  size_t bytes_written = 0;
+  uint8_t reversed[256];
+  while (src_len > 0) {
+    const size_t len = std::min(src_len, sizeof(reversed));
+    std::reverse_copy(src + src_len - len, src + src_len, reversed);
+    bytes_written += Write(reversed, len);
+    src_len -= len;
+  }
   return bytes_written;
 }
 
@@ -471,20 +470,25 @@ size_t Stream::PutBytesAsRawHex8(const void *s, size_t src_len,
   if (dst_byte_order == eByteOrderInvalid)
     dst_byte_order = m_byte_order;
 
+  // Encode the bytes a chunk at a time on the stack, instead of writing the
+  // two digits of each of them to the stream.
   size_t bytes_written = 0;
   const uint8_t *src = (const uint8_t *)s;
-  bool binary_is_set = m_flags.Test(eBinary);
-  m_flags.Clear(eBinary);
-  if (src_byte_order == dst_byte_order) {
-    for (size_t i = 0; i < src_len; ++i)
-      bytes_written += _PutHex8(src[i], false);
-  } else {
-    for (size_t i = src_len - 1; i < src_len; --i)
-      bytes_written += _PutHex8(src[i], false);
+  const bool reverse = src_byte_order != dst_byte_order;
+  char hex[512];
+  while (src_len > 0) {
+    const size_t len = std::min(src_len, sizeof(hex) / 2);
+    if (reverse) {
+      HexCodec::Encode(llvm::makeArrayRef(src + src_len - len, len), hex,
+                       true);
+      src_len -= len;
+    } else {
+      HexCodec::Encode(llvm::makeArrayRef(src, len), hex);
+      src += len;
+      src_len -= len;
+    }
+    bytes_written += Write(hex, 2 * len);
   }
-  if (binary_is_set)
-    m_flags.Set(eBinary);
-
   return bytes_written;
 }
 
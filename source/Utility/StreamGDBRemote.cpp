@@ -9,8 +9,9 @@
 
 #include "lldb/Utility/StreamGDBRemote.h"
 
-#include "lldb/Utility/Flags.h"  // for Flags
-#include "lldb/Utility/Stream.h" // for Stream::::eBinary
+#include "lldb/Utility/HexCodec.h"
+
+#include <algorithm>
 
 #include <stdio.h>
 
@@ -26,21 +27,17 @@ StreamGDBRemote::StreamGDBRemote(uint32_t flags, uint32_t addr_size,
 StreamGDBRemote::~StreamGDBRemote() {}
 
 int StreamGDBRemote::PutEscapedBytes(const void *s, size_t src_len) {
+  // Escape the bytes a chunk at a time on the stack, each byte taking up at
+  // most two characters, and write each chunk at once.
   int bytes_written = 0;
   const uint8_t *src = (const uint8_t *)s;
-  bool binary_is_set = m_flags.Test(eBinary);
-  m_flags.Clear(eBinary);
+  char escaped[512];
   while (src_len) {
-    uint8_t byte = *src;
-    src++;
-    src_len--;
-    if (byte == 0x23 || byte == 0x24 || byte == 0x7d || byte == 0x2a) {
-      bytes_written += PutChar(0x7d);
-      byte ^= 0x20;
-    }
-    bytes_written += PutChar(byte);
-  };
-  if (binary_is_set)
-    m_flags.Set(eBinary);
+    const size_t len = std::min(src_len, sizeof(escaped) / 2);
+    bytes_written += Write(
+        escaped, HexCodec::Escape(llvm::makeArrayRef(src, len), escaped));
+    src += len;
+    src_len -= len;
+  }
   return bytes_written;
 }
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Utility/StringExtractor.h"
+#include "lldb/Utility/HexCodec.h"
 
 #include <tuple>
 
@@ -288,9 +289,29 @@ bool StringExtractor::ConsumeFront(const llvm::StringRef &str) {
   return true;
 }
 
+//----------------------------------------------------------------------
+// Decodes the run of hex digit pairs at the head of the StringExtractor,
+// several bytes at a time, and drops the decoded bytes from the front of
+// 'dest'. What it stops at (spaces, an invalid or odd character) is left to
+// the byte at a time code, so that it is handled the same way as before.
+//
+// Returns the number of bytes decoded
+//----------------------------------------------------------------------
+size_t StringExtractor::DecodeHexBytesFast(
+    llvm::MutableArrayRef<uint8_t> &dest) {
+  const char *src = Peek();
+  if (src == nullptr)
+    return 0;
+  const size_t decoded = lldb_private::HexCodec::Decode(
+      llvm::StringRef(src, GetBytesLeft()), dest);
+  m_index += 2 * decoded;
+  dest = dest.drop_front(decoded);
+  return decoded;
+}
+
 size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
                                     uint8_t fail_fill_value) {
-  size_t bytes_extracted = 0;
+  size_t bytes_extracted = DecodeHexBytesFast(dest);
   while (!dest.empty() && GetBytesLeft() > 0) {
     dest[0] = GetHexU8(fail_fill_value);
     if (!IsGood())
@@ -312,7 +333,7 @@ size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
 // Returns the number of bytes successfully decoded
 //----------------------------------------------------------------------
 size_t StringExtractor::GetHexBytesAvail(llvm::MutableArrayRef<uint8_t> dest) {
-  size_t bytes_extracted = 0;
+  size_t bytes_extracted = DecodeHexBytesFast(dest);
   while (!dest.empty()) {
     int decode = DecodeHexU8();
     if (decode == -1)
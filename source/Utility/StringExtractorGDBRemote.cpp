@@ -98,6 +98,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_QEnvironmentHexEncoded;
       if (PACKET_STARTS_WITH("QEnableErrorStrings"))
         return eServerPacketType_QEnableErrorStrings;
+      if (PACKET_STARTS_WITH("QEnableCompression:"))
+        return eServerPacketType_QEnableCompression;
       break;
 
     case 'P':
@@ -266,6 +268,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_qThreadExtraInfo;
       if (PACKET_STARTS_WITH("qThreadStopInfo"))
         return eServerPacketType_qThreadStopInfo;
+      if (PACKET_MATCHES("qTracepointBuffer"))
+        return eServerPacketType_qTracepointBuffer;
       break;
 
     case 'U':
@@ -295,6 +299,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
   case 'j':
     if (PACKET_STARTS_WITH("jModulesInfo:"))
       return eServerPacketType_jModulesInfo;
+    if (PACKET_STARTS_WITH("jMultiMemRead:"))
+      return eServerPacketType_jMultiMemRead;
     if (PACKET_MATCHES("jSignalsInfo"))
       return eServerPacketType_jSignalsInfo;
     if (PACKET_MATCHES("jThreadsInfo"))
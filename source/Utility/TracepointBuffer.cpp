@@ -0,0 +1,65 @@
+//===-- TracepointBuffer.cpp ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/TracepointBuffer.h"
+
+#include <utility>
+
+using namespace lldb_private;
+
+size_t TracepointBuffer::GetEntryDataSize(
+    llvm::ArrayRef<TracepointCollect> collects) {
+  size_t size = 0;
+  for (const TracepointCollect &collect : collects)
+    size += 1 + collect.size;
+  return size;
+}
+
+void TracepointBuffer::Append(Entry entry) {
+  const size_t size = GetEntryByteSize(entry);
+  if (size > m_capacity) {
+    ++m_num_dropped;
+    return;
+  }
+  while (!m_entries.empty() && m_byte_size + size > m_capacity) {
+    m_byte_size -= GetEntryByteSize(m_entries.front());
+    m_entries.pop_front();
+    ++m_num_dropped;
+  }
+  m_byte_size += size;
+  m_entries.push_back(std::move(entry));
+}
+
+size_t TracepointBuffer::Drain(size_t max_bytes, std::vector<Entry> &entries) {
+  size_t num_entries = 0;
+  size_t num_bytes = 0;
+  while (!m_entries.empty()) {
+    const size_t size = m_entries.front().data.size();
+    if (num_entries > 0 && num_bytes + size > max_bytes)
+      break;
+    num_bytes += size;
+    m_byte_size -= GetEntryByteSize(m_entries.front());
+    entries.push_back(std::move(m_entries.front()));
+    m_entries.pop_front();
+    ++num_entries;
+  }
+  return num_entries;
+}
+
+uint64_t TracepointBuffer::TakeNumDropped() {
+  const uint64_t num_dropped = m_num_dropped;
+  m_num_dropped = 0;
+  return num_dropped;
+}
+
+void TracepointBuffer::Clear() {
+  m_entries.clear();
+  m_byte_size = 0;
+  m_num_dropped = 0;
+}
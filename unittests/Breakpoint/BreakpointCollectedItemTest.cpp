@@ -0,0 +1,40 @@
+//===-- BreakpointCollectedItemTest.cpp -------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Utility/StreamString.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static std::string ParseAndDescribe(llvm::StringRef text) {
+  Breakpoint::CollectedItem item;
+  if (!Breakpoint::CollectedItem::Parse(text, item))
+    return "<error>";
+  StreamString s;
+  item.GetDescription(s);
+  return s.GetString();
+}
+
+TEST(BreakpointCollectedItemTest, Parse) {
+  EXPECT_EQ("rax", ParseAndDescribe("rax"));
+  EXPECT_EQ("0x601040,4", ParseAndDescribe("0x601040,4"));
+  EXPECT_EQ("rsp,8", ParseAndDescribe("rsp,8"));
+  EXPECT_EQ("rsp+0x8,16", ParseAndDescribe("rsp + 8, 16"));
+  EXPECT_EQ("rbp-0x10,4", ParseAndDescribe("rbp-0x10,4"));
+
+  EXPECT_EQ("<error>", ParseAndDescribe(""));
+  EXPECT_EQ("<error>", ParseAndDescribe("12"));
+  EXPECT_EQ("<error>", ParseAndDescribe("rsp+8"));
+  EXPECT_EQ("<error>", ParseAndDescribe("rsp+8,0"));
+  EXPECT_EQ("<error>", ParseAndDescribe("rsp+x,4"));
+  EXPECT_EQ("<error>", ParseAndDescribe("+8,4"));
+}
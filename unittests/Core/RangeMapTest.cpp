@@ -0,0 +1,122 @@
+//===-- RangeMapTest.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/RangeMap.h"
+
+#include <cstdint>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+typedef RangeDataVector<lldb::addr_t, uint32_t, uint32_t> RangeDataVectorT;
+
+namespace {
+// The data of the entries containing addr, found by looking at all of them.
+std::vector<uint32_t> FindAllContaining(const RangeDataVectorT &map,
+                                        lldb::addr_t addr) {
+  std::vector<uint32_t> result;
+  for (size_t i = 0; i < map.GetSize(); ++i) {
+    if (map.GetEntryRef(i).Contains(addr))
+      result.push_back(map.GetEntryRef(i).data);
+  }
+  return result;
+}
+
+std::vector<uint32_t> FindEntryIndexesThatContain(const RangeDataVectorT &map,
+                                                  lldb::addr_t addr) {
+  std::vector<uint32_t> result;
+  map.FindEntryIndexesThatContain(addr, result);
+  return result;
+}
+
+// Fill the map with num_entries random ranges, the data of each entry being
+// its index. A few large ranges enclose many small ones, like a symbol table
+// where sections or functions contain local labels.
+void FillRandomRanges(RangeDataVectorT &map, uint32_t num_entries,
+                      lldb::addr_t max_addr) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<lldb::addr_t> addr_dist(0, max_addr);
+  std::uniform_int_distribution<uint32_t> small_size_dist(0, 64);
+  // On average, an address is in one or two of the large ranges.
+  std::uniform_int_distribution<uint32_t> large_size_dist(
+      0, 256 * (max_addr / num_entries));
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    const uint32_t size =
+        (i % 64 == 0) ? large_size_dist(rng) : small_size_dist(rng);
+    map.Append(RangeDataVectorT::Entry(addr_dist(rng), size, i));
+  }
+  map.Sort();
+}
+} // namespace
+
+TEST(RangeDataVector, FindEntryIndexesThatContain) {
+  RangeDataVectorT map;
+  map.Append(RangeDataVectorT::Entry(10, 10, 0));
+  map.Append(RangeDataVectorT::Entry(12, 2, 1));
+  map.Append(RangeDataVectorT::Entry(15, 1, 2));
+  map.Append(RangeDataVectorT::Entry(0, 100, 3));
+  map.Sort();
+
+  EXPECT_EQ(std::vector<uint32_t>({3}), FindEntryIndexesThatContain(map, 5));
+  EXPECT_EQ(std::vector<uint32_t>({3, 0}),
+            FindEntryIndexesThatContain(map, 10));
+  EXPECT_EQ(std::vector<uint32_t>({3, 0, 1}),
+            FindEntryIndexesThatContain(map, 13));
+  EXPECT_EQ(std::vector<uint32_t>({3, 0, 2}),
+            FindEntryIndexesThatContain(map, 15));
+  EXPECT_EQ(std::vector<uint32_t>({3}), FindEntryIndexesThatContain(map, 50));
+  EXPECT_EQ(std::vector<uint32_t>(), FindEntryIndexesThatContain(map, 100));
+}
+
+TEST(RangeDataVector, FindEntryThatContainsEnclosingEntry) {
+  RangeDataVectorT map;
+  map.Append(RangeDataVectorT::Entry(0, 100, 0));
+  map.Append(RangeDataVectorT::Entry(10, 10, 1));
+  map.Sort();
+
+  // The entry right before 50 doesn't contain it, the one enclosing it does.
+  const RangeDataVectorT::Entry *entry = map.FindEntryThatContains(50);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(0u, entry->data);
+  EXPECT_EQ(0u, map.FindEntryIndexThatContains(50));
+  EXPECT_EQ(nullptr, map.FindEntryThatContains(100));
+}
+
+TEST(RangeDataVector, FindEntryIndexesThatContainAfterModification) {
+  RangeDataVectorT map;
+  map.Append(RangeDataVectorT::Entry(0, 10, 0));
+  map.Append(RangeDataVectorT::Entry(20, 10, 1));
+  map.Sort();
+  EXPECT_EQ(std::vector<uint32_t>(), FindEntryIndexesThatContain(map, 15));
+
+  // Growing an entry makes them overlap without a call to Sort().
+  map.GetMutableEntryAtIndex(0)->SetByteSize(30);
+  EXPECT_EQ(std::vector<uint32_t>({0}), FindEntryIndexesThatContain(map, 15));
+  EXPECT_EQ(std::vector<uint32_t>({0, 1}),
+            FindEntryIndexesThatContain(map, 25));
+
+  map.Sort();
+  EXPECT_EQ(std::vector<uint32_t>({0, 1}),
+            FindEntryIndexesThatContain(map, 25));
+}
+
+TEST(RangeDataVector, FindEntryIndexesThatContainRandom) {
+  RangeDataVectorT map;
+  const lldb::addr_t max_addr = 100000;
+  FillRandomRanges(map, 5000, max_addr);
+
+  for (lldb::addr_t addr = 0; addr < max_addr; addr += 97) {
+    SCOPED_TRACE(addr);
+    EXPECT_EQ(FindAllContaining(map, addr),
+              FindEntryIndexesThatContain(map, addr));
+  }
+}
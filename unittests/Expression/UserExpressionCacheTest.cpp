@@ -0,0 +1,204 @@
+//===-- UserExpressionCacheTest.cpp -----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb_private;
+using namespace lldb_private::platform_linux;
+using namespace lldb;
+
+namespace {
+
+// An expression which is never parsed nor run, only kept in the cache.
+class TestUserExpression : public UserExpression {
+public:
+  TestUserExpression(Target &target, llvm::StringRef text)
+      : UserExpression(target, text, llvm::StringRef(), eLanguageTypeC,
+                       eResultTypeAny, EvaluateExpressionOptions()) {}
+
+  bool Parse(DiagnosticManager &diagnostic_manager, ExecutionContext &exe_ctx,
+             ExecutionPolicy execution_policy, bool keep_result_in_memory,
+             bool generate_debug_info) override {
+    return false;
+  }
+  bool CanInterpret() override { return false; }
+  bool FinalizeJITExecution(DiagnosticManager &diagnostic_manager,
+                            ExecutionContext &exe_ctx,
+                            ExpressionVariableSP &result,
+                            addr_t function_stack_bottom,
+                            addr_t function_stack_top) override {
+    return false;
+  }
+  const char *FunctionName() override { return "$__lldb_expr"; }
+  bool NeedsValidation() override { return false; }
+  bool NeedsVariableResolution() override { return false; }
+
+protected:
+  ExpressionResults DoExecute(DiagnosticManager &diagnostic_manager,
+                              ExecutionContext &exe_ctx,
+                              const EvaluateExpressionOptions &options,
+                              UserExpressionSP &shared_ptr_to_me,
+                              ExpressionVariableSP &result) override {
+    return eExpressionSetupError;
+  }
+};
+
+class UserExpressionCacheTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    PlatformLinux::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    PlatformLinux::Terminate();
+    HostInfo::Terminate();
+  }
+
+protected:
+  void SetUp() override {
+    ArchSpec arch("x86_64-pc-linux");
+    PlatformSP platform_sp = PlatformLinux::CreateInstance(true, &arch);
+    Platform::SetHostPlatform(platform_sp);
+    m_debugger_sp = Debugger::CreateInstance();
+    ASSERT_TRUE(m_debugger_sp);
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false, platform_sp,
+                                  m_target_sp)
+                    .Success());
+    ASSERT_TRUE(m_target_sp);
+    m_target_sp->SetCollectingStats(true);
+    m_exe_ctx = ExecutionContext(m_target_sp.get(), false);
+  }
+
+  void TearDown() override {
+    m_target_sp.reset();
+    if (m_debugger_sp)
+      Debugger::Destroy(m_debugger_sp);
+  }
+
+  UserExpressionCache::Key MakeKey(llvm::StringRef text) {
+    return UserExpressionCache::MakeKey(
+        m_exe_ctx, text, llvm::StringRef(), eLanguageTypeC,
+        Expression::eResultTypeAny, eExecutionPolicyOnlyWhenNeeded, false);
+  }
+
+  // The count of 'kind' in the statistics of the target.
+  uint64_t GetStat(StatisticKind kind) {
+    StructuredData::ObjectSP stat_sp =
+        m_target_sp->GetStatistics()->GetValueForKey(GetStatDescription(kind));
+    return stat_sp ? stat_sp->GetIntegerValue() : UINT64_MAX;
+  }
+
+  // Insert an expression for 'text' and return it.
+  UserExpressionSP Insert(UserExpressionCache &cache, llvm::StringRef text) {
+    UserExpressionSP expr_sp =
+        std::make_shared<TestUserExpression>(*m_target_sp, text);
+    cache.Insert(MakeKey(text), m_exe_ctx, expr_sp);
+    return expr_sp;
+  }
+
+  UserExpressionSP Find(UserExpressionCache &cache, llvm::StringRef text) {
+    return cache.Find(MakeKey(text), m_exe_ctx);
+  }
+
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  // Expressions without a process nor a frame can be found from any
+  // context of their target.
+  ExecutionContext m_exe_ctx;
+};
+
+} // namespace
+
+TEST_F(UserExpressionCacheTest, FindsInsertedExpressions) {
+  UserExpressionCache cache(4);
+  EXPECT_FALSE(Find(cache, "a"));
+  Insert(cache, "a");
+  UserExpressionSP a_sp = Find(cache, "a");
+  ASSERT_TRUE(a_sp);
+  EXPECT_STREQ("a", a_sp->GetUserText());
+  a_sp.reset();
+  EXPECT_FALSE(Find(cache, "b"));
+
+  EXPECT_EQ(1u, GetStat(StatisticKind::ExpressionCacheHit));
+  EXPECT_EQ(2u, GetStat(StatisticKind::ExpressionCacheMiss));
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheEviction));
+}
+
+TEST_F(UserExpressionCacheTest, CountsOnlyWhileCollectingStats) {
+  UserExpressionCache cache(1);
+  m_target_sp->SetCollectingStats(false);
+  Insert(cache, "a");
+  EXPECT_TRUE(Find(cache, "a"));
+  EXPECT_FALSE(Find(cache, "b"));
+  Insert(cache, "b");
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheHit));
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheMiss));
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheEviction));
+}
+
+TEST_F(UserExpressionCacheTest, EvictsLeastRecentlyUsed) {
+  UserExpressionCache cache(2);
+  Insert(cache, "a");
+  Insert(cache, "b");
+  // Using "a" makes "b" the least recently used.
+  EXPECT_TRUE(Find(cache, "a"));
+  Insert(cache, "c");
+  EXPECT_EQ(1u, GetStat(StatisticKind::ExpressionCacheEviction));
+  EXPECT_FALSE(Find(cache, "b"));
+  EXPECT_TRUE(Find(cache, "a"));
+  EXPECT_TRUE(Find(cache, "c"));
+
+  // Inserting an expression again replaces it without evicting another.
+  Insert(cache, "a");
+  EXPECT_EQ(1u, GetStat(StatisticKind::ExpressionCacheEviction));
+  EXPECT_TRUE(Find(cache, "c"));
+
+  // "a" is now the least recently used.
+  Insert(cache, "d");
+  EXPECT_EQ(2u, GetStat(StatisticKind::ExpressionCacheEviction));
+  EXPECT_FALSE(Find(cache, "a"));
+  EXPECT_TRUE(Find(cache, "c"));
+  EXPECT_TRUE(Find(cache, "d"));
+}
+
+TEST_F(UserExpressionCacheTest, HeldExpressionsAreNotFound) {
+  UserExpressionCache cache(2);
+  // Like an expression stopped in the middle of its execution, which its
+  // thread plan holds.
+  UserExpressionSP held_sp = Insert(cache, "a");
+  EXPECT_FALSE(Find(cache, "a"));
+  EXPECT_EQ(1u, GetStat(StatisticKind::ExpressionCacheMiss));
+  held_sp.reset();
+  EXPECT_TRUE(Find(cache, "a"));
+}
+
+TEST_F(UserExpressionCacheTest, Clear) {
+  UserExpressionCache cache(2);
+  Insert(cache, "a");
+  cache.Clear();
+  EXPECT_FALSE(Find(cache, "a"));
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheEviction));
+}
+
+TEST_F(UserExpressionCacheTest, ZeroCapacityKeepsNothing) {
+  UserExpressionCache cache(0);
+  Insert(cache, "a");
+  EXPECT_FALSE(Find(cache, "a"));
+  EXPECT_EQ(0u, GetStat(StatisticKind::ExpressionCacheEviction));
+}
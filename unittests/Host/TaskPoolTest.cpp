@@ -2,6 +2,8 @@
 
 #include "lldb/Host/TaskPool.h"
 
+#include <atomic>
+
 using namespace lldb_private;
 
 TEST(TaskPoolTest, AddTask) {
@@ -43,3 +45,35 @@ TEST(TaskPoolTest, TaskMap) {
   ASSERT_EQ(data[2], 4);
   ASSERT_EQ(data[3], 9);
 }
+
+TEST(TaskPoolTest, TaskMapLarge) {
+  std::vector<int> data(100000);
+  TaskMapOverInt(0, data.size(), [&data](size_t x) { data[x] += x; });
+
+  for (size_t x = 0; x < data.size(); ++x)
+    ASSERT_EQ(static_cast<int>(x), data[x]);
+}
+
+TEST(TaskPoolTest, NestedTaskMap) {
+  std::atomic<size_t> count{0};
+  TaskMapOverInt(0, 100, [&count](size_t) {
+    TaskMapOverInt(0, 100, [&count](size_t) { ++count; });
+  });
+
+  ASSERT_EQ(10000u, count);
+}
+
+TEST(TaskPoolTest, NestedWait) {
+  // Spawn far more waiting tasks than there are workers. This only completes
+  // if waiting workers keep running the tasks they are waiting for.
+  std::function<int(int)> fib = [&fib](int n) {
+    if (n < 2)
+      return n;
+    auto f = TaskPool::AddTask(fib, n - 1);
+    int result = fib(n - 2);
+    TaskPool::Wait(f);
+    return result + f.get();
+  };
+
+  ASSERT_EQ(6765, TaskPool::AddTask(fib, 20).get());
+}
@@ -0,0 +1,284 @@
+//===-- BreakpointConditionCompilerTest.cpp ---------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "Plugins/Process/gdb-remote/BreakpointConditionCompiler.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+
+#include <map>
+
+using namespace lldb_private;
+using namespace lldb_private::platform_linux;
+using namespace lldb_private::process_gdb_remote;
+using namespace lldb;
+
+namespace {
+
+class DummyProcess : public Process {
+public:
+  DummyProcess(TargetSP target_sp, ListenerSP listener_sp)
+      : Process(target_sp, listener_sp) {}
+
+  bool CanDebug(TargetSP target, bool plugin_specified_by_name) override {
+    return true;
+  }
+  Status DoDestroy() override { return Status(); }
+  void RefreshStateAfterStop() override {}
+  size_t DoReadMemory(addr_t vm_addr, void *buf, size_t size,
+                      Status &error) override {
+    return 0;
+  }
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+  ConstString GetPluginName() override { return ConstString("dummy"); }
+  uint32_t GetPluginVersion() override { return 1; }
+};
+
+class DummyThread : public Thread {
+public:
+  DummyThread(Process &process) : Thread(process, 1) {}
+
+  void RefreshStateAfterStop() override {}
+  RegisterContextSP GetRegisterContext() override {
+    return RegisterContextSP();
+  }
+  RegisterContextSP CreateRegisterContextForFrame(StackFrame *frame) override {
+    return RegisterContextSP();
+  }
+  bool CalculateStopInfo() override { return false; }
+};
+
+// Registers of all the sizes and encodings the compiler reads, which the
+// stub numbers from 10.
+class TestRegisterContext : public RegisterContext {
+public:
+  TestRegisterContext(Thread &thread) : RegisterContext(thread, 0) {
+    AddRegister("r0", 8, eEncodingUint);
+    AddRegister("r1", 8, eEncodingUint);
+    AddRegister("e0", 4, eEncodingUint);
+    AddRegister("w0", 2, eEncodingUint);
+    AddRegister("f0", 8, eEncodingIEEE754);
+  }
+
+  void InvalidateAllRegisters() override {}
+  size_t GetRegisterCount() override { return m_infos.size(); }
+  const RegisterInfo *GetRegisterInfoAtIndex(size_t reg) override {
+    return reg < m_infos.size() ? &m_infos[reg] : nullptr;
+  }
+  size_t GetRegisterSetCount() override { return 0; }
+  const RegisterSet *GetRegisterSet(size_t reg_set) override {
+    return nullptr;
+  }
+  bool ReadRegister(const RegisterInfo *reg_info,
+                    RegisterValue &reg_value) override {
+    return false;
+  }
+  bool WriteRegister(const RegisterInfo *reg_info,
+                     const RegisterValue &reg_value) override {
+    return false;
+  }
+
+private:
+  void AddRegister(const char *name, uint32_t byte_size, Encoding encoding) {
+    RegisterInfo info = {};
+    info.name = name;
+    info.byte_size = byte_size;
+    info.encoding = encoding;
+    info.format = eFormatHex;
+    for (uint32_t &reg : info.kinds)
+      reg = LLDB_INVALID_REGNUM;
+    info.kinds[eRegisterKindLLDB] = m_infos.size();
+    info.kinds[eRegisterKindProcessPlugin] = 10 + m_infos.size();
+    m_infos.push_back(info);
+  }
+
+  std::vector<RegisterInfo> m_infos;
+};
+
+// What the stub reads while evaluating the compiled conditions. A register
+// missing from 'registers' fails to read, which shows whether a condition
+// read it.
+class TestContext : public AgentExpression::Context {
+public:
+  Status ReadRegister(uint32_t reg, uint64_t &value) override {
+    auto pos = registers.find(reg);
+    if (pos == registers.end())
+      return Status("no register %u", reg);
+    value = pos->second;
+    return Status();
+  }
+
+  Status ReadMemory(addr_t addr, size_t size, uint64_t &value) override {
+    return Status("no memory");
+  }
+
+  std::map<uint32_t, uint64_t> registers;
+};
+
+class BreakpointConditionCompilerTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    PlatformLinux::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    PlatformLinux::Terminate();
+    HostInfo::Terminate();
+  }
+
+protected:
+  void SetUp() override {
+    ArchSpec arch("x86_64-pc-linux");
+    PlatformSP platform_sp = PlatformLinux::CreateInstance(true, &arch);
+    Platform::SetHostPlatform(platform_sp);
+    m_debugger_sp = Debugger::CreateInstance();
+    ASSERT_TRUE(m_debugger_sp);
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false, platform_sp,
+                                  m_target_sp)
+                    .Success());
+    ASSERT_TRUE(m_target_sp);
+    m_process_sp = std::make_shared<DummyProcess>(
+        m_target_sp, Listener::MakeListener("dummy"));
+    m_thread_sp = std::make_shared<DummyThread>(*m_process_sp);
+    m_reg_ctx_sp = std::make_shared<TestRegisterContext>(*m_thread_sp);
+
+    // r0 = 5, e0 = 5, w0 = 0xffff, and r1 can't be read.
+    m_context.registers[10] = 5;
+    m_context.registers[12] = 5;
+    m_context.registers[13] = 0xffff;
+  }
+
+  void TearDown() override {
+    m_reg_ctx_sp.reset();
+    m_thread_sp.reset();
+    if (m_process_sp)
+      m_process_sp->Finalize();
+    m_process_sp.reset();
+    if (m_debugger_sp)
+      Debugger::Destroy(m_debugger_sp);
+  }
+
+  bool Compile(llvm::StringRef condition, AgentExpression &expr) {
+    return BreakpointConditionCompiler::Compile(
+        condition, *m_target_sp, *m_reg_ctx_sp, SymbolContext(), expr);
+  }
+
+  // Compile and evaluate 'condition', which has to succeed.
+  uint64_t Evaluate(llvm::StringRef condition) {
+    AgentExpression expr;
+    EXPECT_TRUE(Compile(condition, expr)) << condition.str();
+    uint64_t result = 0xdeadbeef;
+    Status error = expr.Evaluate(m_context, result);
+    EXPECT_TRUE(error.Success()) << condition.str() << ": "
+                                 << error.AsCString();
+    return result;
+  }
+
+  // Compile 'condition' and return whether evaluating it failed.
+  bool EvaluationFails(llvm::StringRef condition) {
+    AgentExpression expr;
+    EXPECT_TRUE(Compile(condition, expr)) << condition.str();
+    uint64_t result;
+    return expr.Evaluate(m_context, result).Fail();
+  }
+
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  std::shared_ptr<DummyProcess> m_process_sp;
+  ThreadSP m_thread_sp;
+  RegisterContextSP m_reg_ctx_sp;
+  TestContext m_context;
+};
+
+} // namespace
+
+TEST_F(BreakpointConditionCompilerTest, Precedence) {
+  EXPECT_EQ(7u, Evaluate("1 + 2 * 3"));
+  EXPECT_EQ(9u, Evaluate("(1 + 2) * 3"));
+  EXPECT_EQ(5u, Evaluate("10 - 2 - 3"));
+  EXPECT_EQ(1u, Evaluate("1 | 2 & 0"));
+  EXPECT_EQ(0u, Evaluate("(1 | 2) & 0"));
+  EXPECT_EQ(3u, Evaluate("1 ^ 3 & 2 | 0"));
+  EXPECT_EQ(1u, Evaluate("2 + 3 == 5"));
+  EXPECT_EQ(1u, Evaluate("1 < 2 == 2 < 3"));
+  EXPECT_EQ(0u, Evaluate("1 == 2 || 3 == 4 && 1"));
+  EXPECT_EQ(1u, Evaluate("1 == 1 || 3 == 4 && 0"));
+  EXPECT_EQ(2u, Evaluate("!0 + 1"));
+  EXPECT_EQ(1u, Evaluate("-$r0 + 6"));
+  EXPECT_EQ(1u, Evaluate("$r0 * 2 >= 10 && $e0 <= 5"));
+}
+
+TEST_F(BreakpointConditionCompilerTest, LogicalValues) {
+  EXPECT_EQ(1u, Evaluate("2 && 3"));
+  EXPECT_EQ(0u, Evaluate("2 && 0"));
+  EXPECT_EQ(1u, Evaluate("0 || 5"));
+  EXPECT_EQ(0u, Evaluate("0 || 0"));
+  EXPECT_EQ(1u, Evaluate("true"));
+  EXPECT_EQ(1u, Evaluate("$r0 != nullptr"));
+}
+
+TEST_F(BreakpointConditionCompilerTest, ShortCircuit) {
+  // The right hand side, which reads a register the stub can't read, is
+  // only evaluated when it decides the result.
+  EXPECT_EQ(0u, Evaluate("0 && $r1"));
+  EXPECT_EQ(0u, Evaluate("$r0 == 4 && $r1 == 1"));
+  EXPECT_EQ(1u, Evaluate("1 || $r1"));
+  EXPECT_EQ(1u, Evaluate("$r0 == 5 || $r1 == 1"));
+  EXPECT_TRUE(EvaluationFails("1 && $r1"));
+  EXPECT_TRUE(EvaluationFails("0 || $r1"));
+}
+
+TEST_F(BreakpointConditionCompilerTest, SignedAndUnsignedConversions) {
+  // An int compared with an unsigned int is converted to unsigned.
+  EXPECT_EQ(1u, Evaluate("-1 < 0"));
+  EXPECT_EQ(0u, Evaluate("-1 < 0u"));
+  EXPECT_EQ(0u, Evaluate("$e0 > -1"));
+  EXPECT_EQ(1u, Evaluate("0xffffffff == -1"));
+  EXPECT_EQ(1u, Evaluate("0u - 1 > 0"));
+  EXPECT_EQ(0xffffffffu, Evaluate("0u - 1"));
+
+  // A long can hold any unsigned int, so the comparison stays signed.
+  EXPECT_EQ(1u, Evaluate("-1 < 0L"));
+  EXPECT_EQ(1u, Evaluate("-1L < 0u"));
+  // A decimal literal too large for an int is a long.
+  EXPECT_EQ(0u, Evaluate("4294967295 == -1"));
+
+  // An int converted to an unsigned long is sign extended.
+  EXPECT_EQ(1u, Evaluate("$r0 < -1"));
+  EXPECT_EQ(1u, Evaluate("-1 == 0xffffffffffffffff"));
+
+  // Registers narrower than an int are promoted to int.
+  EXPECT_EQ(1u, Evaluate("$w0 > -1"));
+  EXPECT_EQ(0xffffu, Evaluate("$w0"));
+}
+
+TEST_F(BreakpointConditionCompilerTest, Unsupported) {
+  AgentExpression expr;
+  EXPECT_FALSE(Compile("", expr));
+  EXPECT_FALSE(Compile("1 << 2", expr));
+  EXPECT_FALSE(Compile("1 +", expr));
+  EXPECT_FALSE(Compile("(1", expr));
+  EXPECT_FALSE(Compile("$f0 == 0", expr));
+  EXPECT_FALSE(Compile("$nosuchreg == 0", expr));
+  EXPECT_FALSE(Compile("no_such_variable == 0", expr));
+  EXPECT_FALSE(Compile("1.5 > 1", expr));
+  EXPECT_FALSE(Compile("foo()", expr));
+}
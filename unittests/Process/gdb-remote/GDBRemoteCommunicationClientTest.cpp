@@ -265,6 +265,44 @@ TEST_F(GDBRemoteCommunicationClientTest, GetModulesInfoInvalidResponse) {
   }
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, ReadMemoryRanges) {
+  Process::MemoryRange ranges[] = {
+      {0x1000, 4}, {0x2000, 3}, {0x3000, 2}};
+  uint8_t buffer[9] = {};
+  std::future<llvm::Optional<std::vector<size_t>>> async_result =
+      std::async(std::launch::async,
+                 [&] { return client.ReadMemoryRanges(ranges, buffer); });
+  HandlePacket(server,
+               "jMultiMemRead:["
+               R"({"address":4096,"length":4},)"
+               R"({"address":8192,"length":3},)"
+               R"({"address":12288,"length":2}])",
+               "4,1,0;ABCDE");
+
+  auto result = async_result.get();
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(std::vector<size_t>({4, 1, 0}), *result);
+  EXPECT_EQ(0, memcmp(buffer, "ABCDE", 5));
+
+  // A response that doesn't match the request is rejected.
+  async_result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buffer);
+  });
+  HandlePacket(server, testing::StartsWith("jMultiMemRead:"), "4,1,0;ABCD");
+  EXPECT_FALSE(async_result.get().hasValue());
+  EXPECT_TRUE(client.GetMultiMemReadSupported());
+
+  // The client stops sending the packet after the server says it doesn't
+  // support it.
+  async_result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buffer);
+  });
+  HandlePacket(server, testing::StartsWith("jMultiMemRead:"), "");
+  EXPECT_FALSE(async_result.get().hasValue());
+  EXPECT_FALSE(client.GetMultiMemReadSupported());
+  EXPECT_FALSE(client.ReadMemoryRanges(ranges, buffer).hasValue());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, TestPacketSpeedJSON) {
   std::thread server_thread([this] {
     for (;;) {
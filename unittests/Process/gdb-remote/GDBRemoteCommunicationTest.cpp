@@ -7,8 +7,12 @@
 //
 //===----------------------------------------------------------------------===//
 #include "GDBRemoteTestUtils.h"
+#include "lldb/Utility/StreamString.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Testing/Support/Error.h"
 
+#include <random>
+
 using namespace lldb_private::process_gdb_remote;
 using namespace lldb_private;
 using namespace lldb;
@@ -25,6 +29,17 @@ public:
     return GDBRemoteCommunication::ReadPacket(response, std::chrono::seconds(1),
                                               /*sync_on_timeout*/ false);
   }
+
+  PacketResult SendPacket(llvm::StringRef payload) {
+    return SendPacketNoLock(payload);
+  }
+
+  void SetSendAcks(bool send_acks) { m_send_acks = send_acks; }
+
+  void SetCompressionType(CompressionType type) { m_compression_type = type; }
+
+  using GDBRemoteCommunication::GetSupportedCompressions;
+  using GDBRemoteCommunication::GetSupportedCompressionType;
 };
 
 class GDBRemoteCommunicationTest : public GDBRemoteTest {
@@ -42,7 +57,67 @@ protected:
     return server.Write(packet.data(), packet.size(), status, nullptr) ==
            packet.size();
   }
+
+  // Have the server handle a QEnableCompression packet from the client, and
+  // the client decompress the packets which follow its reply.
+  void EnableCompression(llvm::StringRef name, size_t minsize) {
+    client.SetSendAcks(false);
+    StreamString packet;
+    packet.Printf("QEnableCompression:type:%s;minsize:%zu;", name.str().c_str(),
+                  minsize);
+    ASSERT_EQ(PacketResult::Success, client.SendPacket(packet.GetString()));
+    Status error;
+    bool interrupt = false;
+    bool quit = false;
+    ASSERT_EQ(PacketResult::Success,
+              server.GetPacketAndSendResponse(std::chrono::seconds(1), error,
+                                              interrupt, quit));
+    StringExtractorGDBRemote response;
+    ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+    ASSERT_TRUE(response.IsOKResponse());
+    client.SetCompressionType(client.GetSupportedCompressionType(name));
+  }
 };
+
+// The reply to a jThreadsInfo packet for 'num_threads' threads, with their
+// expedited registers and the frame pointer chains of their stacks.
+std::string MakeThreadsInfo(int num_threads) {
+  StreamString info;
+  info.PutChar('[');
+  for (int tid = 1; tid <= num_threads; ++tid) {
+    info.Printf("%s{\"name\":\"worker-%d\",\"reason\":\"signal\","
+                "\"signal\":19,\"tid\":%d,\"registers\":{",
+                tid == 1 ? "" : ",", tid, 1000 + tid);
+    for (int reg = 0; reg < 24; ++reg)
+      info.Printf("%s\"%d\":\"%016llx\"", reg == 0 ? "" : ",", reg,
+                  0x00007fffffffe000ULL + reg * 0x10 + tid);
+    info.PutCString("},\"memory\":[");
+    for (int frame = 0; frame < 8; ++frame)
+      info.Printf("%s{\"address\":%d,\"bytes\":\"%016llx%016llx\"}",
+                  frame == 0 ? "" : ",", 0x7fffe000 + frame * 0x40,
+                  0x00007fffffffe040ULL + frame * 0x40,
+                  0x0000555555554000ULL + frame * 0x11);
+    info.PutCString("]}");
+  }
+  info.PutChar(']');
+  return info.GetString();
+}
+
+// The hex reply to an 'x' packet reading 'size' bytes of memory which looks
+// like a heap: small integers, pointers and zeros.
+std::string MakeMemoryRead(size_t size) {
+  std::mt19937_64 rng(42);
+  StreamString hex;
+  for (size_t i = 0; i < size; i += 8) {
+    const uint64_t kind = rng() % 4;
+    const uint64_t word = kind == 0   ? 0
+                          : kind == 1 ? rng() % 256
+                          : kind == 2 ? 0x00005555555a0000ULL + rng() % 0x10000
+                                      : rng();
+    hex.PutBytesAsRawHex8(&word, sizeof(word));
+  }
+  return hex.GetString();
+}
 } // end anonymous namespace
 
 TEST_F(GDBRemoteCommunicationTest, ReadPacket_checksum) {
@@ -65,3 +140,49 @@ TEST_F(GDBRemoteCommunicationTest, ReadPacket_checksum) {
     ASSERT_EQ(PacketResult::Success, server.GetAck());
   }
 }
+
+TEST_F(GDBRemoteCommunicationTest, ReadPacket_compressed) {
+  llvm::SmallVector<llvm::StringRef, 2> names;
+  llvm::StringRef(TestClient::GetSupportedCompressions()).split(names, ',');
+  const std::string large = MakeThreadsInfo(4);
+  for (llvm::StringRef name : names) {
+    if (name.empty())
+      continue;
+    SCOPED_TRACE(name.str());
+    EnableCompression(name, 64);
+    for (llvm::StringRef payload : {llvm::StringRef("OK"),
+                                    llvm::StringRef(large),
+                                    llvm::StringRef("T05thread:3e8;")}) {
+      StringExtractorGDBRemote response;
+      ASSERT_EQ(PacketResult::Success, server.SendPacket(payload));
+      ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+      ASSERT_EQ(payload, response.GetStringRef());
+    }
+  }
+}
+
+TEST_F(GDBRemoteCommunicationTest, ReadPacket_compressedLarge) {
+  llvm::SmallVector<llvm::StringRef, 2> names;
+  llvm::StringRef(TestClient::GetSupportedCompressions()).split(names, ',');
+  const std::string threads_info = MakeThreadsInfo(200);
+  const std::string memory = MakeMemoryRead(64 * 1024);
+  for (llvm::StringRef name : names) {
+    if (name.empty())
+      continue;
+    SCOPED_TRACE(name.str());
+    EnableCompression(name, 384);
+    for (const std::string *payload : {&threads_info, &memory}) {
+      // Both the thread registers and the heap contents repeat enough to
+      // be sent compressed.
+      std::string packet;
+      server.CompressPayload(*payload, packet);
+      EXPECT_EQ('C', packet[0]);
+      EXPECT_LT(packet.size(), payload->size());
+
+      StringExtractorGDBRemote response;
+      ASSERT_EQ(PacketResult::Success, server.SendPacket(*payload));
+      ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+      ASSERT_EQ(*payload, response.GetStringRef());
+    }
+  }
+}
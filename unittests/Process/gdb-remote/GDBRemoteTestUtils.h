@@ -42,6 +42,7 @@ struct MockServer : public GDBRemoteCommunicationServer {
                                sync_on_timeout);
   }
 
+  using GDBRemoteCommunicationServer::CompressPayload;
   using GDBRemoteCommunicationServer::SendOKResponse;
   using GDBRemoteCommunicationServer::SendUnimplementedResponse;
 };
@@ -18,6 +18,7 @@
 #include "TestingSupport/TestUtilities.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
@@ -297,6 +298,71 @@ TEST_F(MinidumpParserTest, FindMemoryRangeWithFullMemoryMinidump) {
   EXPECT_FALSE(parser->FindMemoryRange(0x7ffe0000 + 4096).hasValue());
 }
 
+TEST_F(MinidumpParserTest, GetMemorySpanningRanges) {
+  // A minidump with a single Memory64List stream. Its ranges are not sorted
+  // by address and the last two are adjacent both in memory and in the file.
+  struct Descriptor {
+    uint64_t start;
+    uint64_t size;
+  };
+  const Descriptor descriptors[] = {
+      {0x3000, 0x10}, {0x1000, 0x100}, {0x1100, 0x100}};
+  const uint32_t num_descriptors = llvm::array_lengthof(descriptors);
+  const uint32_t directory_rva = sizeof(MinidumpHeader);
+  const uint32_t stream_rva = directory_rva + sizeof(MinidumpDirectory);
+  const uint32_t stream_size =
+      16 + num_descriptors * sizeof(MinidumpMemoryDescriptor64);
+  const uint64_t base_rva = stream_rva + stream_size;
+
+  std::vector<uint8_t> bytes;
+  auto append = [&bytes](uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      bytes.push_back(value >> (8 * i));
+  };
+  append(static_cast<uint32_t>(MinidumpHeaderConstants::Signature), 4);
+  append(static_cast<uint32_t>(MinidumpHeaderConstants::Version), 4);
+  append(1, 4);             // streams_count
+  append(directory_rva, 4); // stream_directory_rva
+  append(0, 4);             // checksum
+  append(0, 4);             // time_date_stamp
+  append(0, 8);             // flags
+  append(static_cast<uint32_t>(MinidumpStreamType::Memory64List), 4);
+  append(stream_size, 4);
+  append(stream_rva, 4);
+  append(num_descriptors, 8);
+  append(base_rva, 8);
+  for (const Descriptor &desc : descriptors) {
+    append(desc.start, 8);
+    append(desc.size, 8);
+  }
+  for (const Descriptor &desc : descriptors)
+    for (uint64_t i = 0; i < desc.size; ++i)
+      bytes.push_back((desc.start + i) & 0xff);
+
+  llvm::Optional<MinidumpParser> optional_parser = MinidumpParser::Create(
+      std::make_shared<DataBufferHeap>(bytes.data(), bytes.size()));
+  ASSERT_TRUE(optional_parser.hasValue());
+  parser.reset(new MinidumpParser(optional_parser.getValue()));
+  auto result = parser->Initialize();
+  ASSERT_TRUE(result.Success()) << result.AsCString();
+
+  check_mem_range_exists(parser, 0x1000, 0x100);
+  check_mem_range_exists(parser, 0x1100, 0x100);
+  check_mem_range_exists(parser, 0x3000, 0x10);
+  EXPECT_FALSE(parser->FindMemoryRange(0xfff).hasValue());
+  EXPECT_FALSE(parser->FindMemoryRange(0x1200).hasValue());
+  EXPECT_FALSE(parser->FindMemoryRange(0x3010).hasValue());
+
+  llvm::ArrayRef<uint8_t> mem = parser->GetMemory(0x10f0, 0x20);
+  ASSERT_EQ(0x20UL, mem.size());
+  for (size_t i = 0; i < mem.size(); ++i)
+    EXPECT_EQ((0x10f0 + i) & 0xff, mem[i]);
+
+  EXPECT_EQ(0x110UL, parser->GetMemory(0x10f0, 0x1000).size());
+  EXPECT_EQ(0x10UL, parser->GetMemory(0x3000, 0x20).size());
+  EXPECT_TRUE(parser->GetMemory(0x2000, 0x10).empty());
+}
+
 void check_region_info(std::unique_ptr<MinidumpParser> &parser,
                        const uint64_t addr, MemoryRegionInfo::OptionalBool read,
                        MemoryRegionInfo::OptionalBool write,
@@ -0,0 +1,228 @@
+//===-- TestLineTable.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/LineTable.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+struct Row {
+  addr_t file_addr;
+  uint32_t line;
+  bool is_terminal_entry;
+};
+
+typedef std::vector<std::tuple<addr_t, uint32_t, bool>> RowList;
+
+// A line table without a compile unit, whose rows and sequence index can be
+// looked at directly.
+class TestLineTable : public LineTable {
+public:
+  TestLineTable() : LineTable(nullptr) {}
+
+  using LineTable::FindEntryIndexInSequences;
+
+  bool IsIndexed() const { return !m_sequence_index.IsEmpty(); }
+
+  RowList GetRows() const {
+    RowList rows;
+    for (const Entry &entry : m_entries)
+      rows.emplace_back(entry.file_addr, entry.line,
+                        static_cast<bool>(entry.is_terminal_entry));
+    return rows;
+  }
+
+  const Entry &GetEntry(uint32_t idx) const { return m_entries[idx]; }
+
+  std::unique_ptr<LineSequence> MakeSequence(const std::vector<Row> &rows) {
+    std::unique_ptr<LineSequence> sequence(CreateLineSequenceContainer());
+    for (const Row &row : rows)
+      AppendLineEntryToSequence(sequence.get(), row.file_addr, row.line,
+                                /*column*/ 0, /*file_idx*/ 1,
+                                /*is_start_of_statement*/ true,
+                                /*is_start_of_basic_block*/ false,
+                                /*is_prologue_end*/ false,
+                                /*is_epilogue_begin*/ false,
+                                row.is_terminal_entry);
+    return sequence;
+  }
+
+  void InsertSequences(const std::vector<std::vector<Row>> &sequences) {
+    std::vector<std::unique_ptr<LineSequence>> line_sequences;
+    for (const std::vector<Row> &rows : sequences)
+      line_sequences.push_back(MakeSequence(rows));
+    LineTable::InsertSequences(line_sequences);
+  }
+};
+
+// The index of the row describing file_addr, found by looking at all the
+// sequences.
+uint32_t FindEntryIndexLinearly(const TestLineTable &table,
+                                addr_t file_addr) {
+  const RowList rows = table.GetRows();
+  uint32_t first_idx = 0;
+  for (uint32_t idx = 0; idx < rows.size(); ++idx) {
+    if (!std::get<2>(rows[idx]))
+      continue;
+    if (std::get<0>(rows[first_idx]) <= file_addr &&
+        file_addr < std::get<0>(rows[idx])) {
+      uint32_t match = first_idx;
+      for (uint32_t i = first_idx; i < idx; ++i) {
+        if (std::get<0>(rows[i]) > file_addr)
+          break;
+        if (std::get<0>(rows[i]) != std::get<0>(rows[match]))
+          match = i;
+      }
+      return match;
+    }
+    first_idx = idx + 1;
+  }
+  return UINT32_MAX;
+}
+} // namespace
+
+TEST(LineTableTest, InsertSequencesSortsAndIndexes) {
+  TestLineTable table;
+  table.InsertSequences({{{0x200, 10, false}, {0x210, 11, false},
+                          {0x220, 0, true}},
+                         {{0x100, 1, false}, {0x110, 2, false},
+                          {0x120, 0, true}}});
+
+  EXPECT_EQ((RowList{{0x100, 1, false},
+                     {0x110, 2, false},
+                     {0x120, 0, true},
+                     {0x200, 10, false},
+                     {0x210, 11, false},
+                     {0x220, 0, true}}),
+            table.GetRows());
+  ASSERT_TRUE(table.IsIndexed());
+
+  EXPECT_EQ(UINT32_MAX, table.FindEntryIndexInSequences(0xff));
+  EXPECT_EQ(0u, table.FindEntryIndexInSequences(0x100));
+  EXPECT_EQ(0u, table.FindEntryIndexInSequences(0x10f));
+  EXPECT_EQ(1u, table.FindEntryIndexInSequences(0x110));
+  EXPECT_EQ(1u, table.FindEntryIndexInSequences(0x11f));
+  // The end of a sequence isn't part of it.
+  EXPECT_EQ(UINT32_MAX, table.FindEntryIndexInSequences(0x120));
+  EXPECT_EQ(UINT32_MAX, table.FindEntryIndexInSequences(0x1ff));
+  EXPECT_EQ(3u, table.FindEntryIndexInSequences(0x200));
+  EXPECT_EQ(4u, table.FindEntryIndexInSequences(0x21f));
+  EXPECT_EQ(UINT32_MAX, table.FindEntryIndexInSequences(0x220));
+}
+
+TEST(LineTableTest, AdjacentSequences) {
+  TestLineTable table;
+  table.InsertSequences({{{0x120, 5, false}, {0x130, 0, true}},
+                         {{0x100, 1, false}, {0x120, 0, true}}});
+
+  EXPECT_EQ((RowList{{0x100, 1, false},
+                     {0x120, 0, true},
+                     {0x120, 5, false},
+                     {0x130, 0, true}}),
+            table.GetRows());
+  ASSERT_TRUE(table.IsIndexed());
+
+  EXPECT_EQ(0u, table.FindEntryIndexInSequences(0x11f));
+  // The end of the first sequence is the start of the second one.
+  EXPECT_EQ(2u, table.FindEntryIndexInSequences(0x120));
+  EXPECT_EQ(2u, table.FindEntryIndexInSequences(0x12f));
+  EXPECT_EQ(UINT32_MAX, table.FindEntryIndexInSequences(0x130));
+}
+
+TEST(LineTableTest, OverlappingSequencesAreNotIndexed) {
+  // Like the sequences of functions removed by the linker, which all start
+  // at zero.
+  TestLineTable table;
+  table.InsertSequences({{{0x0, 7, false}, {0x20, 0, true}},
+                         {{0x0, 1, false}, {0x10, 0, true}},
+                         {{0x100, 3, false}, {0x110, 0, true}}});
+
+  EXPECT_EQ((RowList{{0x0, 1, false},
+                     {0x10, 0, true},
+                     {0x0, 7, false},
+                     {0x20, 0, true},
+                     {0x100, 3, false},
+                     {0x110, 0, true}}),
+            table.GetRows());
+  EXPECT_FALSE(table.IsIndexed());
+}
+
+TEST(LineTableTest, UnterminatedSequenceIsNotIndexed) {
+  TestLineTable table;
+  table.InsertSequences({{{0x100, 1, false}, {0x110, 0, true}},
+                         {{0x200, 2, false}, {0x210, 3, false}}});
+
+  EXPECT_EQ(4u, table.GetSize());
+  EXPECT_FALSE(table.IsIndexed());
+}
+
+TEST(LineTableTest, AppendLineEntryToSequenceCollapsesDuplicates) {
+  TestLineTable table;
+  table.InsertSequences({{{0x100, 1, false},
+                          {0x100, 2, false},
+                          {0x110, 3, false},
+                          {0x110, 4, false},
+                          {0x120, 0, true}}});
+
+  // The last row at an address replaces the ones before it, and marks the
+  // end of the prologue.
+  EXPECT_EQ((RowList{{0x100, 2, false}, {0x110, 4, false}, {0x120, 0, true}}),
+            table.GetRows());
+  EXPECT_TRUE(table.GetEntry(0).is_prologue_end);
+  EXPECT_TRUE(table.GetEntry(1).is_prologue_end);
+
+  ASSERT_TRUE(table.IsIndexed());
+  EXPECT_EQ(0u, table.FindEntryIndexInSequences(0x100));
+  EXPECT_EQ(1u, table.FindEntryIndexInSequences(0x115));
+}
+
+TEST(LineTableTest, InsertSequencesMatchesInsertSequence) {
+  // Sequences of a few rows each, with gaps and adjacent ones, in a random
+  // order.
+  std::vector<std::vector<Row>> sequences;
+  addr_t addr = 0x1000;
+  for (uint32_t i = 0; i < 64; ++i) {
+    std::vector<Row> rows;
+    for (uint32_t line = 0; line < i % 5 + 1; ++line) {
+      rows.push_back({addr, i * 10 + line, false});
+      addr += 4 + line * 2;
+    }
+    rows.push_back({addr, 0, true});
+    sequences.push_back(rows);
+    if (i % 3 == 0)
+      addr += 0x10;
+  }
+  std::mt19937 rng(42);
+  std::shuffle(sequences.begin(), sequences.end(), rng);
+
+  // How the line tables are built one sequence at a time.
+  TestLineTable serial_table;
+  for (const std::vector<Row> &rows : sequences)
+    serial_table.InsertSequence(serial_table.MakeSequence(rows).get());
+
+  TestLineTable table;
+  table.InsertSequences(sequences);
+  EXPECT_EQ(serial_table.GetRows(), table.GetRows());
+  ASSERT_TRUE(table.IsIndexed());
+
+  for (addr_t file_addr = 0xff0; file_addr < addr + 0x10; ++file_addr) {
+    SCOPED_TRACE(file_addr);
+    EXPECT_EQ(FindEntryIndexLinearly(table, file_addr),
+              table.FindEntryIndexInSequences(file_addr));
+  }
+}
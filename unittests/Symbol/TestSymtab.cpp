@@ -0,0 +1,144 @@
+//===-- TestSymtab.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Symtab.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+std::string MangleName(const std::string &name) {
+  return std::to_string(name.size()) + name;
+}
+
+// The mangled name of "void ns::<class_name>::<method_name>()".
+std::string MangleMethod(const std::string &class_name,
+                         const std::string &method_name) {
+  return "_ZN2ns" + MangleName(class_name) + MangleName(method_name) + "Ev";
+}
+
+// The mangled name of the complete object constructor of "ns::<class_name>".
+std::string MangleConstructor(const std::string &class_name) {
+  return "_ZN2ns" + MangleName(class_name) + "C1Ev";
+}
+
+void AddCodeSymbol(Symtab &symtab, const std::string &mangled) {
+  const uint32_t id = symtab.GetNumSymbols();
+  symtab.AddSymbol(Symbol(id, mangled.c_str(), true, eSymbolTypeCode,
+                          /*external*/ true, /*is_debug*/ false,
+                          /*is_trampoline*/ false, /*is_artificial*/ false,
+                          SectionSP(), /*value*/ id * 16, /*size*/ 16,
+                          /*size_is_valid*/ true,
+                          /*contains_linker_annotations*/ false, /*flags*/ 0));
+}
+
+// Fill a symtab with num_groups groups of symbols. Each group has:
+// - a constructor and a method of class "ns::C<i>",
+// - a method of class "ns::D<i>" which has no constructor,
+// - a method of class "ns::E<i>" whose constructor only comes at the end of
+//   the symbol table,
+// - a free function "f<i>".
+void FillSymtab(Symtab &symtab, uint32_t num_groups) {
+  for (uint32_t i = 0; i < num_groups; ++i) {
+    const std::string n = std::to_string(i);
+    AddCodeSymbol(symtab, MangleConstructor("C" + n));
+    AddCodeSymbol(symtab, MangleMethod("C" + n, "cm" + n));
+    AddCodeSymbol(symtab, MangleMethod("D" + n, "dm" + n));
+    AddCodeSymbol(symtab, MangleMethod("E" + n, "em" + n));
+    AddCodeSymbol(symtab, "_Z" + MangleName("f" + n) + "v");
+  }
+  for (uint32_t i = 0; i < num_groups; ++i)
+    AddCodeSymbol(symtab, MangleConstructor("E" + std::to_string(i)));
+}
+
+size_t CountFunctions(Symtab &symtab, const char *name, uint32_t name_type) {
+  SymbolContextList sc_list;
+  return symtab.FindFunctionSymbols(ConstString(name), name_type, sc_list);
+}
+} // namespace
+
+TEST(SymtabTest, InitNameIndexes) {
+  // Enough symbols to be split in several ranges indexed in parallel.
+  const uint32_t num_groups = 10000;
+  Symtab symtab(nullptr);
+  FillSymtab(symtab, num_groups);
+  symtab.PreloadSymbols();
+
+  for (uint32_t i : {0u, 1234u, num_groups - 1}) {
+    const std::string n = std::to_string(i);
+    SCOPED_TRACE(n);
+
+    // A method of a class with a known constructor is only a method.
+    EXPECT_EQ(1u, CountFunctions(symtab, ("cm" + n).c_str(),
+                                 eFunctionNameTypeMethod));
+    EXPECT_EQ(0u, CountFunctions(symtab, ("cm" + n).c_str(),
+                                 eFunctionNameTypeBase));
+
+    // Without a constructor, the context could be a namespace.
+    EXPECT_EQ(1u, CountFunctions(symtab, ("dm" + n).c_str(),
+                                 eFunctionNameTypeMethod));
+    EXPECT_EQ(1u, CountFunctions(symtab, ("dm" + n).c_str(),
+                                 eFunctionNameTypeBase));
+
+    // The constructor of E is found after the method, and likely in another
+    // range of the symbols.
+    EXPECT_EQ(1u, CountFunctions(symtab, ("em" + n).c_str(),
+                                 eFunctionNameTypeMethod));
+    EXPECT_EQ(0u, CountFunctions(symtab, ("em" + n).c_str(),
+                                 eFunctionNameTypeBase));
+
+    EXPECT_EQ(1u, CountFunctions(symtab, ("f" + n).c_str(),
+                                 eFunctionNameTypeBase));
+    EXPECT_EQ(1u, CountFunctions(symtab, ("f" + n + "()").c_str(),
+                                 eFunctionNameTypeFull));
+    EXPECT_EQ(1u, CountFunctions(symtab,
+                                 ("ns::C" + n + "::cm" + n + "()").c_str(),
+                                 eFunctionNameTypeFull));
+  }
+}
+
+TEST(SymtabTest, FindFunctionSymbolsWithoutObjectFile) {
+  Symtab symtab(nullptr);
+  FillSymtab(symtab, 1);
+
+  SymbolContextList sc_list;
+  ASSERT_EQ(1u, symtab.FindFunctionSymbols(ConstString("f0"),
+                                           eFunctionNameTypeBase, sc_list));
+  SymbolContext sc;
+  ASSERT_TRUE(sc_list.GetContextAtIndex(0, sc));
+  EXPECT_FALSE(sc.module_sp);
+  ASSERT_NE(nullptr, sc.symbol);
+  EXPECT_EQ(ConstString("_Z2f0v"), sc.symbol->GetMangled().GetMangledName());
+}
+
+// Measures how long indexing the names of a large symbol table takes. Run
+// with --gtest_also_run_disabled_tests to get the timing.
+TEST(SymtabTest, DISABLED_InitNameIndexesBenchmark) {
+  const uint32_t num_groups = 200000;
+  Symtab symtab(nullptr);
+  FillSymtab(symtab, num_groups);
+
+  auto start = std::chrono::steady_clock::now();
+  symtab.PreloadSymbols();
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  RecordProperty("InitNameIndexesMilliseconds", elapsed.count());
+  printf("InitNameIndexes for %u symbols: %lld ms\n", symtab.GetNumSymbols(),
+         static_cast<long long>(elapsed.count()));
+
+  EXPECT_EQ(1u, CountFunctions(symtab, "cm0", eFunctionNameTypeMethod));
+}
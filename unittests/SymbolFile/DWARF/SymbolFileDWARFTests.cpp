@@ -14,8 +14,12 @@
 #include "llvm/DebugInfo/PDB/PDBSymbolExe.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "Plugins/ObjectFile/PECOFF/ObjectFilePECOFF.h"
+#include "Plugins/SymbolFile/DWARF/DWARFAbbreviationDeclaration.h"
+#include "Plugins/SymbolFile/DWARF/DWARFUnit.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
 #include "Plugins/SymbolFile/PDB/SymbolFilePDB.h"
 #include "TestingSupport/TestUtilities.h"
@@ -28,7 +32,10 @@
 #include "lldb/Symbol/LineTable.h"
 #include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/StreamString.h"
 
 using namespace lldb_private;
 
@@ -74,3 +81,129 @@ TEST_F(SymbolFileDWARFTests, TestAbilitiesForDWARF) {
   uint32_t expected_abilities = SymbolFile::kAllAbilities;
   EXPECT_EQ(expected_abilities, symfile->CalculateAbilities());
 }
+
+TEST(NameToDIETest, EncodeDecode) {
+  NameToDIE map;
+  map.Insert(ConstString("foo"), DIERef(0x10, 0x20));
+  map.Insert(ConstString("bar"), DIERef(0x10, 0x30));
+  map.Insert(ConstString("foo"), DIERef(0x40, 0x50));
+  map.Finalize();
+
+  std::string strtab;
+  auto get_string_offset = [&strtab](ConstString name) -> uint32_t {
+    uint32_t offset = strtab.size();
+    strtab.append(name.GetCString(), name.GetLength() + 1);
+    return offset;
+  };
+  std::string encoded;
+  llvm::raw_string_ostream os(encoded);
+  map.Encode(os, get_string_offset);
+  os.flush();
+
+  DataExtractor data(encoded.data(), encoded.size(),
+                     endian::InlHostByteOrder(), sizeof(void *));
+  DataExtractor strtab_data(strtab.data(), strtab.size(),
+                            endian::InlHostByteOrder(), sizeof(void *));
+  NameToDIE decoded;
+  lldb::offset_t offset = 0;
+  ASSERT_TRUE(decoded.Decode(data, &offset, strtab_data));
+  EXPECT_EQ(encoded.size(), offset);
+
+  DIEArray foo_dies;
+  EXPECT_EQ(2u, decoded.Find(ConstString("foo"), foo_dies));
+  DIEArray bar_dies;
+  ASSERT_EQ(1u, decoded.Find(ConstString("bar"), bar_dies));
+  EXPECT_EQ(0x10u, bar_dies[0].cu_offset);
+  EXPECT_EQ(0x30u, bar_dies[0].die_offset);
+
+  // The decoded map is queried in place, without interning the names.
+  EXPECT_TRUE(decoded.IsFrozen());
+  DIEArray baz_dies;
+  EXPECT_EQ(0u, decoded.Find(llvm::StringRef("baz"), baz_dies));
+  EXPECT_EQ(0u, decoded.Find(llvm::StringRef("fo"), baz_dies));
+  foo_dies.clear();
+  ASSERT_EQ(2u, decoded.Find(llvm::StringRef("foo"), foo_dies));
+  EXPECT_EQ(0x40u, foo_dies[1].cu_offset);
+  EXPECT_EQ(0x50u, foo_dies[1].die_offset);
+  DIEArray cu_dies;
+  EXPECT_EQ(2u, decoded.FindAllEntriesForCompileUnit(0x10, cu_dies));
+  DIEArray regex_dies;
+  EXPECT_EQ(3u, decoded.Find(RegularExpression(llvm::StringRef("^(foo|bar)$")),
+                             regex_dies));
+
+  // Truncated data must be rejected rather than producing a partial map.
+  DataExtractor truncated(encoded.data(), encoded.size() - 1,
+                          endian::InlHostByteOrder(), sizeof(void *));
+  offset = 0;
+  EXPECT_FALSE(decoded.Decode(truncated, &offset, strtab_data));
+}
+
+TEST(NameToDIETest, FrozenQueriesDontInternNames) {
+  NameToDIE map;
+  map.Insert(ConstString("foo"), DIERef(0x10, 0x20));
+  map.Insert(ConstString("bar"), DIERef(0x10, 0x30));
+  map.Insert(ConstString("foo"), DIERef(0x40, 0x50));
+  map.Finalize();
+
+  // Names which no ConstString was made of.
+  std::string strtab;
+  auto get_string_offset = [&strtab](ConstString name) -> uint32_t {
+    uint32_t offset = strtab.size();
+    strtab += name.GetStringRef().str() + "_never_interned";
+    strtab.push_back('\0');
+    return offset;
+  };
+  std::string encoded;
+  llvm::raw_string_ostream os(encoded);
+  map.Encode(os, get_string_offset);
+  os.flush();
+
+  DataExtractor data(encoded.data(), encoded.size(),
+                     endian::InlHostByteOrder(), sizeof(void *));
+  DataExtractor strtab_data(strtab.data(), strtab.size(),
+                            endian::InlHostByteOrder(), sizeof(void *));
+  NameToDIE decoded;
+  lldb::offset_t offset = 0;
+  ASSERT_TRUE(decoded.Decode(data, &offset, strtab_data));
+
+  const uint64_t num_strings = ConstString::GetMemoryReport().num_strings;
+  DIEArray cu_dies;
+  EXPECT_EQ(2u, decoded.FindAllEntriesForCompileUnit(0x10, cu_dies));
+  EXPECT_EQ(1u, decoded.FindAllEntriesForCompileUnit(0x40, cu_dies));
+  DIEArray foo_dies;
+  EXPECT_EQ(2u, decoded.Find(llvm::StringRef("foo_never_interned"),
+                             foo_dies));
+  StreamString dump;
+  decoded.Dump(&dump);
+  EXPECT_NE(std::string::npos, dump.GetString().find("bar_never_interned"));
+  EXPECT_EQ(num_strings, ConstString::GetMemoryReport().num_strings);
+
+  // Appending it to a map keyed by ConstStrings interns each name.
+  NameToDIE appended;
+  appended.Append(decoded);
+  appended.Finalize();
+  EXPECT_EQ(num_strings + 2, ConstString::GetMemoryReport().num_strings);
+  foo_dies.clear();
+  EXPECT_EQ(2u, appended.Find(ConstString("foo_never_interned"), foo_dies));
+}
+
+TEST(DWARFAbbreviationDeclarationTest, GetAttributeOffset) {
+  DWARFAbbreviationDeclaration abbrev(DW_TAG_subprogram, DW_CHILDREN_yes);
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_external, DW_FORM_flag_present));
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_low_pc, DW_FORM_addr));
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_high_pc, DW_FORM_data4));
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_name, DW_FORM_strp));
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_decl_line, DW_FORM_udata));
+  abbrev.AddAttribute(DWARFAttribute(DW_AT_type, DW_FORM_ref4));
+
+  // Without a unit, addresses have the default size and offsets are 32-bit.
+  const dw_offset_t addr_size = DWARFUnit::GetAddressByteSize(nullptr);
+  EXPECT_EQ(0u, abbrev.GetAttributeOffset(0, nullptr));
+  EXPECT_EQ(0u, abbrev.GetAttributeOffset(1, nullptr));
+  EXPECT_EQ(addr_size, abbrev.GetAttributeOffset(2, nullptr));
+  EXPECT_EQ(addr_size + 4, abbrev.GetAttributeOffset(3, nullptr));
+  EXPECT_EQ(addr_size + 8, abbrev.GetAttributeOffset(4, nullptr));
+  // The ULEB128 before it has a variable size.
+  EXPECT_EQ(DW_INVALID_OFFSET, abbrev.GetAttributeOffset(5, nullptr));
+  EXPECT_EQ(DW_INVALID_OFFSET, abbrev.GetAttributeOffset(6, nullptr));
+}
@@ -0,0 +1,215 @@
+//===-- DynamicLoaderTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/DynamicLoader.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/ThreadPlan.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <cstring>
+
+using namespace lldb_private;
+using namespace lldb;
+using namespace lldb_private::platform_linux;
+
+namespace {
+
+const addr_t kBase = 0x10000;
+
+// A platform remembering the modules it was asked to find the scripting
+// resources of.
+class ScriptingPlatform : public PlatformLinux {
+public:
+  ScriptingPlatform() : PlatformLinux(true) {}
+
+  FileSpecList
+  LocateExecutableScriptingResources(Target *target, Module &module,
+                                     Stream *feedback_stream) override {
+    m_scripted_modules.push_back(module.GetFileSpec().GetFilename());
+    return FileSpecList();
+  }
+
+  std::vector<ConstString> m_scripted_modules;
+};
+
+// A process whose memory is a buffer, holding an image that only exists
+// there.
+class DummyProcess : public Process {
+public:
+  DummyProcess(TargetSP target_sp, ListenerSP listener_sp)
+      : Process(target_sp, listener_sp) {}
+
+  bool CanDebug(TargetSP target, bool plugin_specified_by_name) override {
+    return true;
+  }
+  Status DoDestroy() override { return Status(); }
+  void RefreshStateAfterStop() override {}
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+  ConstString GetPluginName() override { return ConstString("dummy"); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+  size_t DoReadMemory(addr_t vm_addr, void *buf, size_t size,
+                      Status &error) override {
+    if (vm_addr < kBase || vm_addr - kBase >= m_memory.size()) {
+      error.SetErrorString("invalid address");
+      return 0;
+    }
+    size = std::min(size, m_memory.size() - (vm_addr - kBase));
+    memcpy(buf, m_memory.data() + vm_addr - kBase, size);
+    return size;
+  }
+
+  std::vector<uint8_t> m_memory;
+};
+
+class DummyDynamicLoader : public DynamicLoader {
+public:
+  explicit DummyDynamicLoader(Process *process) : DynamicLoader(process) {}
+
+  void DidAttach() override {}
+  void DidLaunch() override {}
+  ThreadPlanSP GetStepThroughTrampolinePlan(Thread &thread,
+                                            bool stop_others) override {
+    return ThreadPlanSP();
+  }
+  Status CanLoadImage() override { return Status(); }
+  ConstString GetPluginName() override { return ConstString("dummy"); }
+  uint32_t GetPluginVersion() override { return 1; }
+};
+
+class DynamicLoaderTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    PlatformLinux::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    PlatformLinux::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+  }
+
+protected:
+  void SetUp() override {
+    ArchSpec arch("x86_64-pc-linux");
+    m_platform_sp = std::make_shared<ScriptingPlatform>();
+    PlatformSP platform_sp = m_platform_sp;
+    Platform::SetHostPlatform(platform_sp);
+    m_debugger_sp = Debugger::CreateInstance();
+    ASSERT_TRUE(m_debugger_sp);
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false, platform_sp,
+                                  m_target_sp)
+                    .Success());
+    ASSERT_TRUE(m_target_sp);
+
+    m_listener_sp = Listener::MakeListener("modules");
+    m_listener_sp->StartListeningForEvents(m_target_sp.get(),
+                                           Target::eBroadcastBitModulesLoaded);
+
+    m_process_sp = std::make_shared<DummyProcess>(
+        m_target_sp, Listener::MakeListener("dummy"));
+    auto buffer_or_error =
+        llvm::MemoryBuffer::getFile(GetInputFilePath("TestModule.so"));
+    ASSERT_TRUE(bool(buffer_or_error));
+    llvm::StringRef contents = (*buffer_or_error)->getBuffer();
+    m_process_sp->m_memory.assign(contents.begin(), contents.end());
+  }
+
+  void TearDown() override {
+    m_process_sp->Finalize();
+    m_process_sp.reset();
+    Debugger::Destroy(m_debugger_sp);
+  }
+
+  // The modules of each eBroadcastBitModulesLoaded event sent since the last
+  // call.
+  std::vector<ModuleList> LoadedBatches() {
+    std::vector<ModuleList> batches;
+    EventSP event_sp;
+    while (m_listener_sp->GetEvent(event_sp, std::chrono::seconds(0)))
+      batches.push_back(
+          Target::TargetEventData::GetModuleListFromEvent(event_sp.get()));
+    return batches;
+  }
+
+  ModuleSP LoadModuleFromMemory(bool notify) {
+    DummyDynamicLoader loader(m_process_sp.get());
+    // The file doesn't exist, so the module has to be read from memory.
+    FileSpec file("/nonexistent/libmemory.so", false);
+    return loader.LoadModuleAtAddress(file, LLDB_INVALID_ADDRESS, kBase, false,
+                                      notify);
+  }
+
+  std::shared_ptr<ScriptingPlatform> m_platform_sp;
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  ListenerSP m_listener_sp;
+  std::shared_ptr<DummyProcess> m_process_sp;
+};
+
+} // namespace
+
+TEST_F(DynamicLoaderTest, ModuleReadFromMemoryIsAnnounced) {
+  ModuleSP module_sp = LoadModuleFromMemory(true);
+  ASSERT_TRUE(module_sp);
+  ASSERT_NE(nullptr, module_sp->GetObjectFile());
+  EXPECT_NE(LLDB_INVALID_INDEX32,
+            m_target_sp->GetImages().GetIndexForModule(module_sp.get()));
+
+  std::vector<ModuleList> batches = LoadedBatches();
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_EQ(1u, batches[0].GetSize());
+  EXPECT_EQ(module_sp, batches[0].GetModuleAtIndex(0));
+  EXPECT_EQ(std::vector<ConstString>({ConstString("libmemory.so")}),
+            m_platform_sp->m_scripted_modules);
+}
+
+TEST_F(DynamicLoaderTest, ModuleReadFromMemoryWithoutNotifying) {
+  ModuleSP module_sp = LoadModuleFromMemory(false);
+  ASSERT_TRUE(module_sp);
+  EXPECT_NE(LLDB_INVALID_INDEX32,
+            m_target_sp->GetImages().GetIndexForModule(module_sp.get()));
+
+  // The module isn't announced, but its scripting resources are still
+  // looked for.
+  EXPECT_TRUE(LoadedBatches().empty());
+  EXPECT_EQ(std::vector<ConstString>({ConstString("libmemory.so")}),
+            m_platform_sp->m_scripted_modules);
+
+  // Loading it again finds it in the target.
+  EXPECT_EQ(module_sp, LoadModuleFromMemory(false));
+  EXPECT_EQ(1u, m_target_sp->GetImages().GetSize());
+  EXPECT_EQ(1u, m_platform_sp->m_scripted_modules.size());
+
+  // The caller announces it along with the rest of its batch.
+  ModuleList batch;
+  batch.Append(module_sp);
+  m_target_sp->ModulesDidLoad(batch);
+  std::vector<ModuleList> batches = LoadedBatches();
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_EQ(1u, batches[0].GetSize());
+  EXPECT_EQ(module_sp, batches[0].GetModuleAtIndex(0));
+}
@@ -0,0 +1,336 @@
+//===-- MemoryCacheTest.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Memory.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+
+#include <cstring>
+
+using namespace lldb_private;
+using namespace lldb;
+using namespace lldb_private::platform_linux;
+
+namespace {
+
+const addr_t kBase = 0x10000;
+const size_t kNumLines = 64;
+
+// A process whose memory is a buffer, counting how often it is read.
+class DummyProcess : public Process {
+public:
+  DummyProcess(TargetSP target_sp, ListenerSP listener_sp)
+      : Process(target_sp, listener_sp) {}
+
+  bool CanDebug(TargetSP target, bool plugin_specified_by_name) override {
+    return true;
+  }
+  Status DoDestroy() override { return Status(); }
+  void RefreshStateAfterStop() override {}
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+  ConstString GetPluginName() override { return ConstString("dummy"); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+  size_t DoReadMemory(addr_t vm_addr, void *buf, size_t size,
+                      Status &error) override {
+    ++m_read_calls;
+    return ReadRaw(vm_addr, buf, size, error);
+  }
+
+  std::vector<size_t> DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                         uint8_t *buf) override {
+    ++m_read_ranges_calls;
+    std::vector<size_t> bytes_read;
+    for (const MemoryRange &range : ranges) {
+      Status error;
+      bytes_read.push_back(
+          ReadRaw(range.GetRangeBase(), buf, range.GetByteSize(), error));
+      buf += range.GetByteSize();
+    }
+    return bytes_read;
+  }
+
+  size_t DoWriteMemory(addr_t vm_addr, const void *buf, size_t size,
+                       Status &error) override {
+    if (vm_addr < kBase || vm_addr - kBase + size > m_memory.size()) {
+      error.SetErrorString("invalid address");
+      return 0;
+    }
+    memcpy(m_memory.data() + vm_addr - kBase, buf, size);
+    return size;
+  }
+
+  Status EnableBreakpointSite(BreakpointSite *bp_site) override {
+    return EnableSoftwareBreakpoint(bp_site);
+  }
+
+  Status DisableBreakpointSite(BreakpointSite *bp_site) override {
+    return DisableSoftwareBreakpoint(bp_site);
+  }
+
+  MemoryCache &GetMemoryCache() { return m_memory_cache; }
+
+  std::vector<uint8_t> m_memory;
+  size_t m_read_calls = 0;
+  size_t m_read_ranges_calls = 0;
+
+private:
+  size_t ReadRaw(addr_t vm_addr, void *buf, size_t size, Status &error) {
+    if (vm_addr < kBase || vm_addr - kBase >= m_memory.size()) {
+      error.SetErrorString("invalid address");
+      return 0;
+    }
+    size = std::min(size, m_memory.size() - (vm_addr - kBase));
+    memcpy(buf, m_memory.data() + vm_addr - kBase, size);
+    return size;
+  }
+};
+
+class MemoryCacheTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    PlatformLinux::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    PlatformLinux::Terminate();
+    HostInfo::Terminate();
+  }
+
+protected:
+  void SetUp() override {
+    ArchSpec arch("x86_64-pc-linux");
+    PlatformSP platform_sp = PlatformLinux::CreateInstance(true, &arch);
+    Platform::SetHostPlatform(platform_sp);
+    m_debugger_sp = Debugger::CreateInstance();
+    ASSERT_TRUE(m_debugger_sp);
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false, platform_sp,
+                                  m_target_sp)
+                    .Success());
+    ASSERT_TRUE(m_target_sp);
+
+    m_process_sp = std::make_shared<DummyProcess>(
+        m_target_sp, Listener::MakeListener("dummy"));
+    m_line_size = m_process_sp->GetMemoryCacheLineSize();
+    m_prefetch_lines = m_process_sp->GetMemoryCachePrefetchLines();
+    ASSERT_GT(m_prefetch_lines, 0u);
+
+    m_process_sp->m_memory.resize(kNumLines * m_line_size);
+    for (size_t i = 0; i < m_process_sp->m_memory.size(); ++i)
+      m_process_sp->m_memory[i] = static_cast<uint8_t>(i * 7 + 1);
+    m_original = m_process_sp->m_memory;
+  }
+
+  void TearDown() override {
+    m_process_sp->Finalize();
+    m_process_sp.reset();
+    Debugger::Destroy(m_debugger_sp);
+  }
+
+  addr_t LineAddress(size_t line) const { return kBase + line * m_line_size; }
+
+  std::vector<uint8_t> Original(addr_t addr, size_t size) const {
+    auto begin = m_original.begin() + (addr - kBase);
+    return std::vector<uint8_t>(begin, begin + size);
+  }
+
+  std::vector<uint8_t> Read(addr_t addr, size_t size) {
+    std::vector<uint8_t> bytes(size);
+    Status error;
+    bytes.resize(
+        m_process_sp->GetMemoryCache().Read(addr, bytes.data(), size, error));
+    EXPECT_TRUE(error.Success()) << error.AsCString();
+    return bytes;
+  }
+
+  void SetBreakpoint(addr_t addr) {
+    BreakpointSP bp_sp = m_target_sp->CreateBreakpoint(addr, false, false);
+    ASSERT_TRUE(bp_sp);
+    BreakpointLocationSP loc_sp = bp_sp->GetLocationAtIndex(0);
+    ASSERT_TRUE(loc_sp);
+    ASSERT_NE(LLDB_INVALID_BREAK_ID,
+              m_process_sp->CreateBreakpointSite(loc_sp, false));
+  }
+
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  std::shared_ptr<DummyProcess> m_process_sp;
+  std::vector<uint8_t> m_original;
+  uint64_t m_line_size = 0;
+  uint64_t m_prefetch_lines = 0;
+};
+
+} // namespace
+
+TEST_F(MemoryCacheTest, ReadsLinesOnce) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  EXPECT_EQ(Original(kBase + 8, 4), Read(kBase + 8, 4));
+  MemoryCache::Statistics stats = cache.GetStatistics();
+  EXPECT_EQ(0u, stats.l2_hits);
+  EXPECT_EQ(1u, stats.l2_misses);
+  EXPECT_EQ(m_line_size, stats.bytes_from_process);
+  EXPECT_EQ(1u, m_process_sp->m_read_calls);
+
+  EXPECT_EQ(Original(kBase + 16, 4), Read(kBase + 16, 4));
+  stats = cache.GetStatistics();
+  EXPECT_EQ(1u, stats.l2_hits);
+  EXPECT_EQ(1u, stats.l2_misses);
+  EXPECT_EQ(4u, stats.bytes_from_cache);
+  EXPECT_EQ(1u, m_process_sp->m_read_calls);
+
+  // A read larger than a line goes to the L1 cache.
+  EXPECT_EQ(Original(LineAddress(4), 2 * m_line_size),
+            Read(LineAddress(4), 2 * m_line_size));
+  EXPECT_EQ(Original(LineAddress(4) + 4, 8), Read(LineAddress(4) + 4, 8));
+  stats = cache.GetStatistics();
+  EXPECT_EQ(1u, stats.l1_hits);
+  EXPECT_EQ(2u, m_process_sp->m_read_calls);
+}
+
+TEST_F(MemoryCacheTest, PrefetchesSequentialLines) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  // The third line read with the same stride reads the next ones with it.
+  for (size_t line = 0; line < 3; ++line)
+    EXPECT_EQ(Original(LineAddress(line), 4), Read(LineAddress(line), 4));
+  MemoryCache::Statistics stats = cache.GetStatistics();
+  EXPECT_EQ(3u, stats.l2_misses);
+  EXPECT_EQ(1u, stats.prefetch_reads);
+  EXPECT_EQ(m_prefetch_lines, stats.prefetched_lines);
+  EXPECT_EQ(3u, m_process_sp->m_read_calls);
+  EXPECT_EQ(0u, m_process_sp->m_read_ranges_calls);
+
+  for (size_t line = 3; line < 3 + m_prefetch_lines; ++line)
+    EXPECT_EQ(Original(LineAddress(line), 4), Read(LineAddress(line), 4));
+  stats = cache.GetStatistics();
+  EXPECT_EQ(3u, stats.l2_misses);
+  EXPECT_EQ(m_prefetch_lines, stats.l2_hits);
+  EXPECT_EQ(3u, m_process_sp->m_read_calls);
+}
+
+TEST_F(MemoryCacheTest, PrefetchesStridedLines) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  for (size_t line = 0; line < 6; line += 2)
+    EXPECT_EQ(Original(LineAddress(line), 4), Read(LineAddress(line), 4));
+  MemoryCache::Statistics stats = cache.GetStatistics();
+  EXPECT_EQ(3u, stats.l2_misses);
+  EXPECT_EQ(1u, stats.prefetch_reads);
+  EXPECT_EQ(m_prefetch_lines, stats.prefetched_lines);
+  // The last line and the prefetched ones are read as a list of ranges.
+  EXPECT_EQ(2u, m_process_sp->m_read_calls);
+  EXPECT_EQ(1u, m_process_sp->m_read_ranges_calls);
+
+  for (size_t line = 6; line < 6 + 2 * m_prefetch_lines; line += 2)
+    EXPECT_EQ(Original(LineAddress(line), 4), Read(LineAddress(line), 4));
+  stats = cache.GetStatistics();
+  EXPECT_EQ(3u, stats.l2_misses);
+  EXPECT_EQ(m_prefetch_lines, stats.l2_hits);
+  EXPECT_EQ(2u, m_process_sp->m_read_calls);
+  EXPECT_EQ(1u, m_process_sp->m_read_ranges_calls);
+}
+
+TEST_F(MemoryCacheTest, FlushDropsOverlappingData) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  Read(LineAddress(0), 4);
+  Read(LineAddress(1), 4);
+  Read(LineAddress(8), 2 * m_line_size);
+  EXPECT_EQ(0u, cache.GetStatistics().invalidations);
+
+  // Nothing is cached there.
+  cache.Flush(LineAddress(4), m_line_size);
+  EXPECT_EQ(0u, cache.GetStatistics().invalidations);
+
+  // Straddling the first two lines.
+  cache.Flush(LineAddress(1) - 2, 4);
+  EXPECT_EQ(2u, cache.GetStatistics().invalidations);
+
+  // Inside of the L1 chunk.
+  cache.Flush(LineAddress(9), 4);
+  EXPECT_EQ(3u, cache.GetStatistics().invalidations);
+
+  // The flushed memory is read again from the process.
+  m_process_sp->m_memory[0] ^= 0xff;
+  m_original[0] ^= 0xff;
+  const size_t read_calls = m_process_sp->m_read_calls;
+  EXPECT_EQ(Original(LineAddress(0), 4), Read(LineAddress(0), 4));
+  EXPECT_EQ(read_calls + 1, m_process_sp->m_read_calls);
+}
+
+TEST_F(MemoryCacheTest, ReadOverBreakpointSiteReturnsOriginalBytes) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  for (size_t line = 0; line < 16; ++line)
+    SetBreakpoint(LineAddress(line) + 8);
+  ASSERT_NE(m_original[8], m_process_sp->m_memory[8]);
+
+  Status error;
+  uint8_t byte;
+  ASSERT_EQ(1u,
+            m_process_sp->ReadMemoryFromInferior(kBase + 8, &byte, 1, error));
+  EXPECT_EQ(m_original[8], byte);
+
+  // Lines read on their own and prefetched along with the previous ones.
+  for (size_t line = 0; line < 3 + m_prefetch_lines; ++line)
+    EXPECT_EQ(Original(LineAddress(line) + 6, 4),
+              Read(LineAddress(line) + 6, 4));
+  EXPECT_EQ(m_prefetch_lines, cache.GetStatistics().prefetched_lines);
+
+  // Lines prefetched as a list of ranges.
+  cache.Clear();
+  for (size_t line = 0; line < 6 + 2 * m_prefetch_lines; line += 2)
+    EXPECT_EQ(Original(LineAddress(line) + 6, 4),
+              Read(LineAddress(line) + 6, 4));
+  EXPECT_EQ(2 * m_prefetch_lines, cache.GetStatistics().prefetched_lines);
+  EXPECT_EQ(1u, m_process_sp->m_read_ranges_calls);
+}
+
+TEST_F(MemoryCacheTest, ReadMemoryRangesKeepsRangesInCache) {
+  MemoryCache &cache = m_process_sp->GetMemoryCache();
+
+  std::vector<Process::MemoryRange> ranges = {
+      Process::MemoryRange(LineAddress(1) + 3, 40),
+      Process::MemoryRange(LineAddress(5) + 10, 100),
+      Process::MemoryRange(LineAddress(9), 20)};
+  std::vector<uint8_t> buffer(160);
+  std::vector<size_t> bytes_read =
+      m_process_sp->ReadMemoryRanges(ranges, buffer);
+  EXPECT_EQ(std::vector<size_t>({40, 100, 20}), bytes_read);
+  EXPECT_EQ(1u, m_process_sp->m_read_ranges_calls);
+  EXPECT_EQ(0u, m_process_sp->m_read_calls);
+
+  // Reading the ranges again, or a part of them, doesn't go back to the
+  // process.
+  const uint8_t *bytes = buffer.data();
+  for (const Process::MemoryRange &range : ranges) {
+    EXPECT_EQ(Original(range.GetRangeBase(), range.GetByteSize()),
+              std::vector<uint8_t>(bytes, bytes + range.GetByteSize()));
+    EXPECT_EQ(Original(range.GetRangeBase() + 4, 8),
+              Read(range.GetRangeBase() + 4, 8));
+    bytes += range.GetByteSize();
+  }
+  EXPECT_EQ(3u, cache.GetStatistics().l1_hits);
+  EXPECT_EQ(0u, m_process_sp->m_read_calls);
+  EXPECT_EQ(1u, m_process_sp->m_read_ranges_calls);
+}
@@ -0,0 +1,148 @@
+//===-- AgentExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include <inttypes.h>
+
+#include <map>
+
+using namespace lldb_private;
+
+namespace {
+class TestContext : public AgentExpression::Context {
+public:
+  Status ReadRegister(uint32_t reg, uint64_t &value) override {
+    auto pos = registers.find(reg);
+    if (pos == registers.end())
+      return Status("no register %u", reg);
+    value = pos->second;
+    return Status();
+  }
+
+  Status ReadMemory(lldb::addr_t addr, size_t size, uint64_t &value) override {
+    auto pos = memory.find(addr);
+    if (pos == memory.end())
+      return Status("no memory at 0x%" PRIx64, addr);
+    value = pos->second;
+    if (size < 8)
+      value &= (1ULL << (8 * size)) - 1;
+    return Status();
+  }
+
+  std::map<uint32_t, uint64_t> registers;
+  std::map<lldb::addr_t, uint64_t> memory;
+};
+
+uint64_t Evaluate(const AgentExpression &expr, TestContext &context) {
+  uint64_t result = 0xdeadbeef;
+  Status error = expr.Evaluate(context, result);
+  EXPECT_TRUE(error.Success()) << error.AsCString();
+  return result;
+}
+} // namespace
+
+TEST(AgentExpressionTest, Encoding) {
+  AgentExpression expr;
+  expr.EmitConst(0x12);
+  expr.EmitConst(0x1234);
+  expr.EmitConst(0x12345678);
+  expr.EmitConst(0x123456789aULL);
+  expr.EmitReg(0x102);
+  expr.EmitRef(4);
+  expr.EmitExt(32);
+  expr.Emit(AgentExpression::eOpEnd);
+  const std::vector<uint8_t> expected = {
+      0x22, 0x12, 0x23, 0x12, 0x34, 0x24, 0x12, 0x34, 0x56, 0x78,
+      0x25, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78, 0x9a, 0x26,
+      0x01, 0x02, 0x19, 0x16, 0x20, 0x27};
+  EXPECT_EQ(expected, expr.GetBytes().vec());
+}
+
+TEST(AgentExpressionTest, Arithmetic) {
+  TestContext context;
+  context.registers[7] = 0x1000;
+  context.memory[0x1010] = 0xfffffffe;
+
+  // *(int32_t *)($7 + 0x10) < 4, compared as signed then unsigned.
+  AgentExpression expr;
+  expr.EmitReg(7);
+  expr.EmitConst(0x10);
+  expr.Emit(AgentExpression::eOpAdd);
+  expr.EmitRef(4);
+  expr.EmitExt(32);
+  expr.EmitConst(4);
+  AgentExpression unsigned_expr = expr;
+  expr.Emit(AgentExpression::eOpLessSigned);
+  expr.Emit(AgentExpression::eOpEnd);
+  unsigned_expr.Emit(AgentExpression::eOpLessUnsigned);
+  unsigned_expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_EQ(1u, Evaluate(expr, context));
+  EXPECT_EQ(0u, Evaluate(unsigned_expr, context));
+
+  context.memory[0x1010] = 7;
+  EXPECT_EQ(0u, Evaluate(expr, context));
+}
+
+TEST(AgentExpressionTest, Goto) {
+  TestContext context;
+  // $0 == 3 || $1 == 4, evaluating $1 only when needed.
+  AgentExpression expr;
+  expr.EmitReg(0);
+  expr.EmitConst(3);
+  expr.Emit(AgentExpression::eOpEqual);
+  const size_t if_true = expr.EmitGoto(AgentExpression::eOpIfGoto);
+  expr.EmitReg(1);
+  expr.EmitConst(4);
+  expr.Emit(AgentExpression::eOpEqual);
+  const size_t to_end = expr.EmitGoto(AgentExpression::eOpGoto);
+  expr.SetGotoTarget(if_true, expr.GetSize());
+  expr.EmitConst(1);
+  expr.SetGotoTarget(to_end, expr.GetSize());
+  expr.Emit(AgentExpression::eOpEnd);
+
+  context.registers[0] = 3;
+  EXPECT_EQ(1u, Evaluate(expr, context));
+  context.registers[0] = 2;
+  context.registers[1] = 4;
+  EXPECT_EQ(1u, Evaluate(expr, context));
+  context.registers[1] = 5;
+  EXPECT_EQ(0u, Evaluate(expr, context));
+}
+
+TEST(AgentExpressionTest, Errors) {
+  TestContext context;
+  uint64_t result;
+
+  // A register the context can't read.
+  AgentExpression reg_expr;
+  reg_expr.EmitReg(3);
+  reg_expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_TRUE(reg_expr.Evaluate(context, result).Fail());
+
+  // Stack underflow.
+  AgentExpression underflow_expr;
+  underflow_expr.EmitConst(1);
+  underflow_expr.Emit(AgentExpression::eOpAdd);
+  underflow_expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_TRUE(underflow_expr.Evaluate(context, result).Fail());
+
+  // Running past the end, a truncated operand and an unknown opcode.
+  EXPECT_TRUE(AgentExpression({0x22, 0x01}).Evaluate(context, result).Fail());
+  EXPECT_TRUE(AgentExpression({0x23, 0x01}).Evaluate(context, result).Fail());
+  EXPECT_TRUE(AgentExpression({0x01, 0x27}).Evaluate(context, result).Fail());
+
+  // A loop forever and a jump out of the expression.
+  EXPECT_TRUE(
+      AgentExpression({0x21, 0x00, 0x00}).Evaluate(context, result).Fail());
+  EXPECT_TRUE(
+      AgentExpression({0x21, 0x01, 0x00}).Evaluate(context, result).Fail());
+}
@@ -0,0 +1,63 @@
+//===-- CRC32Test.cpp -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/CRC32.h"
+
+#include <vector>
+
+using namespace lldb_private;
+
+static uint32_t BitwiseCRC32(uint32_t crc, llvm::ArrayRef<uint8_t> data) {
+  crc = ~crc;
+  for (uint8_t byte : data) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+TEST(CRC32Test, KnownValues) {
+  EXPECT_EQ(0u, CRC32::Calculate({}));
+  EXPECT_EQ(0xcbf43926u,
+            CRC32::Calculate(llvm::makeArrayRef(
+                reinterpret_cast<const uint8_t *>("123456789"), 9)));
+}
+
+TEST(CRC32Test, MatchesReference) {
+  std::vector<uint8_t> data(4096);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i * 7 + (i >> 3);
+
+  // Cover all the alignments and the sizes around the block boundaries of the
+  // accelerated implementations.
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t size = 0; size + offset < data.size(); size += 13) {
+      llvm::ArrayRef<uint8_t> slice(data.data() + offset, size);
+      EXPECT_EQ(BitwiseCRC32(0x12345678, slice),
+                CRC32::Calculate(slice, 0x12345678))
+          << "offset " << offset << " size " << size;
+    }
+  }
+}
+
+TEST(CRC32Test, Incremental) {
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i;
+  llvm::ArrayRef<uint8_t> bytes(data);
+
+  CRC32 crc;
+  crc.Update(bytes.take_front(1));
+  crc.Update(bytes.slice(1, 100));
+  crc.Update(bytes.drop_front(101));
+  EXPECT_EQ(CRC32::Calculate(bytes), crc.GetValue());
+}
@@ -90,3 +90,26 @@ TEST(ConstStringTest, NullAndEmptyStates) {
   EXPECT_TRUE(null.IsEmpty());
   EXPECT_TRUE(null.IsNull());
 }
+
+TEST(ConstStringTest, MemoryReport) {
+  const ConstString::MemoryReport before = ConstString::GetMemoryReport();
+  ConstString foo("ConstStringTest-MemoryReport");
+  const ConstString::MemoryReport after = ConstString::GetMemoryReport();
+  EXPECT_EQ(before.num_strings + 1, after.num_strings);
+  EXPECT_LT(before.bytes_used, after.bytes_used);
+  EXPECT_LE(after.bytes_used, after.bytes_allocated);
+  EXPECT_LE(after.min_shard_strings, after.max_shard_strings);
+  EXPECT_LT(0u, after.num_shards);
+}
+
+TEST(ConstStringTest, Arena) {
+  const ConstString::MemoryReport before = ConstString::GetMemoryReport();
+  ConstStringArena arena;
+  ConstString foo = arena.GetString("ConstStringTest-Arena");
+  EXPECT_EQ(foo, arena.GetString("ConstStringTest-Arena"));
+  EXPECT_NE(foo, arena.GetString("ConstStringTest-Arena2"));
+  EXPECT_EQ("ConstStringTest-Arena", foo.GetStringRef());
+  EXPECT_EQ(2u, arena.GetMemoryReport().num_strings);
+  // The global pool doesn't get the strings of the arena.
+  EXPECT_EQ(before.num_strings, ConstString::GetMemoryReport().num_strings);
+}
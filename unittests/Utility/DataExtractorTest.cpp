@@ -0,0 +1,107 @@
+//===-- DataExtractorTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/DataExtractor.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+using namespace lldb_private;
+
+namespace {
+// Numbers of all the encoded lengths, with and without the sign bit of their
+// last group set.
+std::vector<int64_t> GetTestNumbers() {
+  std::vector<int64_t> numbers = {0, 1, -1, 63, 64, -64, -65, 127, 128};
+  for (int bits = 7; bits < 64; bits += 7) {
+    numbers.push_back((1LL << bits) - 1);
+    numbers.push_back(1LL << bits);
+    numbers.push_back(-(1LL << bits));
+    numbers.push_back(-(1LL << bits) - 1);
+  }
+  numbers.push_back(INT64_MAX);
+  numbers.push_back(INT64_MIN);
+  return numbers;
+}
+
+DataExtractor MakeExtractor(const std::string &bytes) {
+  return DataExtractor(bytes.data(), bytes.size(), lldb::eByteOrderLittle,
+                       sizeof(void *));
+}
+} // namespace
+
+TEST(DataExtractorTest, GetULEB128) {
+  for (int64_t number : GetTestNumbers()) {
+    const uint64_t value = number;
+    SCOPED_TRACE(value);
+    // Decode the number alone, which is decoded byte by byte, and followed by
+    // enough data to be decoded a word at a time.
+    for (size_t padding : {0, 8}) {
+      std::string bytes;
+      llvm::raw_string_ostream os(bytes);
+      llvm::encodeULEB128(value, os);
+      const lldb::offset_t size = os.str().size();
+      bytes.append(padding, '\xff');
+      DataExtractor data = MakeExtractor(bytes);
+
+      lldb::offset_t offset = 0;
+      EXPECT_EQ(value, data.GetULEB128(&offset));
+      EXPECT_EQ(size, offset);
+      offset = 0;
+      EXPECT_EQ(size - 1, data.Skip_LEB128(&offset));
+      EXPECT_EQ(size, offset);
+    }
+  }
+}
+
+TEST(DataExtractorTest, GetSLEB128) {
+  for (int64_t value : GetTestNumbers()) {
+    SCOPED_TRACE(value);
+    for (size_t padding : {0, 8}) {
+      std::string bytes;
+      llvm::raw_string_ostream os(bytes);
+      llvm::encodeSLEB128(value, os);
+      const lldb::offset_t size = os.str().size();
+      bytes.append(padding, '\xff');
+      DataExtractor data = MakeExtractor(bytes);
+
+      lldb::offset_t offset = 0;
+      EXPECT_EQ(value, data.GetSLEB128(&offset));
+      EXPECT_EQ(size, offset);
+      offset = 0;
+      EXPECT_EQ(size - 1, data.Skip_LEB128(&offset));
+      EXPECT_EQ(size, offset);
+    }
+  }
+}
+
+TEST(DataExtractorTest, GetULEB128Truncated) {
+  // A number which isn't terminated before the end of the data.
+  const std::string bytes(16, '\x81');
+  DataExtractor data = MakeExtractor(bytes);
+  lldb::offset_t offset = 0;
+  data.GetULEB128(&offset);
+  EXPECT_EQ(bytes.size(), offset);
+  offset = 8;
+  data.Skip_LEB128(&offset);
+  EXPECT_EQ(bytes.size(), offset);
+}
+
+TEST(DataExtractorTest, GetSLEB128Overlong) {
+  // A negative one padded with more groups than fit in 64 bits.
+  std::string bytes(11, '\xff');
+  bytes.push_back('\x7f');
+  DataExtractor data = MakeExtractor(bytes);
+  lldb::offset_t offset = 0;
+  EXPECT_EQ(-1, data.GetSLEB128(&offset));
+  EXPECT_EQ(bytes.size(), offset);
+}
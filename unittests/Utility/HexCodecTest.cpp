@@ -0,0 +1,128 @@
+//===-- HexCodecTest.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/HexCodec.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace {
+// The bytes 0 to 255 followed by some random ones, so that all the bytes go
+// through both the word at a time and the byte at a time paths.
+std::vector<uint8_t> GetTestBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  std::mt19937 rng(42);
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = i < 256 ? i : rng();
+  return bytes;
+}
+
+std::string Encode(llvm::ArrayRef<uint8_t> bytes, bool reverse = false) {
+  std::string hex(2 * bytes.size(), '\0');
+  HexCodec::Encode(bytes, &hex[0], reverse);
+  return hex;
+}
+
+std::string Escape(llvm::ArrayRef<uint8_t> bytes) {
+  std::string escaped(2 * bytes.size(), '\0');
+  escaped.resize(HexCodec::Escape(bytes, &escaped[0]));
+  return escaped;
+}
+} // namespace
+
+TEST(HexCodecTest, Encode) {
+  const uint8_t bytes[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0x0f};
+  EXPECT_EQ("0123456789abcdef0f", Encode(bytes));
+  EXPECT_EQ("0fefcdab8967452301", Encode(bytes, true));
+  EXPECT_EQ("", Encode({}));
+}
+
+TEST(HexCodecTest, EncodeMatchesPrintf) {
+  const std::vector<uint8_t> bytes = GetTestBytes(1027);
+  std::string expected;
+  for (uint8_t byte : bytes) {
+    char buf[3];
+    snprintf(buf, sizeof(buf), "%2.2x", byte);
+    expected += buf;
+  }
+  EXPECT_EQ(expected, Encode(bytes));
+}
+
+TEST(HexCodecTest, DecodeRoundTrip) {
+  for (size_t size : {0, 1, 3, 4, 5, 8, 255, 256, 1027}) {
+    SCOPED_TRACE(size);
+    const std::vector<uint8_t> bytes = GetTestBytes(size);
+    std::vector<uint8_t> decoded(size);
+    EXPECT_EQ(size, HexCodec::Decode(Encode(bytes), decoded));
+    EXPECT_EQ(bytes, decoded);
+
+    // Reversing twice gives the bytes back.
+    std::vector<uint8_t> reversed(size);
+    HexCodec::Decode(Encode(bytes, true), reversed);
+    EXPECT_EQ(bytes, std::vector<uint8_t>(reversed.rbegin(), reversed.rend()));
+  }
+}
+
+TEST(HexCodecTest, DecodeUpperCase) {
+  uint8_t bytes[5];
+  EXPECT_EQ(5u, HexCodec::Decode("ABCDEFabcd", bytes));
+  EXPECT_EQ(0xab, bytes[0]);
+  EXPECT_EQ(0xcd, bytes[1]);
+  EXPECT_EQ(0xef, bytes[2]);
+  EXPECT_EQ(0xab, bytes[3]);
+  EXPECT_EQ(0xcd, bytes[4]);
+}
+
+TEST(HexCodecTest, DecodeStopsAtInvalidPair) {
+  const std::string hex = Encode(GetTestBytes(64));
+  // Every character which isn't a hex digit, at every position of a word.
+  for (int ch = 0; ch < 256; ++ch) {
+    if (isxdigit(ch))
+      continue;
+    for (size_t pos = 0; pos < 16; ++pos) {
+      std::string bad = hex;
+      bad[pos] = ch;
+      uint8_t bytes[64];
+      ASSERT_EQ(pos / 2, HexCodec::Decode(bad, bytes)) << ch << " " << pos;
+    }
+  }
+
+  // Decoding stops at the end of the destination and at an odd character.
+  uint8_t bytes[2];
+  EXPECT_EQ(2u, HexCodec::Decode("112233", bytes));
+  EXPECT_EQ(1u, HexCodec::Decode("112", bytes));
+}
+
+TEST(HexCodecTest, Escape) {
+  const uint8_t bytes[] = {'a', '#', '$', '}', '*', 'b', 0x00, 0xff};
+  EXPECT_EQ(std::string("a}\x03}\x04}]}\x0a" "b\x00\xff", 12), Escape(bytes));
+
+  uint8_t unescaped[sizeof(bytes)];
+  const std::string escaped = Escape(bytes);
+  EXPECT_EQ(sizeof(bytes), HexCodec::Unescape(escaped, unescaped));
+  EXPECT_EQ(0, memcmp(bytes, unescaped, sizeof(bytes)));
+
+  // A trailing escape character is dropped.
+  EXPECT_EQ(1u, HexCodec::Unescape("a}", unescaped));
+}
+
+TEST(HexCodecTest, EscapeRoundTrip) {
+  const std::vector<uint8_t> bytes = GetTestBytes(4096);
+  const std::string escaped = Escape(bytes);
+  for (char ch : escaped)
+    EXPECT_TRUE(ch != '#' && ch != '$' && ch != '*');
+  std::vector<uint8_t> unescaped(escaped.size());
+  unescaped.resize(HexCodec::Unescape(escaped, unescaped.data()));
+  EXPECT_EQ(bytes, unescaped);
+}
@@ -0,0 +1,91 @@
+//===-- TracepointBufferTest.cpp --------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/TracepointBuffer.h"
+
+using namespace lldb_private;
+
+static TracepointBuffer::Entry MakeEntry(lldb::addr_t addr, size_t size) {
+  TracepointBuffer::Entry entry;
+  entry.addr = addr;
+  entry.tid = 1;
+  entry.data.assign(size, static_cast<uint8_t>(addr));
+  return entry;
+}
+
+static const size_t kEntrySize = sizeof(TracepointBuffer::Entry);
+
+TEST(TracepointBufferTest, DropsOldest) {
+  TracepointBuffer buffer(2 * kEntrySize + 10);
+  buffer.Append(MakeEntry(1, 4));
+  buffer.Append(MakeEntry(2, 4));
+  EXPECT_EQ(2 * kEntrySize + 8, buffer.GetByteSize());
+  EXPECT_EQ(0u, buffer.TakeNumDropped());
+
+  buffer.Append(MakeEntry(3, 4));
+  EXPECT_EQ(2u, buffer.GetNumEntries());
+  EXPECT_EQ(2 * kEntrySize + 8, buffer.GetByteSize());
+  EXPECT_EQ(1u, buffer.TakeNumDropped());
+  EXPECT_EQ(0u, buffer.TakeNumDropped());
+
+  // An entry bigger than the whole buffer is dropped by itself.
+  buffer.Append(MakeEntry(4, kEntrySize + 11));
+  EXPECT_EQ(2u, buffer.GetNumEntries());
+  EXPECT_EQ(1u, buffer.TakeNumDropped());
+
+  std::vector<TracepointBuffer::Entry> entries;
+  EXPECT_EQ(2u, buffer.Drain(100, entries));
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ(2u, entries[0].addr);
+  EXPECT_EQ(3u, entries[1].addr);
+  EXPECT_EQ(std::vector<uint8_t>(4, 3), entries[1].data);
+}
+
+TEST(TracepointBufferTest, EmptyEntriesFillTheBuffer) {
+  // Entries which collect nothing still take memory.
+  TracepointBuffer buffer(3 * kEntrySize);
+  for (lldb::addr_t addr = 0; addr < 4; ++addr)
+    buffer.Append(MakeEntry(addr, 0));
+  EXPECT_EQ(3u, buffer.GetNumEntries());
+  EXPECT_EQ(3 * kEntrySize, buffer.GetByteSize());
+  EXPECT_EQ(1u, buffer.TakeNumDropped());
+}
+
+TEST(TracepointBufferTest, Drain) {
+  TracepointBuffer buffer(5 * (kEntrySize + 10));
+  for (lldb::addr_t addr = 0; addr < 5; ++addr)
+    buffer.Append(MakeEntry(addr, 10));
+
+  std::vector<TracepointBuffer::Entry> entries;
+  // The limit is on the data drained, which is what a response holds.
+  EXPECT_EQ(2u, buffer.Drain(25, entries));
+  EXPECT_EQ(3 * (kEntrySize + 10), buffer.GetByteSize());
+  // At least one entry is drained, however small the limit.
+  EXPECT_EQ(1u, buffer.Drain(1, entries));
+  EXPECT_EQ(2u, buffer.Drain(100, entries));
+  EXPECT_EQ(0u, buffer.Drain(100, entries));
+  ASSERT_EQ(5u, entries.size());
+  for (lldb::addr_t addr = 0; addr < 5; ++addr)
+    EXPECT_EQ(addr, entries[addr].addr);
+  EXPECT_EQ(0u, buffer.GetByteSize());
+}
+
+TEST(TracepointBufferTest, GetEntryDataSize) {
+  TracepointCollect reg;
+  reg.reg = 3;
+  reg.size = 8;
+  TracepointCollect memory;
+  memory.kind = TracepointCollect::eMemory;
+  memory.offset = 0x1000;
+  memory.size = 16;
+  EXPECT_EQ(0u, TracepointBuffer::GetEntryDataSize({}));
+  EXPECT_EQ(26u, TracepointBuffer::GetEntryDataSize({reg, memory}));
+}